@@ -61,8 +61,10 @@ RAW_OBJ_FILES := $(addsuffix $(OBJ_FILE_EXT),$(BASE_SRC_NAMES))
 # The devops code requires the following object code to link
 # The devops code library utilizes tried and true dir ops and
 #	file ops functionality.  Meanwhile, file ops requires
-#	the memory library.  Also, dir ops requires file metadata.
+#	the memory library.  Also, dir ops requires file metadata
+#	and the arena library.
 DEVOPS_CODE_LINK_DEPS = $(DIST_DIR)devops_code$(OBJ_FILE_EXT) \
+                        $(DIST_DIR)skid_arena$(OBJ_FILE_EXT) \
                         $(DIST_DIR)skid_dir_operations$(OBJ_FILE_EXT) \
                         $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) \
                         $(DIST_DIR)skid_file_operations$(OBJ_FILE_EXT) \
@@ -72,16 +74,30 @@ DEVOPS_CODE_LINK_DEPS = $(DIST_DIR)devops_code$(OBJ_FILE_EXT) \
 # CHECK UNIT TEST VARIABLES
 # Prefix for *all* Check unit test files
 CHECK_PREFIX = check_
+# Prefix for all skid_async_log library unit tests
+CHECK_SAL_PREFIX = $(CHECK_PREFIX)sal_
+# Prefix for all skid_arena library unit tests
+CHECK_SAR_PREFIX = $(CHECK_PREFIX)sar_
 # Prefix for all skid_dir_operations library unit tests
 CHECK_SDO_PREFIX = $(CHECK_PREFIX)sdo_
 # Prefix for all skid_file_control library unit tests
 CHECK_SFC_PREFIX = $(CHECK_PREFIX)sfc_
+# Prefix for all skid_file_descriptors library unit tests
+CHECK_SFD_PREFIX = $(CHECK_PREFIX)sfd_
 # Prefix for all skid_file_link library unit tests
 CHECK_SFL_PREFIX = $(CHECK_PREFIX)sfl_
 # Prefix for all skid_file_metadata_read library unit tests
 CHECK_SFMR_PREFIX = $(CHECK_PREFIX)sfmr_
 # Prefix for all skid_file_metadata_write library unit tests
 CHECK_SFMW_PREFIX = $(CHECK_PREFIX)sfmw_
+# Prefix for all skid_file_operations library unit tests
+CHECK_SFO_PREFIX = $(CHECK_PREFIX)sfo_
+# Prefix for all skid_io_batch library unit tests
+CHECK_SIB_PREFIX = $(CHECK_PREFIX)sib_
+# Prefix for all skid_meta_cache library unit tests
+CHECK_SMC_PREFIX = $(CHECK_PREFIX)smc_
+# Prefix for all skid_slab library unit tests
+CHECK_SSLB_PREFIX = $(CHECK_PREFIX)sslb_
 # Prefix for all skid_validation library unit tests
 CHECK_SV_PREFIX = $(CHECK_PREFIX)sv_
 # All check*.c filenames found in TEST_DIR
@@ -251,6 +267,18 @@ _validate_musl:
 	@$(MCC) --version > $(NULL)
 	@echo "        $(CHECK) $(shell $(MCC) --version | head -n 1)"
 
+# CHECK: Linking skid_async_log library unit test binaries
+$(DIST_DIR)$(CHECK_SAL_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SAL_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_async_log$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
+# CHECK: Linking skid_arena library unit test binaries
+$(DIST_DIR)$(CHECK_SAR_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SAR_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_arena$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
 # CHECK: Linking skid_dir_operations library unit test binaries
 $(DIST_DIR)$(CHECK_SDO_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SDO_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
 	@#echo "$@ needs $^"  # DEBUGGING
@@ -263,6 +291,12 @@ $(DIST_DIR)$(CHECK_SFC_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SFC_PREFIX)%$
 	@echo "    Linking Check unit test binary: $@"
 	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
 
+# CHECK: Linking skid_file_descriptors library unit test binaries
+$(DIST_DIR)$(CHECK_SFD_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SFD_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
 # CHECK: Linking skid_file_link library unit test binaries
 $(DIST_DIR)$(CHECK_SFL_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SFL_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_link$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_metadata_read$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS) $(UNIT_TEST_LINK_DEPS)
 	@#echo "$@ needs $^"  # DEBUGGING
@@ -281,6 +315,30 @@ $(DIST_DIR)$(CHECK_SFMW_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SFMW_PREFIX)
 	@echo "    Linking Check unit test binary: $@"
 	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
 
+# CHECK: Linking skid_file_operations library unit test binaries
+$(DIST_DIR)$(CHECK_SFO_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SFO_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
+# CHECK: Linking skid_io_batch library unit test binaries
+$(DIST_DIR)$(CHECK_SIB_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SIB_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_io_batch$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
+# CHECK: Linking skid_meta_cache library unit test binaries
+$(DIST_DIR)$(CHECK_SMC_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SMC_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_metadata_read$(OBJ_FILE_EXT) $(DIST_DIR)skid_memory$(OBJ_FILE_EXT) $(DIST_DIR)skid_meta_cache$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
+# CHECK: Linking skid_slab library unit test binaries
+$(DIST_DIR)$(CHECK_SSLB_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SSLB_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_memory$(OBJ_FILE_EXT) $(DIST_DIR)skid_slab$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS)
+	@#echo "$@ needs $^"  # DEBUGGING
+	@echo "    Linking Check unit test binary: $@"
+	@$(CC) $(CFLAGS) -o $@ $^ $(CHECK_CC_ARGS)
+
 # CHECK: Linking skid_validation library unit test binaries
 $(DIST_DIR)$(CHECK_SV_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(CHECK_SV_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_metadata_read$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT) $(DEVOPS_CODE_LINK_DEPS) $(UNIT_TEST_LINK_DEPS)
 	@#echo "$@ needs $^"  # DEBUGGING
@@ -314,7 +372,7 @@ $(DIST_DIR)$(MAN_TEST_SC_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(MAN_TEST_SC_PREFI
 	@$(CC) $(CFLAGS) -o $@ $^ -I $(INCLUDE_DIR)
 
 # MANUAL TEST: Linking skid_dir_operations library manual test binaries
-$(DIST_DIR)$(MAN_TEST_SDO_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(MAN_TEST_SDO_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_dir_operations$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_metadata_read$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_operations$(OBJ_FILE_EXT) $(DIST_DIR)skid_memory$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT)
+$(DIST_DIR)$(MAN_TEST_SDO_PREFIX)%$(BIN_FILE_EXT): $(DIST_DIR)$(MAN_TEST_SDO_PREFIX)%$(OBJ_FILE_EXT) $(DIST_DIR)skid_arena$(OBJ_FILE_EXT) $(DIST_DIR)skid_dir_operations$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_descriptors$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_metadata_read$(OBJ_FILE_EXT) $(DIST_DIR)skid_file_operations$(OBJ_FILE_EXT) $(DIST_DIR)skid_memory$(OBJ_FILE_EXT) $(DIST_DIR)skid_validation$(OBJ_FILE_EXT)
 	@echo "    Linking manual test binary: $@"
 	@$(CC) $(CFLAGS) -o $@ $^ -I $(INCLUDE_DIR)
 
@@ -563,6 +563,26 @@ int make_a_socket(const char *filename);
  */
 int make_a_symlink(const char *target_path, const char *link_path);
 
+/*
+ *  Description:
+ *      Recursively fill dir_fd with num_files empty files and, while tree_depth is greater than
+ *      zero, tree_width sub-directories.  Every entry is named "eNNNNN" with a unique number,
+ *      taken from num_made, so a test can identify each entry by name alone.
+ *
+ *  Args:
+ *      dir_fd: An open file descriptor for an existing directory.
+ *      num_files: Number of files to create in each directory.
+ *      tree_width: Number of sub-directories to create in each directory.
+ *      tree_depth: Number of sub-directory levels to create beneath dir_fd.
+ *      num_made: [In/Out] The number to name the next entry with.  Incremented for each entry
+ *          created, so start it at 0 to count every entry in the tree.
+ *
+ *  Returns:
+ *      0 on success, errno on error.
+ */
+int make_a_tree(int dir_fd, unsigned int num_files, unsigned int tree_width,
+                unsigned int tree_depth, unsigned int *num_made);
+
 /*
  *  Description:
  *      Call usleep() to sleep for a number of microseconds.
@@ -603,6 +623,20 @@ char *read_a_file(const char *filename, int *errnum);
  */
 int remove_a_file(const char *filename, bool ignore_missing);
 
+/*
+ *  Description:
+ *      Use nftw() to delete dirname and everything beneath it.  Symbolic links are removed, not
+ *      followed.
+ *
+ *  Args:
+ *      dirname: The directory name, relative or absolute, to delete.
+ *      ignore_missing: Treat a missing dirname as success.
+ *
+ *  Returns:
+ *      0 on success, errno on error.
+ */
+int remove_a_tree(const char *dirname, bool ignore_missing);
+
 /*
  *    Description:
  *        Remove and empty directory by executing the following command in a shell:
@@ -0,0 +1,150 @@
+/*
+ *  This library defines a region (AKA arena) allocator for request-scoped memory.  Allocations
+ *  are carved, bump-pointer style, from chunks of virtual memory mapped with map_skid_mem() and
+ *  are never freed one by one.  Instead, clear_skid_arena() forgets every allocation at once, in
+ *  constant time, and keeps the chunks mapped for the next request.  free_skid_arena() unmaps the
+ *  chunks.  Arena-aware variants of the skid_memory and skid_file_descriptors functions that
+ *  allocate are provided so their results can share an arena.  Other libraries build on this one
+ *  (e.g., skid_dir_operations' read_dir_contents_arena()).
+ *
+ *  USAGE:
+ *      int errnum = ENOERR;       // Out-parameter for the results of SKID API functions
+ *      skidArena arena = { 0 };   // Zero-initialize it, then use it
+ *      size_t capacity = 0;       // Number of indices in dir_contents
+ *
+ *      // Handle a request
+ *      char *msg = read_fd_arena(&arena, clientfd, NULL, &errnum);
+ *      // See: skid_dir_operations.h
+ *      char **dir_contents = read_dir_contents_arena(&arena, msg, false, &errnum, &capacity);
+ *      // No free_skid_mem() or free_skid_dir_contents() calls... just forget them all
+ *      errnum = clear_skid_arena(&arena);
+ *      // Handle the next request with the same chunks
+ *
+ *      // Done with the arena
+ *      errnum = free_skid_arena(&arena);
+ *
+ *  NOTES:
+ *      - An arena is not thread-safe.  Give each thread its own (see: get_thread_arena()).
+ *      - Pointers into an arena are invalidated by clear_skid_arena() and free_skid_arena().
+ *        Never pass them to free_skid_mem(), free_skid_string(), or free_skid_dir_contents().
+ */
+
+#ifndef __SKID_ARENA__
+#define __SKID_ARENA__
+
+#include <stddef.h>                         // size_t
+#include "skid_macros.h"                    // ENOERR
+
+#define SKID_ARENA_CHUNK_SIZE 65536  // Default size, in bytes, of each chunk an arena maps
+
+// A chunk of an arena's mapped memory.  Arena internals only.
+typedef struct _skidArenaChunk skidArenaChunk, *skidArenaChunk_ptr;
+
+// A region of mapped chunks to allocate from.  Zero-initialize an arena (e.g.,
+// skidArena arena = { 0 };) before first use, optionally set chunk_size, and release it with
+// free_skid_arena().  Chunks are only mapped as they are needed.
+typedef struct _skidArena
+{
+    skidArenaChunk_ptr first;    // The first chunk, where a cleared arena starts over
+    skidArenaChunk_ptr current;  // The chunk allocations are carved from
+    size_t offset;               // Number of bytes of current in use
+    size_t chunk_size;           // Bytes to map per chunk, 0 for SKID_ARENA_CHUNK_SIZE
+    size_t mapped;               // Total number of bytes mapped for this arena
+} skidArena, *skidArena_ptr;
+
+/*
+ *  Description:
+ *      Allocate a zeroized array from an arena.  The memory is suitably aligned for any type.
+ *      Allocations too large for a chunk get a chunk of their own.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to allocate from.
+ *      num_elem: The number of elements in the array.
+ *      size_elem: The size of each element in the array.
+ *      errnum: [Out] Storage location for errno values encountered.  EOVERFLOW is used to
+ *          indicate num_elem * size_elem overflows a size_t.
+ *
+ *  Returns:
+ *      Zeroized memory of total size num_elem * size_elem, on success.  It lives until arena is
+ *      cleared or freed.  NULL on error (check errnum for details).
+ */
+void *alloc_skid_arena(skidArena_ptr arena, size_t num_elem, size_t size_elem, int *errnum);
+
+/*
+ *  Description:
+ *      Forget every allocation made from an arena, in constant time.  The chunks stay mapped
+ *      and are reused, in order, by later allocations.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to empty.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int clear_skid_arena(skidArena_ptr arena);
+
+/*
+ *  Description:
+ *      The arena-aware copy_skid_string().  Determine the length of source, allocate room for it
+ *      from an arena, and copy it.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to allocate from.
+ *      source: A string to copy.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A copy of source, on success.  It lives until arena is cleared or freed.  NULL on error
+ *      (check errnum for details).
+ */
+char *copy_skid_string_arena(skidArena_ptr arena, const char *source, int *errnum);
+
+/*
+ *  Description:
+ *      Unmap every chunk of an arena.  The arena's members, other than chunk_size, are zeroized
+ *      so it may be used again.  The cost is one munmap() per chunk, regardless of the number of
+ *      allocations.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to release.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  Every chunk is unmapped, best effort, regardless.
+ */
+int free_skid_arena(skidArena_ptr arena);
+
+/*
+ *  Description:
+ *      Fetch the calling thread's own arena, which is created empty on first use.  Each thread's
+ *      arena is freed automatically when that thread exits (but not when the process exits,
+ *      which unmaps everything anyway).  A thread may call clear_skid_arena() or
+ *      free_skid_arena() on its arena at any time.  Never hand it to another thread.
+ *
+ *  Args:
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The calling thread's arena, on success.  NULL on error (check errnum for details).
+ */
+skidArena_ptr get_thread_arena(int *errnum);
+
+/*
+ *  Description:
+ *      The arena-aware read_fd_len().  Read the contents of the file descriptor into memory
+ *      allocated from an arena.  Data is read directly into the unused end of the current chunk,
+ *      which is only copied if the data outgrows it.  This function is binary-safe and the data
+ *      is always nul-terminated (the terminator is not counted in output_len).
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to allocate from.
+ *      fd: File descriptor to read from.
+ *      output_len: [Optional/Out] The number of bytes read.  Set to 0 on error.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The contents of fd, on success.  It lives until arena is cleared or freed.  NULL on
+ *      error (check errnum for details).
+ */
+char *read_fd_arena(skidArena_ptr arena, int fd, size_t *output_len, int *errnum);
+
+#endif  /* __SKID_ARENA__ */
@@ -0,0 +1,103 @@
+/*
+ *  This library defines functionality to log messages without blocking the calling thread on
+ *  disk I/O.  Callers copy each message into a fixed-size record in a lock-free ring buffer.  A
+ *  dedicated writer thread timestamps the records, in the same "[YYYYMMDD-HHMMSS] msg" format
+ *  timestamp_a_msg() uses, and appends them to the log file in batches (see: skidAppender).
+ *
+ *  USAGE:
+ *      int errnum = ENOERR;  // Out-parameter for the results of SKID API functions
+ *      skidAsyncLog_ptr log = start_async_log("/tmp/server.log", 0, SKID_LOG_COUNT, &errnum);
+ *      // Any number of threads may call this concurrently
+ *      errnum = write_async_log(log, "Request handled");
+ *      // Once every thread is done logging
+ *      errnum = stop_async_log(&log);  // Writes everything that's left
+ *
+ *  NOTES:
+ *      write_async_log() never allocates memory and never touches the log file.  What it does
+ *      when the ring is full is governed by the skidLogOverflow policy.
+ */
+
+#ifndef __SKID_ASYNC_LOG__
+#define __SKID_ASYNC_LOG__
+
+#include <stdint.h>                         // uint64_t
+#include "skid_macros.h"                    // ENOERR
+
+#define SKID_LOG_MSG_MAX 224       // Longer messages are truncated to this many bytes
+#define SKID_LOG_RECORDS 4096      // Default number of records in the ring
+
+// What write_async_log() does when every record in the ring is in use.
+typedef enum _skidLogOverflow
+{
+    SKID_LOG_BLOCK = 1,  // Wait for the writer thread to free a record
+    SKID_LOG_DROP,       // Discard the message and return EAGAIN
+    SKID_LOG_COUNT       // Like SKID_LOG_DROP but the writer also logs how many were discarded
+} skidLogOverflow;
+
+// Opaque handle to an asynchronous log: the ring buffer, the writer thread, and the log file.
+typedef struct _skidAsyncLog skidAsyncLog, *skidAsyncLog_ptr;
+
+/*
+ *  Description:
+ *      Report how many messages have been discarded because the ring was full.  Always 0 for
+ *      SKID_LOG_BLOCK.
+ *
+ *  Args:
+ *      async_log: The asynchronous log to inspect.
+ *
+ *  Returns:
+ *      The number of discarded messages.  0 if async_log is NULL.
+ */
+uint64_t get_async_log_drops(skidAsyncLog_ptr async_log);
+
+/*
+ *  Description:
+ *      Open (or create) filename for appending and start the writer thread that empties the
+ *      ring into it.
+ *
+ *  Args:
+ *      filename: Absolute or relative filename to log to.
+ *      num_records: The number of records in the ring, rounded up to a power of two.  Use 0
+ *          for SKID_LOG_RECORDS.
+ *      policy: What write_async_log() does when the ring is full.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A new asynchronous log, on success.  Stop it with stop_async_log().  NULL on error (check
+ *      errnum for details).
+ */
+skidAsyncLog_ptr start_async_log(const char *filename, unsigned int num_records,
+                                 skidLogOverflow policy, int *errnum);
+
+/*
+ *  Description:
+ *      Stop the writer thread, after it has written every message already in the ring, close
+ *      the log file, and free the asynchronous log.  Call this only once no other thread is
+ *      calling write_async_log().
+ *
+ *  Args:
+ *      async_log: [In/Out] A pointer to the asynchronous log to stop.  Set to NULL on success.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  This includes the first error the writer thread
+ *      encountered writing to the log file.
+ */
+int stop_async_log(skidAsyncLog_ptr *async_log);
+
+/*
+ *  Description:
+ *      Copy msg into the ring for the writer thread to timestamp and log.  The time is taken
+ *      now, not when the writer gets to it.  A trailing newline is optional; one is always
+ *      written.  Safe to call from any number of threads at once.
+ *
+ *  Args:
+ *      async_log: The asynchronous log to write to.
+ *      msg: The message to log.  Messages longer than SKID_LOG_MSG_MAX bytes are truncated.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the ring was full and msg was
+ *      discarded (see: skidLogOverflow).
+ */
+int write_async_log(skidAsyncLog_ptr async_log, const char *msg);
+
+#endif  /* __SKID_ASYNC_LOG__ */
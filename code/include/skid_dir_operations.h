@@ -5,9 +5,104 @@
 #define _DEFAULT_SOURCE  // Make glibc expose macros to test a struct dirent.d_type's value
 #endif  /* _DEFAULT_SOURCE */
 
+#include <dirent.h>                         // DT_DIR, DT_REG, etc.
+#include <stdatomic.h>                      // atomic_uint_fast64_t
 #include <stdbool.h>                        // bool, false, true
 #include <stddef.h>                         // size_t
-#include <sys/stat.h>                       // mode_t
+#include <sys/stat.h>                       // mode_t, UTIME_NOW, UTIME_OMIT
+#include <sys/types.h>                      // gid_t, uid_t
+#include <time.h>                           // struct timespec
+#include "skid_arena.h"                     // skidArena_ptr
+
+#define SKID_WALK_MAX_THREADS 64  // The most workers walk_dir_parallel() will use
+
+// The results of read_dir_listing().  Every path is stored, nul-terminated, in a single
+// heap-allocated string arena and is located by its offset into that arena.  Zero-initialize a
+// listing (e.g., skidDirListing listing = { 0 };) before first use and release it with
+// free_dir_listing().  A listing is not thread-safe.
+typedef struct _skidDirListing
+{
+    char *arena;        // Heap-allocated paths, back to back
+    size_t arena_len;   // Number of bytes used in arena
+    size_t arena_size;  // Number of bytes allocated for arena
+    size_t *offsets;    // Heap-allocated array of each path's offset into arena
+    size_t count;       // Number of paths in the listing
+    size_t capacity;    // Number of elements allocated in offsets
+} skidDirListing, *skidDirListing_ptr;
+
+// Progress counters destroy_dir_parallel() updates as it deletes.  Zero-initialize it before
+// the call.  Another thread may poll it, with atomic_load(), while the deletion is underway.
+typedef struct _skidDestroyProgress
+{
+    atomic_uint_fast64_t files_deleted;  // Number of non-directories unlinked
+    atomic_uint_fast64_t dirs_deleted;   // Number of directories removed, dirname included
+} skidDestroyProgress, *skidDestroyProgress_ptr;
+
+// The changes set_tree_meta() makes to every entry in a tree.  Start from SKID_TREE_META_INIT,
+// which changes nothing, and fill in only the attributes to change.  Permissions are computed
+// as ((set_mode ? file_mode or dir_mode : current) & ~remove_mode) | add_mode.
+typedef struct _skidTreeMeta
+{
+    bool set_mode;          // Replace the permissions with file_mode or dir_mode
+    mode_t file_mode;       // New permissions for every non-directory, if set_mode
+    mode_t dir_mode;        // New permissions for every directory, if set_mode
+    mode_t remove_mode;     // Permission bits to turn off (e.g., S_IWOTH)
+    mode_t add_mode;        // Permission bits to turn on (e.g., S_IRGRP)
+    uid_t owner;            // New owner, or (uid_t)-1 to leave it alone
+    gid_t group;            // New group, or (gid_t)-1 to leave it alone
+    struct timespec atime;  // New access time, UTIME_NOW, or UTIME_OMIT to leave it alone
+    struct timespec mtime;  // New modification time, UTIME_NOW, or UTIME_OMIT to leave it alone
+} skidTreeMeta, *skidTreeMeta_ptr;
+
+// A skidTreeMeta that changes nothing
+#define SKID_TREE_META_INIT { .set_mode = false, .owner = (uid_t)-1, .group = (gid_t)-1, \
+                              .atime = { .tv_nsec = UTIME_OMIT }, \
+                              .mtime = { .tv_nsec = UTIME_OMIT } }
+
+// Progress counters set_tree_meta() updates as it works.  Zero-initialize it before the call.
+// Another thread may poll it, with atomic_load(), while the changes are underway.
+typedef struct _skidTreeMetaProgress
+{
+    atomic_uint_fast64_t entries_checked;  // Number of entries stat()ed, dirname included
+    atomic_uint_fast64_t entries_changed;  // Number of entries that needed at least one change
+} skidTreeMetaProgress, *skidTreeMetaProgress_ptr;
+
+// What a DirVisitor tells walk_dir() to do next.
+typedef enum _skidWalkAction
+{
+    SKID_WALK_CONTINUE = 0,  // Keep walking (and descend into this entry if it's a directory)
+    SKID_WALK_PRUNE,         // Don't descend into this directory; same as CONTINUE otherwise
+    SKID_WALK_STOP           // End the walk now; walk_dir() returns ENOERR
+} skidWalkAction;
+
+// One directory entry, as walk_dir() hands it to a DirVisitor.  Every pointer and the
+// file descriptor are only valid for the duration of the call.  Look the entry up with dir_fd
+// and name (e.g., get_file_meta_at(), fstatat()) rather than path: that resolves one component
+// instead of every directory between the current working directory and the entry.
+typedef struct _skidDirEntry
+{
+    const char *path;     // dirname joined with every name down to this entry
+    const char *name;     // This entry's name, the final component of path
+    size_t path_len;      // Length of path
+    unsigned char type;   // DT_* file type (see: readdir(3)), symbolic links are not followed
+    size_t depth;         // 1 for the entries of dirname itself, 2 for theirs, etc.
+    int dir_fd;           // Open file descriptor of the directory containing this entry
+    unsigned int worker;  // Index of the walk_dir_parallel() worker visiting this entry, else 0
+} skidDirEntry, *skidDirEntry_ptr;
+
+/*
+ *  Description:
+ *      Function pointer to be used with walk_dir().  Called once per entry, as it's read,
+ *      with each directory visited before its contents.
+ *
+ *  Args:
+ *      entry: The entry being visited.  Copy anything that must outlive the call.
+ *      context: The context pointer passed to walk_dir().
+ *
+ *  Returns:
+ *      A skidWalkAction describing how the walk continues.
+ */
+typedef skidWalkAction (*DirVisitor)(const skidDirEntry *entry, void *context);
 
 /*
  *  Description:
@@ -59,6 +154,40 @@ int delete_dir(const char *dirname);
  */
 int destroy_dir(const char *dirname);
 
+/*
+ *  Description:
+ *      The high-throughput destroy_dir().  A pool of walk_dir_parallel() workers reads the tree
+ *      with getdents64() and, as each batch of records is read, unlinks the files in it,
+ *      relative to the directory's file descriptor, before any sub-directory is descended into.
+ *      Each directory is removed, relative to its parent's file descriptor, by whichever worker
+ *      finishes the last of its contents.
+ *
+ *  Args:
+ *      dirname: Absolute or relative directory to destroy.
+ *      num_threads: The number of workers, counting the calling thread.  0 for one per online
+ *          CPU.  Capped at SKID_WALK_MAX_THREADS.
+ *      progress: [Optional] Counters to update as entries are deleted.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  On failure, some of the tree may
+ *      already be gone (see: progress).
+ */
+int destroy_dir_parallel(const char *dirname, unsigned int num_threads,
+                         skidDestroyProgress_ptr progress);
+
+/*
+ *  Description:
+ *      Free the memory held by a read_dir_listing() listing, in two free() calls regardless of
+ *      the number of paths, and zeroize it so it may be reused.
+ *
+ *  Args:
+ *      listing: [In/Out] The listing to free.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int free_dir_listing(skidDirListing_ptr listing);
+
 /*
  *  Description:
  *      Easily free the return value from the read_dir_contents() function.
@@ -71,13 +200,29 @@ int destroy_dir(const char *dirname);
  */
 int free_skid_dir_contents(char ***dir_contents);
 
+/*
+ *  Description:
+ *      Fetch one path from a listing.  The pointer is invalidated by the next read_dir_listing()
+ *      or free_dir_listing() call on listing.
+ *
+ *  Args:
+ *      listing: The listing to read from.
+ *      index: The index of the path, from 0 to listing->count - 1.
+ *
+ *  Returns:
+ *      A pointer into the listing's arena, on success.  NULL if listing is NULL or index is out
+ *      of range.
+ */
+const char *get_dir_listing_path(const skidDirListing *listing, size_t index);
+
 /*
  *  Description:
  *      Read the contents of dirname into a heap-allocated, NULL-terminated, array of string
  *      buffers.  It is the caller's responsibility to free the memory (each string and the array)
  *      returned by this function.  Use free_skid_mem() to free individual string pointers
  *      (AKA pick-and-choose what to keep) or use free_skid_dir_contents() to free the entire
- *      collection.
+ *      collection.  Use read_dir_listing() instead for large trees; it does not allocate each
+ *      path separately.
  *
  *  Args:
  *      dirname: Absolute or relative directory to read the contents of (must exist).
@@ -92,4 +237,123 @@ int free_skid_dir_contents(char ***dir_contents);
  */
 char **read_dir_contents(const char *dirname, bool recurse, int *errnum, size_t *capacity);
 
+/*
+ *  Description:
+ *      The arena-aware read_dir_contents().  Read the contents of dirname into a NULL-terminated
+ *      array of strings allocated from an arena.  The tree is read with read_dir_listing() and
+ *      then copied to arena with two allocations, instead of one heap allocation per path, so
+ *      there is nothing to free path by path.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to allocate from.
+ *      dirname: Absolute or relative directory to read the contents of (must exist).
+ *      recurse: If true, also include all sub-dirs and their files in the array.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *      capacity: [Out] The total number of available indices, 0 or otherwise, in the return value.
+ *
+ *  Returns:
+ *      An array of string pointers, on success.  It lives until arena is cleared or freed.  If
+ *      dirname is empty, this function will return NULL but errnum will be ENOERR.  On failure,
+ *      NULL will be returned and errnum will be set with an errno value.
+ */
+char **read_dir_contents_arena(skidArena_ptr arena, const char *dirname, bool recurse,
+                               int *errnum, size_t *capacity);
+
+/*
+ *  Description:
+ *      Read the contents of dirname into listing.  Paths are stored in the same order
+ *      read_dir_contents() uses: each directory is immediately followed by its contents.  Unlike
+ *      read_dir_contents(), there is one allocation for all of the paths (grown geometrically)
+ *      instead of one per path so large trees are read in linear time and freed in one call.
+ *
+ *  Args:
+ *      dirname: Absolute or relative directory to read the contents of (must exist).
+ *      recurse: If true, also include all sub-dirs and their files in the listing.
+ *      listing: [In/Out] A zero-initialized listing or one that already holds paths.  New paths
+ *          are appended.  On error, listing is restored to the paths it held on entry.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  An empty dirname adds nothing to listing.
+ */
+int read_dir_listing(const char *dirname, bool recurse, skidDirListing_ptr listing);
+
+/*
+ *  Description:
+ *      Apply changes to dirname and everything beneath it, like chmod -R, chown -R, and
+ *      touch combined, in one walk_dir_parallel() pass.  Each entry is checked with a single
+ *      fstatat() relative to its directory's file descriptor and only the attributes that
+ *      differ from changes are written, with fchownat(), fchmodat(), and utimensat() relative
+ *      to the same file descriptor.  An entry already in the target state costs one system
+ *      call.  Like chmod -R, directories are changed before their contents, so a change that
+ *      grants access (e.g., an add_mode of S_IRUSR | S_IXUSR) lets the walk into a directory it
+ *      couldn't read.  Turning off the owner's read and search bits waits until the directory's
+ *      contents are done, so a restrictive dir_mode can't lock the walk out.  Symbolic links are
+ *      never followed: their ownership and timestamps are changed but they have no permissions
+ *      of their own.  Ownership is changed before permissions since chown() may clear the
+ *      set-user-ID and set-group-ID bits.
+ *
+ *  Args:
+ *      dirname: Absolute or relative directory to change (must exist).
+ *      changes: The changes to make (see: skidTreeMeta).
+ *      num_threads: The number of workers, counting the calling thread.  0 for one per online
+ *          CPU.  Capped at SKID_WALK_MAX_THREADS.
+ *      progress: [Optional] Counters to update as entries are checked.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  An entry that can't be changed, or a
+ *      directory that can't be read, doesn't stop the rest of the tree from being changed, and
+ *      the first such errno value is returned.  EINVAL if changes holds bits outside of 07777
+ *      or an invalid timestamp.
+ */
+int set_tree_meta(const char *dirname, const skidTreeMeta *changes, unsigned int num_threads,
+                  skidTreeMetaProgress_ptr progress);
+
+/*
+ *  Description:
+ *      Walk dirname, depth-first, calling visitor for each entry as soon as it's read.  Nothing
+ *      is accumulated so memory use is bounded by the depth of the walk (one open directory and
+ *      one getdents64() buffer per level) rather than the size of the tree.  Symbolic links are
+ *      reported but never followed.  This is the engine read_dir_listing() is built on.
+ *
+ *  Args:
+ *      dirname: Absolute or relative directory to walk (must exist).
+ *      max_depth: The deepest entries to visit (e.g., 1 visits only dirname's own entries).
+ *          Use 0 for no limit.
+ *      visitor: Called for each entry.  Its return value can prune a sub-directory or end the
+ *          walk early.
+ *      context: [Optional] Passed, untouched, to visitor.
+ *
+ *  Returns:
+ *      ENOERR on success, including a walk ended early by SKID_WALK_STOP.  On failure, an errno
+ *      value.  ENAMETOOLONG if a path would exceed PATH_MAX.
+ */
+int walk_dir(const char *dirname, size_t max_depth, DirVisitor visitor, void *context);
+
+/*
+ *  Description:
+ *      Walk dirname like walk_dir() but spread the work across num_threads worker threads (the
+ *      calling thread is one of them).  Each worker keeps its own double-ended queue of
+ *      directories waiting to be read.  A worker reads the newest directory it queued, which
+ *      keeps it depth-first and cache-friendly, and an idle worker steals the oldest directory
+ *      another worker queued, which tends to be the largest unexplored subtree.  Entries are
+ *      visited in no particular order, except that a directory is always visited before its
+ *      contents.
+ *
+ *  Args:
+ *      dirname: Absolute or relative directory to walk (must exist).
+ *      max_depth: The deepest entries to visit (see: walk_dir()).  Use 0 for no limit.
+ *      num_threads: The number of workers, capped at SKID_WALK_MAX_THREADS.  Use 0 for the
+ *          number of online CPUs.
+ *      visitor: Called for each entry, concurrently, from every worker.  Use entry->worker to
+ *          index per-worker state so the visitor doesn't need locks.  SKID_WALK_STOP ends the
+ *          walk for every worker, though visits already in progress will finish.
+ *      context: [Optional] Passed, untouched, to visitor.
+ *
+ *  Returns:
+ *      ENOERR on success, including a walk ended early by SKID_WALK_STOP.  On failure, the
+ *      first errno value any worker encountered.
+ */
+int walk_dir_parallel(const char *dirname, size_t max_depth, unsigned int num_threads,
+                      DirVisitor visitor, void *context);
+
 #endif  /* __SKID_DIR_OPERATIONS__ */
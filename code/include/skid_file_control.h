@@ -1,7 +1,161 @@
 #ifndef __SKID_FILE_CONTROL__
 #define __SKID_FILE_CONTROL__
 
-#include <stdbool.h>    // bool, false, true
+#include <fcntl.h>          // F_RDLCK, F_WRLCK
+#include <stdbool.h>        // bool, false, true
+#include <stdint.h>         // uint64_t
+#include <sys/types.h>      // off_t
+#include "skid_macros.h"    // SKID_BAD_FD
+
+/*
+ *  NOTES ON RANGE LOCKS:
+ *      The *_range_lock() functions use open file description (OFD) locks (see: fcntl(2)).
+ *      Unlike the process-associated locks used by get_read_lock() and get_write_lock(), an
+ *      OFD lock belongs to the open file description, not the process, so:
+ *          - Threads that each open() the file can lock disjoint (or shared) ranges of it
+ *            concurrently and conflicting ranges block one another, as expected.
+ *          - File descriptors that share an open file description (e.g., from dup() or fork())
+ *            share its locks.
+ *          - Closing some other file descriptor for the same file doesn't release the locks.
+ *            They're released by release_range_lock() or once the last file descriptor for
+ *            the open file description is closed.
+ *      OFD locks and process-associated locks on the same file conflict with each other.
+ *
+ *  LOCK SESSIONS:
+ *      read_locked_fd() and write_locked_fd() take and release a lock per call, so a
+ *      read-modify-write takes the lock twice and races in between.  A lock session takes the
+ *      lock once, for any number of reads, writes, and seeks, and releases it when it goes out
+ *      of scope.  These macros use the gcc attribute "cleanup" (see: SKID_AUTO_FREE_CHAR).
+ *
+ *      int errnum = ENOERR;  // Out-parameter for the results of SKID API functions
+ *      SKID_AUTO_LOCK_SESSION skidLockSession session = SKID_LOCK_SESSION_INIT;
+ *      errnum = begin_lock_session(fd, F_WRLCK, 0, 0, &session);
+ *      if (ENOERR == errnum)
+ *      {
+ *          SKID_AUTO_FREE_CHAR char *record = read_lock_session(&session, &errnum);
+ *          // Modify record...
+ *          errnum = seek_lock_session(&session, 0, SEEK_SET, NULL);
+ *          errnum = write_lock_session(&session, record);
+ *      }
+ *      // The lock is released when session goes out of scope (or call end_lock_session())
+ */
+
+#if (defined(__GNUC__) || defined(__clang__))
+// Auto-end a skidLockSession variable when it goes out of scope.  skidLockSession-use only.
+#define SKID_AUTO_LOCK_SESSION __attribute__((cleanup(end_lock_session)))
+#else
+// Let the compiler inform the user that this macro is unresolved.
+//  Otherwise, defining this macro as "empty" (which is normally standard) will likely result in
+//  a lock that's never released and that BUG shouldn't pass quietly.
+#endif  /* SKID_AUTO_LOCK_SESSION */
+
+// Initialize every skidLockSession with this so it's always safe to end.
+#define SKID_LOCK_SESSION_INIT { .fd = SKID_BAD_FD, .lock_type = F_UNLCK, .start = 0, .len = 0 }
+
+// A range lock held on one file descriptor, from begin_lock_session() to end_lock_session().
+// The session doesn't own fd: it's never closed, only unlocked.
+typedef struct _skidLockSession
+{
+    int fd;           // The locked file descriptor, SKID_BAD_FD if no lock is held
+    short lock_type;  // F_RDLCK or F_WRLCK
+    off_t start;      // The offset of the first locked byte
+    off_t len;        // The number of locked bytes, 0 for everything from start on
+} skidLockSession, *skidLockSession_ptr;
+
+// Process-wide range lock counters, as reported by get_lock_stats().  Every *_range_lock() call
+// and lock session counts.
+typedef struct _skidLockStats
+{
+    uint64_t acquired;   // Range locks acquired
+    uint64_t contended;  // Lock attempts that found a conflicting lock held
+    uint64_t wait_ns;    // Nanoseconds spent waiting for conflicting locks to be released
+} skidLockStats, *skidLockStats_ptr;
+
+/*
+ *  Description:
+ *      Begin a lock session: lock a byte range of fd, with get_range_lock(), and remember it
+ *      for the *_lock_session() functions.
+ *
+ *  Args:
+ *      fd: File descriptor to lock.  It must stay open until the session ends.
+ *      lock_type: F_RDLCK for a shared lock or F_WRLCK for an exclusive lock.
+ *      start: The offset of the first byte to lock.
+ *      len: The number of bytes to lock.  Use 0 for everything from start on.
+ *      session: [Out] The session to begin.  On error, it's left safe to end.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int begin_lock_session(int fd, short lock_type, off_t start, off_t len,
+                       skidLockSession_ptr session);
+
+/*
+ *  Description:
+ *      End a lock session by releasing its range.  Ending a session that never began, or
+ *      already ended, does nothing.  SKID_AUTO_LOCK_SESSION calls this automatically.
+ *
+ *  Args:
+ *      session: [In/Out] The session to end.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  The session is ended either way.
+ */
+int end_lock_session(skidLockSession_ptr session);
+
+/*
+ *  Description:
+ *      Report the process-wide range lock counters.
+ *
+ *  Args:
+ *      stats: [Out] The counters.
+ *      reset: If true, zero the counters as they're read.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int get_lock_stats(skidLockStats_ptr stats, bool reset);
+
+/*
+ *  Description:
+ *      Use fcntl(F_OFD_SETLKW) to lock a byte range of the given file descriptor, waiting for
+ *      any conflicting lock to be released.  Signal interruptions are retried.  The kernel does
+ *      no deadlock detection for OFD locks: two callers each waiting on a range the other holds
+ *      will wait forever.  Callers that lock more than one range should use
+ *      get_range_lock_timed() (or always lock ranges in the same order).
+ *
+ *  Args:
+ *      fd: File descriptor to obtain a lock for.  Open it for reading to get an F_RDLCK and for
+ *          writing to get an F_WRLCK.
+ *      lock_type: F_RDLCK for a shared lock or F_WRLCK for an exclusive lock.
+ *      start: The offset of the first byte to lock.
+ *      len: The number of bytes to lock.  Use 0 for everything from start on, including any
+ *          bytes later appended to the file.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  EINVAL for a bad lock_type, start, or
+ *      len.
+ */
+int get_range_lock(int fd, short lock_type, off_t start, off_t len);
+
+/*
+ *  Description:
+ *      Like get_range_lock() but give up after timeout_ms milliseconds.  The lock is retried,
+ *      with fcntl(F_OFD_SETLK), on an exponential backoff that starts at 50 microseconds and is
+ *      capped at 10 milliseconds.
+ *
+ *  Args:
+ *      fd: File descriptor to obtain a lock for.
+ *      lock_type: F_RDLCK for a shared lock or F_WRLCK for an exclusive lock.
+ *      start: The offset of the first byte to lock.
+ *      len: The number of bytes to lock.  Use 0 for everything from start on.
+ *      timeout_ms: The longest to wait for a conflicting lock to be released.  0 tries once.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  ETIMEDOUT if the range was still
+ *      locked when timeout_ms ran out.  EINVAL for a bad lock_type, start, or len.
+ */
+int get_range_lock_timed(int fd, short lock_type, off_t start, off_t len,
+                         unsigned int timeout_ms);
 
 /*
  *  Description:
@@ -47,6 +201,24 @@ int get_write_lock(int fd);
  */
 bool is_close_on_exec(int fd, int *errnum);
 
+/*
+ *  Description:
+ *      Read a lock session's file descriptor, from its current offset, into a heap-allocated
+ *      buffer.  The read stops at the end of the locked range (or EOF, whichever comes first) so
+ *      only locked bytes are ever read.  A session locked to EOF (len 0) is read with read_fd().
+ *      It is the caller's responsibility to free the buffer with free_skid_mem().
+ *
+ *  Args:
+ *      session: The active session to read from.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      Pointer to the heap-allocated buffer, on success.  The buffer is an empty string if the
+ *      offset is already at (or past) the end of the locked range.  NULL on error (check errnum
+ *      for details).  EINVAL if session isn't active or the offset is before the locked range.
+ */
+char *read_lock_session(skidLockSession_ptr session, int *errnum);
+
 /*
  *  Description:
  *      Obtain a read lock on the file descriptor, read its contents into a
@@ -80,6 +252,69 @@ char *read_locked_fd(int fd, int *errnum);
  */
 int release_lock(int fd);
 
+/*
+ *  Description:
+ *      Use fcntl(F_OFD_SETLK) to release a byte range locked by get_range_lock(),
+ *      get_range_lock_timed(), or try_range_lock().  Releasing part of a locked range splits it.
+ *
+ *  Args:
+ *      fd: File descriptor to release the range on.
+ *      start: The offset of the first byte to release.
+ *      len: The number of bytes to release.  Use 0 for everything from start on.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int release_range_lock(int fd, off_t start, off_t len);
+
+/*
+ *  Description:
+ *      Reposition a lock session's file descriptor offset with lseek().
+ *
+ *  Args:
+ *      session: The active session to seek.
+ *      offset: The new offset, relative to whence.
+ *      whence: SEEK_SET, SEEK_CUR, or SEEK_END (see: lseek(2)).
+ *      new_offset: [Optional Out] The resulting offset from the start of the file.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  EINVAL if session isn't active.
+ */
+int seek_lock_session(skidLockSession_ptr session, off_t offset, int whence, off_t *new_offset);
+
+/*
+ *  Description:
+ *      Use fcntl(F_OFD_SETLK) to lock a byte range of the given file descriptor without waiting.
+ *
+ *  Args:
+ *      fd: File descriptor to obtain a lock for.
+ *      lock_type: F_RDLCK for a shared lock or F_WRLCK for an exclusive lock.
+ *      start: The offset of the first byte to lock.
+ *      len: The number of bytes to lock.  Use 0 for everything from start on.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  EAGAIN if a conflicting lock is held.
+ *      EINVAL for a bad lock_type, start, or len.
+ */
+int try_range_lock(int fd, short lock_type, off_t start, off_t len);
+
+/*
+ *  Description:
+ *      Write a string to a lock session's file descriptor, at its current offset, with
+ *      write_fd().  Nothing is written unless every byte of msg lands inside the locked range,
+ *      so a session never changes bytes it hasn't locked.
+ *
+ *  Args:
+ *      session: The active session to write to.  It must hold an F_WRLCK.
+ *      msg: The nul-terminated message to write.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  EINVAL if session isn't active or msg
+ *      would start before, or run past the end of, the locked range.  EPERM if session only
+ *      holds an F_RDLCK.
+ */
+int write_lock_session(skidLockSession_ptr session, const char *msg);
+
 /*
  *  Description:
  *      Obtain a write lock on the file descriptor, write the string, and release the write lock.
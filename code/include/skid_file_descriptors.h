@@ -4,7 +4,9 @@
 #include <stdbool.h>            // bool, false, true
 #include <stddef.h>             // size_t
 #include <sys/types.h>          // mode_t
+#include <sys/uio.h>            // struct iovec
 #include "skid_macros.h"        // SKID_BAD_FD
+#include "skid_memory.h"        // skidBuffer
 
 /*
  *  Description:
@@ -35,6 +37,31 @@ int close_fd(int *fdp, bool quiet);
  */
 int call_dup2(int oldfd, int newfd, int *errnum);
 
+/*
+ *  Description:
+ *      Copy everything from in_fd's current offset to EOF into out_fd, at out_fd's current offset,
+ *      letting the kernel move the data whenever possible instead of pulling it through userspace.
+ *      The mechanism is chosen by the types of the file descriptors:
+ *          Regular file to regular file: copy_file_range(), one data segment at a time.  If
+ *              out_fd is being extended, holes in in_fd (found with SEEK_DATA/SEEK_HOLE) are
+ *              skipped so sparse files stay sparse.
+ *          Regular file to anything else (e.g., a socket): sendfile().
+ *          Otherwise: splice(), directly if either fd is a pipe, else through an internal pipe.
+ *      If the kernel refuses the chosen mechanism (e.g., EXDEV, ENOSYS, EINVAL) before any data
+ *      has moved, a read()/write() loop is used instead.  On success, both file offsets are left
+ *      at the end of the copied data.
+ *
+ *  Args:
+ *      in_fd: File descriptor to copy from.
+ *      out_fd: File descriptor to copy to.  Must not be in_fd, or refer to the same file.
+ *      bytes_copied: [Optional/Out] The number of bytes copied (skipped holes are counted since
+ *          they are part of the copy).  On error, the number of bytes copied before the error.
+ *
+ *  Returns:
+ *      On success, ENOERR is returned.  On error, errno is returned.
+ */
+int copy_fd(int in_fd, int out_fd, size_t *bytes_copied);
+
 /*
  *  Description:
  *      Open a file descriptor using open().
@@ -54,7 +81,9 @@ int open_fd(const char *filename, int flags, mode_t mode, int *errnum);
 /*
  *  Description:
  *      Read the contents of the file descriptor into a heap-allocated buffer.  It is the caller's
- *      responsibility to free the buffer with free_skid_mem().
+ *      responsibility to free the buffer with free_skid_mem().  This is a thin wrapper around
+ *      read_fd_len() for callers that only deal in strings.  Use read_fd_len() if the contents
+ *      may contain embedded nul characters.
  *
  *  Args:
  *      fd: File descriptor to read from.
@@ -65,9 +94,85 @@ int open_fd(const char *filename, int flags, mode_t mode, int *errnum);
  */
 char *read_fd(int fd, int *errnum);
 
+/*
+ *  Description:
+ *      Read the contents of the file descriptor into a caller-owned, reusable skidBuffer.  Any
+ *      existing contents are replaced.  The buffer's existing capacity is reused and it only grows
+ *      when the data will not fit, so reusing one buffer across calls avoids an allocation per
+ *      read.  Like read_fd_len(), this function is binary-safe and the data is nul-terminated.
+ *
+ *  Args:
+ *      fd: File descriptor to read from.
+ *      buffer: [In/Out] The skidBuffer to read into.  On success, buffer->length holds the number
+ *          of bytes read.  On error, buffer->length is 0 but the buffer is not freed.  Release
+ *          the buffer with free_skid_buffer() when it is no longer needed.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int read_fd_buf(int fd, skidBuffer_ptr buffer);
+
+/*
+ *  Description:
+ *      Make one read() on behalf of a read-until-done loop (e.g., read_fd_len()), so every such
+ *      loop ends the same way.  EOF stops the loop.  So does EAGAIN (or EWOULDBLOCK) from an
+ *      O_NONBLOCK fd, which is only an error if the loop hasn't read anything yet.
+ *
+ *  Args:
+ *      fd: File descriptor to read from.
+ *      buf: The buffer to read into.
+ *      buf_size: The number of bytes available in buf.  Must be positive.
+ *      read_something: True if an earlier call in this loop read data.
+ *      num_read: [Out] The number of bytes read.  Set to 0 when the loop should stop.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int read_fd_chunk(int fd, char *buf, size_t buf_size, bool read_something, size_t *num_read);
+
+/*
+ *  Description:
+ *      Read the contents of the file descriptor into a heap-allocated buffer, tracking the number
+ *      of bytes read.  This function is binary-safe: embedded nul characters are preserved and
+ *      counted.  Data is read directly into the buffer, which grows geometrically, so the cost
+ *      of reading is linear in the number of bytes read.  The buffer is always nul-terminated
+ *      (the terminator is not counted in output_len) as a convenience for string data.
+ *      It is the caller's responsibility to free the buffer with free_skid_mem().
+ *
+ *  Args:
+ *      fd: File descriptor to read from.
+ *      output_len: [Out] The number of bytes read into the buffer.  Set to 0 on error.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      Pointer to the heap-allocated buffer, on success.  NULL on error (check errnum for details).
+ */
+char *read_fd_len(int fd, size_t *output_len, int *errnum);
+
+/*
+ *  Description:
+ *      Scatter read: read from the file descriptor into the caller's buffers, in order, using
+ *      readv().  Short reads are handled by advancing through iov and calling again until every
+ *      buffer is full, EOF is reached, or (for non-blocking fds) no more data is available.
+ *      Nothing is allocated and nothing is nul-terminated.  The iov array is not modified.
+ *
+ *  Args:
+ *      fd: File descriptor to read from.
+ *      iov: An array of iovcnt buffers to fill.  Zero-length entries are skipped.
+ *      iovcnt: The number of entries in iov.  Must be positive.  Counts greater than IOV_MAX
+ *          are read in IOV_MAX-sized batches.
+ *      bytes_read: [Out] The total number of bytes read into iov.  On error, this holds the
+ *          number of bytes successfully read before the error occurred.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  A short count with ENOERR indicates EOF (or no more
+ *      data was available on a non-blocking fd).
+ */
+int read_fd_v(int fd, const struct iovec *iov, int iovcnt, size_t *bytes_read);
+
 /*
  *    Description:
- *        Write a string to the file descriptor.
+ *        Write a string to the file descriptor.  Partial writes are finished by write_fd_v().
  *
  *    Args:
  *        fd: File descriptor to write to.
@@ -78,4 +183,25 @@ char *read_fd(int fd, int *errnum);
  */
 int write_fd(int fd, const char *msg);
 
+/*
+ *  Description:
+ *      Gather write: write the caller's buffers, in order, to the file descriptor using writev().
+ *      Use this to write framed data (e.g., header + payload + trailer) without first copying
+ *      it into one temporary buffer.  Partial writes are handled iteratively by advancing through
+ *      iov until every byte has been written or an error occurs.  The iov array is not modified.
+ *      Unlike write_fd(), the data is not treated as a string so it may contain nul characters.
+ *
+ *  Args:
+ *      fd: File descriptor to write to.
+ *      iov: An array of iovcnt buffers to write.  Zero-length entries are skipped.
+ *      iovcnt: The number of entries in iov.  Must be positive.  Counts greater than IOV_MAX
+ *          are written in IOV_MAX-sized batches.
+ *      bytes_written: [Optional/Out] The total number of bytes written from iov.  On error,
+ *          this holds the number of bytes successfully written before the error occurred.
+ *
+ *  Returns:
+ *      On success, ENOERR is returned.  On error, errno is returned.
+ */
+int write_fd_v(int fd, const struct iovec *iov, int iovcnt, size_t *bytes_written);
+
 #endif  /* __SKID_FILE_DESCRIPTORS__ */
@@ -5,8 +5,52 @@
 #include <stdbool.h>                        // bool, false, true
 #include <sys/types.h>
 #include <sys/stat.h>                       // mode_t, struct stat
+#include <time.h>                           // struct timespec, time_t
 #include <unistd.h>
 
+// Fields a skidFileMeta snapshot can hold.  OR together the ones you need for get_file_meta(),
+// which asks the filesystem for nothing else.  The values match statx(2)'s STATX_* flags.
+#define SKID_META_TYPE   0x0001U  // The file type bits of mode
+#define SKID_META_MODE   0x0002U  // The permission bits of mode
+#define SKID_META_NLINK  0x0004U  // nlink
+#define SKID_META_UID    0x0008U  // uid
+#define SKID_META_GID    0x0010U  // gid
+#define SKID_META_ATIME  0x0020U  // atime
+#define SKID_META_MTIME  0x0040U  // mtime
+#define SKID_META_CTIME  0x0080U  // ctime
+#define SKID_META_INO    0x0100U  // ino
+#define SKID_META_SIZE   0x0200U  // size
+#define SKID_META_BLOCKS 0x0400U  // blocks
+#define SKID_META_BASIC  0x07FFU  // Everything above: what stat() reports
+#define SKID_META_BTIME  0x0800U  // btime, which not every filesystem records
+#define SKID_META_ALL    0x0FFFU  // Everything
+
+#define SKID_META_MAX_THREADS 64  // The most workers get_file_meta_batch() will use
+
+// A snapshot of a file's metadata, taken by get_file_meta() or get_file_meta_fd() with a single
+// statx() call.  Only the fields flagged in mask are valid, so read them with the get_meta_*()
+// accessors, which check.  The blksize, dev, and rdev fields are always valid.  Where statx() is
+// unavailable (ENOSYS, or EPERM from a seccomp filter) the snapshot comes from fstatat() instead
+// and holds the SKID_META_BASIC fields, never SKID_META_BTIME.
+typedef struct _skidFileMeta
+{
+    unsigned int mask;      // SKID_META_* flags of the fields that hold valid values
+    mode_t mode;            // File type and permission bits
+    nlink_t nlink;          // Number of hard links
+    uid_t uid;              // Owner's user ID
+    gid_t gid;              // Group ID
+    ino_t ino;              // Inode number
+    off_t size;             // Size, in bytes
+    blkcnt_t blocks;        // Number of 512-byte blocks allocated
+    blksize_t blksize;      // The "preferred" block size for efficient file system I/O
+    dev_t dev;              // ID of the device containing the file
+    dev_t rdev;             // ID of the device, if the file is a character or block device
+    struct timespec atime;  // Last access time
+    struct timespec btime;  // Birth (creation) time
+    struct timespec ctime;  // Last status change time
+    struct timespec mtime;  // Last modification time
+} skidFileMeta, *skidFileMeta_ptr;
+
 
 /*
  *  Description:
@@ -210,6 +254,95 @@ dev_t get_container_device_id(const char *pathname, int *errnum);
  */
 dev_t get_file_device_id(const char *pathname, int *errnum);
 
+/*
+ *  Description:
+ *      Take a snapshot of pathname's metadata with a single statx() call, asking for only the
+ *      fields in mask.  Reading several fields from one snapshot costs one path lookup, instead
+ *      of one per getter, and every field describes the file at the same moment.  Read the
+ *      snapshot with the get_meta_*() accessors.
+ *
+ *  Args:
+ *      pathname: Absolute or relative pathname to take a snapshot of.
+ *      mask: The SKID_META_* fields to fetch (e.g., SKID_META_SIZE | SKID_META_MTIME).  The
+ *          filesystem may supply more, or fewer (e.g., SKID_META_BTIME), than requested.
+ *      follow_sym: If false, the snapshot describes a symbolic link rather than its target.
+ *      meta: [Out] The snapshot.  Its mask flags the fields actually fetched.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.
+ */
+int get_file_meta(const char *pathname, unsigned int mask, bool follow_sym,
+                  skidFileMeta_ptr meta);
+
+/*
+ *  Description:
+ *      Take a get_file_meta() snapshot of pathname, resolved relative to dir_fd, with a single
+ *      statx() call.  Tree walkers already hold each entry's parent directory open (see:
+ *      skidDirEntry), so passing that descriptor and the entry's name costs one path component
+ *      lookup instead of one per directory between the current working directory and the entry.
+ *
+ *  Args:
+ *      dir_fd: Directory file descriptor a relative pathname is resolved against, or AT_FDCWD
+ *          for the current working directory.  Absolute pathnames ignore it.
+ *      pathname: Absolute or relative pathname to take a snapshot of.
+ *      mask: The SKID_META_* fields to fetch (e.g., SKID_META_SIZE | SKID_META_MTIME).  The
+ *          filesystem may supply more, or fewer (e.g., SKID_META_BTIME), than requested.
+ *      follow_sym: If false, the snapshot describes a symbolic link rather than its target.
+ *      meta: [Out] The snapshot.  Its mask flags the fields actually fetched.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.  EBADF if dir_fd is neither open nor AT_FDCWD.
+ */
+int get_file_meta_at(int dir_fd, const char *pathname, unsigned int mask, bool follow_sym,
+                     skidFileMeta_ptr meta);
+
+/*
+ *  Description:
+ *      Take a get_file_meta() snapshot of every pathname in pathnames, spreading the statx()
+ *      calls across num_threads worker threads (the calling thread is one of them) so their
+ *      latency overlaps.  Each entry succeeds or fails on its own: errnums[i] reports the
+ *      results for pathnames[i] and, on success, metas[i] holds its snapshot.
+ *
+ *  Args:
+ *      dir_fd: Directory file descriptor relative pathnames are resolved against, or AT_FDCWD
+ *          for the current working directory.  Absolute pathnames ignore it.
+ *      pathnames: Array of num_paths pathnames to take snapshots of.
+ *      num_paths: The number of entries in pathnames, metas, and errnums.
+ *      mask: The SKID_META_* fields to fetch for every entry.
+ *      follow_sym: If false, the snapshots describe symbolic links rather than their targets.
+ *      num_threads: The number of workers, counting the calling thread.  0 for one per online
+ *          CPU.  Capped at SKID_META_MAX_THREADS.  statx() mostly waits on the filesystem, so
+ *          more workers than CPUs can pay off for cold caches and network filesystems.
+ *      metas: [Out] Array of num_paths snapshots.  metas[i] is only valid if errnums[i] is
+ *          ENOERR.
+ *      errnums: [Out] Array of num_paths errno values.  ENOERR for each successful entry.
+ *
+ *  Returns:
+ *      ENOERR if every entry was attempted, even if some of them failed (check errnums).  On
+ *      failure, an errno value and no entry was attempted.
+ */
+int get_file_meta_batch(int dir_fd, const char *const *pathnames, size_t num_paths,
+                        unsigned int mask, bool follow_sym, unsigned int num_threads,
+                        skidFileMeta_ptr metas, int *errnums);
+
+/*
+ *  Description:
+ *      Take a snapshot of the metadata of the file fd refers to with a single statx() call
+ *      (using AT_EMPTY_PATH), asking for only the fields in mask.  A caller that already has
+ *      the file open pays no path lookup at all, and the snapshot is guaranteed to describe the
+ *      file it will read from or write to.  Read the snapshot with the get_meta_*() accessors.
+ *
+ *  Args:
+ *      fd: An open file descriptor.  O_PATH file descriptors are fine.
+ *      mask: The SKID_META_* fields to fetch (e.g., SKID_META_SIZE | SKID_META_UID).  The
+ *          filesystem may supply more, or fewer (e.g., SKID_META_BTIME), than requested.
+ *      meta: [Out] The snapshot.  Its mask flags the fields actually fetched.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.
+ */
+int get_file_meta_fd(int fd, unsigned int mask, skidFileMeta_ptr meta);
+
 /*
  *  Description:
  *      Use library macros to extract just the permission values from the stat struct
@@ -280,6 +413,225 @@ gid_t get_group(const char *pathname, int *errnum, bool follow_sym);
  */
 nlink_t get_hard_link_num(const char *pathname, int *errnum);
 
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_access_timestamp().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_ATIME.
+ *      seconds: [Out] Pointer to store the epoch seconds time in.
+ *      nseconds: [Out] Pointer to store the nanoseconds in.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.  ENODATA if meta doesn't hold the field.
+ */
+int get_meta_access_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds);
+
+/*
+ *  Description:
+ *      Fetch the birth (creation) time seconds and nanoseconds from a snapshot.  There is no
+ *      pathname getter for this field since only statx() reports it.
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_BTIME.
+ *      seconds: [Out] Pointer to store the epoch seconds time in.
+ *      nseconds: [Out] Pointer to store the nanoseconds in.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.  ENODATA if meta doesn't hold the field,
+ *      which is normal for filesystems that don't record it.
+ */
+int get_meta_birth_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_block_count().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_BLOCKS.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      The number of 512-byte blocks allocated, on success.  0 on error, and errnum is set.
+ */
+blkcnt_t get_meta_block_count(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_block_size().  Every snapshot holds this field.
+ *
+ *  Args:
+ *      meta: A snapshot.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *
+ *  Returns:
+ *      The "preferred" block size, on success.  0 on error, and errnum is set.
+ */
+blksize_t get_meta_block_size(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_change_timestamp().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_CTIME.
+ *      seconds: [Out] Pointer to store the epoch seconds time in.
+ *      nseconds: [Out] Pointer to store the nanoseconds in.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.  ENODATA if meta doesn't hold the field.
+ */
+int get_meta_change_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_container_device_id().  Every snapshot holds this
+ *      field.
+ *
+ *  Args:
+ *      meta: A snapshot.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *
+ *  Returns:
+ *      The device ID of a character or block special file, on success.  Error conditions are
+ *      indicated by non-zero values in errnum.
+ */
+dev_t get_meta_container_device_id(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_file_device_id().  Every snapshot holds this
+ *      field.
+ *
+ *  Args:
+ *      meta: A snapshot.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *
+ *  Returns:
+ *      The ID of the device containing the file, on success.  Error conditions are indicated by
+ *      non-zero values in errnum.
+ */
+dev_t get_meta_file_device_id(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_file_perms().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_MODE.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      Just the file permission bits, on success.  0 on error, and errnum is set.
+ */
+mode_t get_meta_file_perms(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_file_type().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_TYPE.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      On success, a value comparable to any of the file type mask values:
+ *      S_IFBLK, S_IFCHR, S_IFDIR, S_IFIFO, S_IFREG, S_IFSOCK, S_IFLNK.  0 on error, and errnum
+ *      is set.
+ */
+mode_t get_meta_file_type(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_group().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_GID.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      The group ID on success.  Error conditions are indicated by non-zero values in errnum.
+ */
+gid_t get_meta_group(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_hard_link_num().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_NLINK.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      Number of hard links on success.  Error conditions are indicated by non-zero values in
+ *      errnum.
+ */
+nlink_t get_meta_hard_link_num(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_mod_timestamp().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_MTIME.
+ *      seconds: [Out] Pointer to store the epoch seconds time in.
+ *      nseconds: [Out] Pointer to store the nanoseconds in.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure.  ENODATA if meta doesn't hold the field.
+ */
+int get_meta_mod_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_owner().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_UID.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      The owner's UID on success.  Error conditions are indicated by non-zero values in
+ *      errnum.
+ */
+uid_t get_meta_owner(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_serial_num().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_INO.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      The inode number on success.  Error conditions are indicated by non-zero values in
+ *      errnum.
+ */
+ino_t get_meta_serial_num(const skidFileMeta *meta, int *errnum);
+
+/*
+ *  Description:
+ *      The get_file_meta() counterpart to get_size().
+ *
+ *  Args:
+ *      meta: A snapshot taken with SKID_META_SIZE.
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *          ENODATA if meta doesn't hold the field.
+ *
+ *  Returns:
+ *      The size, in bytes, on success.  Error conditions are indicated by non-zero values in
+ *      errnum.
+ */
+off_t get_meta_size(const skidFileMeta *meta, int *errnum);
+
 /*
  *  Description:
  *      Fetches the modification time (mtime) for pathname by reading the st_mtime member from the
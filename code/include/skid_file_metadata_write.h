@@ -26,6 +26,22 @@
  */
 int add_mode(const char *pathname, mode_t more_mode);
 
+/*
+ *  Description:
+ *      Adds to the permission bits of the file fd refers to by fetching the current mode with
+ *      get_file_meta_fd(), ORing more_mode, and then calling set_mode_fd() with the new mode.
+ *
+ *      See set_mode() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      more_mode: The additional permission flags to add to fd's mode.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int add_mode_fd(int fd, mode_t more_mode);
+
 /*
  *  Description:
  *      Removes the less_mode permission bits from pathname by fetching the current mode,
@@ -45,6 +61,23 @@ int add_mode(const char *pathname, mode_t more_mode);
  */
 int remove_mode(const char *pathname, mode_t less_mode);
 
+/*
+ *  Description:
+ *      Removes the less_mode permission bits from the file fd refers to by fetching the current
+ *      mode with get_file_meta_fd(), removing less_mode bits, and then calling set_mode_fd() with
+ *      the new mode.
+ *
+ *      See set_mode() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      less_mode: The permission flags to remove from fd's mode.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int remove_mode_fd(int fd, mode_t less_mode);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's access time to the provided values using
@@ -63,6 +96,21 @@ int remove_mode(const char *pathname, mode_t less_mode);
  */
 int set_atime(const char *pathname, bool follow_sym, time_t seconds, long nseconds);
 
+/*
+ *  Description:
+ *      Changes the access time of the file fd refers to to the provided values using
+ *      futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      seconds: The epoch seconds to set the atime to.
+ *      nseconds: The nanoseconds to set the atime to.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_atime_fd(int fd, time_t seconds, long nseconds);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's access time to the current local time using
@@ -79,6 +127,19 @@ int set_atime(const char *pathname, bool follow_sym, time_t seconds, long nsecon
  */
 int set_atime_now(const char *pathname, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the access time of the file fd refers to to the current local time using
+ *      futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_atime_now_fd(int fd);
+
 /*
  *  Description:
  *      Changes pathname's owner by calling chown(), or lchown() if follow_sym is false.
@@ -105,6 +166,21 @@ int set_atime_now(const char *pathname, bool follow_sym);
  */
 int set_group_id(const char *pathname, gid_t new_group, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the group of the file fd refers to by calling fchown().
+ *
+ *      See set_group_id() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      new_group: The GID of the new group for fd.  If this value is -1, it will not change.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_group_id_fd(int fd, gid_t new_group);
+
 /*
  *  Description:
  *      Changes pathname's permission bits to new_mode by calling chmod().  Symbolic links are
@@ -129,6 +205,21 @@ int set_group_id(const char *pathname, gid_t new_group, bool follow_sym);
  */
 int set_mode(const char *pathname, mode_t new_mode);
 
+/*
+ *  Description:
+ *      Changes the permission bits of the file fd refers to to new_mode by calling fchmod().
+ *
+ *      See set_mode() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      new_mode: The new mode for fd.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_mode_fd(int fd, mode_t new_mode);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's modification time to the provided values using
@@ -147,6 +238,21 @@ int set_mode(const char *pathname, mode_t new_mode);
  */
 int set_mtime(const char *pathname, bool follow_sym, time_t seconds, long nseconds);
 
+/*
+ *  Description:
+ *      Changes the modification time of the file fd refers to to the provided values using
+ *      futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      seconds: The epoch seconds to set the mtime to.
+ *      nseconds: The nanoseconds to set the mtime to.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_mtime_fd(int fd, time_t seconds, long nseconds);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's modification time to the current local time using
@@ -163,6 +269,19 @@ int set_mtime(const char *pathname, bool follow_sym, time_t seconds, long nsecon
  */
 int set_mtime_now(const char *pathname, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the modification time of the file fd refers to to the current local time using
+ *      futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_mtime_now_fd(int fd);
+
 /*
  *  Description:
  *      Changes pathname's owner by calling chown(), or lchown() if follow_sym is false.
@@ -186,6 +305,21 @@ int set_mtime_now(const char *pathname, bool follow_sym);
  */
 int set_owner_id(const char *pathname, uid_t new_owner, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the owner of the file fd refers to by calling fchown().
+ *
+ *      See set_owner_id() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      new_owner: The UID of the new owner for fd.  If this value is -1, it will not change.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_owner_id_fd(int fd, uid_t new_owner);
+
 /*
  *  Description:
  *      Changes pathname's owner and group by calling chown(), or lchown() if follow_sym is false.
@@ -213,6 +347,22 @@ int set_owner_id(const char *pathname, uid_t new_owner, bool follow_sym);
  */
 int set_ownership(const char *pathname, uid_t new_owner, gid_t new_group, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the owner and group of the file fd refers to by calling fchown().
+ *
+ *      See set_ownership() for important notes.
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      new_owner: The UID of the new owner for fd.  If this value is -1, it will not change.
+ *      new_group: The GID of the new group for fd.  If this value is -1, it will not change.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_ownership_fd(int fd, uid_t new_owner, gid_t new_group);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's access and modification times to both match
@@ -231,6 +381,21 @@ int set_ownership(const char *pathname, uid_t new_owner, gid_t new_group, bool f
  */
 int set_times(const char *pathname, bool follow_sym, time_t seconds, long nseconds);
 
+/*
+ *  Description:
+ *      Changes the access and modification times of the file fd refers to to both match the
+ *      provided values using futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *      seconds: The epoch seconds to set the times to.
+ *      nseconds: The nanoseconds to set the times to.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_times_fd(int fd, time_t seconds, long nseconds);
+
 /*
  *  Description:
  *      Changes the file metadata of pathname's access and modification times to the current local
@@ -247,4 +412,17 @@ int set_times(const char *pathname, bool follow_sym, time_t seconds, long nsecon
  */
 int set_times_now(const char *pathname, bool follow_sym);
 
+/*
+ *  Description:
+ *      Changes the access and modification times of the file fd refers to to the current local
+ *      time using futimens().
+ *
+ *  Args:
+ *      fd: An open file descriptor for the file to modify.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int set_times_now_fd(int fd);
+
 #endif  /* __SKID_FILE_METADATA_WRITE__ */
@@ -2,6 +2,67 @@
 #define __SKID_FILE_OPERATIONS__
 
 #include <stdbool.h>                        // bool, false, true
+#include <stddef.h>                         // size_t
+#include <sys/types.h>                      // dev_t, ino_t, off_t
+#include <sys/uio.h>                        // struct iovec
+#include <time.h>                           // struct timespec
+#include "skid_memory.h"                    // skidBuffer, skidMemMapRegion
+
+#define SKID_VIEW_SEQUENTIAL 0x1  // map_file_view() hint: madvise(MADV_SEQUENTIAL)
+#define SKID_VIEW_WILLNEED 0x2    // map_file_view() hint: madvise(MADV_WILLNEED)
+#define SKID_STREAM_CHUNK_SIZE (size_t)(1024 * 1024)  // Default stream_file() chunk size
+#define SKID_APPENDER_SIZE (size_t)(64 * 1024)        // Default open_appender() flush size
+
+// This struct holds the state of a long-lived, buffered file appender.  Initialize it with
+// open_appender() and release it with close_appender().  Treat the members as read-only.
+// An appender is not thread-safe.
+typedef struct _skidAppender
+{
+    int fd;                      // File descriptor opened with O_APPEND
+    skidBuffer buffer;           // Entries that have not been written yet
+    size_t flush_size;           // Write the buffer once it holds this many bytes
+    unsigned int flush_ms;       // Write the buffer once its oldest entry is this old (0 = never)
+    unsigned int sync_ms;        // fdatasync() written data at most this often (0 = never)
+    struct timespec first_pending;  // CLOCK_MONOTONIC time the oldest buffered entry arrived
+    struct timespec last_sync;      // CLOCK_MONOTONIC time of the last fdatasync()
+    bool unsynced;               // True if data has been written since the last fdatasync()
+} skidAppender, *skidAppender_ptr;
+
+// One directory with renames that have not been made durable yet.
+typedef struct _skidSyncDir
+{
+    int fd;     // Open directory file descriptor
+    dev_t dev;  // Device ID, used to avoid holding the same directory twice
+    ino_t ino;  // Inode number, used to avoid holding the same directory twice
+} skidSyncDir, *skidSyncDir_ptr;
+
+// This struct collects the directories touched by create_file_atomic() so many files can share
+// one fsync() per directory (see: commit_sync_batch()).  Zero-initialize the struct (e.g.,
+// skidSyncBatch batch = { 0 };) before first use.  A batch is not thread-safe.
+typedef struct _skidSyncBatch
+{
+    skidSyncDir_ptr dirs;  // Heap-allocated array of distinct directories
+    size_t num_dirs;       // Number of directories in dirs
+    size_t capacity;       // Number of elements allocated in dirs
+} skidSyncBatch, *skidSyncBatch_ptr;
+
+/*
+ *    Description:
+ *        Function pointer to be used with stream_file().  Called once per chunk, in file order.
+ *        The chunk buffer is reused for the next chunk so copy anything that must outlive the
+ *        call.
+ *
+ *    Args:
+ *        chunk: The chunk's data.  Not nul-terminated.
+ *        chunk_len: The number of bytes in chunk.  Only the final chunk may be short.
+ *        offset: The file offset of chunk[0].
+ *        context: The context pointer passed to stream_file().
+ *
+ *    Returns:
+ *        ENOERR to continue streaming.  Any other value stops the stream and is returned by
+ *        stream_file().
+ */
+typedef int (*ChunkHandler)(const char *chunk, size_t chunk_len, off_t offset, void *context);
 
 /*
  *  Description:
@@ -21,7 +82,59 @@ int append_to_file(const char *filename, const char *entry, bool create);
 
 /*
  *  Description:
- *      Created a filename with provided contents.
+ *      Write any buffered entries, fdatasync() the file if sync_ms was set and data was written
+ *      since the last sync, close the file descriptor, and free the buffer.  The appender is
+ *      zeroized (and its fd set to SKID_BAD_FD) even if an error occurs.
+ *
+ *  Args:
+ *      appender: [In/Out] An appender initialized by open_appender().
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  The first error encountered is
+ *      returned.
+ */
+int close_appender(skidAppender_ptr appender);
+
+/*
+ *  Description:
+ *      Make every rename recorded in batch durable with one fsync() per distinct directory, then
+ *      close the directories and free the batch's storage.  Every directory is synced, and
+ *      closed, even if an earlier one fails.  The batch may be reused afterwards.
+ *
+ *  Args:
+ *      batch: [In/Out] A batch filled by create_file_atomic().  Zeroized on return.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  The first error encountered is
+ *      returned.
+ */
+int commit_sync_batch(skidSyncBatch_ptr batch);
+
+/*
+ *  Description:
+ *      Copy source to destination without pulling the data through userspace, whenever the
+ *      kernel allows it (see: copy_fd()).  Holes in a sparse source are preserved.  Use this
+ *      instead of read_file() + create_file(), which copy every byte twice and stop at the
+ *      first nul character.  The destination is created with source's permission bits (subject
+ *      to the umask).
+ *
+ *  Args:
+ *      source: Absolute or relative filename to copy from.
+ *      destination: Absolute or relative filename to copy to.
+ *      overwrite: If true, will truncate and overwrite a pre-existing destination.  If overwrite
+ *          is false and destination exists, will return EEXIST.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  EINVAL is used to indicate source and
+ *      destination are the same file (e.g., the same name or a hard link), which is left intact.
+ */
+int copy_file(const char *source, const char *destination, bool overwrite);
+
+/*
+ *  Description:
+ *      Created a filename with provided contents.  The file is truncated and written in place so
+ *      a concurrent reader (or a crash) can observe it half-written.  Use create_file_atomic()
+ *      when that matters.
  *
  *  Args:
  *      filename: Absolute or relative filename to create.
@@ -35,6 +148,35 @@ int append_to_file(const char *filename, const char *entry, bool create);
  */
 int create_file(const char *filename, const char *contents, bool overwrite);
 
+/*
+ *  Description:
+ *      Create, or replace, filename so readers see either the old contents or the new contents,
+ *      never a partial write, even across a crash.  The contents are written to an unnamed
+ *      O_TMPFILE (or, if the filesystem lacks support, a hidden temporary file) in filename's
+ *      directory and flushed with fdatasync() before being linked or renamed into place.  The
+ *      directory is then fsync()ed, immediately or, if batch is provided, by
+ *      commit_sync_batch().  A replaced file keeps its permission bits.  New files are created
+ *      as create_file() would create them.  Symbolic links are not followed: if filename is a
+ *      symbolic link (and overwrite is true), the link itself is replaced by a regular file and
+ *      its target is left untouched, just as rename() would.
+ *
+ *  Args:
+ *      filename: Absolute or relative filename to create.
+ *      contents: [Optional] The contents of filename.  May be NULL if contents_len is 0.  Need
+ *          not be nul-terminated.
+ *      contents_len: The number of bytes of contents to write.
+ *      overwrite: If true, atomically replaces a pre-existing filename.  If overwrite is false
+ *          and filename exists, will return EEXIST.
+ *      batch: [Optional] Defer the directory fsync() to commit_sync_batch() so many files in
+ *          the same directory share one sync.  The new contents are visible immediately but
+ *          the rename is only guaranteed to survive a crash once the batch is committed.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  On failure, filename is untouched.
+ */
+int create_file_atomic(const char *filename, const char *contents, size_t contents_len,
+                       bool overwrite, skidSyncBatch_ptr batch);
+
 /*
  *  Description:
  *      Deletes filename by calling unlink().
@@ -69,10 +211,77 @@ int delete_file(const char *filename);
  */
 int empty_file(const char *filename);
 
+/*
+ *  Description:
+ *      Write any buffered entries to the appender's file now, regardless of the thresholds.
+ *
+ *  Args:
+ *      appender: [In/Out] An appender initialized by open_appender().
+ *      sync: If true, fdatasync() the file afterwards if anything has been written since the
+ *          last sync.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  Buffered entries are kept if the write
+ *      fails.
+ */
+int flush_appender(skidAppender_ptr appender, bool sync);
+
+/*
+ *  Description:
+ *      Map a read-only view of filename's contents without copying them.  Pages are read in by
+ *      the kernel as they're touched and may be reclaimed under memory pressure, so large
+ *      read-mostly files don't cost a heap allocation (or RSS) of their full size.  The view is
+ *      *not* nul-terminated; always bound accesses with view->length.  Release the view with
+ *      unmap_file_view().  Changes made to filename while it's mapped may be visible in the view.
+ *
+ *  Args:
+ *      filename: Absolute or relative filename of a regular file to map.
+ *      view: [Out] skidMemMapRegion pointer to store the view in.  view->addr must be NULL.  An
+ *          empty file results in a NULL view->addr and a view->length of 0.
+ *      hints: Zero or more SKID_VIEW_* flags, bit-wise ORed together, describing how the view
+ *          will be accessed.  Hints are advisory; failing to apply one is not an error.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  Uses EISDIR/EINVAL if filename exists
+ *      but is not a regular file.
+ */
+int map_file_view(const char *filename, skidMemMapRegion_ptr view, int hints);
+
+/*
+ *  Description:
+ *      Open filename once, with O_APPEND, for repeated appends.  Unlike append_to_file(), which
+ *      opens and closes filename for every entry, entries are gathered in a buffer and written
+ *      with a single system call once flush_size bytes are pending or the oldest pending entry
+ *      is flush_ms old.  If sync_ms is set, written data is made durable with fdatasync() at
+ *      most once every sync_ms milliseconds, so many entries share the cost of one sync (group
+ *      commit).  Thresholds are only checked when write_appender() or flush_appender() is
+ *      called.  Entries that must reach the file immediately should call flush_appender().
+ *
+ *  Args:
+ *      appender: [Out] The appender to initialize.  Its previous contents are overwritten so
+ *          close any appender it held first.
+ *      filename: Absolute or relative filename to append to.
+ *      flush_size: The number of buffered bytes that triggers a write.  Use 0 for
+ *          SKID_APPENDER_SIZE.  Use 1 to write every entry immediately.
+ *      flush_ms: The age, in milliseconds, of the oldest buffered entry that triggers a write.
+ *          Use 0 to rely on flush_size alone.
+ *      sync_ms: The minimum number of milliseconds between calls to fdatasync().  Use 0 to
+ *          never sync, except on request.
+ *      create: If true, will create filename if it doesn't already exist.  If create is false
+ *          and filename does not exist, returns ENOENT.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  Uses EISDIR if filename exists but
+ *      is not a file.
+ */
+int open_appender(skidAppender_ptr appender, const char *filename, size_t flush_size,
+                  unsigned int flush_ms, unsigned int sync_ms, bool create);
+
 /*
  *  Description:
  *      Read the contents of filename into a heap-allocated buffer.  It is the caller's
- *      responsibility to free the buffer with free_skid_mem().
+ *      responsibility to free the buffer with free_skid_mem().  Large files that are only
+ *      scanned should use map_file_view() instead, which avoids the allocation and the copy.
  *
  *  Args:
  *      filename: Absolute or relative filename to read.
@@ -83,4 +292,73 @@ int empty_file(const char *filename);
  */
 char *read_file(const char *filename, int *errnum);
 
+/*
+ *  Description:
+ *      Stream filename through handler, one fixed-size chunk at a time, so files of any size can
+ *      be processed in a single pass with constant memory.  One page-aligned buffer is reused for
+ *      the whole pass.  The kernel is told the access is sequential (POSIX_FADV_SEQUENTIAL) and
+ *      the next chunk is prefetched with readahead() while handler works on the current one.
+ *
+ *  Args:
+ *      filename: Absolute or relative filename to stream.
+ *      chunk_size: The size of each chunk, rounded up to a multiple of the page size.  Use 0
+ *          for SKID_STREAM_CHUNK_SIZE.
+ *      handler: The function to call for each chunk.
+ *      context: [Optional] Passed, untouched, to handler.
+ *      drop_pages: If true, each chunk's pages are dropped from the page cache
+ *          (POSIX_FADV_DONTNEED) once handler returns so a large scan doesn't evict other,
+ *          hotter data.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.  If handler stops the stream, its return
+ *      value is returned.
+ */
+int stream_file(const char *filename, size_t chunk_size, ChunkHandler handler, void *context,
+                bool drop_pages);
+
+/*
+ *  Description:
+ *      Release a view created by map_file_view().
+ *
+ *  Args:
+ *      view: [In/Out] The view to unmap.  On success, view->addr and view->length are zeroized.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int unmap_file_view(skidMemMapRegion_ptr view);
+
+/*
+ *  Description:
+ *      Append entry to the appender's buffer.  The buffer is written to the file (and the file
+ *      synced) if a threshold has been reached.  If entry doesn't fit in the remainder of the
+ *      buffer, the buffer is written first.  An entry of flush_size bytes or more is then written
+ *      directly, without being copied.
+ *
+ *  Args:
+ *      appender: [In/Out] An appender initialized by open_appender().
+ *      entry: The data to append.  Need not be nul-terminated.
+ *      entry_len: The number of bytes of entry to append.  May be 0.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int write_appender(skidAppender_ptr appender, const char *entry, size_t entry_len);
+
+/*
+ *  Description:
+ *      Append the iovcnt buffers described by iov to the appender's buffer, as one entry (see:
+ *      write_appender()).  Useful for framing an entry (e.g., prefix, message, suffix) without
+ *      first copying its pieces into a contiguous buffer.
+ *
+ *  Args:
+ *      appender: [In/Out] An appender initialized by open_appender().
+ *      iov: Array of iovec structs describing the entry's pieces.
+ *      iovcnt: The number of elements in iov.  Must be positive.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+int write_appender_v(skidAppender_ptr appender, const struct iovec *iov, int iovcnt);
+
 #endif  /* __SKID_FILE_OPERATIONS__ */
@@ -0,0 +1,222 @@
+/*
+ *  This library defines functionality to submit file descriptor I/O in batches.  When the kernel
+ *  supports it, operations are handed to io_uring so many reads, writes, opens, closes, and
+ *  statx() calls cost a single system call to submit and a single system call to reap.  When
+ *  io_uring is unavailable (e.g., old kernel, disabled by sysctl, blocked by seccomp) the same
+ *  API falls back to the synchronous calls skid_file_descriptors uses, executed at submit time.
+ *
+ *  USAGE:
+ *      int errnum = ENOERR;  // Out-parameter for the results of SKID API functions
+ *      skidIoResult results[64];  // Completions
+ *      skidIoBatch_ptr batch = create_io_batch(64, false, &errnum);
+ *      // Queue up to 64 operations, e.g., one read per already-opened file
+ *      queue_io_read(batch, fd, buf, buf_size, 0, (uint64_t)fd);
+ *      submit_io_batch(batch, &errnum);
+ *      // Wait for all of them
+ *      num_done = reap_io_batch(batch, results, 64, 64, &errnum);
+ *      destroy_io_batch(&batch);
+ *
+ *  NOTES:
+ *      Every buffer, pathname, and statx struct handed to a queue_io_*() function must remain
+ *      valid until its completion has been reaped.  A batch is not thread-safe.
+ */
+
+#ifndef __SKID_IO_BATCH__
+#define __SKID_IO_BATCH__
+
+#include <stdbool.h>                        // bool
+#include <stddef.h>                         // size_t
+#include <stdint.h>                         // uint64_t
+#include <sys/types.h>                      // mode_t, off_t, ssize_t
+#include "skid_macros.h"                    // ENOERR
+
+#define SKID_IO_CUR_POS ((off_t)-1)  // Read/write offset that means "use the current file offset"
+
+struct statx;  // See: statx(2)
+
+// Opaque handle to a batch of queued, submitted, and completed I/O operations.
+typedef struct _skidIoBatch skidIoBatch, *skidIoBatch_ptr;
+
+// This struct communicates the completion of one queued operation.
+typedef struct _skidIoResult
+{
+    uint64_t user_data;  // The user_data the operation was queued with
+    ssize_t result;      // Bytes read/written, the new fd (open), 0 (close/statx), or -1 on error
+    int errnum;          // ENOERR on success, errno value on error
+} skidIoResult, *skidIoResult_ptr;
+
+/*
+ *  Description:
+ *      Create a batch capable of holding depth operations (queued, submitted, or completed but
+ *      not yet reaped).  io_uring is used if the kernel supports every operation this library
+ *      queues.  Otherwise, the batch silently uses the synchronous fallback.
+ *
+ *  Args:
+ *      depth: The maximum number of operations outstanding at once.  Must be positive.
+ *      force_sync: If true, the synchronous fallback is used even if io_uring is available.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A new batch, on success.  Destroy it with destroy_io_batch().  NULL on error (check errnum
+ *      for details).
+ */
+skidIoBatch_ptr create_io_batch(unsigned int depth, bool force_sync, int *errnum);
+
+/*
+ *  Description:
+ *      Destroy a batch created by create_io_batch().  If io_uring is in use, any operations still
+ *      in flight are waited on first so the kernel no longer references the caller's buffers.
+ *      Unreaped completions are discarded.
+ *
+ *  Args:
+ *      batch: [In/Out] A pointer to the batch to destroy.  Set to NULL on success.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int destroy_io_batch(skidIoBatch_ptr *batch);
+
+/*
+ *  Description:
+ *      Report whether a batch is backed by io_uring or by the synchronous fallback.
+ *
+ *  Args:
+ *      batch: The batch to inspect.
+ *
+ *  Returns:
+ *      True if the batch submits operations with io_uring.  False if the batch uses the
+ *      synchronous fallback or batch is NULL.
+ */
+bool is_io_uring_batch(skidIoBatch_ptr batch);
+
+/*
+ *  Description:
+ *      Queue a close() of fd.  Nothing happens until submit_io_batch() is called.
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      fd: The file descriptor to close.
+ *      user_data: Returned, untouched, in this operation's skidIoResult.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the batch is full and some
+ *      completions must be reaped first.
+ */
+int queue_io_close(skidIoBatch_ptr batch, int fd, uint64_t user_data);
+
+/*
+ *  Description:
+ *      Queue an openat().  On completion, the skidIoResult.result holds the new file descriptor.
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      dirfd: Directory file descriptor pathname is relative to, or AT_FDCWD.
+ *      pathname: The file to open.  Must remain valid until the operation is reaped.
+ *      flags: The flags to pass to openat() (see: open(2)).
+ *      mode: The mode to pass to openat() (see: open(2)).
+ *      user_data: Returned, untouched, in this operation's skidIoResult.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the batch is full.
+ */
+int queue_io_open(skidIoBatch_ptr batch, int dirfd, const char *pathname, int flags, mode_t mode,
+                  uint64_t user_data);
+
+/*
+ *  Description:
+ *      Queue a read of up to count bytes from fd into buf.  On completion, the
+ *      skidIoResult.result holds the number of bytes read.  Short reads are not retried.
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      fd: The file descriptor to read from.
+ *      buf: The buffer to read into.  Must remain valid until the operation is reaped.
+ *      count: The size of buf.  May not exceed UINT32_MAX.
+ *      offset: The file offset to read from or SKID_IO_CUR_POS to use (and advance) the current
+ *          file offset.
+ *      user_data: Returned, untouched, in this operation's skidIoResult.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the batch is full.
+ */
+int queue_io_read(skidIoBatch_ptr batch, int fd, void *buf, size_t count, off_t offset,
+                  uint64_t user_data);
+
+/*
+ *  Description:
+ *      Queue a statx().
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      dirfd: Directory file descriptor pathname is relative to, or AT_FDCWD.
+ *      pathname: The file to stat.  Must remain valid until the operation is reaped.
+ *      flags: The flags to pass to statx() (e.g., AT_SYMLINK_NOFOLLOW).
+ *      mask: The STATX_* fields to request.
+ *      statxbuf: [Out] Where the file's metadata is stored.  Must remain valid until the
+ *          operation is reaped.
+ *      user_data: Returned, untouched, in this operation's skidIoResult.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the batch is full.
+ */
+int queue_io_statx(skidIoBatch_ptr batch, int dirfd, const char *pathname, int flags,
+                   unsigned int mask, struct statx *statxbuf, uint64_t user_data);
+
+/*
+ *  Description:
+ *      Queue a write of count bytes from buf to fd.  On completion, the skidIoResult.result holds
+ *      the number of bytes written.  Short writes are not retried.
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      fd: The file descriptor to write to.
+ *      buf: The data to write.  Must remain valid until the operation is reaped.
+ *      count: The number of bytes to write.  May not exceed UINT32_MAX.
+ *      offset: The file offset to write to or SKID_IO_CUR_POS to use (and advance) the current
+ *          file offset.
+ *      user_data: Returned, untouched, in this operation's skidIoResult.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN indicates the batch is full.
+ */
+int queue_io_write(skidIoBatch_ptr batch, int fd, const void *buf, size_t count, off_t offset,
+                   uint64_t user_data);
+
+/*
+ *  Description:
+ *      Collect completed operations.  Completions are not necessarily reported in the order the
+ *      operations were queued; use user_data to match them up.
+ *
+ *  Args:
+ *      batch: The batch to reap.
+ *      results: [Out] Array to store completions in.
+ *      max_results: The number of entries in results.  Must be positive.
+ *      min_results: The number of completions to wait for.  Use 0 to never block.  Capped at
+ *          the number of operations that have been submitted but not reaped.
+ *      errnum: [Out] Storage location for errno values encountered.  An errno value here
+ *          describes a failure to reap, not the failure of an operation (see: skidIoResult).
+ *
+ *  Returns:
+ *      The number of entries stored in results.
+ */
+unsigned int reap_io_batch(skidIoBatch_ptr batch, skidIoResult_ptr results,
+                           unsigned int max_results, unsigned int min_results, int *errnum);
+
+/*
+ *  Description:
+ *      Submit every queued operation.  With io_uring, this is one io_uring_enter() call that
+ *      does not wait for the operations to complete.  With the synchronous fallback, each
+ *      operation is executed, in order, before this function returns.  Either way, use
+ *      reap_io_batch() to collect the results.
+ *
+ *  Args:
+ *      batch: The batch to submit.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The number of operations submitted.  Operations that could not be submitted remain queued
+ *      and are retried by the next call.
+ */
+unsigned int submit_io_batch(skidIoBatch_ptr batch, int *errnum);
+
+#endif  /* __SKID_IO_BATCH__ */
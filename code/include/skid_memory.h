@@ -48,6 +48,18 @@ typedef struct _skidMemMapRegion
     size_t length;  // [Out] The length of the mapping
 } skidMemMapRegion, *skidMemMapRegion_ptr;
 
+// This struct holds a reusable, caller-owned, heap-allocated buffer.  Functions that fill a
+// skidBuffer reuse its existing capacity and only reallocate when it is too small, so a buffer
+// that is reused across calls reaches a steady state where no allocations are made.
+// Zero-initialize the struct (e.g., skidBuffer buff = { 0 };) before first use and release it
+// with free_skid_buffer().
+typedef struct _skidBuffer
+{
+    char *data;       // Heap-allocated storage.  Nul-terminated after a successful fill.
+    size_t length;    // The number of bytes of data currently stored (excludes the terminator)
+    size_t capacity;  // The total size of the data allocation, in bytes
+} skidBuffer, *skidBuffer_ptr;
+
 /*
  *  Description:
  *      Allocate a zeroized array in heap memory.
@@ -64,6 +76,19 @@ typedef struct _skidMemMapRegion
  */
 void *alloc_skid_mem(size_t num_elem, size_t size_elem, int *errnum);
 
+/*
+ *  Description:
+ *      Empty a skidBuffer without releasing its storage.  The length is reset to zero and the
+ *      capacity is left unchanged so the buffer may be refilled without reallocating.
+ *
+ *  Args:
+ *      buffer: [In/Out] The skidBuffer to empty.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int clear_skid_buffer(skidBuffer_ptr buffer);
+
 /*
  *  Description:
  *      Close the file descriptor to a POSIX shared memory object opened by open_shared_mem()
@@ -108,6 +133,18 @@ char *copy_skid_string(const char *source, int *errnum);
  */
 int delete_shared_mem(const char *name);
 
+/*
+ *  Description:
+ *      Free a skidBuffer's storage and zeroize its members.  The struct itself is not freed.
+ *
+ *  Args:
+ *      buffer: [In/Out] The skidBuffer to release.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int free_skid_buffer(skidBuffer_ptr buffer);
+
 /*
  *  Description:
  *      Free skid-allocated heap memory and set the original pointer to NULL.
@@ -132,6 +169,21 @@ int free_skid_mem(void **old_mem);
  */
 int free_skid_string(char **old_string);
 
+/*
+ *  Description:
+ *      Ensure a skidBuffer can hold at least min_capacity bytes.  Existing contents are preserved.
+ *      The capacity grows geometrically so repeated growth is amortized.  A buffer that is already
+ *      large enough is left untouched.  An empty (zeroized) buffer is allocated on demand.
+ *
+ *  Args:
+ *      buffer: [In/Out] The skidBuffer to grow.
+ *      min_capacity: The minimum capacity, in bytes, the buffer must have.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  On error, the buffer is unchanged.
+ */
+int grow_skid_buffer(skidBuffer_ptr buffer, size_t min_capacity);
+
 /*
  *  Description:
  *      Map zeroized virtual memory by utilizing mmap().
@@ -221,6 +273,28 @@ int map_skid_struct(skidMemMapRegion_ptr *new_struct, int prot, int flags, size_
 int open_shared_mem(const char *name, int flags, mode_t mode, size_t size,
                     bool truncate, int *errnum);
 
+/*
+ *  Description:
+ *      Resize a skid-allocated array in heap memory by calling realloc().  The contents of
+ *      old_mem are preserved up to the lesser of the old and new sizes.  Unlike alloc_skid_mem(),
+ *      any newly added memory is *not* zeroized.
+ *
+ *  Args:
+ *      old_mem: [Optional] Heap-allocated memory from alloc_skid_mem() (or this function).
+ *          If NULL, this function behaves like an allocation that does not zeroize.
+ *      num_elem: The new number of elements in the array.
+ *      size_elem: The size of each element in the array.
+ *      errnum: [Out] Storage location for errno values encountered.  EOVERFLOW is used to
+ *          indicate num_elem * size_elem overflows a size_t.
+ *
+ *  Returns:
+ *      Heap-allocated memory of total size num_elem * size_elem, on success.  The return value
+ *      replaces old_mem and the caller is responsible for freeing it with free_skid_mem().
+ *      NULL on error (check errnum for details), in which case old_mem is left untouched and
+ *      still belongs to the caller.
+ */
+void *realloc_skid_mem(void *old_mem, size_t num_elem, size_t size_elem, int *errnum);
+
 /*
  *  Description:
  *      Delete the mapping for the specified address range by utilizing munmap().
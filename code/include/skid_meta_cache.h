@@ -0,0 +1,139 @@
+/*
+ *  This library defines an opt-in, in-process cache of file metadata for hot paths that are
+ *  checked over and over (e.g., a request router checking the same few thousand files).  A
+ *  pathname is only cached if its directory is watched with inotify, so the cache is told when
+ *  an entry must be thrown out.  A hit costs a hash table lookup instead of a statx() call.
+ *
+ *  USAGE:
+ *      int errnum = ENOERR;  // Out-parameter for the results of SKID API functions
+ *      skidFileMeta meta;    // Metadata snapshot
+ *      skidMetaCache_ptr cache = create_meta_cache(0, &errnum);
+ *      errnum = watch_meta_cache_dir(cache, "/srv/www/static");
+ *      // Any number of threads may call this concurrently
+ *      errnum = get_cached_meta(cache, "/srv/www/static/index.html", &meta);
+ *      if (ENOERR == errnum && S_IFREG == get_meta_file_type(&meta, &errnum)) ...
+ *      // Once every thread is done with it
+ *      errnum = destroy_meta_cache(&cache);
+ *
+ *  NOTES:
+ *      - Entries are keyed by the pathname string.  A pathname is only cached if everything
+ *        before its last slash matches a watched (absolute) dirname exactly, so build pathnames
+ *        the same way the directory was watched.  Relative pathnames are never cached.
+ *      - inotify events are asynchronous.  A change is seen once the cache's watcher thread
+ *        has read its event, so a lookup racing a change may still get the old metadata.
+ *        Access times are never refreshed.
+ *      - Deleting or renaming a watched directory drops its entries and its watch.  Changes
+ *        made through a hard link in an unwatched directory, or to an ancestor of a watched
+ *        directory, are not seen.
+ *      - Symbolic links are followed but never cached, since their targets may live anywhere.
+ */
+
+#ifndef __SKID_META_CACHE__
+#define __SKID_META_CACHE__
+
+#include <stddef.h>                         // size_t
+#include <stdint.h>                         // uint64_t
+#include "skid_file_metadata_read.h"        // skidFileMeta
+#include "skid_macros.h"                    // ENOERR
+
+#define SKID_META_CACHE_ENTRIES 4096  // Default maximum number of cached entries
+
+// Opaque handle to a metadata cache: the hash table, the inotify watches, and the watcher thread.
+typedef struct _skidMetaCache skidMetaCache, *skidMetaCache_ptr;
+
+// A metadata cache's counters, as reported by get_meta_cache_stats().
+typedef struct _skidMetaCacheStats
+{
+    uint64_t hits;           // Lookups answered from the cache
+    uint64_t misses;         // Lookups that called statx()
+    uint64_t invalidations;  // Entries thrown out because of an inotify event
+    size_t entries;          // Entries currently cached
+} skidMetaCacheStats, *skidMetaCacheStats_ptr;
+
+/*
+ *  Description:
+ *      Create an empty metadata cache and start the watcher thread that invalidates it.
+ *
+ *  Args:
+ *      max_entries: The most entries the cache will hold.  Use 0 for SKID_META_CACHE_ENTRIES.
+ *          Misses aren't cached while the cache is full.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A new metadata cache, on success.  Destroy it with destroy_meta_cache().  NULL on error
+ *      (check errnum for details).
+ */
+skidMetaCache_ptr create_meta_cache(size_t max_entries, int *errnum);
+
+/*
+ *  Description:
+ *      Stop the watcher thread, remove every inotify watch, and free the metadata cache.  Call
+ *      this only once no other thread is using the cache.
+ *
+ *  Args:
+ *      cache: [In/Out] A pointer to the metadata cache to destroy.  Set to NULL on success.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int destroy_meta_cache(skidMetaCache_ptr *cache);
+
+/*
+ *  Description:
+ *      Throw out every cached entry.  Watches and counters are left alone.
+ *
+ *  Args:
+ *      cache: The metadata cache to empty.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int flush_meta_cache(skidMetaCache_ptr cache);
+
+/*
+ *  Description:
+ *      Fetch pathname's metadata from the cache.  On a miss, take a get_file_meta() snapshot
+ *      of it (SKID_META_BASIC, following symbolic links) and cache it if pathname is in a
+ *      watched directory.  Safe to call from any number of threads at once.
+ *
+ *  Args:
+ *      cache: The metadata cache to use.
+ *      pathname: Absolute or relative pathname to fetch the metadata of.
+ *      meta: [Out] pathname's metadata.  Read it with the get_meta_*() accessors.
+ *
+ *  Returns:
+ *      ENOERR on success.  Errno value on failure, which is never cached.
+ */
+int get_cached_meta(skidMetaCache_ptr cache, const char *pathname, skidFileMeta_ptr meta);
+
+/*
+ *  Description:
+ *      Report a metadata cache's hit, miss, and invalidation counters and its current size.
+ *
+ *  Args:
+ *      cache: The metadata cache to inspect.
+ *      stats: [Out] The counters.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int get_meta_cache_stats(skidMetaCache_ptr cache, skidMetaCacheStats_ptr stats);
+
+/*
+ *  Description:
+ *      Start caching the entries of dirname.  The directory is watched with inotify, and any
+ *      change to an entry's attributes, contents, or name throws that entry out of the cache.
+ *      Watching the same dirname again is harmless.
+ *
+ *  Args:
+ *      cache: The metadata cache to use.
+ *      dirname: Absolute directory name to watch.  Trailing slashes are ignored.  Relative
+ *          dirnames are rejected since their meaning changes with the working directory.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EINVAL indicates a relative dirname.  ENOSPC indicates
+ *      the user's inotify watch limit was reached (see: /proc/sys/fs/inotify/max_user_watches).
+ */
+int watch_meta_cache_dir(skidMetaCache_ptr cache, const char *dirname);
+
+#endif  /* __SKID_META_CACHE__ */
@@ -13,6 +13,7 @@
 #include <stdbool.h>                        // bool, false, true
 #include <sys/socket.h>                     // socklen_t
 #include "skid_macros.h"                    // SKID_BAD_FD
+#include "skid_memory.h"                    // skidBuffer
 
 /*
  *  Description:
@@ -273,6 +274,26 @@ char *receive_socket(int sockfd, int flags, int protocol, int *errnum);
  */
 char *recv_socket(int sockfd, int flags, int *errnum);
 
+/*
+ *  Description:
+ *      Read a message from a socket, using recv(), into a caller-owned, reusable skidBuffer.
+ *      Any existing contents are replaced.  The buffer's existing capacity is reused and it only
+ *      grows when the message will not fit, so reusing one buffer across calls avoids an
+ *      allocation per message.
+ *
+ *  Args:
+ *      sockfd: A file descriptor that refers to a socket to receive from.
+ *      flags: A bit-wise OR of zero or more flags, as defined in recv(2):
+ *          MSG_CMSG_CLOEXEC, MSG_DONTWAIT, MSG_ERRQUEUE, MSG_OOB, MSG_PEEK, MSG_TRUNC, MSG_WAITALL.
+ *      buffer: [In/Out] The skidBuffer to receive into.  On success, buffer->length holds the
+ *          number of bytes received.  On error, buffer->length is 0 but the buffer is not freed.
+ *          Release the buffer with free_skid_buffer() when it is no longer needed.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int recv_socket_buf(int sockfd, int flags, skidBuffer_ptr buffer);
+
 /*
  *  Description:
  *      Read a message from a socket, using recvfrom(), into a heap-allocated array.
@@ -304,6 +325,32 @@ char *recv_socket(int sockfd, int flags, int *errnum);
 char *recv_from_socket(int sockfd, int flags, struct sockaddr *src_addr, socklen_t *addrlen,
                        int *errnum);
 
+/*
+ *  Description:
+ *      Read a message from a socket, using recvfrom(), into a caller-owned, reusable skidBuffer.
+ *      Any existing contents are replaced.  The buffer's existing capacity is reused and it only
+ *      grows when the message will not fit, so reusing one buffer across calls avoids an
+ *      allocation per message.  See recv_from_socket() for details on src_addr and addrlen.
+ *
+ *  Args:
+ *      sockfd: A file descriptor that refers to a socket to receive from.
+ *      flags: A bit-wise OR of zero or more flags, as defined in recv(2):
+ *          MSG_CMSG_CLOEXEC, MSG_DONTWAIT, MSG_ERRQUEUE, MSG_OOB, MSG_PEEK, MSG_TRUNC, MSG_WAITALL.
+ *      src_addr: [Optional/Out] A pointer to the storage location for the source address of the
+ *          incoming connection.  Not validated.  Passed directly to recvfrom().
+ *      addrlen: [Optional/Out] A pointer to the storage location for the actual size of the
+ *          source address.  Not validated.  Passed directly to recvfrom().
+ *      buffer: [In/Out] The skidBuffer to receive into.  On success, buffer->length holds the
+ *          number of bytes received.  On error, buffer->length is 0 but the buffer is not freed.
+ *          Release the buffer with free_skid_buffer() when it is no longer needed.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  ENODATA is used to indicate there was no data to
+ *      receive.
+ */
+int recv_from_socket_buf(int sockfd, int flags, struct sockaddr *src_addr, socklen_t *addrlen,
+                         skidBuffer_ptr buffer);
+
 /*
  *  Description:
  *      Resolve a protocol alias into its protocol number by searching the protocols database
@@ -5,6 +5,7 @@
 #define SKID_BAD_TIME_T ((time_t)-1)
 
 #include <poll.h>                           // struct pollfd
+#include "skid_memory.h"                    // skidBuffer
 
 
 /*
@@ -52,5 +53,26 @@ int call_poll(struct pollfd *fds, nfds_t nfds, int timeout, int *errnum);
  */
 char *read_pollfd(struct pollfd *poll_fd, int *revents, int *errnum);
 
+/*
+ *  Description:
+ *      Process one pollfd struct, exactly like read_pollfd(), but read any data into a
+ *      caller-owned, reusable skidBuffer.  Any existing contents are replaced.  The buffer's
+ *      existing capacity is reused so a single buffer can service every pollfd in a poll() loop
+ *      without an allocation per message.
+ *
+ *  Args:
+ *      poll_fd: A pointer to the pollfd struct to potentially read from.
+ *      revents: [Out] The revents value from poll_fd.
+ *      buffer: [In/Out] The skidBuffer to read into.  On return, buffer->length holds the
+ *          number of bytes read (0 if there was nothing to read or an error occurred).  The
+ *          buffer is never freed by this function; use free_skid_buffer() when finished.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  The revents argument will always be set to match
+ *      poll_fd->revents.  The errno value EBADF will be used if poll_fd's fd is already set
+ *      to SKID_BAD_FD.
+ */
+int read_pollfd_buf(struct pollfd *poll_fd, int *revents, skidBuffer_ptr buffer);
+
 
 #endif  /* __SKID_POLL__ */
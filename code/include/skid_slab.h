@@ -0,0 +1,128 @@
+/*
+ *  This library defines a slab allocator (AKA object pool) for hot paths that allocate and free
+ *  the same size object over and over (e.g., per-client state, pollfd arrays).  Each pool hands
+ *  out objects of one size, carved from slabs of memory mapped with map_skid_mem(), and keeps a
+ *  free list of the objects returned to it.  Allocating and freeing are constant time and never
+ *  call malloc() or free(), so a long-running daemon's latency stays predictable and its heap
+ *  doesn't fragment.  Slabs are only unmapped when the pool is destroyed.
+ *
+ *  USAGE:
+ *      int errnum = ENOERR;  // Out-parameter for the results of SKID API functions
+ *      skidSlabStats stats;  // Pool counters
+ *      // One pool per object size, shared by every thread
+ *      skidSlabPool_ptr pool = create_slab_pool(sizeof(clientState), 0, true, &errnum);
+ *      clientState *client = alloc_slab_obj(pool, &errnum);
+ *      // Utilize client, as normal
+ *      errnum = free_slab_obj(pool, (void **)&client);
+ *      errnum = get_slab_stats(pool, &stats, false);  // How many are live?  How many at most?
+ *      // Once every thread is done with it
+ *      errnum = destroy_slab_pool(&pool);
+ *
+ *  NOTES:
+ *      - Only free an object to the pool that allocated it.  Never pass pool objects to
+ *        free_skid_mem().
+ *      - With thread caches, each thread keeps a few free objects of its own so most calls
+ *        don't touch the pool's lock.  Each such pool uses one pthread key (see: PTHREAD_KEYS_MAX).
+ */
+
+#ifndef __SKID_SLAB__
+#define __SKID_SLAB__
+
+#include <stdbool.h>                        // bool
+#include <stddef.h>                         // size_t
+#include <stdint.h>                         // uint64_t
+#include "skid_macros.h"                    // ENOERR
+
+#define SKID_SLAB_SIZE 65536  // Default size, in bytes, of each slab a pool maps
+
+// Opaque handle to a slab pool: the slabs, the free list, and the thread caches.
+typedef struct _skidSlabPool skidSlabPool, *skidSlabPool_ptr;
+
+// A slab pool's counters, as reported by get_slab_stats().
+typedef struct _skidSlabStats
+{
+    size_t obj_size;      // Bytes per object, after rounding up
+    uint64_t live;        // Objects allocated and not yet freed
+    uint64_t high_water;  // The most objects ever live at once (since the last reset)
+    uint64_t slabs;       // Slabs mapped
+    uint64_t capacity;    // Objects the mapped slabs can hold
+} skidSlabStats, *skidSlabStats_ptr;
+
+/*
+ *  Description:
+ *      Allocate one zeroized object from a slab pool.  A new slab is mapped when every object in
+ *      the existing slabs is live.
+ *
+ *  Args:
+ *      pool: The pool to allocate from.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A zeroized object of the pool's obj_size, on success.  Return it with free_slab_obj().
+ *      NULL on error (check errnum for details).
+ */
+void *alloc_slab_obj(skidSlabPool_ptr pool, int *errnum);
+
+/*
+ *  Description:
+ *      Create an empty slab pool for objects of obj_size bytes.  Nothing is mapped until the
+ *      first allocation.
+ *
+ *  Args:
+ *      obj_size: The size of each object (e.g., sizeof(struct pollfd) * num_fds).  Rounded up to
+ *          a multiple of __alignof__(max_align_t), so every object is aligned for any type, as
+ *          with malloc().
+ *      objs_per_slab: The number of objects each slab holds.  Use 0 for as many as fit in
+ *          SKID_SLAB_SIZE (but at least one).
+ *      thread_cache: If true, give each thread that uses the pool a cache of free objects.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A new slab pool, on success.  Destroy it with destroy_slab_pool().  NULL on error (check
+ *      errnum for details).
+ */
+skidSlabPool_ptr create_slab_pool(size_t obj_size, size_t objs_per_slab, bool thread_cache,
+                                  int *errnum);
+
+/*
+ *  Description:
+ *      Unmap every slab and free the slab pool.  Every object the pool allocated is invalidated,
+ *      live or not.  Call this only once no other thread is using the pool.
+ *
+ *  Args:
+ *      pool: [In/Out] A pointer to the slab pool to destroy.  Set to NULL on success.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int destroy_slab_pool(skidSlabPool_ptr *pool);
+
+/*
+ *  Description:
+ *      Return an object to the slab pool that allocated it and set the original pointer to NULL.
+ *
+ *  Args:
+ *      pool: The pool that allocated the object.
+ *      obj: [In/Out] Pointer to the object's storage location.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int free_slab_obj(skidSlabPool_ptr pool, void **obj);
+
+/*
+ *  Description:
+ *      Report a slab pool's counters.
+ *
+ *  Args:
+ *      pool: The pool to report on.
+ *      stats: [Out] Storage location for the counters.
+ *      reset: If true, restart the high-water mark at the current number of live objects, after
+ *          reading it.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+int get_slab_stats(skidSlabPool_ptr pool, skidSlabStats_ptr stats, bool reset);
+
+#endif  /* __SKID_SLAB__ */
@@ -3,19 +3,22 @@
  */
 
 #define SKID_DEBUG          // Enable DEBUG logging
+#define _GNU_SOURCE         // nftw()
 
 #include <errno.h>                      // errno
+#include <fcntl.h>                      // openat(), O_DIRECTORY
+#include <ftw.h>                        // nftw()
 #include <libgen.h>                     // dirname()
 #include <limits.h>                     // PATH_MAX
 #include <signal.h>                     // sigqueue()
-#include <stdio.h>                      // remove()
+#include <stdio.h>                      // remove(), snprintf()
 #include <stdint.h>                     // SIZE_MAX
 #include <stdlib.h>                     // calloc(), free()
 #include <string.h>                     // strstr()
 #include <sys/socket.h>                 // AF_UNIX, socket()
-#include <sys/stat.h>                   // stat()
+#include <sys/stat.h>                   // mkdirat(), stat()
 #include <sys/un.h>                     // struct sockaddr_un
-#include <unistd.h>                     // getcwd()
+#include <unistd.h>                     // close(), getcwd()
 // Local includes
 #include "devops_code.h"            // Headers
 #include "skid_debug.h"                 // PRINT_ERRNO()
@@ -272,6 +275,16 @@ int read_group_field(char *group_entry, int field_num, char *field_value, int fv
 int recurse_path_tree(char **string_arr, const char *dirname, unsigned int num_files,
                       unsigned int tree_width, unsigned int tree_depth);
 
+/*
+ *  Description:
+ *      nftw() callback for remove_a_tree().  Deletes one entry of the tree.
+ *
+ *  Returns:
+ *      0 on success, -1 on error (see: errno).
+ */
+int remove_tree_entry(const char *pathname, const struct stat *sb, int typeflag,
+                      struct FTW *ftwbuf);
+
 /*
  *  Description:
  *      Find needle in haystack.  Truncate the rest of hastack with a trailing "/\0".
@@ -1662,6 +1675,71 @@ int make_a_symlink(const char *target_path, const char *link_path)
 }
 
 
+int make_a_tree(int dir_fd, unsigned int num_files, unsigned int tree_width,
+                unsigned int tree_depth, unsigned int *num_made)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;    // Errno value
+    char name[16] = { 0 };  // The name of a new entry
+    int fd = -1;            // File descriptor for a new entry
+    unsigned int i = 0;     // Iterating variable
+
+    // INPUT VALIDATION
+    if (dir_fd < 0 || NULL == num_made)
+    {
+        result = EINVAL;
+    }
+
+    // MAKE IT
+    // Files
+    for (i = 0; ENOERR == result && i < num_files; i++)
+    {
+        snprintf(name, sizeof(name), "e%05u", (*num_made)++);
+        fd = openat(dir_fd, name, O_CREAT | O_WRONLY, 0644);
+        if (fd < 0)
+        {
+            result = errno;
+            PRINT_ERROR(The call to openat() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            close(fd);
+        }
+    }
+    // Directories
+    for (i = 0; ENOERR == result && tree_depth > 0 && i < tree_width; i++)
+    {
+        snprintf(name, sizeof(name), "e%05u", (*num_made)++);
+        if (mkdirat(dir_fd, name, 0755))
+        {
+            result = errno;
+            PRINT_ERROR(The call to mkdirat() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            fd = openat(dir_fd, name, O_RDONLY | O_DIRECTORY);
+            if (fd < 0)
+            {
+                result = errno;
+                PRINT_ERROR(The call to openat() failed);
+                PRINT_ERRNO(result);
+            }
+            else
+            {
+                // Recurse
+                result = make_a_tree(fd, num_files, tree_width, tree_depth - 1, num_made);
+                close(fd);
+            }
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 int micro_sleep(useconds_t num_microsecs)
 {
     // LOCAL VARIABLES
@@ -1804,6 +1882,35 @@ int remove_a_file(const char *filename, bool ignore_missing)
 }
 
 
+int remove_a_tree(const char *dirname, bool ignore_missing)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno value
+
+    // INPUT VALIDATION
+    result = validate_name(dirname);
+
+    // REMOVE IT
+    // Children first and never follow symbolic links
+    if (ENOERR == result && nftw(dirname, remove_tree_entry, 16, FTW_DEPTH | FTW_PHYS))
+    {
+        result = errno;
+        if (ENOENT == result && true == ignore_missing)
+        {
+            result = ENOERR;
+        }
+        else
+        {
+            PRINT_ERROR(The call to nftw() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 int remove_shell_dir(const char *dirname)
 {
     // LOCAL VARIABLES
@@ -2855,6 +2962,13 @@ int recurse_path_tree(char **string_arr, const char *dirname, unsigned int num_f
 }
 
 
+int remove_tree_entry(const char *pathname, const struct stat *sb, int typeflag,
+                      struct FTW *ftwbuf)
+{
+    return remove(pathname);
+}
+
+
 int truncate_dir(char *haystack, const char *needle, size_t hay_len)
 {
     // LOCAL VARIABLES
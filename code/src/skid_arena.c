@@ -0,0 +1,524 @@
+/*
+ *  This library defines functionality to allocate request-scoped memory from mapped arenas.
+ */
+
+// #define SKID_DEBUG                          // Enable DEBUG logging
+
+#include <errno.h>                          // errno, EINVAL, EOVERFLOW
+#include <pthread.h>                        // pthread_key_create(), pthread_once()
+#include <stdbool.h>                        // bool, false, true
+#include <stddef.h>                         // max_align_t
+#include <stdint.h>                         // SIZE_MAX
+#include <string.h>                         // memcpy(), memset(), strlen()
+#include <unistd.h>                         // sysconf()
+#include "skid_arena.h"                     // public functions, skidArena
+#include "skid_debug.h"                     // PRINT_ERROR(), PRINT_ERRNO()
+#include "skid_file_descriptors.h"          // read_fd_chunk()
+#include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
+#include "skid_memory.h"                    // map_skid_mem(), unmap_skid_mem()
+#include "skid_validation.h"                // validate_skid_*()
+
+MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
+MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
+
+#ifndef SKID_ARENA_MIN_READ
+#define SKID_ARENA_MIN_READ 4096  // Fewest bytes read_fd_arena() reserves before each read()
+#endif  /* SKID_ARENA_MIN_READ */
+
+#define SKID_ARENA_ALIGN __alignof__(max_align_t)  // Every allocation is aligned to this
+// Round size up to the next multiple of align (which must be a power of two)
+#define SKID_ARENA_ROUND(size, align) (((size) + ((align) - 1)) & ~((size_t)(align) - 1))
+// Number of bytes at the start of each chunk reserved for the chunk's header
+#define SKID_ARENA_HEADER SKID_ARENA_ROUND(sizeof(skidArenaChunk), SKID_ARENA_ALIGN)
+
+
+// The header at the start of each chunk
+struct _skidArenaChunk
+{
+    struct _skidArenaChunk *next;  // The chunk after this one, in the order they're used
+    size_t length;                 // Size of this chunk's mapping, header included
+};
+
+static __thread skidArena thread_arena;                       // get_thread_arena()'s arena
+static __thread bool thread_arena_registered = false;         // Is thread_arena's key set?
+static pthread_key_t thread_arena_key;                        // Frees thread_arena at thread exit
+static pthread_once_t thread_arena_once = PTHREAD_ONCE_INIT;  // Creates thread_arena_key
+static int thread_arena_key_err = ENOERR;                     // Results of creating the key
+
+
+/**************************************************************************************************/
+/********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
+/**************************************************************************************************/
+
+/*
+ *  Description:
+ *      Create thread_arena_key, with a destructor that frees each thread's arena.  Only call
+ *      this through pthread_once().  Stores the results in thread_arena_key_err.
+ */
+SKID_INTERNAL void create_thread_arena_key(void);
+
+/*
+ *  Description:
+ *      Map a new chunk with room for at least size bytes, link it in after arena's current chunk
+ *      (so chunks left over from before a clear_skid_arena() are still used, in order), and make
+ *      it the current chunk.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to grow.
+ *      size: The number of bytes the new chunk must have room for, after the header.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  On error, arena is unchanged.
+ */
+SKID_INTERNAL int map_arena_chunk(skidArena_ptr arena, size_t size);
+
+/*
+ *  Description:
+ *      Thread-specific data destructor for thread_arena_key.
+ *
+ *  Args:
+ *      arena: The exiting thread's arena.
+ */
+SKID_INTERNAL void release_thread_arena(void *arena);
+
+/*
+ *  Description:
+ *      Find at least size contiguous, aligned, bytes at the top of arena without allocating
+ *      them.  The current chunk is used if it has room, then the next chunk, then a new chunk.
+ *      Commit the bytes that are actually used by setting arena->offset.  Reserving more than
+ *      is available at the top of the current chunk never returns the same memory.
+ *
+ *  Args:
+ *      arena: [In/Out] The arena to reserve from.
+ *      size: The fewest bytes to reserve.
+ *      avail: [Out] The number of bytes actually available, which may be more than size.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      A pointer into arena's current chunk, on success.  NULL on error (check errnum for
+ *      details).
+ */
+SKID_INTERNAL char *reserve_arena(skidArena_ptr arena, size_t size, size_t *avail, int *errnum);
+
+/*
+ *  Description:
+ *      Validate an arena pointer.
+ *
+ *  Args:
+ *      arena: A non-NULL arena pointer.
+ *
+ *  Returns:
+ *      ENOERR for good input, EINVAL otherwise.
+ */
+SKID_INTERNAL int validate_arena(skidArena_ptr arena);
+
+
+/**************************************************************************************************/
+/********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+
+void *alloc_skid_arena(skidArena_ptr arena, size_t num_elem, size_t size_elem, int *errnum)
+{
+    // LOCAL VARIABLES
+    char *new_mem = NULL;                // Memory carved from arena
+    int result = validate_arena(arena);  // Store local errno values here
+    size_t avail = 0;                    // Bytes reserved at the top of arena
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+    if (ENOERR == result && (0 == num_elem || 0 == size_elem))
+    {
+        result = EINVAL;  // Nothing to allocate
+    }
+    if (ENOERR == result && num_elem > SIZE_MAX / size_elem)
+    {
+        result = EOVERFLOW;  // num_elem * size_elem doesn't fit in a size_t
+    }
+
+    // ALLOCATE IT
+    if (ENOERR == result)
+    {
+        new_mem = reserve_arena(arena, num_elem * size_elem, &avail, &result);
+    }
+    if (ENOERR == result)
+    {
+        arena->offset = (size_t)(new_mem - (char *)arena->current) + num_elem * size_elem;
+        memset(new_mem, 0, num_elem * size_elem);  // Chunks are reused after a clear
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return new_mem;
+}
+
+
+int clear_skid_arena(skidArena_ptr arena)
+{
+    // LOCAL VARIABLES
+    int result = validate_arena(arena);  // Errno values
+
+    // CLEAR IT
+    if (ENOERR == result)
+    {
+        arena->current = arena->first;
+        arena->offset = SKID_ARENA_HEADER;
+    }
+
+    // DONE
+    return result;
+}
+
+
+char *copy_skid_string_arena(skidArena_ptr arena, const char *source, int *errnum)
+{
+    // LOCAL VARIABLES
+    char *destination = NULL;            // Arena-allocated copy of source
+    int result = validate_arena(arena);  // Errno values
+    size_t src_len = 0;                  // Length of source
+    size_t avail = 0;                    // Bytes reserved at the top of arena
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_string(source, false);
+    }
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+
+    // COPY IT
+    // Reserve room for it
+    if (ENOERR == result)
+    {
+        src_len = strlen(source);
+        destination = reserve_arena(arena, src_len + 1, &avail, &result);
+    }
+    // Copy it
+    if (ENOERR == result)
+    {
+        memcpy(destination, source, src_len + 1);
+        arena->offset = (size_t)(destination - (char *)arena->current) + src_len + 1;
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return destination;
+}
+
+
+int free_skid_arena(skidArena_ptr arena)
+{
+    // LOCAL VARIABLES
+    int result = validate_arena(arena);  // Errno values
+    int tmp_result = ENOERR;             // Results of each unmap_skid_mem() call
+    skidArenaChunk_ptr chunk = NULL;     // The chunk to unmap
+    skidMemMapRegion region = { 0 };     // Argument to unmap_skid_mem()
+
+    // FREE IT
+    if (ENOERR == result)
+    {
+        while (arena->first)
+        {
+            chunk = arena->first;
+            arena->first = chunk->next;  // Read it before it's unmapped
+            region.addr = chunk;
+            region.length = chunk->length;
+            tmp_result = unmap_skid_mem(&region);
+            if (ENOERR != tmp_result)
+            {
+                PRINT_ERROR(The call to unmap_skid_mem() failed);
+                PRINT_ERRNO(tmp_result);
+                if (ENOERR == result)
+                {
+                    result = tmp_result;  // Report the first error but unmap the rest
+                }
+            }
+        }
+        arena->current = NULL;
+        arena->offset = 0;
+        arena->mapped = 0;
+    }
+
+    // DONE
+    return result;
+}
+
+
+skidArena_ptr get_thread_arena(int *errnum)
+{
+    // LOCAL VARIABLES
+    skidArena_ptr arena = NULL;              // The calling thread's arena
+    int result = validate_skid_err(errnum);  // Errno values
+
+    // CREATE THE KEY
+    if (ENOERR == result)
+    {
+        result = pthread_once(&thread_arena_once, create_thread_arena_key);
+        if (ENOERR == result)
+        {
+            result = thread_arena_key_err;
+        }
+    }
+
+    // REGISTER IT
+    if (ENOERR == result && false == thread_arena_registered)
+    {
+        result = pthread_setspecific(thread_arena_key, &thread_arena);
+        if (ENOERR == result)
+        {
+            thread_arena_registered = true;
+        }
+        else
+        {
+            PRINT_ERROR(The call to pthread_setspecific() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    if (ENOERR == result)
+    {
+        arena = &thread_arena;
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return arena;
+}
+
+
+char *read_fd_arena(skidArena_ptr arena, int fd, size_t *output_len, int *errnum)
+{
+    // LOCAL VARIABLES
+    char *data = NULL;                   // The contents of fd, at the top of arena
+    char *new_data = NULL;               // A bigger reservation to move data to
+    int result = validate_arena(arena);  // Errno values
+    size_t length = 0;                   // Number of bytes read into data
+    size_t avail = 0;                    // Number of bytes reserved for data
+    size_t num_read = 0;                 // Number of bytes read by one read()
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+    if (ENOERR == result)
+    {
+        result = validate_skid_fd(fd);
+    }
+
+    // READ IT
+    if (ENOERR == result)
+    {
+        data = reserve_arena(arena, SKID_ARENA_MIN_READ, &avail, &result);
+    }
+    while (ENOERR == result)
+    {
+        // Check for room (always keep one byte in reserve for the nul-terminator)
+        if (length + 1 >= avail)
+        {
+            // Not enough room?  Move to a reservation twice the size.
+            new_data = reserve_arena(arena, 2 * avail, &avail, &result);
+            if (ENOERR != result)
+            {
+                PRINT_ERROR(The call to reserve_arena() failed);
+                PRINT_ERRNO(result);
+                break;  // Stop on error
+            }
+            memcpy(new_data, data, length);
+            data = new_data;
+        }
+        // Read directly into the unused portion of the reservation
+        result = read_fd_chunk(fd, data + length, avail - length - 1, length > 0, &num_read);
+        if (0 == num_read)
+        {
+            break;  // EOF or error... either way, let's stop
+        }
+        length += num_read;  // Keep track of what's been stored
+    }
+
+    // COMMIT IT
+    if (ENOERR == result)
+    {
+        data[length] = '\0';  // Room was reserved for this
+        arena->offset = (size_t)(data - (char *)arena->current) + length + 1;
+    }
+    else
+    {
+        data = NULL;  // The reservation was never committed
+        length = 0;
+    }
+
+    // DONE
+    if (output_len)
+    {
+        *output_len = length;
+    }
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return data;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL void create_thread_arena_key(void)
+{
+    thread_arena_key_err = pthread_key_create(&thread_arena_key, release_thread_arena);
+    if (ENOERR != thread_arena_key_err)
+    {
+        PRINT_ERROR(The call to pthread_key_create() failed);
+        PRINT_ERRNO(thread_arena_key_err);
+    }
+}
+
+
+SKID_INTERNAL int map_arena_chunk(skidArena_ptr arena, size_t size)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                // Errno values
+    size_t length = arena->chunk_size;  // Size of the new chunk's mapping
+    // Round oversized chunks up to this
+    long page_size = sysconf(_SC_PAGESIZE);
+    skidMemMapRegion region = { 0 };    // Argument to map_skid_mem()
+    skidArenaChunk_ptr chunk = NULL;    // The new chunk
+
+    // SIZE IT
+    if (0 == length)
+    {
+        length = SKID_ARENA_CHUNK_SIZE;
+    }
+    if (0 >= page_size)
+    {
+        page_size = 4096;  // sysconf() doesn't know so assume the most common page size
+    }
+    if (size > SIZE_MAX - SKID_ARENA_HEADER - (size_t)page_size)
+    {
+        result = EOVERFLOW;  // Too big to map
+    }
+    else if (SKID_ARENA_HEADER + size > length)
+    {
+        length = SKID_ARENA_ROUND(SKID_ARENA_HEADER + size, (size_t)page_size);  // Its own chunk
+    }
+
+    // MAP IT
+    if (ENOERR == result)
+    {
+        region.length = length;
+        result = map_skid_mem(&region, PROT_READ | PROT_WRITE, MAP_PRIVATE);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to map_skid_mem() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // LINK IT
+    if (ENOERR == result)
+    {
+        chunk = region.addr;
+        chunk->length = region.length;
+        if (arena->current)
+        {
+            chunk->next = arena->current->next;
+            arena->current->next = chunk;
+        }
+        else
+        {
+            chunk->next = arena->first;
+            arena->first = chunk;
+        }
+        arena->current = chunk;
+        arena->offset = SKID_ARENA_HEADER;
+        arena->mapped += region.length;
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void release_thread_arena(void *arena)
+{
+    free_skid_arena(arena);  // Best effort
+}
+
+
+SKID_INTERNAL char *reserve_arena(skidArena_ptr arena, size_t size, size_t *avail, int *errnum)
+{
+    // LOCAL VARIABLES
+    char *top = NULL;                           // The reserved memory
+    int result = ENOERR;                        // Errno values
+    skidArenaChunk_ptr chunk = arena->current;  // The chunk to reserve from
+    size_t start = 0;                           // Aligned offset of top into chunk
+
+    // FIND ROOM
+    // The current chunk
+    if (chunk)
+    {
+        start = SKID_ARENA_ROUND(arena->offset, SKID_ARENA_ALIGN);
+        if (start > chunk->length || chunk->length - start < size)
+        {
+            chunk = chunk->next;  // Not enough room
+            start = SKID_ARENA_HEADER;
+            // The next chunk (left over from before a clear)
+            if (chunk && chunk->length - start < size)
+            {
+                chunk = NULL;  // Not enough room either
+            }
+        }
+    }
+    // A new chunk
+    if (NULL == chunk)
+    {
+        result = map_arena_chunk(arena, size);
+        chunk = arena->current;
+        start = SKID_ARENA_HEADER;
+    }
+
+    // RESERVE IT
+    if (ENOERR == result)
+    {
+        arena->current = chunk;
+        arena->offset = start;
+        top = (char *)chunk + start;
+        *avail = chunk->length - start;
+    }
+
+    // DONE
+    *errnum = result;
+    return top;
+}
+
+
+SKID_INTERNAL int validate_arena(skidArena_ptr arena)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // INPUT VALIDATION
+    if (NULL == arena)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // DONE
+    return result;
+}
@@ -0,0 +1,610 @@
+/*
+ *  This library defines functionality to log messages from a dedicated writer thread.
+ */
+
+// #define SKID_DEBUG                          // Enable DEBUG logging
+
+#include <errno.h>                          // EAGAIN, EINVAL
+#include <poll.h>                           // poll()
+#include <pthread.h>                        // pthread_create(), pthread_join()
+#include <sched.h>                          // sched_yield()
+#include <stdatomic.h>                      // atomic_*
+#include <stdbool.h>                        // bool, false, true
+#include <stdio.h>                          // snprintf()
+#include <string.h>                         // memcpy(), strnlen()
+#include <sys/eventfd.h>                    // eventfd()
+#include <sys/uio.h>                        // struct iovec
+#include <time.h>                           // clock_gettime(), localtime_r()
+#include <unistd.h>                         // read(), write()
+#include "skid_async_log.h"                 // skidAsyncLog, skidLogOverflow
+#include "skid_debug.h"                     // PRINT_ERROR()
+#include "skid_file_descriptors.h"          // close_fd()
+#include "skid_file_operations.h"           // skidAppender, open_appender(), write_appender_v()
+#include "skid_macros.h"                    // ENOERR, SKID_BAD_FD, SKID_INTERNAL
+#include "skid_memory.h"                    // alloc_skid_mem(), free_skid_mem()
+#include "skid_validation.h"                // validate_skid_err(), validate_skid_pathname()
+
+MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
+MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
+
+#define SKID_LOG_CACHE_LINE 64   // Keeps the producers' and the writer's hot fields apart
+#define SKID_LOG_IDLE_MS 100     // Longest the idle writer sleeps before rechecking the ring
+#define SKID_LOG_STAMP_LEN 18    // Length of "[YYYYMMDD-HHMMSS] "
+
+
+// One fixed-size ring entry (256 bytes)
+typedef struct _skidLogRecord
+{
+    atomic_size_t sequence;      // Slot state: ready to fill when == position, ready to read
+                                 // when == position + 1
+    struct timespec timestamp;   // CLOCK_REALTIME time the message was written
+    size_t msg_len;              // Number of bytes in msg
+    char msg[SKID_LOG_MSG_MAX];  // The message, not nul-terminated
+} skidLogRecord, *skidLogRecord_ptr;
+
+struct _skidAsyncLog
+{
+    skidLogRecord_ptr records;   // Heap-allocated ring of mask + 1 records
+    size_t mask;                 // Ring size - 1 (the ring size is a power of two)
+    skidLogOverflow policy;      // What producers do when the ring is full
+    int wake_fd;                 // eventfd the producers use to wake the idle writer
+    skidAppender appender;       // The log file (writer thread only)
+    pthread_t writer;            // The writer thread
+    bool writer_started;         // Was the writer thread created?
+    atomic_int writer_err;       // First error the writer thread encountered
+    atomic_bool stopping;        // Set by stop_async_log()
+    atomic_bool sleeping;        // Set while the writer is (about to be) waiting on wake_fd
+    atomic_uint_fast64_t drops;  // Number of messages discarded
+    uint64_t drops_logged;       // Number of discarded messages already reported (writer only)
+    size_t head;                 // Position of the next record to read (writer only)
+    char pad[SKID_LOG_CACHE_LINE];  // Keep the writer's fields off the producers' cache line
+    atomic_size_t tail;          // Position of the next record to claim (producers)
+};
+
+
+/**************************************************************************************************/
+/********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
+/**************************************************************************************************/
+
+/*
+ *  Description:
+ *      Log every record that's ready, in order, and release each one back to the producers.
+ *      Adjacent records share a cached timestamp string while their second is unchanged.
+ *
+ *  Args:
+ *      async_log: The asynchronous log to drain.
+ *      stamp: [In/Out] Cached "[YYYYMMDD-HHMMSS] " string.
+ *      stamp_sec: [In/Out] The second stamp was formatted for.
+ *
+ *  Returns:
+ *      The number of records drained.
+ */
+SKID_INTERNAL size_t drain_sal_ring(skidAsyncLog_ptr async_log, char *stamp, time_t *stamp_sec);
+
+/*
+ *  Description:
+ *      Format "[YYYYMMDD-HHMMSS] " into stamp for the local time of seconds.  Matches
+ *      build_timestamp() without allocating.
+ *
+ *  Args:
+ *      seconds: The time to format.
+ *      stamp: [Out] A buffer of at least SKID_LOG_STAMP_LEN + 1 bytes.
+ */
+SKID_INTERNAL void format_sal_stamp(time_t seconds, char *stamp);
+
+/*
+ *  Description:
+ *      Writer thread entry point.  Drains the ring until stop_async_log() is called and the
+ *      ring is empty, writing out the appender whenever the ring runs dry.
+ *
+ *  Args:
+ *      arg: The skidAsyncLog_ptr to service.
+ *
+ *  Returns:
+ *      NULL.  Errors are stored in async_log->writer_err.
+ */
+SKID_INTERNAL void *run_sal_writer(void *arg);
+
+/*
+ *  Description:
+ *      Record a writer thread error, unless one was already recorded.
+ *
+ *  Args:
+ *      async_log: The asynchronous log the writer is servicing.
+ *      errnum: The error to record.  ENOERR is ignored.
+ */
+SKID_INTERNAL void set_sal_writer_err(skidAsyncLog_ptr async_log, int errnum);
+
+/*
+ *  Description:
+ *      Validates the skidAsyncLog_ptr arguments on behalf of this library.
+ *
+ *  Args:
+ *      async_log: A pointer returned by start_async_log().
+ *
+ *  Returns:
+ *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ */
+SKID_INTERNAL int validate_sal_log(skidAsyncLog_ptr async_log);
+
+/*
+ *  Description:
+ *      Put the writer thread to sleep until a producer wakes it, the idle timeout expires, or
+ *      stop_async_log() is called.  Returns immediately if a record became ready after the
+ *      writer last checked.
+ *
+ *  Args:
+ *      async_log: The asynchronous log the writer is servicing.
+ */
+SKID_INTERNAL void wait_sal_writer(skidAsyncLog_ptr async_log);
+
+/*
+ *  Description:
+ *      Wake the writer thread if it is sleeping.  Costs a system call only when it is.
+ *
+ *  Args:
+ *      async_log: The asynchronous log whose writer should wake.
+ */
+SKID_INTERNAL void wake_sal_writer(skidAsyncLog_ptr async_log);
+
+
+/**************************************************************************************************/
+/********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+
+uint64_t get_async_log_drops(skidAsyncLog_ptr async_log)
+{
+    // LOCAL VARIABLES
+    uint64_t drops = 0;  // Number of discarded messages
+
+    // GET IT
+    if (NULL != async_log)
+    {
+        drops = atomic_load_explicit(&(async_log->drops), memory_order_relaxed);
+    }
+
+    // DONE
+    return drops;
+}
+
+
+skidAsyncLog_ptr start_async_log(const char *filename, unsigned int num_records,
+                                 skidLogOverflow policy, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                // Errno values
+    skidAsyncLog_ptr async_log = NULL;  // The new asynchronous log
+    size_t ring_size = 2;               // Number of records, rounded up to a power of two
+    size_t i = 0;                       // Iterating variable
+
+    // INPUT VALIDATION
+    result = validate_skid_err(errnum);
+    if (ENOERR == result)
+    {
+        result = validate_skid_pathname(filename, false);
+    }
+    if (ENOERR == result && SKID_LOG_BLOCK != policy && SKID_LOG_DROP != policy
+        && SKID_LOG_COUNT != policy)
+    {
+        result = EINVAL;
+        PRINT_ERROR(The policy argument is not a skidLogOverflow value);
+    }
+
+    // SETUP
+    if (ENOERR == result)
+    {
+        if (0 == num_records)
+        {
+            num_records = SKID_LOG_RECORDS;
+        }
+        while (ring_size < num_records)
+        {
+            ring_size <<= 1;
+        }
+        async_log = alloc_skid_mem(1, sizeof(skidAsyncLog), &result);
+    }
+    if (ENOERR == result)
+    {
+        async_log->mask = ring_size - 1;
+        async_log->policy = policy;
+        async_log->wake_fd = SKID_BAD_FD;
+        async_log->appender.fd = SKID_BAD_FD;
+        atomic_init(&(async_log->writer_err), ENOERR);
+        atomic_init(&(async_log->stopping), false);
+        atomic_init(&(async_log->sleeping), false);
+        atomic_init(&(async_log->drops), 0);
+        atomic_init(&(async_log->tail), 0);
+        async_log->records = alloc_skid_mem(ring_size, sizeof(skidLogRecord), &result);
+    }
+    if (ENOERR == result)
+    {
+        for (i = 0; i < ring_size; i++)
+        {
+            atomic_init(&(async_log->records[i].sequence), i);  // Every slot starts fillable
+        }
+        async_log->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (SKID_BAD_FD == async_log->wake_fd)
+        {
+            result = errno;
+            PRINT_ERROR(The call to eventfd() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Open the log file (flushing is left to the writer, which flushes whenever it's idle)
+    if (ENOERR == result)
+    {
+        result = open_appender(&(async_log->appender), filename, 0, 0, 0, true);
+    }
+
+    // START IT
+    if (ENOERR == result)
+    {
+        result = pthread_create(&(async_log->writer), NULL, run_sal_writer, async_log);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to pthread_create() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            async_log->writer_started = true;
+        }
+    }
+
+    // CLEANUP
+    if (ENOERR != result && NULL != async_log)
+    {
+        stop_async_log(&async_log);  // Best effort
+        async_log = NULL;
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return async_log;
+}
+
+
+int stop_async_log(skidAsyncLog_ptr *async_log)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Errno values
+    skidAsyncLog_ptr tmp_log = NULL;  // Local copy of *async_log
+    int tmp_errnum = ENOERR;         // Errno values encountered during teardown
+
+    // INPUT VALIDATION
+    if (NULL == async_log)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        tmp_log = *async_log;
+        result = validate_sal_log(tmp_log);
+    }
+
+    // STOP IT
+    // Let the writer drain the ring and exit
+    if (ENOERR == result && true == tmp_log->writer_started)
+    {
+        atomic_store(&(tmp_log->stopping), true);
+        atomic_store(&(tmp_log->sleeping), true);  // Force the wake
+        wake_sal_writer(tmp_log);
+        tmp_errnum = pthread_join(tmp_log->writer, NULL);
+        if (ENOERR != tmp_errnum)
+        {
+            PRINT_ERROR(The call to pthread_join() failed);
+            PRINT_ERRNO(tmp_errnum);
+        }
+        result = atomic_load(&(tmp_log->writer_err));
+        if (ENOERR == result)
+        {
+            result = tmp_errnum;
+        }
+    }
+    // Tear it down
+    if (NULL != tmp_log)
+    {
+        if (SKID_BAD_FD != tmp_log->appender.fd)
+        {
+            tmp_errnum = close_appender(&(tmp_log->appender));
+            if (ENOERR == result)
+            {
+                result = tmp_errnum;
+            }
+        }
+        if (SKID_BAD_FD != tmp_log->wake_fd)
+        {
+            close_fd(&(tmp_log->wake_fd), true);  // Best effort
+        }
+        free_skid_mem((void **)&(tmp_log->records));  // Best effort
+        free_skid_mem((void **)async_log);  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+int write_async_log(skidAsyncLog_ptr async_log, const char *msg)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                  // Errno values
+    skidLogRecord_ptr record = NULL;      // The record claimed for msg
+    size_t position = 0;                  // The ring position of record
+    size_t sequence = 0;                  // The state of the record at position
+    intptr_t diff = 0;                    // sequence - position
+
+    // INPUT VALIDATION
+    result = validate_sal_log(async_log);
+    if (ENOERR == result && NULL == msg)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // CLAIM A RECORD
+    if (ENOERR == result)
+    {
+        position = atomic_load_explicit(&(async_log->tail), memory_order_relaxed);
+    }
+    while (ENOERR == result && NULL == record)
+    {
+        record = async_log->records + (position & async_log->mask);
+        sequence = atomic_load_explicit(&(record->sequence), memory_order_acquire);
+        diff = (intptr_t)sequence - (intptr_t)position;
+        if (0 == diff)
+        {
+            // The record is free: try to claim it (a failure reloads position)
+            if (false == atomic_compare_exchange_weak_explicit(&(async_log->tail), &position,
+                                                               position + 1, memory_order_relaxed,
+                                                               memory_order_relaxed))
+            {
+                record = NULL;
+            }
+        }
+        else if (diff > 0)
+        {
+            // Another producer claimed it first
+            record = NULL;
+            position = atomic_load_explicit(&(async_log->tail), memory_order_relaxed);
+        }
+        else
+        {
+            // The ring is full
+            record = NULL;
+            if (SKID_LOG_BLOCK == async_log->policy)
+            {
+                wake_sal_writer(async_log);
+                sched_yield();
+                position = atomic_load_explicit(&(async_log->tail), memory_order_relaxed);
+            }
+            else
+            {
+                atomic_fetch_add_explicit(&(async_log->drops), 1, memory_order_relaxed);
+                result = EAGAIN;
+            }
+        }
+    }
+
+    // FILL IT
+    if (ENOERR == result)
+    {
+        clock_gettime(CLOCK_REALTIME, &(record->timestamp));  // vDSO: no system call
+        record->msg_len = strnlen(msg, SKID_LOG_MSG_MAX);
+        memcpy(record->msg, msg, record->msg_len);
+        // Publish it
+        atomic_store_explicit(&(record->sequence), position + 1, memory_order_release);
+        wake_sal_writer(async_log);
+    }
+
+    // DONE
+    return result;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL size_t drain_sal_ring(skidAsyncLog_ptr async_log, char *stamp, time_t *stamp_sec)
+{
+    // LOCAL VARIABLES
+    size_t num_drained = 0;           // Number of records drained
+    skidLogRecord_ptr record = NULL;  // The next record to read
+    size_t msg_len = 0;               // Length of the record's message, without a newline
+    struct iovec entry[3] = { { 0 } };  // stamp, message, newline
+    int errnum = ENOERR;              // Errno values
+
+    // DRAIN IT
+    while (1)
+    {
+        record = async_log->records + (async_log->head & async_log->mask);
+        if (atomic_load_explicit(&(record->sequence), memory_order_acquire)
+            != async_log->head + 1)
+        {
+            break;  // Not ready yet
+        }
+        // Timestamp it
+        if (record->timestamp.tv_sec != *stamp_sec)
+        {
+            format_sal_stamp(record->timestamp.tv_sec, stamp);
+            *stamp_sec = record->timestamp.tv_sec;
+        }
+        // Log it
+        msg_len = record->msg_len;
+        if (msg_len > 0 && '\n' == record->msg[msg_len - 1])
+        {
+            msg_len--;  // The newline is added below
+        }
+        entry[0].iov_base = stamp;
+        entry[0].iov_len = SKID_LOG_STAMP_LEN;
+        entry[1].iov_base = record->msg;
+        entry[1].iov_len = msg_len;
+        entry[2].iov_base = "\n";
+        entry[2].iov_len = 1;
+        errnum = write_appender_v(&(async_log->appender), entry, 3);
+        set_sal_writer_err(async_log, errnum);  // Keep draining so producers never wedge
+        // Release it
+        atomic_store_explicit(&(record->sequence), async_log->head + async_log->mask + 1,
+                              memory_order_release);
+        async_log->head++;
+        num_drained++;
+    }
+
+    // DONE
+    return num_drained;
+}
+
+
+SKID_INTERNAL void format_sal_stamp(time_t seconds, char *stamp)
+{
+    // LOCAL VARIABLES
+    struct tm dt_struct = { 0 };  // Broken-down local time
+
+    // FORMAT IT
+    if (NULL == localtime_r(&seconds, &dt_struct))
+    {
+        memset(&dt_struct, 0x0, sizeof(dt_struct));  // Still produce a fixed-width stamp
+    }
+    snprintf(stamp, SKID_LOG_STAMP_LEN + 1, "[%04u%02u%02u-%02u%02u%02u] ",
+             (unsigned int)(dt_struct.tm_year + 1900) % 10000,
+             (unsigned int)(dt_struct.tm_mon + 1) % 100, (unsigned int)dt_struct.tm_mday % 100,
+             (unsigned int)dt_struct.tm_hour % 100, (unsigned int)dt_struct.tm_min % 100,
+             (unsigned int)dt_struct.tm_sec % 100);
+}
+
+
+SKID_INTERNAL void *run_sal_writer(void *arg)
+{
+    // LOCAL VARIABLES
+    skidAsyncLog_ptr async_log = (skidAsyncLog_ptr)arg;  // The asynchronous log to service
+    char stamp[SKID_LOG_STAMP_LEN + 1] = { 0 };         // Cached timestamp string
+    time_t stamp_sec = -1;                               // The second stamp was formatted for
+    bool stopping = false;                               // Was stop_async_log() called?
+    uint64_t drops = 0;                                  // Number of discarded messages
+    char notice[64] = { 0 };                             // Dropped message notice
+    struct iovec entry[2] = { { 0 } };                   // stamp, notice
+    struct timespec now = { 0 };                         // Time of the dropped message notice
+
+    // WRITE IT
+    while (1)
+    {
+        // Read the flag first so nothing published before the stop is missed
+        stopping = atomic_load(&(async_log->stopping));
+        if (drain_sal_ring(async_log, stamp, &stamp_sec) > 0)
+        {
+            continue;  // More may have arrived while draining
+        }
+        // The ring is empty so report drops
+        drops = atomic_load_explicit(&(async_log->drops), memory_order_relaxed);
+        if (SKID_LOG_COUNT == async_log->policy && drops > async_log->drops_logged)
+        {
+            clock_gettime(CLOCK_REALTIME, &now);
+            format_sal_stamp(now.tv_sec, stamp);
+            stamp_sec = now.tv_sec;
+            entry[0].iov_base = stamp;
+            entry[0].iov_len = SKID_LOG_STAMP_LEN;
+            entry[1].iov_base = notice;
+            entry[1].iov_len = snprintf(notice, sizeof(notice), "%ju log messages dropped\n",
+                                        (uintmax_t)(drops - async_log->drops_logged));
+            set_sal_writer_err(async_log, write_appender_v(&(async_log->appender), entry, 2));
+            async_log->drops_logged = drops;
+        }
+        // ...and write out what's buffered
+        set_sal_writer_err(async_log, flush_appender(&(async_log->appender), false));
+        if (true == stopping)
+        {
+            break;  // Empty and stopped
+        }
+        wait_sal_writer(async_log);
+    }
+
+    // DONE
+    return NULL;
+}
+
+
+SKID_INTERNAL void set_sal_writer_err(skidAsyncLog_ptr async_log, int errnum)
+{
+    // LOCAL VARIABLES
+    int expected = ENOERR;  // Only replace a clean slate
+
+    // SET IT
+    if (ENOERR != errnum)
+    {
+        atomic_compare_exchange_strong(&(async_log->writer_err), &expected, errnum);
+    }
+}
+
+
+SKID_INTERNAL int validate_sal_log(skidAsyncLog_ptr async_log)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // VALIDATE IT
+    if (NULL == async_log)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else if (NULL == async_log->records)
+    {
+        result = EINVAL;  // Not created by start_async_log()
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void wait_sal_writer(skidAsyncLog_ptr async_log)
+{
+    // LOCAL VARIABLES
+    struct pollfd wake_pfd = { 0 };  // Wait on wake_fd
+    skidLogRecord_ptr record = NULL;  // The next record to read
+    uint64_t count = 0;              // eventfd counter
+
+    // WAIT
+    atomic_store(&(async_log->sleeping), true);
+    // Pairs with the producers' publish-then-check: one side must see the other
+    atomic_thread_fence(memory_order_seq_cst);
+    record = async_log->records + (async_log->head & async_log->mask);
+    if (atomic_load_explicit(&(record->sequence), memory_order_acquire) == async_log->head + 1
+        || true == atomic_load(&(async_log->stopping)))
+    {
+        atomic_store(&(async_log->sleeping), false);  // Something arrived after all
+    }
+    else
+    {
+        wake_pfd.fd = async_log->wake_fd;
+        wake_pfd.events = POLLIN;
+        poll(&wake_pfd, 1, SKID_LOG_IDLE_MS);  // Best effort: a timeout rechecks the ring
+        atomic_store(&(async_log->sleeping), false);
+    }
+    if (sizeof(count) != read(async_log->wake_fd, &count, sizeof(count)))
+    {
+        count = 0;  // Nothing to clear
+    }
+}
+
+
+SKID_INTERNAL void wake_sal_writer(skidAsyncLog_ptr async_log)
+{
+    // LOCAL VARIABLES
+    uint64_t count = 1;  // eventfd increment
+
+    // WAKE IT
+    atomic_thread_fence(memory_order_seq_cst);  // Publish before checking (see: wait_sal_writer())
+    if (true == atomic_load_explicit(&(async_log->sleeping), memory_order_relaxed)
+        && true == atomic_exchange(&(async_log->sleeping), false))
+    {
+        if (sizeof(count) != write(async_log->wake_fd, &count, sizeof(count)))
+        {
+            PRINT_WARNG(The call to write() failed to wake the writer thread);
+        }
+    }
+}
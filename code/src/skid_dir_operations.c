@@ -4,29 +4,162 @@
 
 // #define SKID_DEBUG                      // Enable DEBUG logging
 
+#include "skid_arena.h"                 // alloc_skid_arena()
 #include "skid_debug.h"                 // PRINT_ERRNO()
 #include "skid_dir_operations.h"        // _DEFAULT_SOURCE, delete_dir()
+#include "skid_file_descriptors.h"      // close_fd()
 #include "skid_file_metadata_read.h"    // is_directory()
-#include "skid_file_operations.h"       // delete_file()
 #include "skid_macros.h"                // ENOERR, SKID_INTERNAL
-#include "skid_memory.h"                // copy_skid_string(), free_skid_mem(), free_skid_string()
+#include "skid_memory.h"                // copy_skid_string(), free_skid_mem(), realloc_skid_mem()
 #include "skid_validation.h"            // validate_skid_err(), validate_skid_pathname()
-#include <dirent.h>                     // closedir(), opendir(), readdir(), struct dirent
+#include <dirent.h>                     // DT_DIR, DT_UNKNOWN
 #include <errno.h>                      // errno
-#include <stdint.h>                     // SIZE_MAX
-#include <string.h>                     // strncpy()
-#include <unistd.h>                     // link(), rmdir(), symlink()
+#include <fcntl.h>                      // AT_FDCWD, O_DIRECTORY, fstatat(), openat()
+#include <limits.h>                     // PATH_MAX
+#include <pthread.h>                    // pthread_create(), pthread_join(), pthread_mutex_lock()
+#include <stdatomic.h>                  // atomic_*
+#include <stdint.h>                     // SIZE_MAX, uint64_t
+#include <string.h>                     // memcpy(), strlen()
+#include <sys/stat.h>                   // fstat(), struct stat
+#include <sys/syscall.h>                // SYS_getdents64
+#include <unistd.h>                     // rmdir(), syscall(), sysconf(), unlinkat()
 #ifndef SKID_ARRAY_SIZE
-// #define SKID_ARRAY_SIZE 1024            // Starting num of indices in read_dir_contents()'s array
-#define SKID_ARRAY_SIZE 8               // Starting num of indices in read_dir_contents()'s array
+#define SKID_ARRAY_SIZE 1024            // Starting num of offsets in a skidDirListing
 #endif  /* SKID_ARRAY_SIZE */
-#ifndef SKID_MAX_RETRIES
-#define SKID_MAX_RETRIES 10             // Maximum number of maximum failure loops for store_dent()
-#endif  /* SKID_MAX_RETRIES */
+#ifndef SKID_DENTS_MIN_SIZE
+#define SKID_DENTS_MIN_SIZE (32 * 1024)    // Smallest getdents64() buffer, like readdir()'s
+#endif  /* SKID_DENTS_MIN_SIZE */
+#ifndef SKID_DENTS_MAX_SIZE
+#define SKID_DENTS_MAX_SIZE (1024 * 1024)  // Largest getdents64() buffer, used for huge directories
+#endif  /* SKID_DENTS_MAX_SIZE */
+#ifndef SKID_LISTING_ARENA_SIZE
+#define SKID_LISTING_ARENA_SIZE (64 * 1024)  // Starting size of a skidDirListing's string arena
+#endif  /* SKID_LISTING_ARENA_SIZE */
+#ifndef SKID_WALK_DEQUE_SIZE
+#define SKID_WALK_DEQUE_SIZE 64         // Starting num of tasks in a walk_dir_parallel() deque
+#endif  /* SKID_WALK_DEQUE_SIZE */
+#ifndef SKID_WALK_MAX_OPEN_FDS
+#define SKID_WALK_MAX_OPEN_FDS 256      // Most queued directories walk_dir_parallel() holds open
+#endif  /* SKID_WALK_MAX_OPEN_FDS */
+#ifndef SKID_TREE_MODE_BITS
+#define SKID_TREE_MODE_BITS (mode_t)07777  // The mode bits set_tree_meta() reads and writes
+#endif  /* SKID_TREE_MODE_BITS */
+#define SKID_TREE_WALK_BITS (mode_t)(S_IRUSR | S_IXUSR)  // The bits the walk needs to get in
+
+// apply_sdo_meta() stages
+#define SKID_TREE_ALL 0   // A non-directory: every change at once
+#define SKID_TREE_PRE 1   // A directory before its contents: all but turning off the walk bits
+#define SKID_TREE_POST 2  // A directory after its contents: whatever is left, uncounted
 
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
 
+// The record getdents64() fills its buffer with (see: getdents64(2))
+typedef struct _skidDirent64
+{
+    uint64_t d_ino;           // Inode number
+    int64_t d_off;            // Offset to the next record
+    unsigned short d_reclen;  // Size of this record, padding included
+    unsigned char d_type;     // File type (DT_*)
+    char d_name[];            // Nul-terminated filename
+} skidDirent64, *skidDirent64_ptr;
+
+// The state of one walk_dir() call, shared by every level of its recursion
+typedef struct _skidDirWalk
+{
+    DirVisitor visitor;            // Called for each entry
+    DirVisitor post_visitor;       // [Optional] Called for each directory after its contents
+    void *context;                 // Passed, untouched, to both visitors
+    size_t max_depth;              // Deepest entries to visit, 0 for no limit
+    bool stopped;                  // Set once visitor returns SKID_WALK_STOP
+    char path_buff[PATH_MAX + 1];  // Working path, each level appends to it
+} skidDirWalk, *skidDirWalk_ptr;
+
+// The context destroy_dir() and destroy_dir_parallel() pass to their visitors
+typedef struct _skidDestroyVisit
+{
+    atomic_int result;                 // The first deletion error
+    skidDestroyProgress_ptr progress;  // [Optional] Counters to update as entries are deleted
+} skidDestroyVisit, *skidDestroyVisit_ptr;
+
+// The context read_dir_listing() passes to visit_listing_entry()
+typedef struct _skidListingVisit
+{
+    skidDirListing_ptr listing;  // The listing to append to
+    int result;                  // The first errno value encountered
+} skidListingVisit, *skidListingVisit_ptr;
+
+// The context set_tree_meta() passes to its visitors
+typedef struct _skidTreeMetaVisit
+{
+    atomic_int result;                  // The first error
+    const skidTreeMeta *changes;        // The changes to make
+    skidTreeMetaProgress_ptr progress;  // [Optional] Counters to update as entries are checked
+} skidTreeMetaVisit, *skidTreeMetaVisit_ptr;
+
+// A directory in a parallel walk with a post_visitor.  It stays open, for its sub-directories'
+// post-visits, until everything queued beneath it has been post-visited.
+typedef struct _skidWalkNode
+{
+    atomic_size_t refs;            // 1 until it's been read plus 1 per unfinished sub-directory
+    struct _skidWalkNode *parent;  // The directory containing this one, NULL for the top
+    char *path;                    // Heap-allocated path, taken from the task once it's read
+    size_t path_len;               // Length of path
+    size_t name_off;               // Offset of the final component of path
+    size_t depth;                  // This directory's depth as an entry
+    int dir_fd;                    // This directory, once it's been opened
+} skidWalkNode, *skidWalkNode_ptr;
+
+// One directory waiting to be read by a walk_dir_parallel() worker
+typedef struct _skidWalkTask
+{
+    char *path;             // Heap-allocated path of the directory
+    size_t path_len;        // Length of path
+    size_t depth;           // The depth of the directory's entries
+    int dir_fd;             // The directory, already opened relative to its parent, or SKID_BAD_FD
+    skidWalkNode_ptr node;  // [Optional] The directory's node, if the walk has a post_visitor
+} skidWalkTask, *skidWalkTask_ptr;
+
+// One walk_dir_parallel() worker's double-ended queue of directories waiting to be read
+typedef struct _skidWalkDeque
+{
+    pthread_mutex_t lock;     // Guards the fields below (taken by the owner and by thieves)
+    skidWalkTask_ptr tasks;   // Heap-allocated array of tasks
+    size_t top;               // Index of the oldest task, stolen by other workers
+    size_t bottom;            // One past the newest task, popped by the owner
+    size_t capacity;          // Number of elements allocated in tasks
+} skidWalkDeque, *skidWalkDeque_ptr;
+
+// The state shared by every walk_dir_parallel() worker
+typedef struct _skidParallelWalk
+{
+    DirVisitor visitor;         // Called for each entry
+    DirVisitor post_visitor;    // [Optional] Called for each directory after its contents
+    void *context;              // Passed, untouched, to both visitors
+    size_t max_depth;           // Deepest entries to visit, 0 for no limit
+    unsigned int num_workers;   // Number of elements in deques
+    skidWalkDeque_ptr deques;   // Heap-allocated array, one deque per worker
+    atomic_size_t pending;      // Directories queued or being read, the walk is done at 0
+    atomic_size_t queued;       // Directories queued
+    atomic_uint open_fds;       // Queued directories holding an open file descriptor
+    atomic_uint num_idle;       // Workers waiting on idle_cond
+    atomic_int first_err;       // The first errno value any worker encountered
+    atomic_bool stopped;        // Set on error or SKID_WALK_STOP
+    bool keep_going;            // Record directories that can't be read instead of stopping
+    pthread_mutex_t idle_lock;  // Guards idle_cond
+    pthread_cond_t idle_cond;   // Signaled when work is queued or the walk ends
+} skidParallelWalk, *skidParallelWalk_ptr;
+
+// One walk_dir_parallel() worker thread
+typedef struct _skidWalkWorker
+{
+    skidParallelWalk_ptr walk;     // The state shared by every worker
+    unsigned int index;            // This worker's deque and skidDirEntry.worker value
+    pthread_t thread;              // This worker's thread (unused for worker 0, the caller)
+    bool started;                  // True if thread needs to be joined
+    char path_buff[PATH_MAX + 1];  // Working path
+} skidWalkWorker, *skidWalkWorker_ptr;
+
 
 /**************************************************************************************************/
 /********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
@@ -34,140 +167,271 @@ MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destruct
 
 /*
  *  Description:
- *      Count the number of sequential, non-NULL entries in content_arr.  Stops counting at the
- *      first NULL or capacity has been reached.  Bad input will result in 0.
+ *      Append path (and a nul terminator) to listing's arena and record its offset.  The arena
+ *      and offset array grow by doubling so appending is amortized constant time.
  *
  *  Args:
- *      content_arr: [Optional] Starting array of strings (which represent pathnames).  If NULL,
- *          this function will return 0.
- *      capacity: [In] Current capacity of content_arr.
+ *      listing: [In/Out] The listing to append to.
+ *      path: The path to append.
+ *      path_len: The length of path, excluding the nul terminator.
  *
  *  Returns:
- *      The number of non-NULL entries in the content_arr.  0 on bad input: NULL pointer, invalid
- *      capacity value.
+ *      ENOERR on success, errno on error.  On error, listing is unchanged.
  */
-SKID_INTERNAL size_t count_content_arr_entries(char **content_arr, size_t *capacity);
+SKID_INTERNAL int add_listing_path(skidDirListing_ptr listing, const char *path, size_t path_len);
 
 /*
  *  Description:
- *      Replicates skid_file_metadata_read's is_directory() functionality for dirent structs.
+ *      Check one entry against visit's changes with fstatat() and make only the changes it
+ *      needs, relative to dir_fd.  Ownership goes first since chown() may clear the
+ *      set-user-ID and set-group-ID bits, in which case the permissions are always rewritten.
+ *      A directory is changed in two stages: before its contents, so a change that grants
+ *      access lets the walk in, and after, to turn off any SKID_TREE_WALK_BITS the walk needed.
  *
  *  Args:
- *      direntp: A pointer to a dirent struct.
+ *      visit: [In/Out] The changes to make and the progress to update.
+ *      dir_fd: The directory containing name, or AT_FDCWD.
+ *      name: The entry to change, relative to dir_fd.
+ *      at_flags: AT_SYMLINK_NOFOLLOW to change a symbolic link itself, 0 to follow it.
+ *      stage: SKID_TREE_ALL, SKID_TREE_PRE, or SKID_TREE_POST.  The progress is only updated
+ *          by the first two, so each entry counts once.
  *
  *  Returns:
- *      True if direntp represents a directory, false otherwise.  Also returns false on any error.
+ *      ENOERR on success, errno on error.
  */
-SKID_INTERNAL bool is_dirent_a_dir(struct dirent *direntp);
+SKID_INTERNAL int apply_sdo_meta(skidTreeMetaVisit_ptr visit, int dir_fd, const char *name,
+                                 int at_flags, int stage);
 
 /*
  *  Description:
- *      Allocate an array and copy in dirname/path.  This function will add a delimiter if
- *      dirname does not end with one and path does not begin with one.  It is the caller's
- *      responsiblity to free the return value.  Use free_skid_string() to free the return value.
+ *      Allocate the node for a directory a post-visited parallel walk has yet to read.  The
+ *      node holds a reference to parent until it has been post-visited.
  *
  *  Args:
- *      dirname: A directory, relative or absolute, to join path to.
- *      path: A path, relative or absolute, to join to dirname.
- *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *      parent: [In/Out] The node of the directory containing this one, NULL for the top.
+ *      name_off: The offset of the directory's name in its (eventual) path.
+ *      depth: The directory's depth as an entry.
+ *      errnum: [Out] Storage location for errno values encountered.
  *
  *  Returns:
- *      A heap-allocated copy of dirname/path on success.  NULL on failure (see errnum for details).
+ *      A new node with one reference, on success.  NULL on error (check errnum for details).
  */
-SKID_INTERNAL char *join_dir_path(const char *dirname, const char *path, int *errnum);
+SKID_INTERNAL skidWalkNode_ptr create_sdo_node(skidWalkNode_ptr parent, size_t name_off,
+                                               size_t depth, int *errnum);
 
 /*
  *  Description:
- *      Allocate a larger array, copy the string pointers in, update the capacity, and free the
- *      old array.
+ *      Free a walk_dir_parallel() task's path, close its directory, if open, and release its
+ *      node, if any.
  *
  *  Args:
- *      content_arr: [Optional] Starting array of strings (which represent pathnames).  If NULL,
- *          this function will create the first array.
- *      capacity: [In/Out] Current capacity of content_arr.
- *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *      walk: [In/Out] The state shared by every worker.
+ *      task: [In/Out] The task to free.
+ *      worker: The index of the worker freeing the task.
+ */
+SKID_INTERNAL void free_sdo_task(skidParallelWalk_ptr walk, skidWalkTask_ptr task,
+                                 unsigned int worker);
+
+/*
+ *  Description:
+ *      Determine the file type of a getdents64() record.  The record's d_type is trusted so no
+ *      stat() is necessary.  Only filesystems that report DT_UNKNOWN cost an fstatat().
+ *
+ *  Args:
+ *      dir_fd: The directory the record was read from.
+ *      direntp: A pointer to a getdents64() record.
  *
  *  Returns:
- *      A larger string array on success, content_arr on failure.  Ensure errnum is checked for
- *      errno values.
+ *      A DT_* file type.  Symbolic links are not followed.  DT_UNKNOWN on error.
  */
-SKID_INTERNAL char **realloc_dir_contents(char **content_arr, size_t *capacity, int *errnum);
+SKID_INTERNAL unsigned char get_dirent_type(int dir_fd, skidDirent64_ptr direntp);
 
 /*
  *  Description:
- *      Underpins read_dir_contents().  The caller is responsible for free()ing the return value.
+ *      Decide whether a timestamp from a skidTreeMeta needs to be written.
  *
  *  Args:
- *      content_arr: [Optional] Starting array of strings (which represent pathnames).  There is no
- *          guarantee the return value will match content_arr.  If NULL, this function will
- *          allocate an array.  If content_arr is full, this function will reallocate an array
- *          and update capacity with the new size.
- *      capacity: [In/Out] A pointer to the current capacity of content_arr.  This value will be
- *          updated if the content array has to be reallocated.
- *      dirname: Absolute or relative directory to read the contents of (must exist).
- *      recurse: If true, also include all sub-dirs and their files in the array.
- *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *      want: The timestamp to set, UTIME_NOW, or UTIME_OMIT.
+ *      have: The entry's current timestamp.
+ *
+ *  Returns:
+ *      True for UTIME_NOW or a timestamp that differs from have.  False otherwise.
+ */
+SKID_INTERNAL bool needs_sdo_time(const struct timespec *want, const struct timespec *have);
+
+/*
+ *  Description:
+ *      Take the newest task from worker index's own deque or, if it's empty, steal the oldest
+ *      task from another worker's deque.
+ *
+ *  Args:
+ *      walk: The state shared by every worker.
+ *      index: The index of the worker looking for work.
+ *      task: [Out] The task, if one was found.  The caller owns it.
+ *
+ *  Returns:
+ *      True if a task was found, false otherwise.
+ */
+SKID_INTERNAL bool pop_sdo_task(skidParallelWalk_ptr walk, unsigned int index,
+                                skidWalkTask_ptr task);
+
+/*
+ *  Description:
+ *      Queue task at the newest end of worker index's deque, count it as pending, and wake an
+ *      idle worker to steal it.
+ *
+ *  Args:
+ *      walk: [In/Out] The state shared by every worker.
+ *      index: The index of the worker queueing the task.
+ *      task: The task to queue.  The deque owns it on success.
  *
  *  Returns:
- *      A NULL-terminated array of string pointers.  Each string pointer represents one path
- *      found in dirname.  The array contains a number of indices equal to capacity.  If dirname
- *      is empty, this function will return NULL.  On failure, NULL an errnum will be set with
- *      an errno value (or -1 for an unspecified error).
+ *      ENOERR on success, errno on error.
  */
-SKID_INTERNAL char **recurse_dir_contents(char **content_arr, size_t *capacity, const char *dirname,
-                                          bool recurse, int *errnum);
+SKID_INTERNAL int push_sdo_task(skidParallelWalk_ptr walk, unsigned int index,
+                                skidWalkTask_ptr task);
 
 /*
  *  Description:
- *      Allocate, copy, and store dirp->d_name in content_arr (unless d_name is . or ..).
+ *      Read the next batch of dirname's records, in one getdents64() call, into dents_buff.
  *
  *  Args:
- *      content_arr: [Optional] Starting array of strings (which represent pathnames).  There is no
- *          guarantee the return value will match content_arr.  If NULL, this function will
- *          allocate an array.  If content_arr is full, this function will reallocate an array,
- *          copy the legacy pointers, and update capacity with the new size.
- *      capacity: [In/Out] A pointer to the current capacity of content_arr.  This value will be
- *          updated if the content array has to be reallocated.
- *      dirname: [Optional] Preceding directory to prepend to the dirent->d_name.  If ommitted,
- *          just the d_name will be stored.
- *      direntp: [Optional] A pointer to a dirent struct to store in content_arr.  This function
- *          will ignore NULL direntp pointers.
+ *      dir_fd: The open directory to read.
+ *      dents_buff: [Out] The buffer to read into.
+ *      buff_size: The size of dents_buff.
  *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
  *
  *  Returns:
- *      A NULL-terminated array of string pointers.  Each string pointer represents one path.
- *      The last entry in the array will be a copy of dirp->d_name (if dirp is a valid pointer).
- *      The array contains a number of indices equal to capacity.  On failure, NULL an errnum
- *      will be set with an errno value (or -1 for an unspecified error).
+ *      The number of bytes of records read into dents_buff.  0 at the end of the directory or
+ *      on error (check errnum for details).
+ */
+SKID_INTERNAL size_t read_dents(int dir_fd, char *dents_buff, size_t buff_size, int *errnum);
+
+/*
+ *  Description:
+ *      Read one directory on behalf of a walk_dir_parallel() worker: visit each entry and
+ *      queue each sub-directory that should be read, already opened relative to this one
+ *      unless SKID_WALK_MAX_OPEN_FDS queued directories are already open.
+ *
+ *  Args:
+ *      worker: [In/Out] The worker reading the directory.
+ *      task: [In/Out] The directory to read.  Its file descriptor is closed or, if it has a
+ *          node, handed to the node along with its path.
+ *      dents_buff: The worker's getdents64() buffer of SKID_DENTS_MAX_SIZE bytes.
+ *
+ *  Returns:
+ *      ENOERR on success (or a stopped walk), errno on error.
+ */
+SKID_INTERNAL int read_sdo_task(skidWalkWorker_ptr worker, skidWalkTask_ptr task,
+                                char *dents_buff);
+
+/*
+ *  Description:
+ *      Record errnum as a walk_dir_parallel() walk's error if it's the first one.
+ *
+ *  Args:
+ *      walk: [In/Out] The state shared by every worker.
+ *      errnum: The errno value to record.
+ */
+SKID_INTERNAL void record_sdo_error(skidParallelWalk_ptr walk, int errnum);
+
+/*
+ *  Description:
+ *      Drop one reference to node.  Dropping the last one means every directory beneath it has
+ *      been post-visited, so node is post-visited, relative to its parent's file descriptor,
+ *      closed, freed, and its reference to its parent is dropped in turn.  The top of the walk
+ *      is not post-visited; its caller deals with it.
+ *
+ *  Args:
+ *      walk: [In/Out] The state shared by every worker.
+ *      node: [In/Out] The node to release.
+ *      worker: The index of the worker releasing the node.
  */
-SKID_INTERNAL char **store_dirent(char **content_arr, size_t *capacity, const char *dirname,
-                                  struct dirent *direntp, int *errnum);
+SKID_INTERNAL void release_sdo_node(skidParallelWalk_ptr walk, skidWalkNode_ptr node,
+                                   unsigned int worker);
 
 /*
  *  Description:
- *      Validate struct dirent pointers on behalf of store_dirent().
+ *      Walk dirname with a pool of work-stealing workers using walk's visitors, context, and
+ *      depth limit.  Underpins walk_dir_parallel() and destroy_dir_parallel().
  *
  *  Args:
- *      direntp: A non-NULL dirent struct pointer.
+ *      walk: [In/Out] The visitors, context, and depth limit, the rest zeroed.
+ *      dirname: Absolute or relative directory to walk (must exist).
+ *      num_threads: The number of workers, counting the calling thread.  0 for one per online
+ *          CPU.  Capped at SKID_WALK_MAX_THREADS.
  *
  *  Returns:
- *      True if direntp is valid: non-NULL, d_name lenth > 0, is not a relative symbol
- *      (e.g., ".", "..").  False otherwise.
+ *      ENOERR on success (or a stopped walk), errno on error.
  */
-SKID_INTERNAL bool validate_direntp(struct dirent *direntp);
+SKID_INTERNAL int run_sdo_parallel(skidParallelWalk_ptr walk, const char *dirname,
+                                   unsigned int num_threads);
 
 /*
  *  Description:
- *      Validate the arguments on behalf of recurse_dir_contents().
+ *      Validate dirname, copy it into walk's path buffer, and walk it with walk's visitors.
+ *      Underpins walk_dir() and destroy_dir().
  *
  *  Args:
- *      See recurse_dir_contents().
+ *      walk: [In/Out] The visitors, context, and depth limit for this walk.
+ *      dirname: Absolute or relative directory to walk (must exist).
  *
  *  Returns:
- *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ *      ENOERR on success (or a stopped walk), errno on error.
+ */
+SKID_INTERNAL int run_sdo_walk(skidDirWalk_ptr walk, const char *dirname);
+
+/*
+ *  Description:
+ *      The walk_dir_parallel() worker loop: read tasks, from its own deque or stolen from
+ *      others, until none are queued or being read anywhere, or the walk is stopped.  The
+ *      calling thread runs this too, as worker 0.
+ *
+ *  Args:
+ *      arg: A skidWalkWorker pointer.
+ *
+ *  Returns:
+ *      NULL.  Errors are recorded in the shared state's first_err.
+ */
+SKID_INTERNAL void *run_sdo_worker(void *arg);
+
+/*
+ *  Description:
+ *      Size a getdents64() buffer for the open directory dir_fd.  A directory's st_size grows
+ *      with its number of entries so big directories get a big buffer (and fewer system calls)
+ *      while small directories don't pay for one.
+ *
+ *  Args:
+ *      dir_fd: The open directory to size a buffer for.
+ *
+ *  Returns:
+ *      A buffer size between SKID_DENTS_MIN_SIZE and SKID_DENTS_MAX_SIZE.
+ */
+SKID_INTERNAL size_t size_dents_buff(int dir_fd);
+
+/*
+ *  Description:
+ *      Stop a walk_dir_parallel() walk: record errnum (if it's the first error), flag every
+ *      worker to stop, and wake the idle ones.
+ *
+ *  Args:
+ *      walk: [In/Out] The state shared by every worker.
+ *      errnum: The errno value to record or ENOERR for a SKID_WALK_STOP.
+ */
+SKID_INTERNAL void stop_sdo_walk(skidParallelWalk_ptr walk, int errnum);
+
+/*
+ *  Description:
+ *      Validate directory entry names on behalf of walk_sdo_dir().
+ *
+ *  Args:
+ *      d_name: A directory entry name.
+ *
+ *  Returns:
+ *      True if d_name is valid: non-NULL, length > 0, is not a relative symbol (e.g., ".",
+ *      "..").  False otherwise.
  */
-SKID_INTERNAL int validate_rdc_args(char **content_arr, size_t *capacity, const char *dirname,
-                                    bool recurse, int *errnum);
+SKID_INTERNAL bool validate_d_name(const char *d_name);
 
 /*
  *  Description:
@@ -181,6 +445,124 @@ SKID_INTERNAL int validate_rdc_args(char **content_arr, size_t *capacity, const
  */
 SKID_INTERNAL int validate_sdo_pathname(const char *pathname);
 
+/*
+ *  Description:
+ *      Validates the skidTreeMeta argument on behalf of set_tree_meta().
+ *
+ *  Args:
+ *      changes: The changes to validate.
+ *
+ *  Returns:
+ *      ENOERR if changes is non-NULL, its modes hold only SKID_TREE_MODE_BITS, and its
+ *      timestamps are valid (or UTIME_NOW or UTIME_OMIT).  EINVAL otherwise.
+ */
+SKID_INTERNAL int validate_sdo_tree_meta(const skidTreeMeta *changes);
+
+/*
+ *  Description:
+ *      The post-order DirVisitor destroy_dir() and destroy_dir_parallel() use to remove each
+ *      directory, relative to its parent's file descriptor, once its contents have been deleted.
+ *
+ *  Args:
+ *      entry: The (now empty) directory to remove.
+ *      context: A skidDestroyVisit pointer.  Its result is set on error.
+ *
+ *  Returns:
+ *      SKID_WALK_CONTINUE on success, SKID_WALK_STOP on error.
+ */
+SKID_INTERNAL skidWalkAction visit_destroy_dir(const skidDirEntry *entry, void *context);
+
+/*
+ *  Description:
+ *      The DirVisitor destroy_dir() and destroy_dir_parallel() use to unlink every entry,
+ *      relative to its parent's file descriptor, that isn't a directory.  Symbolic links are
+ *      removed, not followed.
+ *
+ *  Args:
+ *      entry: The entry to unlink.
+ *      context: A skidDestroyVisit pointer.  Its result is set on error.
+ *
+ *  Returns:
+ *      SKID_WALK_CONTINUE on success, SKID_WALK_STOP on error.
+ */
+SKID_INTERNAL skidWalkAction visit_destroy_entry(const skidDirEntry *entry, void *context);
+
+/*
+ *  Description:
+ *      The DirVisitor read_dir_listing() uses to append each entry's path to a listing.
+ *
+ *  Args:
+ *      entry: The entry to append.
+ *      context: A skidListingVisit pointer.  Its result is set on error.
+ *
+ *  Returns:
+ *      SKID_WALK_CONTINUE on success, SKID_WALK_STOP on error.
+ */
+SKID_INTERNAL skidWalkAction visit_listing_entry(const skidDirEntry *entry, void *context);
+
+/*
+ *  Description:
+ *      The post-order DirVisitor set_tree_meta() uses to finish each directory, relative to its
+ *      parent's file descriptor, once its contents have been read.
+ *
+ *  Args:
+ *      entry: The directory to change.
+ *      context: A skidTreeMetaVisit pointer.  Its result is set on error.
+ *
+ *  Returns:
+ *      SKID_WALK_CONTINUE.  One entry's error doesn't stop the rest of the tree from changing.
+ */
+SKID_INTERNAL skidWalkAction visit_tree_meta_dir(const skidDirEntry *entry, void *context);
+
+/*
+ *  Description:
+ *      The DirVisitor set_tree_meta() uses to change every entry, relative to its parent's file
+ *      descriptor.  Directories are changed before they're read, all but turning off the
+ *      SKID_TREE_WALK_BITS, and finished by visit_tree_meta_dir().
+ *
+ *  Args:
+ *      entry: The entry to change.
+ *      context: A skidTreeMetaVisit pointer.  Its result is set on error.
+ *
+ *  Returns:
+ *      SKID_WALK_CONTINUE.  One entry's error doesn't stop the rest of the tree from changing.
+ */
+SKID_INTERNAL skidWalkAction visit_tree_meta_entry(const skidDirEntry *entry, void *context);
+
+/*
+ *  Description:
+ *      Block an idle walk_dir_parallel() worker until a task is queued, every task is done, or
+ *      the walk is stopped.
+ *
+ *  Args:
+ *      walk: [In/Out] The state shared by every worker.
+ */
+SKID_INTERNAL void wait_sdo_work(skidParallelWalk_ptr walk);
+
+/*
+ *  Description:
+ *      Underpins run_sdo_walk().  Visits the contents of the directory in walk's path_buff,
+ *      recursing into sub-directories unless pruned or too deep.  Each directory is opened with
+ *      openat() relative to its parent's file descriptor, and handed to the visitors along with
+ *      each entry, so the kernel never re-resolves the full path.  Each entry's path is still
+ *      built in place at the end of path_buff, for the visitors, and truncated afterwards.
+ *
+ *  Args:
+ *      walk: [In/Out] The state of the walk.  The contents of path_buff beyond path_len are
+ *          scratch space.
+ *      parent_fd: The directory dirname is relative to, or AT_FDCWD for the top of the walk.
+ *      dirname: The directory to open, relative to parent_fd.  Sub-directories are opened
+ *          with O_NOFOLLOW.
+ *      path_len: The length of the directory's full path in walk's path_buff.
+ *      depth: The depth of this directory's entries.
+ *
+ *  Returns:
+ *      ENOERR on success (or a stopped walk), errno on error.  ENAMETOOLONG if a path would
+ *      exceed PATH_MAX.
+ */
+SKID_INTERNAL int walk_sdo_dir(skidDirWalk_ptr walk, int parent_fd, const char *dirname,
+                               size_t path_len, size_t depth);
+
 
 /**************************************************************************************************/
 /********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
@@ -246,90 +628,101 @@ int delete_dir(const char *dirname)
 
 int destroy_dir(const char *dirname)
 {
-    // From readdir(3)
-    // Only  the fields d_name and (as an XSI extension) d_ino are specified in POSIX.1.
-    // Other than Linux, the d_type field is available mainly only on BSD systems.
-    // The remaining fields are available on many, but not all systems.  Under glibc, programs
-    // can check for the availability of the fields not defined in POSIX.1 by testing whether
-    // the macros _DIRENT_HAVE_D_NAMLEN, _DIRENT_HAVE_D_RECLEN, _DIRENT_HAVE_D_OFF, or
-    // _DIRENT_HAVE_D_TYPE are defined.
-
     // LOCAL VARIABLES
-    int result = ENOERR;         // Results of execution
-    char **dir_contents = NULL;  // Array of string pointers containing dirname's paths
-    size_t capacity = 0;         // Size of dir_contents
-    size_t num_paths = 0;        // Number of paths contained in dirname
-    char *tmp_path = NULL;       // Temp pathname to manage
+    int result = ENOERR;                            // Results of execution
+    skidDestroyVisit visit = { .progress = NULL };  // The first deletion error
+    skidDirWalk walk = { .visitor = visit_destroy_entry, .post_visitor = visit_destroy_dir,
+                         .context = &visit };  // Deletes everything it visits
 
     // INPUT VALIDATION
     result = validate_sdo_pathname(dirname);
 
     // DESTROY IT
-    // Get the full list
+    // Delete the contents, relative to their parent directory's file descriptor, leaf first
     if (ENOERR == result)
     {
-        dir_contents = read_dir_contents(dirname, true, &result, &capacity);
-        if (ENOERR != result)
+        atomic_init(&(visit.result), ENOERR);
+        result = run_sdo_walk(&walk, dirname);
+        if (ENOERR == result)
         {
-            PRINT_ERROR(The call to read_dir_contents() failed);
-            PRINT_ERRNO(result);
+            result = atomic_load(&(visit.result));
         }
     }
-    // Size it
+    // Finally, remove the original dir
     if (ENOERR == result)
     {
-        num_paths = count_content_arr_entries(dir_contents, &capacity);
+        result = delete_dir(dirname);
     }
-    // Destroy it (backwards)
+
+    // DONE
+    return result;
+}
+
+
+int destroy_dir_parallel(const char *dirname, unsigned int num_threads,
+                         skidDestroyProgress_ptr progress)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                                // Results of execution
+    skidDestroyVisit visit = { .progress = progress };  // Error and progress of the deletion
+    skidParallelWalk walk = { .visitor = visit_destroy_entry, .post_visitor = visit_destroy_dir,
+                              .context = &visit };  // Deletes everything it visits
+
+    // INPUT VALIDATION
+    result = validate_sdo_pathname(dirname);
+
+    // DESTROY IT
+    // Files first, as each directory is read, then each directory once its contents are gone
     if (ENOERR == result)
     {
-        while (num_paths > 0)
+        atomic_init(&(visit.result), ENOERR);
+        result = run_sdo_parallel(&walk, dirname, num_threads);
+        if (ENOERR == result)
         {
-            tmp_path = dir_contents[num_paths - 1];  // Start at the end
-            if (tmp_path)
-            {
-                if (true == is_regular_file(tmp_path, &result))
-                {
-                    result = delete_file(tmp_path);
-                }
-                else if (true == is_directory(tmp_path, &result))
-                {
-                    result = delete_dir(tmp_path);
-                }
-                else
-                {
-                    if (ENOERR == result)
-                    {
-                        PRINT_WARNG(Detected an unsupported path type);
-                        FPRINTF_ERR("%s - %s is unsupported\n", DEBUG_WARNG_STR, tmp_path);
-                    }
-                    else
-                    {
-                        PRINT_ERROR(Encountered a deletion error);
-                        PRINT_ERRNO(result);
-                        FPRINTF_ERR("%s - Attempting to delete '%s'\n", DEBUG_ERROR_STR, tmp_path);
-                        break;  // Let's stop since the rest will likely  error as well
-                    }
-                }
-            }
-            else
-            {
-                PRINT_WARNG(The array count appears to have been off);
-                break;  // Found a NULL so we'll stop iterating
-            }
-            num_paths--;
+            result = atomic_load(&(visit.result));
         }
     }
     // Finally, remove the original dir
     if (ENOERR == result)
     {
         result = delete_dir(dirname);
+        if (ENOERR == result && progress)
+        {
+            atomic_fetch_add(&(progress->dirs_deleted), 1);
+        }
     }
 
-    // CLEANUP
-    if (dir_contents)
+    // DONE
+    return result;
+}
+
+
+int free_dir_listing(skidDirListing_ptr listing)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno value
+
+    // INPUT VALIDATION
+    if (!listing)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // FREE IT
+    if (ENOERR == result)
     {
-        free_skid_dir_contents(&dir_contents);  // Best effort
+        if (listing->arena)
+        {
+            free_skid_mem((void **)&(listing->arena));
+        }
+        if (listing->offsets)
+        {
+            free_skid_mem((void **)&(listing->offsets));
+        }
+        listing->arena_len = 0;
+        listing->arena_size = 0;
+        listing->count = 0;
+        listing->capacity = 0;
     }
 
     // DONE
@@ -371,11 +764,29 @@ int free_skid_dir_contents(char ***dir_contents)
 }
 
 
+const char *get_dir_listing_path(const skidDirListing *listing, size_t index)
+{
+    // LOCAL VARIABLES
+    const char *path = NULL;  // Pointer into the listing's arena
+
+    // INPUT VALIDATION
+    if (listing && listing->arena && listing->offsets && index < listing->count)
+    {
+        path = listing->arena + listing->offsets[index];
+    }
+
+    // DONE
+    return path;
+}
+
+
 char **read_dir_contents(const char *dirname, bool recurse, int *errnum, size_t *capacity)
 {
     // LOCAL VARIABLES
     char **content_arr = NULL;                    // NULL-terminated array of nul-terminated strs
     int result = validate_sdo_pathname(dirname);  // Capture errno values here
+    skidDirListing listing = { 0 };               // All of dirname's paths, in one arena
+    size_t i = 0;                                 // Iterating variable
 
     // INPUT VALIDATION
     if (ENOERR == result)
@@ -388,18 +799,42 @@ char **read_dir_contents(const char *dirname, bool recurse, int *errnum, size_t
         {
             result = EINVAL;  // NULL pointer
         }
+        else
+        {
+            *capacity = 0;  // Nothing allocated yet
+        }
     }
 
     // READ IT
     if (ENOERR == result)
     {
-        content_arr = recurse_dir_contents(content_arr, capacity, dirname, recurse, &result);
+        result = read_dir_listing(dirname, recurse, &listing);
         if (ENOERR != result)
         {
-            PRINT_ERROR(The intial call to recurse_dir_contents() failed);
+            PRINT_ERROR(The call to read_dir_listing() failed);
             PRINT_ERRNO(result);
         }
     }
+    // Copy it (callers are allowed to free each string individually)
+    if (ENOERR == result && listing.count > 0)
+    {
+        content_arr = alloc_skid_mem(listing.count + 1, sizeof(char *), &result);
+        for (i = 0; ENOERR == result && i < listing.count; i++)
+        {
+            content_arr[i] = copy_skid_string(get_dir_listing_path(&listing, i), &result);
+        }
+        if (ENOERR == result)
+        {
+            *capacity = listing.count + 1;
+        }
+        else
+        {
+            free_skid_dir_contents(&content_arr);  // Best effort
+        }
+    }
+
+    // CLEANUP
+    free_dir_listing(&listing);  // Best effort
 
     // DONE
     if (errnum)
@@ -410,404 +845,399 @@ char **read_dir_contents(const char *dirname, bool recurse, int *errnum, size_t
 }
 
 
-/**************************************************************************************************/
-/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
-/**************************************************************************************************/
-
-
-SKID_INTERNAL size_t count_content_arr_entries(char **content_arr, size_t *capacity)
+char **read_dir_contents_arena(skidArena_ptr arena, const char *dirname, bool recurse,
+                               int *errnum, size_t *capacity)
 {
     // LOCAL VARIABLES
-    size_t count = 0;              // Number of non-NULL entries in content_arr.
-    size_t curr_capacity = 0;      // Current capacity
+    char **content_arr = NULL;       // NULL-terminated array of nul-terminated strs
+    char *paths = NULL;              // Arena copy of the listing's paths
+    int result = ENOERR;             // Capture errno values here
+    skidDirListing listing = { 0 };  // All of dirname's paths, in one heap allocation
+    size_t i = 0;                    // Iterating variable
 
     // INPUT VALIDATION
-    if (content_arr && capacity)
+    if (NULL == arena)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        result = validate_skid_err(errnum);
+    }
+    if (ENOERR == result)
     {
-        curr_capacity = *capacity;
-        for (size_t i = 0; i < curr_capacity; i++)
+        if (!capacity)
         {
-            if (NULL == content_arr[i])
-            {
-                break;  // Found a NULL
-            }
-            else
-            {
-                count++;  // Found a pointer
-            }
+            result = EINVAL;  // NULL pointer
+        }
+        else
+        {
+            *capacity = 0;  // Nothing allocated yet
         }
     }
 
+    // READ IT
+    if (ENOERR == result)
+    {
+        result = read_dir_listing(dirname, recurse, &listing);  // Also validates dirname
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to read_dir_listing() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Copy it
+    if (ENOERR == result && listing.count > 0)
+    {
+        content_arr = alloc_skid_arena(arena, listing.count + 1, sizeof(char *), &result);
+        if (ENOERR == result)
+        {
+            paths = alloc_skid_arena(arena, listing.arena_len, sizeof(char), &result);
+        }
+        if (ENOERR == result)
+        {
+            memcpy(paths, listing.arena, listing.arena_len);
+            for (i = 0; i < listing.count; i++)
+            {
+                content_arr[i] = paths + listing.offsets[i];
+            }
+            *capacity = listing.count + 1;
+        }
+        else
+        {
+            content_arr = NULL;  // The arena keeps the array until it's cleared
+        }
+    }
+
+    // CLEANUP
+    free_dir_listing(&listing);  // Best effort
+
     // DONE
-    return count;
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return content_arr;
 }
 
 
-SKID_INTERNAL bool is_dirent_a_dir(struct dirent *direntp)
+int read_dir_listing(const char *dirname, bool recurse, skidDirListing_ptr listing)
 {
     // LOCAL VARIABLES
-    bool is_dir = false;  // Does direntp represent a directory?
+    int result = validate_sdo_pathname(dirname);  // Capture errno values here
+    skidListingVisit visit = { .listing = listing, .result = ENOERR };
+    size_t orig_count = 0;                        // Number of paths in listing on entry
+    size_t orig_len = 0;                          // Number of arena bytes in use on entry
 
     // INPUT VALIDATION
-    if (direntp)
+    if (ENOERR == result && !listing)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // READ IT
+    if (ENOERR == result)
     {
-        if (DT_DIR == direntp->d_type)
+        orig_count = listing->count;
+        orig_len = listing->arena_len;
+        result = walk_dir(dirname, recurse ? 0 : 1, visit_listing_entry, &visit);
+        if (ENOERR == result)
+        {
+            result = visit.result;  // The visitor may have stopped the walk
+        }
+        if (ENOERR != result)
         {
-            is_dir = true;
+            // Forget the partial results
+            listing->count = orig_count;
+            listing->arena_len = orig_len;
         }
     }
 
     // DONE
-    return is_dir;
+    return result;
 }
 
 
-SKID_INTERNAL char *join_dir_path(const char *dirname, const char *path, int *errnum)
+int set_tree_meta(const char *dirname, const skidTreeMeta *changes, unsigned int num_threads,
+                  skidTreeMetaProgress_ptr progress)
 {
     // LOCAL VARIABLES
-    char work_buff[PATH_MAX + 3] = { 0 };  // Working array
-    char *new_buff = NULL;                 // Heap-allocated copy of work_buff
-    int result = ENOERR;                   // Errno values
+    int result = ENOERR;    // Results of execution
+    int walk_err = ENOERR;  // The first directory that couldn't be read
+    int last_err = ENOERR;  // The results of finishing dirname
+    // The changes to make, the first error, and the progress
+    skidTreeMetaVisit visit = { .changes = changes, .progress = progress };
+    // Changes everything it visits, reading every directory it can
+    skidParallelWalk walk = { .visitor = visit_tree_meta_entry, .post_visitor = visit_tree_meta_dir,
+                              .context = &visit, .keep_going = true };
 
     // INPUT VALIDATION
-    // dirname
     result = validate_sdo_pathname(dirname);
-    // path
-    if (ENOERR == result)
-    {
-        result = validate_sdo_pathname(path);
-    }
-    // errnum
     if (ENOERR == result)
     {
-        result = validate_skid_err(errnum);
+        result = validate_sdo_tree_meta(changes);
     }
 
-    // JOIN IT
-    // Copy dirname in
+    // CHANGE IT
+    // First, the original dir (following it, like the walk does)
     if (ENOERR == result)
     {
-        strncpy(work_buff, dirname, strlen(dirname) + 1);
+        atomic_init(&(visit.result), ENOERR);
+        result = apply_sdo_meta(&visit, AT_FDCWD, dirname, 0, SKID_TREE_PRE);
     }
-    // Add delimiter?
+    // Then everything beneath it, each directory before and after its contents
     if (ENOERR == result)
     {
-        if ('/' != work_buff[strlen(work_buff)-1] && '/' != path[0])
+        walk_err = run_sdo_parallel(&walk, dirname, num_threads);
+        last_err = apply_sdo_meta(&visit, AT_FDCWD, dirname, 0, SKID_TREE_POST);
+        result = atomic_load(&(visit.result));
+        if (ENOERR == result)
         {
-            work_buff[strlen(work_buff)] = '/';
+            result = (ENOERR != walk_err) ? walk_err : last_err;
         }
     }
-    // Concatenate path
-    if (ENOERR == result)
+
+    // DONE
+    return result;
+}
+
+
+int walk_dir(const char *dirname, size_t max_depth, DirVisitor visitor, void *context)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Capture errno values here
+    skidDirWalk walk = { .visitor = visitor, .context = context, .max_depth = max_depth };
+
+    // INPUT VALIDATION
+    if (!visitor)
     {
-        strncat(work_buff, path, (sizeof(work_buff)/sizeof(*work_buff)) - strlen(work_buff));
+        result = EINVAL;  // NULL pointer
     }
-    // Allocate and copy
+
+    // WALK IT
     if (ENOERR == result)
     {
-        new_buff = copy_skid_string(work_buff, &result);
+        result = run_sdo_walk(&walk, dirname);
     }
 
     // DONE
-    if (errnum)
+    return result;
+}
+
+
+int walk_dir_parallel(const char *dirname, size_t max_depth, unsigned int num_threads,
+                      DirVisitor visitor, void *context)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Capture errno values here
+    skidParallelWalk walk = { .visitor = visitor, .context = context, .max_depth = max_depth };
+
+    // INPUT VALIDATION
+    if (!visitor)
     {
-        *errnum = result;
+        result = EINVAL;  // NULL pointer
+    }
+
+    // WALK IT
+    if (ENOERR == result)
+    {
+        result = run_sdo_parallel(&walk, dirname, num_threads);
     }
-    return new_buff;
+
+    // DONE
+    return result;
 }
 
 
-SKID_INTERNAL char **realloc_dir_contents(char **content_arr, size_t *capacity, int *errnum)
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL int add_listing_path(skidDirListing_ptr listing, const char *path, size_t path_len)
 {
     // LOCAL VARIABLES
-    int result = validate_skid_err(errnum);  // Errno value
-    char **new_array = NULL;                 // Newly allocated array
-    char **old_array = content_arr;          // Old array
-    size_t new_size = 0;                     // Size of the new array
-    size_t curr_capacity = 0;                // Current capacity
+    int result = ENOERR;         // Errno value
+    size_t new_size = 0;         // New size of the arena or offset array
+    char *new_arena = NULL;      // Reallocated arena
+    size_t *new_offsets = NULL;  // Reallocated offset array
 
     // INPUT VALIDATION
-    if (ENOERR == result)
+    if (!listing || !path)
     {
-        if (!capacity)
-        {
-            result = EINVAL;  // NULL pointer
-        }
-        else
-        {
-            curr_capacity = *capacity;
-        }
+        result = EINVAL;  // NULL pointer
+    }
+    else if (path_len >= (SIZE_MAX - listing->arena_len))
+    {
+        result = EOVERFLOW;  // The arena can't grow that large
     }
 
-    // REALLOC IT
-    // Size it
-    if (ENOERR == result)
+    // GROW IT
+    // Arena
+    if (ENOERR == result && (listing->arena_len + path_len + 1) > listing->arena_size)
     {
-        if (NULL == old_array || 0 == curr_capacity)
-        {
-            new_size = SKID_ARRAY_SIZE;  // Starting size
-        }
-        // Verify it's not already maxxed out
-        else if (SIZE_MAX == curr_capacity)
-        {
-            result = ENOMEM;  // Already at the max
-        }
-        // Check for overflow
-        else if (curr_capacity > (SIZE_MAX - curr_capacity))
+        new_size = listing->arena_size ? listing->arena_size : SKID_LISTING_ARENA_SIZE;
+        while (new_size < (listing->arena_len + path_len + 1) && new_size <= (SIZE_MAX / 2))
         {
-            new_size = SIZE_MAX;  // This is as big as it gets
+            new_size *= 2;
         }
-        // Double it
-        else
+        new_arena = realloc_skid_mem(listing->arena, new_size, sizeof(char), &result);
+        if (ENOERR == result)
         {
-            new_size = curr_capacity * 2;
+            listing->arena = new_arena;
+            listing->arena_size = new_size;
         }
     }
-    // Allocate a larger array
-    if (ENOERR == result)
-    {
-        new_array = alloc_skid_mem(new_size, sizeof(char*), &result);
-    }
-    // Copy the pointers in
-    if (ENOERR == result && old_array)
+    // Offsets
+    if (ENOERR == result && listing->count >= listing->capacity)
     {
-        for (size_t i = 0; i < curr_capacity; i++)
+        new_size = listing->capacity ? listing->capacity * 2 : SKID_ARRAY_SIZE;
+        new_offsets = realloc_skid_mem(listing->offsets, new_size, sizeof(size_t), &result);
+        if (ENOERR == result)
         {
-            if (old_array[i])
-            {
-                new_array[i] = old_array[i];
-            }
-            else
-            {
-                break;  // Stop copying at the first NULL
-            }
+            listing->offsets = new_offsets;
+            listing->capacity = new_size;
         }
     }
 
-    // WRAP UP
-    // One of the arrays has to go
+    // STORE IT
     if (ENOERR == result)
     {
-        free_skid_mem((void **)&old_array);  // Free the original array
-        *capacity = new_size;  // Update the capacity
-    }
-    else
-    {
-        // Free the new array
-        free_skid_mem((void **)&new_array);  // Best effort
-        // Restore the old capacity
-        if (capacity)
-        {
-            *capacity = curr_capacity;
-        }
-        new_array = old_array;  // Return the old array
+        memcpy(listing->arena + listing->arena_len, path, path_len);
+        listing->arena[listing->arena_len + path_len] = '\0';
+        listing->offsets[listing->count] = listing->arena_len;
+        listing->arena_len += path_len + 1;
+        listing->count++;
     }
 
     // DONE
-    if (errnum)
-    {
-        *errnum = result;
-    }
-    return new_array;
+    return result;
 }
 
 
-SKID_INTERNAL char **recurse_dir_contents(char **content_arr, size_t *capacity, const char *dirname,
-                                          bool recurse, int *errnum)
+SKID_INTERNAL int apply_sdo_meta(skidTreeMetaVisit_ptr visit, int dir_fd, const char *name,
+                                 int at_flags, int stage)
 {
     // LOCAL VARIABLES
-    char **curr_arr = content_arr;      // Current content array
-    int result = ENOERR;                // Errno value
-    DIR *dirp = NULL;                   // Directory stream pointer
-    struct dirent *temp_dirent = NULL;  // Temporary dirent struct pointer
-    size_t curr_count = 0;              // Current count of content_arr entries
-
-    // INPUT VALIDATION
-    result = validate_rdc_args(content_arr, capacity, dirname, recurse, errnum);
+    int result = ENOERR;                           // Results of execution
+    const skidTreeMeta *changes = visit->changes;  // The changes to make
+    struct stat statbuf;                           // The entry's current metadata
+    mode_t old_mode = 0;                           // The entry's current permissions
+    mode_t new_mode = 0;                           // The entry's target permissions
+    mode_t deferred = 0;                           // Walk bits to turn off after the contents
+    bool changed = false;                          // True if anything was written
+    bool mode_stale = false;                       // True if chown() may have changed the mode
+    struct timespec times[2];                      // The access and modification times to set
+
+    // CHECK IT
+    if (fstatat(dir_fd, name, &statbuf, at_flags))
+    {
+        result = errno;
+        PRINT_ERROR(The call to fstatat() failed);
+        PRINT_ERRNO(result);
+    }
+    else if (visit->progress && SKID_TREE_POST != stage)
+    {
+        atomic_fetch_add_explicit(&(visit->progress->entries_checked), 1, memory_order_relaxed);
+    }
 
-    // RECURSION FTW!
-    // Open the directory
-    if (ENOERR == result)
+    // OWNERSHIP
+    if (ENOERR == result && (((uid_t)-1 != changes->owner && changes->owner != statbuf.st_uid)
+                             || ((gid_t)-1 != changes->group && changes->group != statbuf.st_gid)))
     {
-        dirp = opendir(dirname);
-        if (NULL == dirp)
+        if (fchownat(dir_fd, name, changes->owner, changes->group, at_flags))
         {
             result = errno;
-            PRINT_ERROR(The call to opendir() failed);
+            PRINT_ERROR(The call to fchownat() failed);
             PRINT_ERRNO(result);
         }
+        else
+        {
+            changed = true;
+            mode_stale = statbuf.st_mode & (S_ISUID | S_ISGID);
+        }
     }
-    // Read the directory
-    if (ENOERR == result)
+
+    // PERMISSIONS
+    // Symbolic links don't have permissions of their own
+    if (ENOERR == result && !S_ISLNK(statbuf.st_mode))
     {
-        while (1)
+        old_mode = statbuf.st_mode & SKID_TREE_MODE_BITS;
+        new_mode = old_mode;
+        if (true == changes->set_mode)
+        {
+            new_mode = S_ISDIR(statbuf.st_mode) ? changes->dir_mode : changes->file_mode;
+        }
+        new_mode = (new_mode & ~(changes->remove_mode)) | changes->add_mode;
+        if (SKID_TREE_PRE == stage)
         {
-            // To distinguish end of stream from an error, set errno to zero before calling
-            // readdir() and then check the value of errno if NULL is returned.
-            errno = ENOERR;  // Clear errno... see: readdir(3)
-            temp_dirent = readdir(dirp);
-            if (NULL == temp_dirent)
+            // Keep the walk's way in until the contents are done
+            deferred = old_mode & SKID_TREE_WALK_BITS & ~new_mode;
+            new_mode |= deferred;
+        }
+        if (true == mode_stale || new_mode != old_mode)
+        {
+            if (fchmodat(dir_fd, name, new_mode, 0))
             {
                 result = errno;
-                if (ENOERR != result)
-                {
-                    PRINT_ERROR(The call to readdir() failed);
-                    PRINT_ERRNO(result);
-                }
-                else
-                {
-                    break;  // The end of the directory stream has been reached
-                }
+                PRINT_ERROR(The call to fchmodat() failed);
+                PRINT_ERRNO(result);
             }
             else
             {
-                // Store it
-                curr_arr = store_dirent(curr_arr, capacity, dirname, temp_dirent, &result);
-                if (ENOERR != result)
-                {
-                    PRINT_ERROR(The call to store_dirent() failed);
-                    PRINT_ERRNO(result);
-                    break;
-                }
-                // Should we recurse on this valid directory?
-                if (true == recurse && validate_direntp(temp_dirent) \
-                    && true == is_dirent_a_dir(temp_dirent))
-                {
-                    // Recurse!
-                    curr_count = count_content_arr_entries(curr_arr, capacity);
-                    if (curr_count >= 1)
-                    {
-                        curr_arr = recurse_dir_contents(curr_arr, capacity, curr_arr[curr_count-1],
-                                                        recurse, &result);
-                    }
-                    else
-                    {
-                        PRINT_ERROR(Detected failed recursion in recurse_dir_contents());
-                    }
-                }
+                changed = true;
             }
         }
     }
 
-    // CLEANUP
-    // Close the directory stream pointer
-    if (dirp)
+    // TIMESTAMPS
+    if (ENOERR == result && (true == needs_sdo_time(&(changes->atime), &(statbuf.st_atim))
+                             || true == needs_sdo_time(&(changes->mtime), &(statbuf.st_mtim))))
     {
-        if (closedir(dirp))
+        times[0] = changes->atime;
+        times[1] = changes->mtime;
+        if (utimensat(dir_fd, name, times, at_flags))
         {
-            if (ENOERR == result)
-            {
-                result = errno;
-                PRINT_ERROR(The call to closedir() failed);
-                PRINT_ERRNO(result);
-            }
+            result = errno;
+            PRINT_ERROR(The call to utimensat() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            changed = true;
         }
     }
-    // Free any existing array on an error
-    if (ENOERR != result)
+
+    // PROGRESS
+    if ((true == changed || 0 != deferred) && visit->progress && SKID_TREE_POST != stage)
     {
-        free_skid_dir_contents(&curr_arr);  // Best effort
+        atomic_fetch_add_explicit(&(visit->progress->entries_changed), 1, memory_order_relaxed);
     }
 
     // DONE
-    if (errnum)
-    {
-        *errnum = result;
-    }
-    return curr_arr;
+    return result;
 }
 
 
-SKID_INTERNAL char **store_dirent(char **content_arr, size_t *capacity, const char *dirname,
-                                  struct dirent *direntp, int *errnum)
+SKID_INTERNAL skidWalkNode_ptr create_sdo_node(skidWalkNode_ptr parent, size_t name_off,
+                                               size_t depth, int *errnum)
 {
     // LOCAL VARIABLES
-    char **curr_arr = content_arr;  // Current content array
     int result = ENOERR;            // Errno value
-    int num_loops = 0;              // Maximum number of loops before direntp is stored
-    size_t curr_capacity = 0;       // Current capacity
-    size_t num_entries = 0;         // Number of entries already in content_arr
+    skidWalkNode_ptr node = NULL;   // The new node
 
-    // INPUT VALIDATION
-    if (!capacity || !errnum)
-    {
-        result = EINVAL;  // Bad input
-    }
-    // STORE IT
-    else if (direntp)
+    // ALLOCATE IT
+    node = alloc_skid_mem(1, sizeof(skidWalkNode), &result);
+    if (ENOERR == result)
     {
-        if (true == validate_direntp(direntp))
+        atomic_init(&(node->refs), 1);  // Until it's been read
+        node->parent = parent;
+        node->name_off = name_off;
+        node->depth = depth;
+        node->dir_fd = SKID_BAD_FD;
+        if (parent)
         {
-            while (num_loops <= SKID_MAX_RETRIES)
-            {
-                // Gotta store this dirent
-                // 1. Is there are an array?
-                if (curr_arr)
-                {
-                    curr_capacity = *capacity;  // Get the current capacity
-                    // 2. If so, is there space?
-                    num_entries = count_content_arr_entries(curr_arr, capacity);
-                    if (num_entries < (curr_capacity - 1))
-                    {
-                        // 3. Allocate, copy, and store it
-                        if (ENOERR == validate_sdo_pathname(dirname))
-                        {
-                            curr_arr[num_entries] = join_dir_path(dirname, direntp->d_name,
-                                                                  &result);
-                        }
-                        else
-                        {
-                            curr_arr[num_entries] = copy_skid_string(direntp->d_name, &result);
-                        }
-                        // 4. Verify
-                        if (ENOERR != result)
-                        {
-                            PRINT_ERROR(The direntp->d_name copy operation failed);
-                            PRINT_ERRNO(result);
-                            break;  // The copy failed
-                        }
-                        else
-                        {
-                            break;  // We stored it.  Done.
-                        }
-                    }
-                    // Then make a bigger one
-                    else
-                    {
-
-                        curr_arr = realloc_dir_contents(curr_arr, capacity, &result);
-                        if (ENOERR != result)
-                        {
-                            PRINT_ERROR(The call to realloc_dir_contents() failed);
-                            PRINT_ERRNO(result);
-                            break;  // The reallocation failed
-                        }
-                        else
-                        {
-                            FPRINTF_ERR("%s - %s - %s() - %d - resized the dir contents array!\n",
-                                        DEBUG_INFO_STR, __FILE__, __FUNCTION_NAME__, __LINE__);
-                        }
-                    }
-                }
-                // Then make one
-                else
-                {
-                    curr_arr = realloc_dir_contents(curr_arr, capacity, &result);
-                    if (ENOERR != result)
-                    {
-                        PRINT_ERROR(The initial call to realloc_dir_contents() failed?);
-                        PRINT_ERRNO(result);
-                        break;  // The reallocation failed
-                    }
-                }
-
-                num_loops++;  // One loop completed without success
-            }
-            // Verify we did something
-            if (ENOERR == result && num_loops > SKID_MAX_RETRIES)
-            {
-                result = -1;  // It appears we exceeded the max loops without succeeding or failing
-            }
+            atomic_fetch_add(&(parent->refs), 1);  // Until this one is done
         }
     }
 
@@ -816,67 +1246,1068 @@ SKID_INTERNAL char **store_dirent(char **content_arr, size_t *capacity, const ch
     {
         *errnum = result;
     }
-    return curr_arr;
+    return node;
+}
+
+
+SKID_INTERNAL void free_sdo_task(skidParallelWalk_ptr walk, skidWalkTask_ptr task,
+                                 unsigned int worker)
+{
+    if (task)
+    {
+        if (task->path)
+        {
+            free_skid_mem((void **)&(task->path));  // Best effort
+        }
+        if (SKID_BAD_FD != task->dir_fd)
+        {
+            close_fd(&(task->dir_fd), true);  // Best effort
+        }
+        if (task->node)
+        {
+            release_sdo_node(walk, task->node, worker);
+            task->node = NULL;
+        }
+    }
 }
 
 
-SKID_INTERNAL bool validate_direntp(struct dirent *direntp)
+SKID_INTERNAL unsigned char get_dirent_type(int dir_fd, skidDirent64_ptr direntp)
 {
     // LOCAL VARIABLES
-    bool is_valid = true;  // Is direntp valid?
+    unsigned char d_type = DT_UNKNOWN;  // The file type direntp represents
+    struct stat entry_stat;             // Metadata for filesystems that don't report d_type
 
     // INPUT VALIDATION
-    if (!direntp)
-    {
-        is_valid = false;  // NULL pointer
-    }
-    else if (0 >= strlen(direntp->d_name))
+    if (direntp)
     {
-        is_valid = false;  // Empty string
+        d_type = direntp->d_type;
+        if (DT_UNKNOWN == d_type)
+        {
+            if (0 == fstatat(dir_fd, direntp->d_name, &entry_stat, AT_SYMLINK_NOFOLLOW))
+            {
+                d_type = IFTODT(entry_stat.st_mode);
+            }
+        }
     }
-    else if (!strcmp(".", direntp->d_name))
+
+    // DONE
+    return d_type;
+}
+
+
+SKID_INTERNAL bool needs_sdo_time(const struct timespec *want, const struct timespec *have)
+{
+    // LOCAL VARIABLES
+    bool needed = false;  // True if want needs to be written
+
+    // CHECK IT
+    if (UTIME_NOW == want->tv_nsec)
     {
-        is_valid = false;  // We will not store this
+        needed = true;  // "Now" never matches
     }
-    else if (!strcmp("..", direntp->d_name))
+    else if (UTIME_OMIT != want->tv_nsec)
     {
-        is_valid = false;  // We will not store this either
+        needed = want->tv_sec != have->tv_sec || want->tv_nsec != have->tv_nsec;
     }
 
     // DONE
-    return is_valid;
+    return needed;
 }
 
 
-SKID_INTERNAL int validate_rdc_args(char **content_arr, size_t *capacity, const char *dirname,
-                                    bool recurse, int *errnum)
+SKID_INTERNAL bool pop_sdo_task(skidParallelWalk_ptr walk, unsigned int index,
+                                skidWalkTask_ptr task)
 {
     // LOCAL VARIABLES
-    int result = validate_sdo_pathname(dirname);  // The results of validation
-
-    // INPUT VALIDATION
-    // Skipping content_arr
-    // capacity
-    if (ENOERR == result)
+    bool found = false;              // Was a task found?
+    skidWalkDeque_ptr deque = NULL;  // The deque being checked
+    unsigned int i = 0;              // Iterating variable
+
+    // POP IT
+    // Take the newest task from our own deque
+    deque = walk->deques + index;
+    pthread_mutex_lock(&(deque->lock));
+    if (deque->bottom > deque->top)
     {
-        if (!capacity)
+        deque->bottom--;
+        *task = deque->tasks[deque->bottom];
+        found = true;
+    }
+    pthread_mutex_unlock(&(deque->lock));
+    // Otherwise, steal the oldest task from someone else's
+    for (i = 1; false == found && i < walk->num_workers; i++)
+    {
+        deque = walk->deques + ((index + i) % walk->num_workers);
+        pthread_mutex_lock(&(deque->lock));
+        if (deque->bottom > deque->top)
         {
-            result = EINVAL;  // NULL pointer
+            *task = deque->tasks[deque->top];
+            deque->top++;
+            found = true;
         }
+        pthread_mutex_unlock(&(deque->lock));
     }
-    // dirname already validated
-    // errnum
-    if (ENOERR == result)
+    if (true == found)
     {
-        result = validate_skid_err(errnum);
+        atomic_fetch_sub(&(walk->queued), 1);
     }
 
     // DONE
-    return result;
+    return found;
 }
 
 
-SKID_INTERNAL int validate_sdo_pathname(const char *pathname)
+SKID_INTERNAL int push_sdo_task(skidParallelWalk_ptr walk, unsigned int index,
+                                skidWalkTask_ptr task)
 {
-    return validate_skid_pathname(pathname, false);  // Refactored for backwards compatibility
+    // LOCAL VARIABLES
+    int result = ENOERR;                             // Errno value
+    skidWalkDeque_ptr deque = walk->deques + index;  // Our own deque
+    skidWalkTask_ptr new_tasks = NULL;               // Reallocated task array
+    size_t new_size = 0;                             // New capacity of the task array
+
+    // PUSH IT
+    pthread_mutex_lock(&(deque->lock));
+    // Make room
+    if (deque->bottom == deque->capacity)
+    {
+        if (deque->top > 0)
+        {
+            // Reclaim the space stolen tasks left behind
+            memmove(deque->tasks, deque->tasks + deque->top,
+                    (deque->bottom - deque->top) * sizeof(skidWalkTask));
+            deque->bottom -= deque->top;
+            deque->top = 0;
+        }
+        else
+        {
+            new_size = deque->capacity ? deque->capacity * 2 : SKID_WALK_DEQUE_SIZE;
+            new_tasks = realloc_skid_mem(deque->tasks, new_size, sizeof(skidWalkTask), &result);
+            if (ENOERR == result)
+            {
+                deque->tasks = new_tasks;
+                deque->capacity = new_size;
+            }
+        }
+    }
+    // Store it
+    if (ENOERR == result)
+    {
+        deque->tasks[deque->bottom] = *task;
+        deque->bottom++;
+        atomic_fetch_add(&(walk->pending), 1);
+        atomic_fetch_add(&(walk->queued), 1);
+    }
+    pthread_mutex_unlock(&(deque->lock));
+    // Wake an idle worker (see: wait_sdo_work())
+    if (ENOERR == result && atomic_load(&(walk->num_idle)) > 0)
+    {
+        pthread_mutex_lock(&(walk->idle_lock));
+        pthread_cond_signal(&(walk->idle_cond));
+        pthread_mutex_unlock(&(walk->idle_lock));
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL size_t read_dents(int dir_fd, char *dents_buff, size_t buff_size, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(dir_fd);  // Errno value
+    long num_read = 0;                      // Return value from getdents64()
+
+    // INPUT VALIDATION
+    if (ENOERR == result && (!dents_buff || !buff_size || !errnum))
+    {
+        result = EINVAL;  // Bad input
+    }
+
+    // READ IT
+    // glibc only wraps getdents64() from 2.30 on so call it directly
+    if (ENOERR == result)
+    {
+        num_read = syscall(SYS_getdents64, dir_fd, dents_buff, buff_size);
+        if (num_read < 0)
+        {
+            result = errno;
+            PRINT_ERROR(The call to getdents64() failed);
+            PRINT_ERRNO(result);
+            num_read = 0;
+        }
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return (size_t)num_read;
+}
+
+
+SKID_INTERNAL int read_sdo_task(skidWalkWorker_ptr worker, skidWalkTask_ptr task,
+                                char *dents_buff)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                             // Errno value
+    skidParallelWalk_ptr walk = worker->walk;        // The state shared by every worker
+    int dir_fd = task->dir_fd;                       // The directory to read
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;  // Flags to open sub-directories with
+    size_t num_read = 0;                             // Bytes of records in dents_buff
+    size_t offset = 0;                               // Offset of the current record
+    skidDirent64_ptr temp_dirent = NULL;             // Current record in dents_buff
+    size_t base_len = task->path_len;                // Length of the path plus delimiter
+    size_t name_len = 0;                             // Length of the record's d_name
+    skidDirEntry entry = { .depth = task->depth, .worker = worker->index };
+    skidWalkAction action = SKID_WALK_CONTINUE;      // The visitor's verdict
+    skidWalkTask child = { .dir_fd = SKID_BAD_FD };  // A sub-directory to queue
+
+    // OPEN IT
+    if (SKID_BAD_FD == dir_fd)
+    {
+        // Only the top of the walk, or a directory queued while too many were open, gets here
+        dir_fd = openat(AT_FDCWD, task->path, (1 == task->depth) ? flags : flags | O_NOFOLLOW);
+        if (dir_fd < 0)
+        {
+            result = errno;
+            dir_fd = SKID_BAD_FD;
+            PRINT_ERROR(The call to openat() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    else
+    {
+        task->dir_fd = SKID_BAD_FD;  // We own it now
+        atomic_fetch_sub(&(walk->open_fds), 1);
+    }
+    if (ENOERR == result)
+    {
+        memcpy(worker->path_buff, task->path, base_len + 1);
+        entry.dir_fd = dir_fd;
+        entry.path = worker->path_buff;
+        // The node keeps it open for its sub-directories' post-visits
+        if (task->node)
+        {
+            task->node->dir_fd = dir_fd;
+            task->node->path = task->path;
+            task->node->path_len = task->path_len;
+            task->path = NULL;
+        }
+        if ('/' != worker->path_buff[base_len - 1])
+        {
+            if (base_len >= PATH_MAX)
+            {
+                result = ENAMETOOLONG;  // No room for the delimiter
+            }
+            else
+            {
+                worker->path_buff[base_len++] = '/';
+            }
+        }
+    }
+
+    // READ IT
+    while (ENOERR == result && false == atomic_load(&(walk->stopped)))
+    {
+        num_read = read_dents(dir_fd, dents_buff, SKID_DENTS_MAX_SIZE, &result);
+        if (ENOERR != result || 0 == num_read)
+        {
+            break;  // Error or the end of the directory has been reached
+        }
+        // Parse the records in place
+        for (offset = 0; offset < num_read; offset += temp_dirent->d_reclen)
+        {
+            temp_dirent = (skidDirent64_ptr)(dents_buff + offset);
+            if (false == validate_d_name(temp_dirent->d_name))
+            {
+                continue;  // Skip . and ..
+            }
+            if (true == atomic_load_explicit(&(walk->stopped), memory_order_relaxed))
+            {
+                break;  // Another worker stopped the walk
+            }
+            // Build the path
+            name_len = strlen(temp_dirent->d_name);
+            if (name_len > (PATH_MAX - base_len))
+            {
+                result = ENAMETOOLONG;
+                PRINT_ERROR(Detected a path longer than PATH_MAX);
+                break;
+            }
+            memcpy(worker->path_buff + base_len, temp_dirent->d_name, name_len + 1);
+            // Visit it
+            entry.name = worker->path_buff + base_len;
+            entry.path_len = base_len + name_len;
+            entry.type = get_dirent_type(dir_fd, temp_dirent);
+            action = walk->visitor(&entry, walk->context);
+            if (SKID_WALK_STOP == action)
+            {
+                stop_sdo_walk(walk, ENOERR);
+                break;
+            }
+            // Should we queue this valid directory?
+            if (SKID_WALK_CONTINUE == action && DT_DIR == entry.type
+                && (0 == walk->max_depth || task->depth < walk->max_depth))
+            {
+                child.path = copy_skid_string(worker->path_buff, &result);
+                child.path_len = entry.path_len;
+                child.depth = task->depth + 1;
+                if (ENOERR == result && task->node)
+                {
+                    child.node = create_sdo_node(task->node, base_len, task->depth, &result);
+                }
+                // Open it relative to this directory while we hold it, fds permitting
+                if (ENOERR == result)
+                {
+                    if (atomic_fetch_add(&(walk->open_fds), 1) < SKID_WALK_MAX_OPEN_FDS)
+                    {
+                        child.dir_fd = openat(dir_fd, entry.name, flags | O_NOFOLLOW);
+                        if (child.dir_fd < 0)
+                        {
+                            result = errno;
+                            child.dir_fd = SKID_BAD_FD;
+                            PRINT_ERROR(The call to openat() failed);
+                            PRINT_ERRNO(result);
+                        }
+                    }
+                    if (SKID_BAD_FD == child.dir_fd)
+                    {
+                        atomic_fetch_sub(&(walk->open_fds), 1);  // It will be opened by path
+                    }
+                    if (ENOERR != result && true == walk->keep_going)
+                    {
+                        // Skip the sub-directory but read the rest of this one
+                        record_sdo_error(walk, result);
+                        free_sdo_task(walk, &child, worker->index);
+                        result = ENOERR;
+                        continue;
+                    }
+                }
+                if (ENOERR == result)
+                {
+                    result = push_sdo_task(walk, worker->index, &child);
+                }
+                if (ENOERR != result)
+                {
+                    stop_sdo_walk(walk, result);  // Before child's node is released
+                    free_sdo_task(walk, &child, worker->index);
+                    break;
+                }
+                child.path = NULL;  // The deque owns it now
+                child.dir_fd = SKID_BAD_FD;
+                child.node = NULL;
+            }
+        }
+    }
+
+    // CLEANUP
+    if (SKID_BAD_FD != dir_fd && !(task->node))
+    {
+        close_fd(&dir_fd, true);  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void record_sdo_error(skidParallelWalk_ptr walk, int errnum)
+{
+    // LOCAL VARIABLES
+    int expected = ENOERR;  // Only the first error is kept
+
+    // RECORD IT
+    atomic_compare_exchange_strong(&(walk->first_err), &expected, errnum);
+}
+
+
+SKID_INTERNAL void release_sdo_node(skidParallelWalk_ptr walk, skidWalkNode_ptr node,
+                                   unsigned int worker)
+{
+    // LOCAL VARIABLES
+    skidWalkNode_ptr parent = NULL;  // The node to release next
+    skidDirEntry entry = { .type = DT_DIR, .worker = worker };
+
+    // RELEASE IT
+    while (node && 1 == atomic_fetch_sub(&(node->refs), 1))
+    {
+        parent = node->parent;
+        // Its contents are done (unless it was never read or the walk was stopped)
+        if (parent && node->path && false == atomic_load(&(walk->stopped)))
+        {
+            entry.path = node->path;
+            entry.name = node->path + node->name_off;
+            entry.path_len = node->path_len;
+            entry.depth = node->depth;
+            entry.dir_fd = parent->dir_fd;
+            if (SKID_WALK_STOP == walk->post_visitor(&entry, walk->context))
+            {
+                stop_sdo_walk(walk, ENOERR);
+            }
+        }
+        // Free it
+        if (SKID_BAD_FD != node->dir_fd)
+        {
+            close_fd(&(node->dir_fd), true);  // Best effort
+        }
+        if (node->path)
+        {
+            free_skid_mem((void **)&(node->path));  // Best effort
+        }
+        free_skid_mem((void **)&node);  // Best effort
+        node = parent;
+    }
+}
+
+
+SKID_INTERNAL int run_sdo_parallel(skidParallelWalk_ptr walk, const char *dirname,
+                                   unsigned int num_threads)
+{
+    // LOCAL VARIABLES
+    int result = validate_sdo_pathname(dirname);        // Capture errno values here
+    skidWalkWorker_ptr workers = NULL;                  // Heap-allocated array of workers
+    skidWalkTask root = { .dir_fd = SKID_BAD_FD };      // The first directory to read
+    long num_cpus = 0;                                  // Number of online CPUs
+    unsigned int num_inited = 0;                        // Number of deques with an initialized lock
+    bool idle_inited = false;                           // Were idle_lock and idle_cond initialized?
+    skidWalkTask leftover = { .dir_fd = SKID_BAD_FD };  // Tasks abandoned by a stopped walk
+    unsigned int i = 0;                                 // Iterating variable
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !(walk->visitor))
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    if (ENOERR == result)
+    {
+        root.path_len = strlen(dirname);
+        if (root.path_len > PATH_MAX)
+        {
+            result = ENAMETOOLONG;  // It won't fit
+        }
+    }
+
+    // SETUP
+    // Size it
+    if (ENOERR == result)
+    {
+        if (0 == num_threads)
+        {
+            num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            num_threads = (num_cpus > 0) ? (unsigned int)num_cpus : 1;
+        }
+        if (num_threads > SKID_WALK_MAX_THREADS)
+        {
+            num_threads = SKID_WALK_MAX_THREADS;
+        }
+        walk->num_workers = num_threads;
+        atomic_init(&(walk->pending), 0);
+        atomic_init(&(walk->queued), 0);
+        atomic_init(&(walk->open_fds), 0);
+        atomic_init(&(walk->num_idle), 0);
+        atomic_init(&(walk->first_err), ENOERR);
+        atomic_init(&(walk->stopped), false);
+    }
+    // Allocate it
+    if (ENOERR == result)
+    {
+        walk->deques = alloc_skid_mem(num_threads, sizeof(skidWalkDeque), &result);
+    }
+    if (ENOERR == result)
+    {
+        workers = alloc_skid_mem(num_threads, sizeof(skidWalkWorker), &result);
+    }
+    // Initialize the locks
+    if (ENOERR == result)
+    {
+        result = pthread_mutex_init(&(walk->idle_lock), NULL);
+        if (ENOERR == result)
+        {
+            result = pthread_cond_init(&(walk->idle_cond), NULL);
+            if (ENOERR == result)
+            {
+                idle_inited = true;
+            }
+            else
+            {
+                pthread_mutex_destroy(&(walk->idle_lock));
+            }
+        }
+    }
+    for (; ENOERR == result && num_inited < num_threads; num_inited++)
+    {
+        result = pthread_mutex_init(&(walk->deques[num_inited].lock), NULL);
+        if (ENOERR != result)
+        {
+            break;
+        }
+    }
+    // Queue dirname
+    if (ENOERR == result)
+    {
+        root.path = copy_skid_string(dirname, &result);
+        root.depth = 1;
+    }
+    if (ENOERR == result && walk->post_visitor)
+    {
+        root.node = create_sdo_node(NULL, 0, 0, &result);
+    }
+    if (ENOERR == result)
+    {
+        result = push_sdo_task(walk, 0, &root);
+        if (ENOERR != result)
+        {
+            free_sdo_task(walk, &root, 0);
+        }
+    }
+
+    // WALK IT
+    if (ENOERR == result)
+    {
+        // Start the helpers
+        for (i = 0; i < num_threads; i++)
+        {
+            workers[i].walk = walk;
+            workers[i].index = i;
+            if (i > 0)
+            {
+                if (pthread_create(&(workers[i].thread), NULL, run_sdo_worker, workers + i))
+                {
+                    PRINT_WARNG(The call to pthread_create() failed so the walk has fewer workers);
+                }
+                else
+                {
+                    workers[i].started = true;
+                }
+            }
+        }
+        // Work alongside them
+        run_sdo_worker(workers);
+        // Wait for them
+        for (i = 1; i < num_threads; i++)
+        {
+            if (true == workers[i].started)
+            {
+                pthread_join(workers[i].thread, NULL);
+            }
+        }
+        result = atomic_load(&(walk->first_err));
+    }
+
+    // CLEANUP
+    // Abandoned tasks (only a stopped walk leaves any behind)
+    if (num_inited > 0 && num_inited == walk->num_workers)
+    {
+        while (true == pop_sdo_task(walk, 0, &leftover))
+        {
+            free_sdo_task(walk, &leftover, 0);
+        }
+    }
+    for (i = 0; i < num_inited; i++)
+    {
+        if (walk->deques[i].tasks)
+        {
+            free_skid_mem((void **)&(walk->deques[i].tasks));
+        }
+        pthread_mutex_destroy(&(walk->deques[i].lock));
+    }
+    if (true == idle_inited)
+    {
+        pthread_cond_destroy(&(walk->idle_cond));
+        pthread_mutex_destroy(&(walk->idle_lock));
+    }
+    if (walk->deques)
+    {
+        free_skid_mem((void **)&(walk->deques));
+    }
+    if (workers)
+    {
+        free_skid_mem((void **)&workers);
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int run_sdo_walk(skidDirWalk_ptr walk, const char *dirname)
+{
+    // LOCAL VARIABLES
+    int result = validate_sdo_pathname(dirname);  // Capture errno values here
+    size_t path_len = 0;                          // Length of dirname
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !(walk->visitor))
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    if (ENOERR == result)
+    {
+        path_len = strlen(dirname);
+        if (path_len > PATH_MAX)
+        {
+            result = ENAMETOOLONG;  // It won't fit
+        }
+    }
+
+    // WALK IT
+    if (ENOERR == result)
+    {
+        memcpy(walk->path_buff, dirname, path_len + 1);
+        walk->stopped = false;
+        result = walk_sdo_dir(walk, AT_FDCWD, walk->path_buff, path_len, 1);
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void *run_sdo_worker(void *arg)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                            // Errno value
+    skidWalkWorker_ptr worker = arg;                // This worker
+    skidParallelWalk_ptr walk = worker->walk;       // The state shared by every worker
+    skidWalkTask task = { .dir_fd = SKID_BAD_FD };  // The directory being read
+    char *dents_buff = NULL;                        // This worker's getdents64() buffer
+
+    // SETUP
+    dents_buff = alloc_skid_mem(SKID_DENTS_MAX_SIZE, sizeof(char), &result);
+    if (ENOERR != result)
+    {
+        PRINT_ERROR(The call to alloc_skid_mem() failed);
+        PRINT_ERRNO(result);
+        stop_sdo_walk(walk, result);
+    }
+
+    // WORK
+    while (false == atomic_load(&(walk->stopped)))
+    {
+        if (true == pop_sdo_task(walk, worker->index, &task))
+        {
+            result = read_sdo_task(worker, &task, dents_buff);
+            if (ENOERR != result && true == walk->keep_going)
+            {
+                record_sdo_error(walk, result);
+            }
+            else if (ENOERR != result)
+            {
+                stop_sdo_walk(walk, result);  // Before task's node is released
+            }
+            free_sdo_task(walk, &task, worker->index);
+            // Was that the last one?
+            if (1 == atomic_fetch_sub(&(walk->pending), 1))
+            {
+                pthread_mutex_lock(&(walk->idle_lock));
+                pthread_cond_broadcast(&(walk->idle_cond));
+                pthread_mutex_unlock(&(walk->idle_lock));
+            }
+        }
+        else if (0 == atomic_load(&(walk->pending)))
+        {
+            break;  // Nothing queued and nothing being read means nothing left to find
+        }
+        else
+        {
+            wait_sdo_work(walk);
+        }
+    }
+
+    // CLEANUP
+    if (dents_buff)
+    {
+        free_skid_mem((void **)&dents_buff);  // Best effort
+    }
+
+    // DONE
+    return NULL;
+}
+
+
+SKID_INTERNAL size_t size_dents_buff(int dir_fd)
+{
+    // LOCAL VARIABLES
+    size_t buff_size = SKID_DENTS_MIN_SIZE;  // Size of the getdents64() buffer
+    struct stat dir_stat;                    // Directory metadata
+
+    // SIZE IT
+    if (0 == fstat(dir_fd, &dir_stat) && dir_stat.st_size > SKID_DENTS_MIN_SIZE)
+    {
+        if (dir_stat.st_size < SKID_DENTS_MAX_SIZE)
+        {
+            buff_size = dir_stat.st_size;
+        }
+        else
+        {
+            buff_size = SKID_DENTS_MAX_SIZE;
+        }
+    }
+
+    // DONE
+    return buff_size;
+}
+
+
+SKID_INTERNAL void stop_sdo_walk(skidParallelWalk_ptr walk, int errnum)
+{
+    // STOP IT
+    if (ENOERR != errnum)
+    {
+        record_sdo_error(walk, errnum);
+    }
+    atomic_store(&(walk->stopped), true);
+    pthread_mutex_lock(&(walk->idle_lock));
+    pthread_cond_broadcast(&(walk->idle_cond));
+    pthread_mutex_unlock(&(walk->idle_lock));
+}
+
+
+SKID_INTERNAL bool validate_d_name(const char *d_name)
+{
+    // LOCAL VARIABLES
+    bool is_valid = true;  // Is d_name valid?
+
+    // INPUT VALIDATION
+    if (!d_name)
+    {
+        is_valid = false;  // NULL pointer
+    }
+    else if (0 >= strlen(d_name))
+    {
+        is_valid = false;  // Empty string
+    }
+    else if (!strcmp(".", d_name))
+    {
+        is_valid = false;  // We will not store this
+    }
+    else if (!strcmp("..", d_name))
+    {
+        is_valid = false;  // We will not store this either
+    }
+
+    // DONE
+    return is_valid;
+}
+
+
+SKID_INTERNAL int validate_sdo_pathname(const char *pathname)
+{
+    return validate_skid_pathname(pathname, false);  // Refactored for backwards compatibility
+}
+
+
+SKID_INTERNAL int validate_sdo_tree_meta(const skidTreeMeta *changes)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                         // Results of validation
+    const struct timespec *times[2] = { NULL };  // The timestamps to validate
+    int i = 0;                                   // Iterating variable
+
+    // INPUT VALIDATION
+    if (!changes)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else if ((changes->file_mode | changes->dir_mode | changes->remove_mode
+              | changes->add_mode) & ~SKID_TREE_MODE_BITS)
+    {
+        result = EINVAL;  // Not permission bits
+    }
+    else
+    {
+        times[0] = &(changes->atime);
+        times[1] = &(changes->mtime);
+        for (i = 0; i < 2; i++)
+        {
+            if (UTIME_NOW != times[i]->tv_nsec && UTIME_OMIT != times[i]->tv_nsec
+                && (times[i]->tv_nsec < 0 || times[i]->tv_nsec >= 1000000000L))
+            {
+                result = EINVAL;  // Bad nanoseconds
+            }
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL skidWalkAction visit_destroy_dir(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    skidWalkAction action = SKID_WALK_CONTINUE;  // Keep walking unless something goes wrong
+    skidDestroyVisit_ptr visit = context;        // The first deletion error and progress
+    int errnum = ENOERR;                         // The deletion error
+    int expected = ENOERR;                       // Only the first error is recorded
+
+    // DELETE IT
+    if (unlinkat(entry->dir_fd, entry->name, AT_REMOVEDIR))
+    {
+        errnum = errno;
+        PRINT_ERROR(The call to unlinkat(AT_REMOVEDIR) failed);
+        PRINT_ERRNO(errnum);
+        FPRINTF_ERR("%s - Attempting to delete '%s'\n", DEBUG_ERROR_STR, entry->path);
+        atomic_compare_exchange_strong(&(visit->result), &expected, errnum);
+        action = SKID_WALK_STOP;  // Let's stop since the rest will likely error as well
+    }
+    else if (visit->progress)
+    {
+        atomic_fetch_add_explicit(&(visit->progress->dirs_deleted), 1, memory_order_relaxed);
+    }
+
+    // DONE
+    return action;
+}
+
+
+SKID_INTERNAL skidWalkAction visit_destroy_entry(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    skidWalkAction action = SKID_WALK_CONTINUE;  // Keep walking unless something goes wrong
+    skidDestroyVisit_ptr visit = context;        // The first deletion error and progress
+    int errnum = ENOERR;                         // The deletion error
+    int expected = ENOERR;                       // Only the first error is recorded
+
+    // DELETE IT
+    // Directories are deleted by visit_destroy_dir() once they're empty
+    if (DT_DIR != entry->type)
+    {
+        if (unlinkat(entry->dir_fd, entry->name, 0))
+        {
+            errnum = errno;
+            PRINT_ERROR(The call to unlinkat() failed);
+            PRINT_ERRNO(errnum);
+            FPRINTF_ERR("%s - Attempting to delete '%s'\n", DEBUG_ERROR_STR, entry->path);
+            atomic_compare_exchange_strong(&(visit->result), &expected, errnum);
+            action = SKID_WALK_STOP;  // Let's stop since the rest will likely error as well
+        }
+        else if (visit->progress)
+        {
+            atomic_fetch_add_explicit(&(visit->progress->files_deleted), 1,
+                                      memory_order_relaxed);
+        }
+    }
+
+    // DONE
+    return action;
+}
+
+
+SKID_INTERNAL skidWalkAction visit_listing_entry(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    skidWalkAction action = SKID_WALK_CONTINUE;  // Keep walking unless something goes wrong
+    skidListingVisit_ptr visit = context;        // The listing to append to
+
+    // STORE IT
+    visit->result = add_listing_path(visit->listing, entry->path, entry->path_len);
+    if (ENOERR != visit->result)
+    {
+        PRINT_ERROR(The call to add_listing_path() failed);
+        PRINT_ERRNO(visit->result);
+        action = SKID_WALK_STOP;
+    }
+
+    // DONE
+    return action;
+}
+
+
+SKID_INTERNAL skidWalkAction visit_tree_meta_dir(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    skidTreeMetaVisit_ptr visit = context;  // The changes to make and the first error
+    int errnum = ENOERR;                    // The error changing this directory
+    int expected = ENOERR;                  // Only the first error is recorded
+
+    // CHANGE IT
+    errnum = apply_sdo_meta(visit, entry->dir_fd, entry->name, AT_SYMLINK_NOFOLLOW,
+                            SKID_TREE_POST);
+    if (ENOERR != errnum)
+    {
+        FPRINTF_ERR("%s - Attempting to change '%s'\n", DEBUG_ERROR_STR, entry->path);
+        atomic_compare_exchange_strong(&(visit->result), &expected, errnum);
+    }
+
+    // DONE
+    return SKID_WALK_CONTINUE;  // Change as much of the tree as possible
+}
+
+
+SKID_INTERNAL skidWalkAction visit_tree_meta_entry(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    skidTreeMetaVisit_ptr visit = context;  // The changes to make and the first error
+    int errnum = ENOERR;                    // The error changing this entry
+    int expected = ENOERR;                  // Only the first error is recorded
+
+    // CHANGE IT
+    // Directories are finished by visit_tree_meta_dir() once they've been read
+    errnum = apply_sdo_meta(visit, entry->dir_fd, entry->name, AT_SYMLINK_NOFOLLOW,
+                            (DT_DIR == entry->type) ? SKID_TREE_PRE : SKID_TREE_ALL);
+    if (ENOERR != errnum)
+    {
+        FPRINTF_ERR("%s - Attempting to change '%s'\n", DEBUG_ERROR_STR, entry->path);
+        atomic_compare_exchange_strong(&(visit->result), &expected, errnum);
+    }
+
+    // DONE
+    return SKID_WALK_CONTINUE;  // Change as much of the tree as possible
+}
+
+
+SKID_INTERNAL void wait_sdo_work(skidParallelWalk_ptr walk)
+{
+    pthread_mutex_lock(&(walk->idle_lock));
+    // Announce ourselves before checking so push_sdo_task() either sees us or we see its task
+    atomic_fetch_add(&(walk->num_idle), 1);
+    while (0 == atomic_load(&(walk->queued)) && 0 < atomic_load(&(walk->pending))
+           && false == atomic_load(&(walk->stopped)))
+    {
+        pthread_cond_wait(&(walk->idle_cond), &(walk->idle_lock));
+    }
+    atomic_fetch_sub(&(walk->num_idle), 1);
+    pthread_mutex_unlock(&(walk->idle_lock));
+}
+
+
+SKID_INTERNAL int walk_sdo_dir(skidDirWalk_ptr walk, int parent_fd, const char *dirname,
+                               size_t path_len, size_t depth)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                             // Errno value
+    int dir_fd = SKID_BAD_FD;                        // Directory file descriptor
+    char *dents_buff = NULL;                         // Buffer of getdents64() records
+    size_t buff_size = 0;                            // Size of dents_buff
+    size_t num_read = 0;                             // Number of bytes of records in dents_buff
+    size_t offset = 0;                               // Offset of the current record in dents_buff
+    skidDirent64_ptr temp_dirent = NULL;             // Current record in dents_buff
+    size_t base_len = path_len;                      // Length of the directory name plus delimiter
+    size_t name_len = 0;                             // Length of the current record's d_name
+    skidDirEntry entry = { .depth = depth };         // The entry handed to the visitor
+    skidWalkAction action = SKID_WALK_CONTINUE;      // The visitor's verdict
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;  // Flags to open dirname with
+
+    // INPUT VALIDATION
+    if (!walk || !dirname || !path_len)
+    {
+        result = EINVAL;  // Bad input
+    }
+
+    // RECURSION FTW!
+    // Open the directory, relative to its parent so the kernel resolves one component
+    if (ENOERR == result)
+    {
+        if (AT_FDCWD != parent_fd)
+        {
+            flags |= O_NOFOLLOW;  // Never follow an entry swapped for a symlink mid-walk
+        }
+        dir_fd = openat(parent_fd, dirname, flags);
+        if (dir_fd < 0)
+        {
+            result = errno;
+            dir_fd = SKID_BAD_FD;
+            PRINT_ERROR(The call to openat() failed);
+            PRINT_ERRNO(result);
+        }
+        entry.dir_fd = dir_fd;
+        entry.path = walk->path_buff;
+    }
+    // Allocate the buffer
+    if (ENOERR == result)
+    {
+        buff_size = size_dents_buff(dir_fd);
+        dents_buff = alloc_skid_mem(buff_size, sizeof(char), &result);
+    }
+    // Add the delimiter entries will be joined with
+    if (ENOERR == result && '/' != walk->path_buff[path_len - 1])
+    {
+        if (path_len >= PATH_MAX)
+        {
+            result = ENAMETOOLONG;  // No room for the delimiter
+        }
+        else
+        {
+            walk->path_buff[base_len++] = '/';
+        }
+    }
+    // Read the directory
+    while (ENOERR == result && false == walk->stopped)
+    {
+        num_read = read_dents(dir_fd, dents_buff, buff_size, &result);
+        if (ENOERR != result || 0 == num_read)
+        {
+            break;  // Error or the end of the directory has been reached
+        }
+        // Parse the records in place
+        for (offset = 0; offset < num_read; offset += temp_dirent->d_reclen)
+        {
+            temp_dirent = (skidDirent64_ptr)(dents_buff + offset);
+            if (false == validate_d_name(temp_dirent->d_name))
+            {
+                continue;  // Skip . and ..
+            }
+            // Build the path
+            name_len = strlen(temp_dirent->d_name);
+            if (name_len > (PATH_MAX - base_len))
+            {
+                result = ENAMETOOLONG;
+                PRINT_ERROR(Detected a path longer than PATH_MAX);
+                break;
+            }
+            memcpy(walk->path_buff + base_len, temp_dirent->d_name, name_len + 1);
+            // Visit it
+            entry.name = walk->path_buff + base_len;
+            entry.path_len = base_len + name_len;
+            entry.type = get_dirent_type(dir_fd, temp_dirent);
+            action = walk->visitor(&entry, walk->context);
+            if (SKID_WALK_STOP == action)
+            {
+                walk->stopped = true;
+                break;
+            }
+            // Should we recurse on this valid directory?
+            if (SKID_WALK_CONTINUE == action && DT_DIR == entry.type
+                && (0 == walk->max_depth || depth < walk->max_depth))
+            {
+                // Recurse!
+                result = walk_sdo_dir(walk, dir_fd, entry.name, entry.path_len, depth + 1);
+                if (ENOERR != result || true == walk->stopped)
+                {
+                    break;
+                }
+                // Its contents are done
+                if (walk->post_visitor
+                    && SKID_WALK_STOP == walk->post_visitor(&entry, walk->context))
+                {
+                    walk->stopped = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // CLEANUP
+    // Restore the directory name
+    if (walk && path_len)
+    {
+        walk->path_buff[path_len] = '\0';
+    }
+    // Free the buffer
+    if (dents_buff)
+    {
+        free_skid_mem((void **)&dents_buff);  // Best effort
+    }
+    // Close the directory
+    if (SKID_BAD_FD != dir_fd)
+    {
+        close_fd(&dir_fd, true);  // Best effort
+    }
+
+    // DONE
+    return result;
 }
@@ -2,16 +2,23 @@
  *      This library defines functionality to read and control file descriptors.
  */
 
+#define _GNU_SOURCE                         // Access to F_OFD_GETLK, F_OFD_SETLK, F_OFD_SETLKW
+
 // #define SKID_DEBUG                          // Enable DEBUG logging
 
 #include <errno.h>                          // errno
 #include <fcntl.h>                          // fcntl(), FD_CLOEXEC
 #include <stdarg.h>                         // va_end(), va_list, va_start()
-#include <stdint.h>                         // uint64_t
+#include <stdatomic.h>                      // atomic_*
+#include <stdint.h>                         // int64_t, uint64_t
+#include <string.h>                         // strlen()
+#include <time.h>                           // clock_gettime(), nanosleep()
+#include <unistd.h>                         // lseek()
 #include "skid_debug.h"                     // PRINT_ERRNO(), PRINT_ERROR()
 #include "skid_file_control.h"              // get_read_lock(), get_write_lock()
-#include "skid_file_descriptors.h"          // read_fd(), write_fd()
+#include "skid_file_descriptors.h"          // read_fd(), read_fd_chunk(), write_fd()
 #include "skid_macros.h"                    // ENOERR, NULL, SKID_INTERNAL
+#include "skid_memory.h"                    // free_skid_buffer(), grow_skid_buffer()
 #include "skid_validation.h"                // validate_skid_fd(), validate_skid_err()
 
 /*
@@ -20,6 +27,18 @@
  */
 typedef enum { Void = 0, Integer = 1, FlockPtr = 2, FOwnerEx = 3, Uint64tPtr = 4 } FcntlOptArg_t;
 
+#ifndef SKID_RANGE_LOCK_MIN_WAIT
+#define SKID_RANGE_LOCK_MIN_WAIT 50000L     // First range lock retry backoff, in nanoseconds
+#endif  /* SKID_RANGE_LOCK_MIN_WAIT */
+#ifndef SKID_RANGE_LOCK_MAX_WAIT
+#define SKID_RANGE_LOCK_MAX_WAIT 10000000L  // Longest range lock retry backoff, in nanoseconds
+#endif  /* SKID_RANGE_LOCK_MAX_WAIT */
+
+// Process-wide range lock counters reported by get_lock_stats()
+static atomic_uint_fast64_t lock_acquired = 0;   // Range locks acquired
+static atomic_uint_fast64_t lock_contended = 0;  // Range lock attempts that found a conflict
+static atomic_uint_fast64_t lock_wait_ns = 0;    // Nanoseconds spent waiting on conflicts
+
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
 
@@ -48,23 +67,53 @@ SKID_INTERNAL int call_fcntl(int *errnum, FcntlOptArg_t opt_arg, int fd, int cmd
 /*
  *  Description:
  *      Standardize the way this library calls fcntl(), with flock structs, and responds to errors.
- *      This function always uses the same whence (SEEK_SET), start (0), and len (0) for the
- *      flock struct to represent the entirety of the file descriptor.
+ *      This function always uses the same whence (SEEK_SET) for the flock struct.  Use a start
+ *      of 0 and a len of 0 to represent the entirety of the file descriptor.
  *
  *  Args:
  *      errnum: [Out] Storage location for errno values encountered.
  *      fd: Open file descriptor to pass to fcntl().
  *      cmd: The fnctl() operation to execute.  Must be a command that utilizes a struct flock
- *          (e.g., F_SETLK, F_SETLKW, F_GETLK).  See: fcntl(2).
+ *          (e.g., F_SETLK, F_SETLKW, F_GETLK, F_OFD_SETLK, F_OFD_SETLKW, F_OFD_GETLK).
+ *          See: fcntl(2).
  *      lock_type: The lock type to set in the flock struct.  (e.g., F_RDLCK, F_WRLCK, F_UNLCK)
  *          See: fcntl(2).
+ *      start: The offset of the first byte in the range.
+ *      len: The number of bytes in the range, 0 for everything from start on.
  *
  *  Returns:
  *      For a successful call, the return value depends on the operation.  See: fcntl(2).
  *      On error, -1 is returned, and errnum is set appropriately.  The errno value
  *      EOPNOTSUPP is used to indicate an unsupported cmd or lock_type.
  */
-SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type);
+SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type, off_t start,
+                                   off_t len);
+
+/*
+ *  Description:
+ *      Try to lock a byte range with fcntl(F_OFD_SETLK), without waiting.
+ *
+ *  Args:
+ *      fd: Open file descriptor to lock.
+ *      lock_type: F_RDLCK or F_WRLCK.
+ *      start: The offset of the first byte in the range.
+ *      len: The number of bytes in the range, 0 for everything from start on.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN (never EACCES) for a conflicting lock.
+ */
+SKID_INTERNAL int call_ofd_setlk(int fd, short lock_type, off_t start, off_t len);
+
+/*
+ *  Description:
+ *      Update the process-wide range lock counters after an attempt to lock a range.
+ *
+ *  Args:
+ *      result: The results of the attempt.
+ *      contended: True if the attempt found a conflicting lock held.
+ *      wait_ns: The nanoseconds spent waiting for the conflicting lock.
+ */
+SKID_INTERNAL void count_lock_attempt(int result, bool contended, int64_t wait_ns);
 
 /*
  *  Description:
@@ -80,11 +129,235 @@ SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type
  */
 SKID_INTERNAL int get_fd_flags(int *errnum, int fd);
 
+/*
+ *  Description:
+ *      Read CLOCK_MONOTONIC in nanoseconds, for get_range_lock_timed()'s deadline.
+ *
+ *  Args:
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The current time, in nanoseconds, on success.  0 on error (check errnum for details).
+ */
+SKID_INTERNAL int64_t get_monotonic_ns(int *errnum);
+
+/*
+ *  Description:
+ *      Validate a skidLockSession on behalf of the *_lock_session() functions.
+ *
+ *  Args:
+ *      session: The session to validate.
+ *      need_write: If true, the session must hold a write lock.
+ *
+ *  Returns:
+ *      ENOERR if session is an active session.  EINVAL for a NULL or ended session.  EPERM if
+ *      need_write is true but session only holds a read lock.
+ */
+SKID_INTERNAL int validate_lock_session(const skidLockSession *session, bool need_write);
+
+/*
+ *  Description:
+ *      Validate the arguments of the *_range_lock() functions.
+ *
+ *  Args:
+ *      lock_type: F_RDLCK, F_WRLCK, or F_UNLCK.
+ *      start: The offset of the first byte in the range.
+ *      len: The number of bytes in the range.
+ *
+ *  Returns:
+ *      ENOERR if lock_type is supported and neither start nor len are negative.  EINVAL otherwise.
+ */
+SKID_INTERNAL int validate_range_lock(short lock_type, off_t start, off_t len);
+
 /**************************************************************************************************/
 /********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
 /**************************************************************************************************/
 
 
+int begin_lock_session(int fd, short lock_type, off_t start, off_t len,
+                       skidLockSession_ptr session)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // INPUT VALIDATION
+    if (!session)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        session->fd = SKID_BAD_FD;  // Leave it safe to end if anything goes wrong
+    }
+
+    // BEGIN IT
+    if (ENOERR == result)
+    {
+        result = get_range_lock(fd, lock_type, start, len);
+    }
+    if (ENOERR == result)
+    {
+        session->fd = fd;
+        session->lock_type = lock_type;
+        session->start = start;
+        session->len = len;
+    }
+
+    // DONE
+    return result;
+}
+
+
+int end_lock_session(skidLockSession_ptr session)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // END IT
+    // Ending a NULL or ended session is harmless so SKID_AUTO_LOCK_SESSION can always call this
+    if (session && SKID_BAD_FD != session->fd)
+    {
+        result = release_range_lock(session->fd, session->start, session->len);
+        session->fd = SKID_BAD_FD;  // The lock is gone either way once fd is closed
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_lock_stats(skidLockStats_ptr stats, bool reset)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // INPUT VALIDATION
+    if (!stats)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // GET THEM
+    else if (true == reset)
+    {
+        stats->acquired = atomic_exchange(&lock_acquired, 0);
+        stats->contended = atomic_exchange(&lock_contended, 0);
+        stats->wait_ns = atomic_exchange(&lock_wait_ns, 0);
+    }
+    else
+    {
+        stats->acquired = atomic_load(&lock_acquired);
+        stats->contended = atomic_load(&lock_contended);
+        stats->wait_ns = atomic_load(&lock_wait_ns);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_range_lock(int fd, short lock_type, off_t start, off_t len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;     // Errno values
+    bool contended = false;  // True if a conflicting lock was held
+    int64_t began = 0;       // When the wait began, in nanoseconds
+
+    // INPUT VALIDATION
+    if (F_UNLCK == lock_type)
+    {
+        result = EINVAL;  // Use release_range_lock()
+    }
+    else
+    {
+        result = validate_range_lock(lock_type, start, len);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        // Try first so an uncontended lock still costs one fcntl() and contention gets counted
+        result = call_ofd_setlk(fd, lock_type, start, len);
+        if (EAGAIN == result)
+        {
+            contended = true;
+            began = get_monotonic_ns(NULL);
+            do
+            {
+                call_fcntl_flock(&result, fd, F_OFD_SETLKW, lock_type, start, len);
+            } while (EINTR == result);  // A signal handler interrupted the wait so keep waiting
+        }
+        count_lock_attempt(result, contended, contended ? get_monotonic_ns(NULL) - began : 0);
+        if (ENOERR != result)
+        {
+            FPRINTF_ERR("%s Failed to get a range lock on file descriptor '%d'\n",
+                        DEBUG_WARNG_STR, fd);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_range_lock_timed(int fd, short lock_type, off_t start, off_t len,
+                         unsigned int timeout_ms)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                      // Errno values
+    bool contended = false;                   // True if a conflicting lock was held
+    int64_t began = 0;                        // When the attempt began, in nanoseconds
+    int64_t now = 0;                          // The current time, in nanoseconds
+    int64_t deadline = 0;                     // When to give up, in nanoseconds
+    long backoff = SKID_RANGE_LOCK_MIN_WAIT;  // How long to sleep between tries
+    struct timespec nap = { .tv_sec = 0 };    // Argument to nanosleep()
+
+    // INPUT VALIDATION
+    if (F_UNLCK == lock_type)
+    {
+        result = EINVAL;  // Use release_range_lock()
+    }
+    else
+    {
+        result = validate_range_lock(lock_type, start, len);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        began = get_monotonic_ns(&result);
+        now = began;
+        deadline = began + (int64_t)timeout_ms * 1000000;
+        while (ENOERR == result)
+        {
+            result = call_ofd_setlk(fd, lock_type, start, len);
+            if (EAGAIN != result)
+            {
+                break;  // Locked it or something went wrong
+            }
+            // Still locked, so take a nap unless time's up
+            contended = true;
+            now = get_monotonic_ns(&result);
+            if (ENOERR == result && now >= deadline)
+            {
+                result = ETIMEDOUT;
+            }
+            else if (ENOERR == result)
+            {
+                nap.tv_nsec = (deadline - now < backoff) ? (long)(deadline - now) : backoff;
+                nanosleep(&nap, NULL);  // Waking early just means trying early
+                backoff = (2 * backoff > SKID_RANGE_LOCK_MAX_WAIT) ? SKID_RANGE_LOCK_MAX_WAIT
+                          : 2 * backoff;
+            }
+        }
+        count_lock_attempt(result, contended, contended ? get_monotonic_ns(NULL) - began : 0);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int get_read_lock(int fd)
 {
     // LOCAL VARIABLES
@@ -92,7 +365,7 @@ int get_read_lock(int fd)
     int retval = -1;      // Return value from fcntl()
 
     // GET IT
-    retval = call_fcntl_flock(&result, fd, F_SETLK, F_RDLCK);
+    retval = call_fcntl_flock(&result, fd, F_SETLK, F_RDLCK, 0, 0);
     if (-1 == retval)
     {
         FPRINTF_ERR("%s Failed to get a read lock on file descriptor '%d'\n", DEBUG_WARNG_STR, fd);
@@ -110,7 +383,7 @@ int get_write_lock(int fd)
     int retval = -1;      // Return value from fcntl()
 
     // GET IT
-    retval = call_fcntl_flock(&result, fd, F_SETLK, F_WRLCK);
+    retval = call_fcntl_flock(&result, fd, F_SETLK, F_WRLCK, 0, 0);
     if (-1 == retval)
     {
         FPRINTF_ERR("%s Failed to get a write lock on file descriptor '%d'\n", DEBUG_WARNG_STR, fd);
@@ -155,6 +428,95 @@ bool is_close_on_exec(int fd, int *errnum)
 }
 
 
+char *read_lock_session(skidLockSession_ptr session, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;        // Errno values
+    char *fd_cont = NULL;       // Content read from the session's fd
+    off_t offset = 0;           // The session fd's current offset
+    size_t to_read = 0;         // Number of locked bytes left from offset on
+    size_t num_read = 0;        // Number of bytes read by one read
+    skidBuffer buffer = { 0 };  // Working buffer for a bounded read
+
+    // INPUT VALIDATION
+    result = validate_skid_err(errnum);
+    if (ENOERR == result)
+    {
+        result = validate_lock_session(session, false);
+    }
+    // Never read bytes the session hasn't locked
+    if (ENOERR == result)
+    {
+        offset = lseek(session->fd, 0, SEEK_CUR);
+        if (-1 == offset)
+        {
+            result = errno;
+            PRINT_ERROR(The call to lseek() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (offset < session->start)
+        {
+            result = EINVAL;  // The offset is before the locked range
+        }
+        else if (session->len > 0 && offset - session->start < session->len)
+        {
+            to_read = session->len - (offset - session->start);
+        }
+    }
+
+    // READ IT
+    // Everything from start on is locked
+    if (ENOERR == result && 0 == session->len)
+    {
+        fd_cont = read_fd(session->fd, &result);
+    }
+    // Stop at the end of the locked range
+    else if (ENOERR == result)
+    {
+        result = grow_skid_buffer(&buffer, 1);  // Room for the nul-terminator, at least
+        while (ENOERR == result && buffer.length < to_read)
+        {
+            // Check for room (always keep one byte in reserve for the nul-terminator)
+            if (buffer.length + 1 >= buffer.capacity)
+            {
+                result = grow_skid_buffer(&buffer, buffer.length + 2);
+            }
+            if (ENOERR == result)
+            {
+                num_read = buffer.capacity - buffer.length - 1;  // Room left in the buffer
+                if (num_read > to_read - buffer.length)
+                {
+                    num_read = to_read - buffer.length;  // Locked bytes left
+                }
+                result = read_fd_chunk(session->fd, buffer.data + buffer.length, num_read,
+                                       buffer.length > 0, &num_read);
+                if (0 == num_read)
+                {
+                    break;  // EOF or error... either way, let's stop
+                }
+                buffer.length += num_read;
+            }
+        }
+        if (ENOERR == result)
+        {
+            buffer.data[buffer.length] = '\0';  // Room was reserved for this
+            fd_cont = buffer.data;  // The caller now owns the allocation
+        }
+        else
+        {
+            free_skid_buffer(&buffer);  // Best effort
+        }
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return fd_cont;
+}
+
+
 char *read_locked_fd(int fd, int *errnum)
 {
     // LOCAL VARIABLES
@@ -203,7 +565,7 @@ int release_lock(int fd)
     int retval = -1;      // Return value from fcntl()
 
     // GET IT
-    retval = call_fcntl_flock(&result, fd, F_SETLK, F_UNLCK);
+    retval = call_fcntl_flock(&result, fd, F_SETLK, F_UNLCK, 0, 0);
     if (-1 == retval)
     {
         FPRINTF_ERR("%s Failed to release a lock on file descriptor '%d'\n", DEBUG_WARNG_STR, fd);
@@ -214,6 +576,133 @@ int release_lock(int fd)
 }
 
 
+int release_range_lock(int fd, off_t start, off_t len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // INPUT VALIDATION
+    result = validate_range_lock(F_UNLCK, start, len);
+
+    // RELEASE IT
+    if (ENOERR == result)
+    {
+        call_fcntl_flock(&result, fd, F_OFD_SETLK, F_UNLCK, start, len);
+        if (ENOERR != result)
+        {
+            FPRINTF_ERR("%s Failed to release a range lock on file descriptor '%d'\n",
+                        DEBUG_WARNG_STR, fd);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int seek_lock_session(skidLockSession_ptr session, off_t offset, int whence, off_t *new_offset)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+    off_t retval = -1;    // Return value from lseek()
+
+    // INPUT VALIDATION
+    result = validate_lock_session(session, false);
+
+    // SEEK IT
+    if (ENOERR == result)
+    {
+        retval = lseek(session->fd, offset, whence);
+        if (-1 == retval)
+        {
+            result = errno;
+            PRINT_ERROR(The call to lseek() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (new_offset)
+        {
+            *new_offset = retval;
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int try_range_lock(int fd, short lock_type, off_t start, off_t len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // INPUT VALIDATION
+    if (F_UNLCK == lock_type)
+    {
+        result = EINVAL;  // Use release_range_lock()
+    }
+    else
+    {
+        result = validate_range_lock(lock_type, start, len);
+    }
+
+    // TRY IT
+    if (ENOERR == result)
+    {
+        result = call_ofd_setlk(fd, lock_type, start, len);
+        count_lock_attempt(result, EAGAIN == result, 0);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int write_lock_session(skidLockSession_ptr session, const char *msg)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+    off_t offset = 0;     // The session fd's current offset
+    size_t msg_len = 0;   // Length of msg
+
+    // INPUT VALIDATION
+    result = validate_lock_session(session, true);
+    if (ENOERR == result && !msg)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    // Never write bytes the session hasn't locked
+    if (ENOERR == result)
+    {
+        msg_len = strlen(msg);
+        offset = lseek(session->fd, 0, SEEK_CUR);
+        if (-1 == offset)
+        {
+            result = errno;
+            PRINT_ERROR(The call to lseek() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (offset < session->start)
+        {
+            result = EINVAL;  // The offset is before the locked range
+        }
+        else if (session->len > 0 && (offset - session->start > session->len
+                                      || msg_len > session->len - (offset - session->start)))
+        {
+            result = EINVAL;  // msg would run past the end of the locked range
+        }
+    }
+
+    // WRITE IT
+    if (ENOERR == result)
+    {
+        result = write_fd(session->fd, msg);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int write_locked_fd(int fd, const char *msg)
 {
     // LOCAL VARIABLES
@@ -315,21 +804,24 @@ SKID_INTERNAL int call_fcntl(int *errnum, FcntlOptArg_t opt_arg, int fd, int cmd
 }
 
 
-SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type)
+SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type, off_t start,
+                                   off_t len)
 {
     // LOCAL VARIABLES
     int result = ENOERR;  // Errno values
     int retval = -1;      // Return value from fcntl()
-    // Flock struct
+    // Flock struct (l_pid must be 0 for the F_OFD_* commands)
     struct flock fl = {
         .l_type = lock_type,
         .l_whence = SEEK_SET,
-        .l_start = 0,
-        .l_len = 0,
+        .l_start = start,
+        .l_len = len,
+        .l_pid = 0,
     };
 
     // INPUT VALIDATION
-    if (F_SETLK != cmd && F_SETLKW != cmd && F_GETLK != cmd)
+    if (F_SETLK != cmd && F_SETLKW != cmd && F_GETLK != cmd && F_OFD_SETLK != cmd
+        && F_OFD_SETLKW != cmd && F_OFD_GETLK != cmd)
     {
         result = EOPNOTSUPP;  // Unsupported cmd
     }
@@ -359,6 +851,40 @@ SKID_INTERNAL int call_fcntl_flock(int *errnum, int fd, int cmd, short lock_type
 }
 
 
+SKID_INTERNAL int call_ofd_setlk(int fd, short lock_type, off_t start, off_t len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // TRY IT
+    call_fcntl_flock(&result, fd, F_OFD_SETLK, lock_type, start, len);
+    if (EACCES == result)
+    {
+        result = EAGAIN;  // POSIX allows either for a conflicting lock so pick one
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void count_lock_attempt(int result, bool contended, int64_t wait_ns)
+{
+    if (ENOERR == result)
+    {
+        atomic_fetch_add_explicit(&lock_acquired, 1, memory_order_relaxed);
+    }
+    if (true == contended)
+    {
+        atomic_fetch_add_explicit(&lock_contended, 1, memory_order_relaxed);
+        if (wait_ns > 0)
+        {
+            atomic_fetch_add_explicit(&lock_wait_ns, (uint64_t)wait_ns, memory_order_relaxed);
+        }
+    }
+}
+
+
 SKID_INTERNAL int get_fd_flags(int *errnum, int fd)
 {
     // LOCAL VARIABLES
@@ -375,3 +901,71 @@ SKID_INTERNAL int get_fd_flags(int *errnum, int fd)
     }
     return retval;
 }
+
+
+SKID_INTERNAL int64_t get_monotonic_ns(int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;         // Errno values
+    int64_t now = 0;             // The current time, in nanoseconds
+    struct timespec ts = { 0 };  // Argument to clock_gettime()
+
+    // GET IT
+    if (clock_gettime(CLOCK_MONOTONIC, &ts))
+    {
+        result = errno;
+        PRINT_ERROR(The call to clock_gettime() failed);
+        PRINT_ERRNO(result);
+    }
+    else
+    {
+        now = (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return now;
+}
+
+
+SKID_INTERNAL int validate_lock_session(const skidLockSession *session, bool need_write)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // INPUT VALIDATION
+    if (!session || SKID_BAD_FD == session->fd)
+    {
+        result = EINVAL;  // NULL pointer or no lock held
+    }
+    else if (true == need_write && F_WRLCK != session->lock_type)
+    {
+        result = EPERM;  // Writing under a read lock would defeat the purpose
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int validate_range_lock(short lock_type, off_t start, off_t len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // INPUT VALIDATION
+    if (F_RDLCK != lock_type && F_WRLCK != lock_type && F_UNLCK != lock_type)
+    {
+        result = EINVAL;  // Unsupported lock_type
+    }
+    else if (start < 0 || len < 0)
+    {
+        result = EINVAL;  // Negative ranges aren't supported
+    }
+
+    // DONE
+    return result;
+}
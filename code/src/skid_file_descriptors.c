@@ -2,20 +2,30 @@
  *    This library defines functionality to manage Linux file descriptors.
  */
 
+#define _GNU_SOURCE                     // Access to copy_file_range(), splice(), SEEK_DATA
+
 // #define SKID_DEBUG                          // Enable DEBUG logging
 
 #include <errno.h>                      // EINVAL
-#include <fcntl.h>                      // open()
+#include <fcntl.h>                      // open(), splice()
+#include <limits.h>                     // IOV_MAX
 #include <stddef.h>                     // size_t
 #include <string.h>                     // strlen()
-#include <unistd.h>                     // close()
+#include <sys/sendfile.h>               // sendfile()
+#include <sys/stat.h>                   // fstat()
+#include <sys/uio.h>                    // readv(), writev()
+#include <unistd.h>                     // close(), copy_file_range(), lseek()
 #include "skid_debug.h"                 // PRINT_ERROR()
 #include "skid_file_descriptors.h"      // close_fd()
 #include "skid_macros.h"                // ENOERR, SKID_BAD_FD, SKID_INTERNAL
-#include "skid_memory.h"                // alloc_skid_mem(), free_skid_mem()
+#include "skid_memory.h"                // alloc_skid_mem(), free_skid_mem(), *_skid_buffer()
 #include "skid_validation.h"            // validate_skid_fd(), validate_skid_string()
 
-#define SKID_FD_BUFF_SIZE 1024  // Starting buffer size to read into
+#ifndef IOV_MAX
+#define IOV_MAX 1024                    // Linux's UIO_MAXIOV (not exposed without _XOPEN_SOURCE)
+#endif  /* IOV_MAX */
+#define SKID_COPY_CHUNK (size_t)0x40000000  // Maximum bytes requested by one kernel copy call
+#define SKID_COPY_BUFF_SIZE (128 * 1024)    // Size of the copy_fd() userspace fallback buffer
 
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
@@ -27,85 +37,157 @@ MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destruct
 
 /*
  *  Description:
- *      Determine if the bytes_read can fit into the output buffer based on its size and current
- *      length.
+ *      Advance the position within an iovec array by num_bytes.  Fully consumed entries, and any
+ *      zero-length entries that follow them, are skipped.  Call with num_bytes of 0 to skip
+ *      leading zero-length entries.
+ *
+ *  Args:
+ *      iov: The iovec array.
+ *      iovcnt: The number of entries in iov.
+ *      index: [In/Out] The index of the first entry that has not been fully consumed.  Set to
+ *          iovcnt once every entry has been consumed.
+ *      offset: [In/Out] The number of bytes already consumed from iov[*index].
+ *      num_bytes: The number of bytes just consumed by a system call.
+ */
+SKID_INTERNAL void advance_sfd_iov(const struct iovec *iov, int iovcnt, int *index, size_t *offset,
+                                   size_t num_bytes);
+
+/*
+ *  Description:
+ *      Determine how many iovec entries may be passed to one readv()/writev() call.
  *
  *  Args:
- *      bytes_read: The number of bytes to append to the output buffer.
- *      output_len: The number of bytes currently in the buffer.
- *      output_size: Total size of the output buffer.
+ *      remaining: The number of iovec entries left to process.
  *
  *  Returns:
- *      True if there's room.  False if there isn't (time to reallocate), on for invalid args.
+ *      The lesser of remaining and IOV_MAX.
  */
-SKID_INTERNAL bool check_for_space(size_t bytes_read, size_t output_len, size_t output_size);
+SKID_INTERNAL int calc_sfd_iovcnt(int remaining);
 
 /*
  *  Description:
- *      Check for an existing buffer pointer.  If one does not exist, make the first allocation.
+ *      Copy len bytes from in_fd at *in_off to out_fd at *out_off with copy_file_range().  Once
+ *      copy_file_range() is refused (e.g., EXDEV, ENOSYS, EOPNOTSUPP, EINVAL), *use_cfr is
+ *      cleared and pread()/pwrite() are used instead.  Neither file offset is changed.
  *
  *  Args:
- *      output_buf: [Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [Out] Pointer to the size of output_buf.
+ *      in_fd: Regular file to copy from.
+ *      out_fd: Regular file to copy to.
+ *      in_off: [In/Out] The in_fd offset.  Advanced by the number of bytes copied.
+ *      out_off: [In/Out] The out_fd offset.  Advanced by the number of bytes copied.
+ *      len: The number of bytes to copy.  Stops early if in_fd reaches EOF.
+ *      use_cfr: [In/Out] Whether to try copy_file_range().  Shared across calls so that a
+ *          refusal is only discovered once per copy.
  *
  *  Returns:
  *      ENOERR on success, errno on failure.
  */
-SKID_INTERNAL int check_for_pre_alloc(char **output_buf, size_t *output_size);
+SKID_INTERNAL int copy_sfd_range(int in_fd, int out_fd, off_t *in_off, off_t *out_off, size_t len,
+                                 bool *use_cfr);
 
 /*
  *  Description:
- *      Read the contents of the file descriptor into a heap-allocated buffer.  If the buffer ever
- *      fills then this function will (effectively) reallocate more space.  It will read until
- *      no other data can be read or an error occurred.  It is the caller's responsibility to
- *      free the buffer with free_skid_mem().
+ *      Copy a regular file to a regular file, segment by segment, skipping holes in in_fd when
+ *      out_fd is being extended (so no existing out_fd data needs to be overwritten with zeros).
+ *      A trailing hole is reproduced with ftruncate().  Both file offsets are advanced to the end
+ *      of the copy.
  *
  *  Args:
- *      fd: File descriptor to read from.
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
+ *      in_fd: Regular file to copy from.
+ *      out_fd: Regular file, not opened with O_APPEND, to copy to.
+ *      in_size: The size of in_fd.
+ *      out_size: The size of out_fd.
+ *      copied: [Out] The number of bytes copied, including skipped holes.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on failure.
+ */
+SKID_INTERNAL int copy_sfd_sparse(int in_fd, int out_fd, off_t in_size, off_t out_size,
+                                  size_t *copied);
+
+/*
+ *  Description:
+ *      Copy a regular file to any file descriptor with sendfile().  Falls back to
+ *      copy_sfd_userspace() if sendfile() refuses the pair before any data has moved.
+ *
+ *  Args:
+ *      in_fd: Regular file to copy from.  Its file offset is advanced.
+ *      out_fd: File descriptor to copy to.
+ *      copied: [Out] The number of bytes copied.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on failure.
+ */
+SKID_INTERNAL int copy_sfd_sendfile(int in_fd, int out_fd, size_t *copied);
+
+/*
+ *  Description:
+ *      Copy from in_fd to out_fd with splice().  If neither fd is a pipe, the data is spliced
+ *      through an internal pipe.  Falls back to copy_sfd_userspace() if splice() refuses
+ *      either fd.
+ *
+ *  Args:
+ *      in_fd: File descriptor to copy from.
+ *      out_fd: File descriptor to copy to.
+ *      is_pipe: True if either in_fd or out_fd is a pipe.
+ *      copied: [Out] The number of bytes copied.
  *
  *  Returns:
  *      ENOERR on success, errno on failure.
  */
-SKID_INTERNAL int read_fd_dynamic(int fd, char **output_buf, size_t *output_size);
+SKID_INTERNAL int copy_sfd_splice(int in_fd, int out_fd, bool is_pipe, size_t *copied);
 
 /*
  *  Description:
- *      Reallocate a buffer: allocate a new buffer double the *output_size, copy the contents of
- *      *output_buf into the new buffer, free the old buffer, update the Out arguments.
- *      It is the caller's responsibility to free the buffer with free_skid_mem().
+ *      Copy up to limit bytes through a userspace buffer.  If in_off and out_off are provided,
+ *      pread()/pwrite() are used and the file offsets are left untouched.  Otherwise, read() and
+ *      write() are used.
  *
  *  Args:
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
+ *      in_fd: File descriptor to copy from.
+ *      out_fd: File descriptor to copy to.
+ *      in_off: [Optional/In/Out] The in_fd offset to use.  Advanced by the number of bytes read.
+ *      out_off: [Optional/In/Out] The out_fd offset to use.  Advanced by the number of bytes
+ *          written.
+ *      limit: The maximum number of bytes to copy.  Use SKID_MAX_SZ to copy until EOF.
+ *      copied: [Out] The number of bytes copied.
  *
  *  Returns:
- *      ENOERR on success, errno on failure.  EOVERFLOW is used to indicate the output_size can not
- *      be doubled without overflowing the size_t data type.
+ *      ENOERR on success, errno on failure.
  */
-SKID_INTERNAL int realloc_fd_dynamic(char **output_buf, size_t *output_size);
+SKID_INTERNAL int copy_sfd_userspace(int in_fd, int out_fd, off_t *in_off, off_t *out_off,
+                                     size_t limit, size_t *copied);
 
 /*
  *  Description:
- *      Validate common In/Out args on behalf of the library.
+ *      Read the contents of the file descriptor directly into a skidBuffer, appending to any
+ *      existing contents.  If the buffer ever fills then this function will grow it.  It will read
+ *      until no other data can be read or an error occurred.  One byte is always reserved so the
+ *      buffer can be nul-terminated.
  *
  *  Args:
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
+ *      fd: File descriptor to read from.
+ *      buffer: [In/Out] The skidBuffer to read into.  New data is stored starting at
+ *          buffer->length and buffer->length is updated as data is read.
  *
  *  Returns:
- *      ENOERR on success, errno on failed validation.
+ *      ENOERR on success, errno on failure.  On failure, the buffer is left allocated (but may
+ *      contain partial data) and remains the caller's responsibility.
  */
-SKID_INTERNAL int validate_sfd_args(char **output_buf, size_t *output_size);
+SKID_INTERNAL int read_fd_dynamic(int fd, skidBuffer_ptr buffer);
+
+/*
+ *  Description:
+ *      Validate the iovec arguments on behalf of the public vectored I/O functions.
+ *
+ *  Args:
+ *      iov: Must not be NULL.
+ *      iovcnt: Must be positive.
+ *
+ *  Returns:
+ *      ENOERR on success, EINVAL on failure.
+ */
+SKID_INTERNAL int validate_sfd_iov(const struct iovec *iov, int iovcnt);
 
 /**************************************************************************************************/
 /********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
@@ -193,6 +275,84 @@ int call_dup2(int oldfd, int newfd, int *errnum)
 }
 
 
+int copy_fd(int in_fd, int out_fd, size_t *bytes_copied)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;              // Errno values
+    struct stat in_stat = { 0 };      // in_fd's metadata
+    struct stat out_stat = { 0 };     // out_fd's metadata
+    int out_flags = 0;                // out_fd's file status flags
+    size_t copied = 0;                // Number of bytes copied
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(in_fd);
+    if (ENOERR == result)
+    {
+        result = validate_skid_fd(out_fd);
+    }
+    if (ENOERR == result && in_fd == out_fd)
+    {
+        result = EINVAL;  // Copying a file descriptor onto itself is not supported
+        PRINT_ERROR(The in_fd and out_fd arguments may not be the same);
+    }
+
+    // INSPECT THEM
+    if (ENOERR == result)
+    {
+        if (fstat(in_fd, &in_stat) || fstat(out_fd, &out_stat))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fstat() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (S_ISREG(in_stat.st_mode) && in_stat.st_dev == out_stat.st_dev
+                 && in_stat.st_ino == out_stat.st_ino)
+        {
+            result = EINVAL;  // Copying a file onto itself could grow it forever
+            PRINT_ERROR(The in_fd and out_fd arguments refer to the same file);
+        }
+    }
+    if (ENOERR == result)
+    {
+        out_flags = fcntl(out_fd, F_GETFL);
+        if (out_flags < 0)
+        {
+            result = errno;
+            PRINT_ERROR(The call to fcntl() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // COPY IT
+    if (ENOERR == result)
+    {
+        // Pseudo-files (e.g., /proc) report a size of 0 so they're copied until EOF instead
+        if (S_ISREG(in_stat.st_mode) && S_ISREG(out_stat.st_mode) && !(out_flags & O_APPEND)
+            && in_stat.st_size > 0)
+        {
+            result = copy_sfd_sparse(in_fd, out_fd, in_stat.st_size, out_stat.st_size, &copied);
+        }
+        else if (S_ISREG(in_stat.st_mode))
+        {
+            result = copy_sfd_sendfile(in_fd, out_fd, &copied);
+        }
+        else
+        {
+            result = copy_sfd_splice(in_fd, out_fd,
+                                     S_ISFIFO(in_stat.st_mode) || S_ISFIFO(out_stat.st_mode),
+                                     &copied);
+        }
+    }
+
+    // DONE
+    if (NULL != bytes_copied)
+    {
+        *bytes_copied = copied;
+    }
+    return result;
+}
+
+
 int open_fd(const char *filename, int flags, mode_t mode, int *errnum)
 {
     // LOCAL VARIABLES
@@ -230,12 +390,95 @@ int open_fd(const char *filename, int flags, mode_t mode, int *errnum)
 char *read_fd(int fd, int *errnum)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;      // Errno values
-    char *output_buf = NULL;  // Output buffer containing the read contents of the file descriptor
-    size_t output_size = 0;   // The size of output_buf
+    size_t output_len = 0;  // The number of bytes read (unused)
+
+    // READ IT
+    return read_fd_len(fd, &output_len, errnum);
+}
+
+
+int read_fd_buf(int fd, skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Errno values
 
     // INPUT VALIDATION
-    if (errnum)
+    if (ENOERR == result)
+    {
+        result = clear_skid_buffer(buffer);  // Also validates buffer
+    }
+
+    // READ IT
+    if (ENOERR == result)
+    {
+        result = read_fd_dynamic(fd, buffer);
+        if (ENOERR != result)
+        {
+            clear_skid_buffer(buffer);  // Don't report partial data
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int read_fd_chunk(int fd, char *buf, size_t buf_size, bool read_something, size_t *num_read)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Errno values
+    ssize_t tmp_read = 0;               // Return value from read()
+
+    // INPUT VALIDATION
+    if (ENOERR == result && (NULL == buf || 0 == buf_size || NULL == num_read))
+    {
+        result = EINVAL;  // NULL pointer or nowhere to read to
+    }
+
+    // READ IT
+    if (ENOERR == result)
+    {
+        *num_read = 0;  // Stop, unless read() says otherwise
+        tmp_read = read(fd, buf, buf_size);
+        if (0 > tmp_read)
+        {
+            result = errno;
+            // Sometimes, fds flagged with O_NONBLOCK appear to use this on a partial
+            // read.  So, we're going to treat a partial read as a read and roll with it.
+            if ((EAGAIN == result || EWOULDBLOCK == result) && true == read_something)
+            {
+                result = ENOERR;  // At least one read worked so we're gonna roll with it.
+            }
+            else
+            {
+                PRINT_ERROR(The call to read() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+        else if (0 == tmp_read)
+        {
+            FPRINTF_ERR("%s - Call to read() reached EOF\n", DEBUG_INFO_STR);
+        }
+        else
+        {
+            *num_read = tmp_read;
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+char *read_fd_len(int fd, size_t *output_len, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;        // Errno values
+    skidBuffer buffer = { 0 };  // Working buffer containing the read contents of the fd
+    char *output_buf = NULL;    // Output buffer containing the read contents of the fd
+
+    // INPUT VALIDATION
+    if (errnum && output_len)
     {
         result = validate_skid_fd(fd);
     }
@@ -247,17 +490,24 @@ char *read_fd(int fd, int *errnum)
     // READ IT
     if (ENOERR == result)
     {
-        result = read_fd_dynamic(fd, &output_buf, &output_size);
+        result = read_fd_dynamic(fd, &buffer);
+    }
+    if (ENOERR == result)
+    {
+        output_buf = buffer.data;  // The caller now owns the allocation
     }
 
     // CLEAN UP
     if (ENOERR != result)
     {
-        free_skid_mem((void **)&output_buf);
-        output_size = 0;
+        free_skid_buffer(&buffer);  // Best effort
     }
 
     // DONE
+    if (output_len)
+    {
+        *output_len = buffer.length;
+    }
     if (errnum)
     {
         *errnum = result;
@@ -266,214 +516,401 @@ char *read_fd(int fd, int *errnum)
 }
 
 
-int write_fd(int fd, const char *msg)
+int read_fd_v(int fd, const struct iovec *iov, int iovcnt, size_t *bytes_read)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;      // Errno values
-    size_t msg_len = 0;       // Length of the msg string
-    ssize_t bytes_wrote = 0;  // Number of bytes written
+    int result = ENOERR;    // Errno values
+    size_t total = 0;       // Total number of bytes read
+    int index = 0;          // Index of the first iovec that has not been filled
+    size_t offset = 0;      // Number of bytes already read into iov[index]
+    ssize_t num_read = 0;   // Number of bytes read by one system call
 
     // INPUT VALIDATION
     result = validate_skid_fd(fd);
     if (ENOERR == result)
     {
-        result = validate_skid_string(msg, false);
+        result = validate_sfd_iov(iov, iovcnt);
+    }
+    if (ENOERR == result && NULL == bytes_read)
+    {
+        result = EINVAL;  // NULL pointer
     }
 
-    // WRITE IT
-    // Size it
+    // READ IT
     if (ENOERR == result)
     {
-        msg_len = strlen(msg);
+        advance_sfd_iov(iov, iovcnt, &index, &offset, 0);  // Skip leading zero-length entries
     }
-    // Write it
-    if (ENOERR == result)
+    while (ENOERR == result && index < iovcnt)
     {
-        errno = ENOERR;  // Clear errno
-        bytes_wrote = write(fd, (void *)msg, msg_len * sizeof(char));
-        if (bytes_wrote < 0)
+        if (offset > 0)
+        {
+            // Finish filling the partially filled iovec on its own
+            num_read = read(fd, (char *)iov[index].iov_base + offset, iov[index].iov_len - offset);
+        }
+        else
+        {
+            num_read = readv(fd, iov + index, calc_sfd_iovcnt(iovcnt - index));
+        }
+        if (0 > num_read)
         {
             result = errno;
-            PRINT_ERROR(The call to write() failed);
-            PRINT_ERRNO(result);
+            if ((EAGAIN == result || EWOULDBLOCK == result) && total > 0)
+            {
+                result = ENOERR;  // At least one read worked so we're gonna roll with it.
+            }
+            else
+            {
+                PRINT_ERROR(The call to readv() failed);
+                PRINT_ERRNO(result);
+            }
+            break;  // Error... let's stop
+        }
+        else if (0 == num_read)
+        {
+            FPRINTF_ERR("%s - Call to readv() reached EOF\n", DEBUG_INFO_STR);
+            break;  // Done reading
         }
-        else if (bytes_wrote < (msg_len * sizeof(char)))
+        else
         {
-            PRINT_WARNG(A partial write occurred);
-            result = write_fd(fd, msg + bytes_wrote);  // Finish the write or force an error
+            total += num_read;
+            advance_sfd_iov(iov, iovcnt, &index, &offset, num_read);
         }
     }
 
     // DONE
+    if (NULL != bytes_read)
+    {
+        *bytes_read = total;
+    }
     return result;
 }
 
 
-/**************************************************************************************************/
-/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
-/**************************************************************************************************/
-
-
-SKID_INTERNAL bool check_for_space(size_t bytes_read, size_t output_len, size_t output_size)
+int write_fd(int fd, const char *msg)
 {
     // LOCAL VARIABLES
-    bool has_room = false;  // Is there enough room in the output buffer to store bytes_read
+    int result = ENOERR;          // Errno values
+    struct iovec msg_iov = { 0 }; // The msg, as an iovec
 
-    // CHECK IT
-    if (bytes_read > 0 && output_size > 0)
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+    if (ENOERR == result)
     {
-        if ((output_size - output_len) >= bytes_read)
-        {
-            has_room = true;
-        }
+        result = validate_skid_string(msg, false);
+    }
+
+    // WRITE IT
+    if (ENOERR == result)
+    {
+        msg_iov.iov_base = (void *)msg;
+        msg_iov.iov_len = strlen(msg) * sizeof(char);
+        result = write_fd_v(fd, &msg_iov, 1, NULL);
     }
 
     // DONE
-    return has_room;
+    return result;
 }
 
 
-SKID_INTERNAL int check_for_pre_alloc(char **output_buf, size_t *output_size)
+int write_fd_v(int fd, const struct iovec *iov, int iovcnt, size_t *bytes_written)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;   // Success of execution
-    char *tmp_ptr = NULL;  // Return value from allocation
+    int result = ENOERR;    // Errno values
+    size_t total = 0;       // Total number of bytes written
+    int index = 0;          // Index of the first iovec that has not been completely written
+    size_t offset = 0;      // Number of bytes of iov[index] already written
+    ssize_t num_wrote = 0;  // Number of bytes written by one system call
 
     // INPUT VALIDATION
-    result = validate_sfd_args(output_buf, output_size);
+    result = validate_skid_fd(fd);
+    if (ENOERR == result)
+    {
+        result = validate_sfd_iov(iov, iovcnt);
+    }
 
-    // CHECK IT
+    // WRITE IT
     if (ENOERR == result)
     {
-        if (NULL == *output_buf)
+        advance_sfd_iov(iov, iovcnt, &index, &offset, 0);  // Skip leading zero-length entries
+    }
+    while (ENOERR == result && index < iovcnt)
+    {
+        if (offset > 0)
         {
-            tmp_ptr = alloc_skid_mem(SKID_FD_BUFF_SIZE, sizeof(char), &result);
-            if (NULL == tmp_ptr)
-            {
-                PRINT_ERROR(The call to alloc_skid_mem() failed);
-                PRINT_ERRNO(result);
-            }
-            else
+            // Finish the partially written iovec on its own
+            num_wrote = write(fd, (char *)iov[index].iov_base + offset,
+                              iov[index].iov_len - offset);
+        }
+        else
+        {
+            num_wrote = writev(fd, iov + index, calc_sfd_iovcnt(iovcnt - index));
+        }
+        if (0 > num_wrote)
+        {
+            result = errno;
+            PRINT_ERROR(The call to writev() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (0 == num_wrote)
+        {
+            result = EIO;  // No progress was made on a non-empty iovec
+            PRINT_ERROR(The call to writev() failed to make progress);
+        }
+        else
+        {
+            total += num_wrote;
+            advance_sfd_iov(iov, iovcnt, &index, &offset, num_wrote);
+            if (index < iovcnt)
             {
-                *output_buf = tmp_ptr;  // Store the pointer
-                *output_size = SKID_FD_BUFF_SIZE;  // Update the size
+                PRINT_WARNG(A partial write occurred);
             }
         }
     }
 
     // DONE
+    if (NULL != bytes_written)
+    {
+        *bytes_written = total;
+    }
     return result;
 }
 
 
-SKID_INTERNAL int read_fd_dynamic(int fd, char **output_buf, size_t *output_size)
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL void advance_sfd_iov(const struct iovec *iov, int iovcnt, int *index, size_t *offset,
+                                   size_t num_bytes)
 {
     // LOCAL VARIABLES
-    int result = validate_skid_fd(fd);          // Success of execution
-    char local_buf[SKID_FD_BUFF_SIZE] = { 0 };  // Local buffer
-    ssize_t num_read = 0;                       // Number of bytes read
-    size_t output_len = 0;                      // The length of *output_buf's string
-    char *tmp_ptr = NULL;                       // Temp pointer
-    bool read_something = false;                // Did one read work?
+    size_t remaining = 0;  // Unconsumed bytes in the current iovec
 
-    // INPUT VALIDATION
-    if (ENOERR == result)
+    // ADVANCE IT
+    while (*index < iovcnt)
     {
-        result = validate_sfd_args(output_buf, output_size);
+        remaining = iov[*index].iov_len - *offset;
+        if (num_bytes < remaining)
+        {
+            *offset += num_bytes;  // The current iovec was partially consumed
+            break;  // Done advancing
+        }
+        num_bytes -= remaining;  // The current iovec was fully consumed
+        (*index)++;
+        *offset = 0;
     }
+}
 
-    // SETUP
-    if (ENOERR == result)
-    {
-        result = check_for_pre_alloc(output_buf, output_size);
-    }
 
-    // READ DYNAMIC
-    if (ENOERR == result)
+SKID_INTERNAL int calc_sfd_iovcnt(int remaining)
+{
+    return (remaining > IOV_MAX) ? IOV_MAX : remaining;
+}
+
+
+SKID_INTERNAL int copy_sfd_range(int in_fd, int out_fd, off_t *in_off, off_t *out_off, size_t len,
+                                 bool *use_cfr)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;      // Errno values
+    ssize_t num_copied = 0;   // Number of bytes copied by one copy_file_range() call
+    size_t fallback_len = 0;  // Number of bytes copied by copy_sfd_userspace()
+
+    // COPY IT
+    while (ENOERR == result && len > 0)
     {
-        while (1)
+        if (true == *use_cfr)
         {
-            output_len = strlen(*output_buf);  // Get the current length of output_buf
-            // Read into local buff
-            num_read = read(fd, local_buf, sizeof(local_buf));
-            if (0 > num_read)
+            num_copied = copy_file_range(in_fd, in_off, out_fd, out_off,
+                                         (len > SKID_COPY_CHUNK) ? SKID_COPY_CHUNK : len, 0);
+            if (0 > num_copied)
             {
                 result = errno;
-                // Sometimes, fds flagged with O_NONBLOCK appear to use this on a partial
-                // read.  So, we're going to treat a partial read as a read and roll with it.
-                if ((EAGAIN == result || EWOULDBLOCK == result) && true == read_something)
+                if (EXDEV == result || ENOSYS == result || EOPNOTSUPP == result
+                    || EINVAL == result)
                 {
-                    result = ENOERR;  // At least one read worked so we're gonna roll with it.
+                    FPRINTF_ERR("%s copy_file_range() refused the copy, falling back\n",
+                                DEBUG_INFO_STR);
+                    *use_cfr = false;  // Don't bother trying again
+                    result = ENOERR;
                 }
                 else
                 {
-                    PRINT_ERROR(The call to read() failed);
+                    PRINT_ERROR(The call to copy_file_range() failed);
                     PRINT_ERRNO(result);
                 }
-                break;  // EOF or error... either way, let's stop
             }
-            else if (0 == num_read)
+            else if (0 == num_copied)
             {
-                 FPRINTF_ERR("%s - Call to read() reached EOF\n", DEBUG_INFO_STR);
-                 break;  // Done reading
+                break;  // EOF
             }
             else
             {
-                read_something = true;  // At least one read() worked
+                len -= num_copied;
             }
-            // Check for room
-            if (false == check_for_space(num_read, output_len, *output_size))
+        }
+        else
+        {
+            result = copy_sfd_userspace(in_fd, out_fd, in_off, out_off, len, &fallback_len);
+            break;  // copy_sfd_userspace() copies until len or EOF
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int copy_sfd_sparse(int in_fd, int out_fd, off_t in_size, off_t out_size,
+                                  size_t *copied)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;       // Errno values
+    off_t in_start = 0;        // in_fd's starting offset
+    off_t out_start = 0;       // out_fd's starting offset
+    off_t in_pos = 0;          // Current position within in_fd
+    off_t in_end = in_size;    // Where the copy ended within in_fd
+    off_t in_off = 0;          // Working in_fd offset for one segment
+    off_t out_off = 0;         // Working out_fd offset for one segment
+    off_t data = 0;            // Start of the next data segment
+    off_t hole = 0;            // End of the next data segment
+    bool skip_holes = false;   // Are holes being skipped?
+    bool use_cfr = true;       // Use copy_file_range()?
+
+    // SETUP
+    in_start = lseek(in_fd, 0, SEEK_CUR);
+    out_start = lseek(out_fd, 0, SEEK_CUR);
+    if (0 > in_start || 0 > out_start)
+    {
+        result = errno;
+        PRINT_ERROR(The call to lseek() failed);
+        PRINT_ERRNO(result);
+    }
+    else
+    {
+        in_pos = in_start;
+        in_end = (in_start > in_size) ? in_start : in_size;
+        skip_holes = (out_start >= out_size);  // Only skip holes that already read as zeros
+    }
+
+    // COPY IT
+    while (ENOERR == result && in_pos < in_end)
+    {
+        // Find the next data segment
+        data = in_pos;
+        hole = in_end;
+        if (true == skip_holes)
+        {
+            data = lseek(in_fd, in_pos, SEEK_DATA);
+            if (0 > data)
             {
-                // Not enough room?  Reallocate.
-                result = realloc_fd_dynamic(output_buf, output_size);
-                if (ENOERR != result)
+                data = in_pos;
+                if (ENXIO == errno)
                 {
-                    PRINT_ERROR(The call to realloc_fd_dynamic() failed);
-                    PRINT_ERRNO(result);
-                    break;  // Stop on error
+                    break;  // The rest of in_fd is a hole
                 }
-            }
-            // Copy local buff into *output_buf
-            if (true == check_for_space(num_read, output_len, *output_size))
-            {
-                strncat(*output_buf, local_buf, *output_size - output_len);  // Add local to output
-                memset(local_buf, 0x0, sizeof(local_buf));  // Zeroize the local buffer
+                skip_holes = false;  // SEEK_DATA isn't supported here so copy it all
             }
             else
             {
-                PRINT_ERROR(Logic Failure - realloc_fd_dynamic succeeded incorrectly);
-                result = EOVERFLOW;
+                hole = lseek(in_fd, data, SEEK_HOLE);
+                if (0 > hole || hole > in_end)
+                {
+                    hole = in_end;
+                }
             }
         }
+        if (data >= in_end)
+        {
+            break;  // Nothing left but a hole
+        }
+        // Copy the data segment
+        in_off = data;
+        out_off = out_start + (data - in_start);
+        result = copy_sfd_range(in_fd, out_fd, &in_off, &out_off, hole - data, &use_cfr);
+        in_pos = in_off;
+        if (ENOERR == result && in_off < hole)
+        {
+            in_end = in_off;  // in_fd shrank while being copied
+        }
+        if (out_off > out_size)
+        {
+            out_size = out_off;  // Keep track of how far out_fd has been extended
+        }
     }
 
-    // VERIFY NUL-TERMINATED
+    // FINISH IT
     if (ENOERR == result)
     {
-        if (output_len == *output_size)
+        // Reproduce a trailing hole
+        if (out_start + (in_end - in_start) > out_size)
         {
-            tmp_ptr = copy_skid_string(*output_buf, &result);
-            if (ENOERR == result)
+            if (ftruncate(out_fd, out_start + (in_end - in_start)))
             {
-                free_skid_mem((void **)output_buf);  // Free the old buffer
-                *output_buf = tmp_ptr;  // Save the new buffer
-                *output_size += 1;  // Made room for nul-termination
+                result = errno;
+                PRINT_ERROR(The call to ftruncate() failed);
+                PRINT_ERRNO(result);
             }
         }
+        in_pos = in_end;
+    }
+    if (ENOERR == result)
+    {
+        // Leave the file offsets at the end of the copy
+        if (0 > lseek(in_fd, in_end, SEEK_SET)
+            || 0 > lseek(out_fd, out_start + (in_end - in_start), SEEK_SET))
+        {
+            result = errno;
+            PRINT_ERROR(The call to lseek() failed);
+            PRINT_ERRNO(result);
+        }
     }
 
-    // CLEANUP
-    if (ENOERR != result)
+    // DONE
+    *copied = (in_pos > in_start) ? (size_t)(in_pos - in_start) : 0;
+    return result;
+}
+
+
+SKID_INTERNAL int copy_sfd_sendfile(int in_fd, int out_fd, size_t *copied)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;      // Errno values
+    ssize_t num_sent = 0;     // Number of bytes copied by one sendfile() call
+    size_t fallback_len = 0;  // Number of bytes copied by copy_sfd_userspace()
+
+    // COPY IT
+    *copied = 0;
+    while (ENOERR == result)
     {
-        // output_buf
-        free_skid_mem((void **)output_buf);
-        // output_size
-        if (output_size)
+        num_sent = sendfile(out_fd, in_fd, NULL, SKID_COPY_CHUNK);
+        if (0 > num_sent)
         {
-            *output_size = 0;
+            result = errno;
+            if (0 == *copied && (EINVAL == result || ENOSYS == result))
+            {
+                FPRINTF_ERR("%s sendfile() refused the copy, falling back\n", DEBUG_INFO_STR);
+                result = copy_sfd_userspace(in_fd, out_fd, NULL, NULL, SKID_MAX_SZ,
+                                            &fallback_len);
+                *copied += fallback_len;
+            }
+            else
+            {
+                PRINT_ERROR(The call to sendfile() failed);
+                PRINT_ERRNO(result);
+            }
+            break;  // Either way, we're done
+        }
+        else if (0 == num_sent)
+        {
+            break;  // EOF
+        }
+        else
+        {
+            *copied += num_sent;
         }
-        // tmp_ptr
-        free_skid_mem((void **)&tmp_ptr);
     }
 
     // DONE
@@ -481,68 +918,217 @@ SKID_INTERNAL int read_fd_dynamic(int fd, char **output_buf, size_t *output_size
 }
 
 
-SKID_INTERNAL int realloc_fd_dynamic(char **output_buf, size_t *output_size)
+SKID_INTERNAL int copy_sfd_splice(int in_fd, int out_fd, bool is_pipe, size_t *copied)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;   // Success of execution
-    size_t new_size = 0;   // New size of the allocation
-    char *tmp_ptr = NULL;  // Return value from allocation
+    int result = ENOERR;                                 // Errno values
+    int pipe_fds[2] = { SKID_BAD_FD, SKID_BAD_FD };      // Internal pipe
+    unsigned int flags = SPLICE_F_MOVE | SPLICE_F_MORE;  // Flags for splice()
+    ssize_t num_in = 0;                                  // Number of bytes spliced from in_fd
+    ssize_t num_out = 0;                                 // Number of bytes spliced to out_fd
+    size_t fallback_len = 0;                             // Bytes copied by copy_sfd_userspace()
+    bool fall_back = false;                              // Use copy_sfd_userspace() for the rest
 
-    // INPUT VALIDATION
-    result = validate_sfd_args(output_buf, output_size);
-    if (ENOERR == result)
+    // SETUP
+    *copied = 0;
+    if (false == is_pipe)
     {
-        if (0 >= *output_size)
+        if (pipe2(pipe_fds, O_CLOEXEC))
         {
-            result = EINVAL;  // They should have called check_for_pre_alloc()
+            result = errno;
+            PRINT_ERROR(The call to pipe2() failed);
+            PRINT_ERRNO(result);
         }
     }
 
-    // REALLOCATE
-    // Determine new size
-    if (ENOERR == result)
+    // COPY IT
+    while (ENOERR == result && false == fall_back)
     {
-        // Check for maximum
-        if (SKID_MAX_SZ == *output_size)
+        // Pull data from in_fd
+        num_in = splice(in_fd, NULL, (true == is_pipe) ? out_fd : pipe_fds[1], NULL,
+                        SKID_COPY_CHUNK, flags);
+        if (0 > num_in)
         {
-            result = EOVERFLOW;  // Buffer size is already at its maximum value
+            result = errno;
+            if (EINVAL == result && 0 == *copied)
+            {
+                result = ENOERR;
+                fall_back = true;  // splice() doesn't support one of these fds
+            }
+            else
+            {
+                PRINT_ERROR(The call to splice() failed);
+                PRINT_ERRNO(result);
+            }
+            break;  // Either way, stop splicing
         }
-        // Check for overflow
-        else if (*output_size > (SKID_MAX_SZ - *output_size))
+        else if (0 == num_in)
         {
-            result = EOVERFLOW;  // Not enough room left to double it
+            break;  // EOF
         }
-        else
+        else if (true == is_pipe)
         {
-            new_size = 2 * (*output_size);
+            *copied += num_in;  // Direct splice, all done
+            continue;
+        }
+        // Push it from the internal pipe to out_fd
+        while (num_in > 0)
+        {
+            num_out = splice(pipe_fds[0], NULL, out_fd, NULL, num_in, flags);
+            if (0 > num_out)
+            {
+                result = errno;
+                if (EINVAL == result)
+                {
+                    // out_fd doesn't support splice() so drain the pipe the old-fashioned way
+                    result = copy_sfd_userspace(pipe_fds[0], out_fd, NULL, NULL, num_in,
+                                                &fallback_len);
+                    *copied += fallback_len;
+                    fall_back = true;
+                }
+                else
+                {
+                    PRINT_ERROR(The call to splice() failed);
+                    PRINT_ERRNO(result);
+                }
+                break;  // Stop pushing
+            }
+            num_in -= num_out;
+            *copied += num_out;
         }
     }
-    // Allocate
-    if (ENOERR == result)
+    if (ENOERR == result && true == fall_back)
+    {
+        FPRINTF_ERR("%s splice() refused the copy, falling back\n", DEBUG_INFO_STR);
+        result = copy_sfd_userspace(in_fd, out_fd, NULL, NULL, SKID_MAX_SZ, &fallback_len);
+        *copied += fallback_len;
+    }
+
+    // CLEANUP
+    close_fd(&(pipe_fds[0]), true);  // Best effort
+    close_fd(&(pipe_fds[1]), true);  // Best effort
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int copy_sfd_userspace(int in_fd, int out_fd, off_t *in_off, off_t *out_off,
+                                     size_t limit, size_t *copied)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;    // Errno values
+    char *buff = NULL;      // Heap-allocated bounce buffer
+    size_t want = 0;        // Number of bytes to read this pass
+    ssize_t num_read = 0;   // Number of bytes read this pass
+    ssize_t num_wrote = 0;  // Number of bytes written by one call
+    ssize_t written = 0;    // Number of bytes written this pass
+
+    // SETUP
+    *copied = 0;
+    buff = alloc_skid_mem(SKID_COPY_BUFF_SIZE, sizeof(char), &result);
+
+    // COPY IT
+    while (ENOERR == result && *copied < limit)
     {
-        tmp_ptr = alloc_skid_mem(new_size, sizeof(char), &result);
-        if (NULL == tmp_ptr)
+        // Read
+        want = (limit - *copied > SKID_COPY_BUFF_SIZE) ? SKID_COPY_BUFF_SIZE : limit - *copied;
+        num_read = (NULL != in_off) ? pread(in_fd, buff, want, *in_off) : read(in_fd, buff, want);
+        if (0 > num_read)
         {
-            PRINT_ERROR(The call to alloc_skid_mem() failed);
+            result = errno;
+            PRINT_ERROR(The call to read() failed);
             PRINT_ERRNO(result);
+            break;  // Stop on error
+        }
+        else if (0 == num_read)
+        {
+            break;  // EOF
+        }
+        if (NULL != in_off)
+        {
+            *in_off += num_read;
+        }
+        // Write
+        for (written = 0; ENOERR == result && written < num_read; written += num_wrote)
+        {
+            num_wrote = (NULL != out_off)
+                        ? pwrite(out_fd, buff + written, num_read - written, *out_off)
+                        : write(out_fd, buff + written, num_read - written);
+            if (0 > num_wrote)
+            {
+                result = errno;
+                PRINT_ERROR(The call to write() failed);
+                PRINT_ERRNO(result);
+                num_wrote = 0;
+            }
+            else if (0 == num_wrote)
+            {
+                result = EIO;  // No progress was made
+                PRINT_ERROR(The call to write() failed to make progress);
+            }
+            else if (NULL != out_off)
+            {
+                *out_off += num_wrote;
+            }
+            *copied += num_wrote;
         }
     }
-    // Copy old into new
-    if (ENOERR == result)
+
+    // CLEANUP
+    if (NULL != buff)
     {
-        strncpy(tmp_ptr, *output_buf, *output_size);
+        free_skid_mem((void **)&buff);  // Best effort
     }
-    // Free old
-    if (ENOERR == result)
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int read_fd_dynamic(int fd, skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Success of execution
+    size_t num_read = 0;                // Number of bytes read
+    bool read_something = false;        // Did one read work?
+
+    // INPUT VALIDATION
+    if (ENOERR == result && NULL == buffer)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // READ DYNAMIC
+    while (ENOERR == result)
     {
-        result = free_skid_mem((void **)output_buf);
-        *output_size = 0;  // Zero out the size
+        // Check for room (always keep one byte in reserve for the nul-terminator)
+        if (buffer->length + 1 >= buffer->capacity)
+        {
+            // Not enough room?  Grow it.
+            result = grow_skid_buffer(buffer, buffer->length + 2);
+            if (ENOERR != result)
+            {
+                PRINT_ERROR(The call to grow_skid_buffer() failed);
+                PRINT_ERRNO(result);
+                break;  // Stop on error
+            }
+        }
+        // Read directly into the unused portion of the buffer
+        result = read_fd_chunk(fd, buffer->data + buffer->length,
+                               buffer->capacity - buffer->length - 1, read_something, &num_read);
+        if (0 == num_read)
+        {
+            break;  // EOF or error... either way, let's stop
+        }
+        read_something = true;  // At least one read() worked
+        buffer->length += num_read;  // Keep track of what's been stored
     }
-    // Update out arguments
+
+    // NUL-TERMINATE IT
     if (ENOERR == result)
     {
-        *output_buf = tmp_ptr;  // Store the pointer
-        *output_size = new_size;  // Update the size
+        buffer->data[buffer->length] = '\0';  // Room was reserved for this
     }
 
     // DONE
@@ -550,30 +1136,21 @@ SKID_INTERNAL int realloc_fd_dynamic(char **output_buf, size_t *output_size)
 }
 
 
-SKID_INTERNAL int validate_sfd_args(char **output_buf, size_t *output_size)
+SKID_INTERNAL int validate_sfd_iov(const struct iovec *iov, int iovcnt)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;  // Validation result
+    int result = ENOERR;  // Errno values
 
     // VALIDATE IT
-    // output_buf
-    if (NULL == output_buf)
+    if (NULL == iov)
     {
         result = EINVAL;  // NULL pointer
+        PRINT_ERROR(The iov argument may not be NULL);
     }
-    // output_size
-    else if (NULL == output_size)
+    else if (iovcnt < 1)
     {
-        result = EINVAL;  // NULL pointer
-    }
-    // output_buf && output_size
-    else
-    {
-        if (NULL != *output_buf && *output_size <= 0)
-        {
-            result = EINVAL;  // Buffer pointer exists but size is invalid
-            PRINT_ERROR(Invalid size of an existing buffer pointer);
-        }
+        result = EINVAL;  // Nothing to do
+        PRINT_ERROR(The iovcnt argument must be positive);
     }
 
     // DONE
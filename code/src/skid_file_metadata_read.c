@@ -2,14 +2,47 @@
  *  This library defines functionality to read, parse, and report on Linux file metadata.
  */
 
+#define _GNU_SOURCE                         // Access to statx()
+
 // #define SKID_DEBUG                          // Enable DEBUG logging
 
 #include "skid_debug.h"                     // PRINT_ERRNO()
 #include "skid_file_metadata_read.h"
 #include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
 #include "skid_validation.h"                // validate_skid_err(), validate_skid_pathname()
+#include <fcntl.h>                          // AT_EMPTY_PATH, AT_FDCWD, AT_SYMLINK_NOFOLLOW
+#include <pthread.h>                        // pthread_create(), pthread_join()
+#include <stdatomic.h>                      // atomic_bool, atomic_fetch_add(), atomic_size_t
 #include <string.h>                         // memset()
+#include <sys/stat.h>                       // fstatat()
+#include <sys/sysmacros.h>                  // makedev()
 #include <time.h>                           // localtime(), strftime()
+#include <unistd.h>                         // sysconf()
+
+// get_file_meta() hands its mask straight to statx()
+#if SKID_META_BASIC != STATX_BASIC_STATS || SKID_META_BTIME != STATX_BTIME
+#error "The SKID_META_* flags must match the STATX_* flags"
+#endif  /* SKID_META_* */
+
+#ifndef SKID_META_BATCH_CHUNK
+#define SKID_META_BATCH_CHUNK 64  // Entries a get_file_meta_batch() worker claims at a time
+#endif  /* SKID_META_BATCH_CHUNK */
+
+// The work shared by every get_file_meta_batch() worker.
+typedef struct _skidMetaBatch
+{
+    int dir_fd;                    // Directory relative pathnames are resolved against
+    const char *const *pathnames;  // The pathnames to take snapshots of
+    size_t num_paths;              // The number of entries in pathnames, metas, and errnums
+    unsigned int mask;             // The SKID_META_* fields to fetch
+    int flags;                     // statx() flags
+    skidFileMeta_ptr metas;        // [Out] One snapshot per pathname
+    int *errnums;                  // [Out] One errno value per pathname
+    atomic_size_t next;            // Index of the first entry no worker has claimed yet
+} skidMetaBatch, *skidMetaBatch_ptr;
+
+// Set once statx() proves unavailable (e.g., ENOSYS, seccomp's EPERM) so fstatat() goes first
+static atomic_bool sfmr_no_statx = false;
 
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
@@ -20,18 +53,16 @@ MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destruct
 /**************************************************************************************************/
 /*
  *  Description:
- *      Calls one of the stat-family functions based on caller arguments.  Defaults to stat().
- *      If pathname is a symbolic link and follow_sym is false, uses lstat() instead.
+ *      Calls statx(fd, "", AT_EMPTY_PATH) and updates meta.  Standardizes basic error handling.
  *  Args:
- *      pathname: Absolute or relative pathname to check with lstat().
- *      statbuf: [Out] Pointer to a stat struct to update with the results of the call to stat().
+ *      fd: File descriptor to check with statx().
+ *      mask: The SKID_META_* fields to fetch.
+ *      meta: [Out] Pointer to a skidFileMeta struct to update with the results of statx().
  *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
- *      follow_sym: If false, uses lstat() for symlinks.
  *  Returns:
- *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ *      An errno value indicating the results of execution.  ENOERR on success.
  */
-SKID_INTERNAL int call_a_stat(const char *pathname, struct stat *statbuf, int *errnum,
-                              bool follow_sym);
+SKID_INTERNAL int call_fstatx(int fd, unsigned int mask, skidFileMeta_ptr meta, int *errnum);
 
 /*
  *  Description:
@@ -59,6 +90,75 @@ SKID_INTERNAL int call_lstat(const char *pathname, struct stat *statbuf, int *er
  */
 SKID_INTERNAL int call_stat(const char *pathname, struct stat *statbuf, int *errnum);
 
+/*
+ *  Description:
+ *      Calls statx(pathname) for the fields in mask and stores them in meta.  Standardizes basic
+ *      error handling.  Underpins get_file_meta() and the pathname getters, which ask for
+ *      nothing but the field they report.
+ *  Args:
+ *      pathname: Absolute or relative pathname to check with statx().
+ *      mask: The SKID_META_* fields to fetch.
+ *      follow_sym: If false, uses AT_SYMLINK_NOFOLLOW, like lstat().
+ *      meta: [Out] Pointer to a skidFileMeta struct to update with the results of statx().
+ *      errnum: [Out] Stores the first errno value encountered here.  Set to ENOERR on success.
+ *  Returns:
+ *      An errno value indicating the results of execution.  ENOERR on success.
+ */
+SKID_INTERNAL int call_statx(const char *pathname, unsigned int mask, bool follow_sym,
+                             skidFileMeta_ptr meta, int *errnum);
+
+/*
+ *  Description:
+ *      Calls statx(dir_fd, pathname, flags, mask) and stores the results in meta.  If statx() is
+ *      unavailable (ENOSYS or EPERM), falls back to fstatat(dir_fd, pathname, flags), which
+ *      provides the SKID_META_BASIC fields but never SKID_META_BTIME.  Doesn't validate or log.
+ *  Args:
+ *      dir_fd: Directory relative pathnames are resolved against (or AT_FDCWD).
+ *      pathname: Pathname to check.  Use "" with AT_EMPTY_PATH to check dir_fd itself.
+ *      flags: AT_* flags shared by statx() and fstatat().
+ *      mask: The SKID_META_* fields to fetch.
+ *      meta: [Out] Pointer to a skidFileMeta struct to update.
+ *  Returns:
+ *      An errno value indicating the results of execution.  ENOERR on success.
+ */
+SKID_INTERNAL int fetch_sfmr_meta(int dir_fd, const char *pathname, int flags, unsigned int mask,
+                                  skidFileMeta_ptr meta);
+
+/*
+ *  Description:
+ *      A get_file_meta_batch() worker: claims SKID_META_BATCH_CHUNK entries at a time and
+ *      takes a snapshot of each until every entry is claimed.  Per-entry errors are recorded in
+ *      the batch's errnums and don't stop the worker.
+ *  Args:
+ *      arg: A skidMetaBatch_ptr.
+ *  Returns:
+ *      NULL.
+ */
+SKID_INTERNAL void *run_sfmr_batch(void *arg);
+
+/*
+ *  Description:
+ *      Translate a stat struct into meta, zeroizing it first.  Sets mask to SKID_META_BASIC
+ *      since stat has no birth time.
+ *  Args:
+ *      statbuf: The results of a successful fstatat() call.
+ *      meta: [Out] Pointer to the skidFileMeta struct to update.
+ *  Returns:
+ *      Nothing.
+ */
+SKID_INTERNAL void store_stat(const struct stat *statbuf, skidFileMeta_ptr meta);
+
+/*
+ *  Description:
+ *      Translate a statx struct into meta, zeroizing it first.
+ *  Args:
+ *      statx_struct: The results of a successful statx() call.
+ *      meta: [Out] Pointer to the skidFileMeta struct to update.
+ *  Returns:
+ *      Nothing.
+ */
+SKID_INTERNAL void store_statx(const struct statx *statx_struct, skidFileMeta_ptr meta);
+
 /*
  *  Description:
  *      Validates the input arguments and updates errnum accordingly.  Will update errnum unless
@@ -72,6 +172,21 @@ SKID_INTERNAL int call_stat(const char *pathname, struct stat *statbuf, int *err
  */
 SKID_INTERNAL int validate_call_input(const char *pathname, struct stat *statbuf, int *errnum);
 
+/*
+ *  Description:
+ *      Validates the input arguments of the get_meta_*_timestamp() accessors.
+ *  Args:
+ *      meta: Must be a non-NULL pointer.
+ *      field: The SKID_META_* timestamp flag meta must hold.
+ *      seconds: Non-NULL pointer.
+ *      nseconds: Non-NULL pointer.
+ *  Returns:
+ *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ *      ENODATA if meta doesn't hold field.
+ */
+SKID_INTERNAL int validate_meta_timestamp(const skidFileMeta *meta, unsigned int field,
+                                          time_t *seconds, long *nseconds);
+
 /*
  *  Description:
  *      Validates the input arguments and updates errnum accordingly.  Will update errnum unless
@@ -84,6 +199,20 @@ SKID_INTERNAL int validate_call_input(const char *pathname, struct stat *statbuf
  */
 SKID_INTERNAL int validate_sfmr_input(const char *pathname, int *errnum);
 
+/*
+ *  Description:
+ *      Validates the input arguments of the get_meta_*() accessors and updates errnum
+ *      accordingly.  Will update errnum unless errnum is the cause of the problem.
+ *  Args:
+ *      meta: Must be a non-NULL pointer.
+ *      field: The SKID_META_* flag meta must hold, 0 for the fields every snapshot holds.
+ *      errnum: Must be a non-NULL pointer.  Set to ENOERR on success.
+ *  Returns:
+ *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ *      ENODATA if meta doesn't hold field.
+ */
+SKID_INTERNAL int validate_sfmr_meta(const skidFileMeta *meta, unsigned int field, int *errnum);
+
 /*
  *  Description:
  *      Validates the pathname input argument.
@@ -116,19 +245,82 @@ time_t get_access_time(const char *pathname, int *errnum, bool follow_sym)
 {
     // LOCAL VARIABLES
     time_t retval = 0;                                // Access time
+    long nseconds = 0;                                // Unused
     int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        err = get_access_timestamp(pathname, &retval, &nseconds, follow_sym);
+        *errnum = err;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+long get_access_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
+{
+    // LOCAL VARIABLES
+    long retval = 0;                                  // Access time nanoseconds
+    time_t seconds = 0;                               // Unused
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        err = get_access_timestamp(pathname, &seconds, &retval, follow_sym);
+        *errnum = err;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+int get_access_timestamp(const char *pathname, time_t *seconds, long *nseconds, bool follow_sym)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Result of the function call
+    skidFileMeta meta;    // Metadata snapshot
+
+    // INPUT VALIDATION
+    result = validate_timestamp(pathname, seconds, nseconds);
+
+    // GET IT
+    // Both halves from the same snapshot
+    if (ENOERR == result)
+    {
+        result = call_statx(pathname, SKID_META_ATIME, follow_sym, &meta, &result);
+    }
+    if (ENOERR == result)
+    {
+        result = get_meta_access_timestamp(&meta, seconds, nseconds);
+    }
+
+    // DONE
+    return result;
+}
+
+
+blkcnt_t get_block_count(const char *filename, int *errnum)
+{
+    // LOCAL VARIABLES
+    blkcnt_t retval = 0;                              // Block count
+    int err = validate_sfmr_input(filename, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_a_stat(pathname, &stat_struct, errnum, follow_sym);
+        err = call_statx(filename, SKID_META_BLOCKS, true, &meta, errnum);
     }
-    // Check it
+    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_atime;
+        retval = get_meta_block_count(&meta, errnum);
     }
 
     // DONE
@@ -136,23 +328,23 @@ time_t get_access_time(const char *pathname, int *errnum, bool follow_sym)
 }
 
 
-long get_access_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
+blksize_t get_block_size(const char *filename, int *errnum)
 {
     // LOCAL VARIABLES
-    long retval = 0;                                  // Access time nanoseconds
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    blksize_t retval = 0;                             // Block size
+    int err = validate_sfmr_input(filename, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_a_stat(pathname, &stat_struct, errnum, follow_sym);
+        err = call_statx(filename, 0, true, &meta, errnum);
     }
-    // Check it
+    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_atim.tv_nsec;
+        retval = get_meta_block_size(&meta, errnum);
     }
 
     // DONE
@@ -160,24 +352,62 @@ long get_access_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
 }
 
 
-int get_access_timestamp(const char *pathname, time_t *seconds, long *nseconds, bool follow_sym)
+time_t get_change_time(const char *pathname, int *errnum, bool follow_sym)
+{
+    // LOCAL VARIABLES
+    time_t retval = 0;                                // Change time
+    long nseconds = 0;                                // Unused
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        err = get_change_timestamp(pathname, &retval, &nseconds, follow_sym);
+        *errnum = err;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+long get_change_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
+{
+    // LOCAL VARIABLES
+    long retval = 0;                                  // Change time nanoseconds
+    time_t seconds = 0;                               // Unused
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        err = get_change_timestamp(pathname, &seconds, &retval, follow_sym);
+        *errnum = err;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+int get_change_timestamp(const char *pathname, time_t *seconds, long *nseconds, bool follow_sym)
 {
     // LOCAL VARIABLES
     int result = ENOERR;  // Result of the function call
+    skidFileMeta meta;    // Metadata snapshot
 
     // INPUT VALIDATION
     result = validate_timestamp(pathname, seconds, nseconds);
 
     // GET IT
-    // seconds
+    // Both halves from the same snapshot
     if (ENOERR == result)
     {
-        *seconds = get_access_time(pathname, &result, follow_sym);
+        result = call_statx(pathname, SKID_META_CTIME, follow_sym, &meta, &result);
     }
-    // nseconds
     if (ENOERR == result)
     {
-        *nseconds = get_access_time_nsecs(pathname, &result, follow_sym);
+        result = get_meta_change_timestamp(&meta, seconds, nseconds);
     }
 
     // DONE
@@ -185,48 +415,411 @@ int get_access_timestamp(const char *pathname, time_t *seconds, long *nseconds,
 }
 
 
-blkcnt_t get_block_count(const char *filename, int *errnum)
+dev_t get_container_device_id(const char *pathname, int *errnum)
 {
     // LOCAL VARIABLES
-    blkcnt_t retval = 0;                              // Block count
+    dev_t retval = 0;                                 // Container device id
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
+
+    // GET IT
+    // Fetch metadata
+    if (ENOERR == err)
+    {
+        err = call_statx(pathname, 0, true, &meta, errnum);
+    }
+    // Get it
+    if (ENOERR == err)
+    {
+        retval = get_meta_container_device_id(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+dev_t get_file_device_id(const char *pathname, int *errnum)
+{
+    // LOCAL VARIABLES
+    dev_t retval = 0;                                 // File device id
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
+
+    // GET IT
+    // Fetch metadata
+    if (ENOERR == err)
+    {
+        err = call_statx(pathname, 0, true, &meta, errnum);
+    }
+    // Get it
+    if (ENOERR == err)
+    {
+        retval = get_meta_file_device_id(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+int get_file_meta(const char *pathname, unsigned int mask, bool follow_sym,
+                  skidFileMeta_ptr meta)
+{
+    // LOCAL VARIABLES
+    int result = validate_sfmr_pathname(pathname);  // Errno value
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        result = call_statx(pathname, mask, follow_sym, meta, &result);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_file_meta_at(int dir_fd, const char *pathname, unsigned int mask, bool follow_sym,
+                     skidFileMeta_ptr meta)
+{
+    // LOCAL VARIABLES
+    int result = validate_sfmr_pathname(pathname);               // Errno value
+    int flags = (true == follow_sym) ? 0 : AT_SYMLINK_NOFOLLOW;  // statx() flags
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+    else if (ENOERR == result && AT_FDCWD != dir_fd)
+    {
+        result = validate_skid_fd(dir_fd);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        result = fetch_sfmr_meta(dir_fd, pathname, flags, mask, meta);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to statx() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_file_meta_batch(int dir_fd, const char *const *pathnames, size_t num_paths,
+                        unsigned int mask, bool follow_sym, unsigned int num_threads,
+                        skidFileMeta_ptr metas, int *errnums)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                              // Errno value
+    skidMetaBatch batch;                              // The work to share
+    pthread_t threads[SKID_META_MAX_THREADS];         // Helper threads
+    bool started[SKID_META_MAX_THREADS] = { false };  // Was threads[i] started?
+    long num_cpus = 0;                                // Number of online CPUs
+    size_t num_chunks = 0;                            // Number of entry chunks to claim
+    unsigned int i = 0;                               // Iterating variable
+
+    // INPUT VALIDATION
+    if (!pathnames || !metas || !errnums)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null pointer);
+    }
+    else if (AT_FDCWD != dir_fd)
+    {
+        result = validate_skid_fd(dir_fd);
+    }
+
+    // SETUP
+    if (ENOERR == result && num_paths > 0)
+    {
+        batch.dir_fd = dir_fd;
+        batch.pathnames = pathnames;
+        batch.num_paths = num_paths;
+        batch.mask = mask;
+        batch.flags = (true == follow_sym) ? 0 : AT_SYMLINK_NOFOLLOW;
+        batch.metas = metas;
+        batch.errnums = errnums;
+        atomic_init(&(batch.next), 0);
+        // Size it
+        if (0 == num_threads)
+        {
+            num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            num_threads = (num_cpus > 0) ? (unsigned int)num_cpus : 1;
+        }
+        if (num_threads > SKID_META_MAX_THREADS)
+        {
+            num_threads = SKID_META_MAX_THREADS;
+        }
+        // There's no point in a worker that would never claim anything
+        num_chunks = (num_paths + SKID_META_BATCH_CHUNK - 1) / SKID_META_BATCH_CHUNK;
+        if (num_threads > num_chunks)
+        {
+            num_threads = (unsigned int)num_chunks;
+        }
+    }
+
+    // GET THEM
+    if (ENOERR == result && num_paths > 0)
+    {
+        // Start the helpers
+        for (i = 1; i < num_threads; i++)
+        {
+            if (pthread_create(threads + i, NULL, run_sfmr_batch, &batch))
+            {
+                PRINT_WARNG(The call to pthread_create() failed so the batch has fewer workers);
+            }
+            else
+            {
+                started[i] = true;
+            }
+        }
+        // Work alongside them
+        run_sfmr_batch(&batch);
+        // Wait for them
+        for (i = 1; i < num_threads; i++)
+        {
+            if (true == started[i])
+            {
+                pthread_join(threads[i], NULL);
+            }
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_file_meta_fd(int fd, unsigned int mask, skidFileMeta_ptr meta)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Errno value
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        result = call_fstatx(fd, mask, meta, &result);
+    }
+
+    // DONE
+    return result;
+}
+
+
+mode_t get_file_perms(const char *pathname, int *errnum)
+{
+    // LOCAL VARIABLES
+    mode_t retval = 0;                                // File perms
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
+
+    // GET IT
+    // Fetch metadata
+    if (ENOERR == err)
+    {
+        err = call_statx(pathname, SKID_META_MODE, true, &meta, errnum);
+    }
+    // Get it
+    if (ENOERR == err)
+    {
+        retval = get_meta_file_perms(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+mode_t get_file_type(const char *filename, int *errnum)
+{
+    // LOCAL VARIABLES
+    mode_t retval = 0;                                // File type
     int err = validate_sfmr_input(filename, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_stat(filename, &stat_struct, errnum);
+        err = call_statx(filename, SKID_META_TYPE, true, &meta, errnum);
     }
-    // Check it
+    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_blocks;
+        retval = get_meta_file_type(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+gid_t get_group(const char *pathname, int *errnum, bool follow_sym)
+{
+    // LOCAL VARIABLES
+    gid_t retval = 0;                                 // GUID
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
+
+    // GET IT
+    // Fetch metadata
+    if (ENOERR == err)
+    {
+        err = call_statx(pathname, SKID_META_GID, follow_sym, &meta, errnum);
+    }
+    // Get it
+    if (ENOERR == err)
+    {
+        retval = get_meta_group(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+nlink_t get_hard_link_num(const char *pathname, int *errnum)
+{
+    // LOCAL VARIABLES
+    nlink_t retval = 0;                               // Number of hard links
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
+    skidFileMeta meta;                                // Metadata snapshot
+
+    // GET IT
+    // Fetch metadata
+    if (ENOERR == err)
+    {
+        err = call_statx(pathname, SKID_META_NLINK, true, &meta, errnum);
+    }
+    // Get it
+    if (ENOERR == err)
+    {
+        retval = get_meta_hard_link_num(&meta, errnum);
+    }
+
+    // DONE
+    return retval;
+}
+
+
+int get_meta_access_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds)
+{
+    // LOCAL VARIABLES
+    int result = validate_meta_timestamp(meta, SKID_META_ATIME, seconds, nseconds);  // Errno value
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        *seconds = meta->atime.tv_sec;
+        *nseconds = meta->atime.tv_nsec;
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_meta_birth_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds)
+{
+    // LOCAL VARIABLES
+    int result = validate_meta_timestamp(meta, SKID_META_BTIME, seconds, nseconds);  // Errno value
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        *seconds = meta->btime.tv_sec;
+        *nseconds = meta->btime.tv_nsec;
+    }
+
+    // DONE
+    return result;
+}
+
+
+blkcnt_t get_meta_block_count(const skidFileMeta *meta, int *errnum)
+{
+    // LOCAL VARIABLES
+    blkcnt_t retval = 0;                                           // Block count
+    int err = validate_sfmr_meta(meta, SKID_META_BLOCKS, errnum);  // Errno value
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        retval = meta->blocks;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+blksize_t get_meta_block_size(const skidFileMeta *meta, int *errnum)
+{
+    // LOCAL VARIABLES
+    blksize_t retval = 0;                           // Block size
+    int err = validate_sfmr_meta(meta, 0, errnum);  // Errno value
+
+    // GET IT
+    if (ENOERR == err)
+    {
+        retval = meta->blksize;
+    }
+
+    // DONE
+    return retval;
+}
+
+
+int get_meta_change_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds)
+{
+    // LOCAL VARIABLES
+    int result = validate_meta_timestamp(meta, SKID_META_CTIME, seconds, nseconds);  // Errno value
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        *seconds = meta->ctime.tv_sec;
+        *nseconds = meta->ctime.tv_nsec;
     }
 
     // DONE
-    return retval;
+    return result;
 }
 
 
-blksize_t get_block_size(const char *filename, int *errnum)
+dev_t get_meta_container_device_id(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    blksize_t retval = 0;                             // Block size
-    int err = validate_sfmr_input(filename, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    dev_t retval = 0;                               // Container device id
+    int err = validate_sfmr_meta(meta, 0, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_stat(filename, &stat_struct, errnum);
-    }
-    // Check it
-    if (ENOERR == err)
-    {
-        // The st_blksize field gives the "preferred" blocksize for efficient file system I/O.
-        retval = stat_struct.st_blksize;
+        retval = meta->rdev;
     }
 
     // DONE
@@ -234,23 +827,16 @@ blksize_t get_block_size(const char *filename, int *errnum)
 }
 
 
-time_t get_change_time(const char *pathname, int *errnum, bool follow_sym)
+dev_t get_meta_file_device_id(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    time_t retval = 0;                                // Change time
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    dev_t retval = 0;                               // File device id
+    int err = validate_sfmr_meta(meta, 0, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_a_stat(pathname, &stat_struct, errnum, follow_sym);
-    }
-    // Check it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_ctime;
+        retval = meta->dev;
     }
 
     // DONE
@@ -258,23 +844,16 @@ time_t get_change_time(const char *pathname, int *errnum, bool follow_sym)
 }
 
 
-long get_change_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
+mode_t get_meta_file_perms(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    long retval = 0;                                  // Change time nanoseconds
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    mode_t retval = 0;                                           // File perms
+    int err = validate_sfmr_meta(meta, SKID_META_MODE, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_a_stat(pathname, &stat_struct, errnum, follow_sym);
-    }
-    // Check it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_ctim.tv_nsec;
+        retval = meta->mode & (S_ISUID | S_ISGID | S_ISVTX | S_IRWXU | S_IRWXG | S_IRWXO);
     }
 
     // DONE
@@ -282,48 +861,33 @@ long get_change_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
 }
 
 
-int get_change_timestamp(const char *pathname, time_t *seconds, long *nseconds, bool follow_sym)
+mode_t get_meta_file_type(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;  // Result of the function call
-
-    // INPUT VALIDATION
-    result = validate_timestamp(pathname, seconds, nseconds);
+    mode_t retval = 0;                                           // File type
+    int err = validate_sfmr_meta(meta, SKID_META_TYPE, errnum);  // Errno value
 
     // GET IT
-    // seconds
-    if (ENOERR == result)
-    {
-        *seconds = get_change_time(pathname, &result, follow_sym);
-    }
-    // nseconds
-    if (ENOERR == result)
+    if (ENOERR == err)
     {
-        *nseconds = get_change_time_nsecs(pathname, &result, follow_sym);
+        retval = meta->mode & S_IFMT;
     }
 
     // DONE
-    return result;
+    return retval;
 }
 
 
-dev_t get_container_device_id(const char *pathname, int *errnum)
+gid_t get_meta_group(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    dev_t retval = 0;                                 // Container device id
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    gid_t retval = 0;                                           // GUID
+    int err = validate_sfmr_meta(meta, SKID_META_GID, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_stat(pathname, &stat_struct, errnum);
-    }
-    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_rdev;
+        retval = meta->gid;
     }
 
     // DONE
@@ -331,23 +895,16 @@ dev_t get_container_device_id(const char *pathname, int *errnum)
 }
 
 
-dev_t get_file_device_id(const char *pathname, int *errnum)
+nlink_t get_meta_hard_link_num(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    dev_t retval = 0;                                 // File device id
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    nlink_t retval = 0;                                           // Number of hard links
+    int err = validate_sfmr_meta(meta, SKID_META_NLINK, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_stat(pathname, &stat_struct, errnum);
-    }
-    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_dev;
+        retval = meta->nlink;
     }
 
     // DONE
@@ -355,49 +912,33 @@ dev_t get_file_device_id(const char *pathname, int *errnum)
 }
 
 
-mode_t get_file_perms(const char *pathname, int *errnum)
+int get_meta_mod_timestamp(const skidFileMeta *meta, time_t *seconds, long *nseconds)
 {
     // LOCAL VARIABLES
-    mode_t perm_mask = S_ISUID | S_ISGID | S_ISVTX | S_IRWXU | S_IRWXG | S_IRWXO;  // Perm bitmask
-    mode_t retval = 0;                                                             // File perms
-    int err = validate_sfmr_input(pathname, errnum);                               // Errno value
-    struct stat stat_struct;                                                       // stat struct
+    int result = validate_meta_timestamp(meta, SKID_META_MTIME, seconds, nseconds);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_stat(pathname, &stat_struct, errnum);
-    }
-    // Get it
-    if (ENOERR == err)
+    if (ENOERR == result)
     {
-        retval = stat_struct.st_mode & perm_mask;
+        *seconds = meta->mtime.tv_sec;
+        *nseconds = meta->mtime.tv_nsec;
     }
 
     // DONE
-    return retval;
+    return result;
 }
 
 
-mode_t get_file_type(const char *filename, int *errnum)
+uid_t get_meta_owner(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    mode_t retval = 0;                                // File type
-    int err = validate_sfmr_input(filename, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    uid_t retval = 0;                                           // UID
+    int err = validate_sfmr_meta(meta, SKID_META_UID, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_stat(filename, &stat_struct, errnum);
-    }
-    // Check it
     if (ENOERR == err)
     {
-        // S_IFMT is the bit mask for the file type bit field
-        retval = stat_struct.st_mode & S_IFMT;
+        retval = meta->uid;
     }
 
     // DONE
@@ -405,30 +946,16 @@ mode_t get_file_type(const char *filename, int *errnum)
 }
 
 
-gid_t get_group(const char *pathname, int *errnum, bool follow_sym)
+ino_t get_meta_serial_num(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    gid_t retval = 0;                                 // GUID
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    ino_t retval = 0;                                           // Inode number
+    int err = validate_sfmr_meta(meta, SKID_META_INO, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        if (true == follow_sym)
-        {
-            err = call_stat(pathname, &stat_struct, errnum);
-        }
-        else
-        {
-            err = call_lstat(pathname, &stat_struct, errnum);
-        }
-    }
-    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_gid;
+        retval = meta->ino;
     }
 
     // DONE
@@ -436,23 +963,16 @@ gid_t get_group(const char *pathname, int *errnum, bool follow_sym)
 }
 
 
-nlink_t get_hard_link_num(const char *pathname, int *errnum)
+off_t get_meta_size(const skidFileMeta *meta, int *errnum)
 {
     // LOCAL VARIABLES
-    nlink_t retval = 0;                               // Number of hard links
-    int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    off_t retval = 0;                                            // Size
+    int err = validate_sfmr_meta(meta, SKID_META_SIZE, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_stat(pathname, &stat_struct, errnum);
-    }
-    // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_nlink;
+        retval = meta->size;
     }
 
     // DONE
@@ -460,23 +980,18 @@ nlink_t get_hard_link_num(const char *pathname, int *errnum)
 }
 
 
-time_t get_mod_time(const char *filename, int *errnum, bool follow_sym)
+time_t get_mod_time(const char *pathname, int *errnum, bool follow_sym)
 {
     // LOCAL VARIABLES
     time_t retval = 0;                                // Modification time
-    int err = validate_sfmr_input(filename, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    long nseconds = 0;                                // Unused
+    int err = validate_sfmr_input(pathname, errnum);  // Errno value
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_a_stat(filename, &stat_struct, errnum, follow_sym);
-    }
-    // Check it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_mtime;
+        err = get_mod_timestamp(pathname, &retval, &nseconds, follow_sym);
+        *errnum = err;
     }
 
     // DONE
@@ -488,19 +1003,14 @@ long get_mod_time_nsecs(const char *pathname, int *errnum, bool follow_sym)
 {
     // LOCAL VARIABLES
     long retval = 0;                                  // Modification time nanoseconds
+    time_t seconds = 0;                               // Unused
     int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
 
     // GET IT
-    // Fetch metadata
-    if (ENOERR == err)
-    {
-        err = call_a_stat(pathname, &stat_struct, errnum, follow_sym);
-    }
-    // Check it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_mtim.tv_nsec;
+        err = get_mod_timestamp(pathname, &seconds, &retval, follow_sym);
+        *errnum = err;
     }
 
     // DONE
@@ -512,20 +1022,20 @@ int get_mod_timestamp(const char *pathname, time_t *seconds, long *nseconds, boo
 {
     // LOCAL VARIABLES
     int result = ENOERR;  // Result of the function call
+    skidFileMeta meta;    // Metadata snapshot
 
     // INPUT VALIDATION
     result = validate_timestamp(pathname, seconds, nseconds);
 
     // GET IT
-    // seconds
+    // Both halves from the same snapshot
     if (ENOERR == result)
     {
-        *seconds = get_mod_time(pathname, &result, follow_sym);
+        result = call_statx(pathname, SKID_META_MTIME, follow_sym, &meta, &result);
     }
-    // nseconds
     if (ENOERR == result)
     {
-        *nseconds = get_mod_time_nsecs(pathname, &result, follow_sym);
+        result = get_meta_mod_timestamp(&meta, seconds, nseconds);
     }
 
     // DONE
@@ -538,25 +1048,18 @@ uid_t get_owner(const char *pathname, int *errnum, bool follow_sym)
     // LOCAL VARIABLES
     uid_t retval = 0;                                 // UID
     int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        if (true == follow_sym)
-        {
-            err = call_stat(pathname, &stat_struct, errnum);
-        }
-        else
-        {
-            err = call_lstat(pathname, &stat_struct, errnum);
-        }
+        err = call_statx(pathname, SKID_META_UID, follow_sym, &meta, errnum);
     }
     // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_uid;
+        retval = get_meta_owner(&meta, errnum);
     }
 
     // DONE
@@ -569,18 +1072,18 @@ ino_t get_serial_num(const char *pathname, int *errnum)
     // LOCAL VARIABLES
     ino_t retval = 0;                                 // Inode number
     int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_stat(pathname, &stat_struct, errnum);
+        err = call_statx(pathname, SKID_META_INO, true, &meta, errnum);
     }
     // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_ino;
+        retval = get_meta_serial_num(&meta, errnum);
     }
 
     // DONE
@@ -593,18 +1096,18 @@ off_t get_size(const char *pathname, int *errnum)
     // LOCAL VARIABLES
     off_t retval = 0;                                 // Size
     int err = validate_sfmr_input(pathname, errnum);  // Errno value
-    struct stat stat_struct;                          // stat struct
+    skidFileMeta meta;                                // Metadata snapshot
 
     // GET IT
     // Fetch metadata
     if (ENOERR == err)
     {
-        err = call_stat(pathname, &stat_struct, errnum);
+        err = call_statx(pathname, SKID_META_SIZE, true, &meta, errnum);
     }
     // Get it
     if (ENOERR == err)
     {
-        retval = stat_struct.st_size;
+        retval = get_meta_size(&meta, errnum);
     }
 
     // DONE
@@ -885,23 +1388,30 @@ bool is_sym_link(const char *filename, int *errnum)
 /**************************************************************************************************/
 
 
-SKID_INTERNAL int call_a_stat(const char *pathname, struct stat *statbuf, int *errnum,
-                              bool follow_sym)
+SKID_INTERNAL int call_fstatx(int fd, unsigned int mask, skidFileMeta_ptr meta, int *errnum)
 {
     // LOCAL VARIABLES
-    int result = validate_call_input(pathname, statbuf, errnum);  // Errno value
+    int result = validate_skid_err(errnum);  // Errno value
 
-    // CHECK FOR SYMLINK
+    // INPUT VALIDATION
     if (ENOERR == result)
     {
-        // CALL A STAT FUNCTION
-        if (true == is_sym_link(pathname, &result) && false == follow_sym)
-        {
-            result = call_lstat(pathname, statbuf, errnum);
-        }
-        else if (ENOERR == result)
+        result = validate_skid_fd(fd);
+    }
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // Invalid argument
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+
+    // CALL STATX
+    if (ENOERR == result)
+    {
+        result = fetch_sfmr_meta(fd, "", AT_EMPTY_PATH, mask, meta);
+        if (ENOERR != result)
         {
-            result = call_stat(pathname, statbuf, errnum);
+            PRINT_ERROR(The call to statx() failed);
+            PRINT_ERRNO(result);
         }
     }
 
@@ -964,6 +1474,177 @@ SKID_INTERNAL int call_stat(const char *pathname, struct stat *statbuf, int *err
 }
 
 
+SKID_INTERNAL int call_statx(const char *pathname, unsigned int mask, bool follow_sym,
+                             skidFileMeta_ptr meta, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = validate_sfmr_input(pathname, errnum);          // Errno value
+    int flags = (true == follow_sym) ? 0 : AT_SYMLINK_NOFOLLOW;  // statx() flags
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // Invalid argument
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+
+    // CALL STATX
+    if (ENOERR == result)
+    {
+        result = fetch_sfmr_meta(AT_FDCWD, pathname, flags, mask, meta);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to statx() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return result;
+}
+
+
+SKID_INTERNAL int fetch_sfmr_meta(int dir_fd, const char *pathname, int flags, unsigned int mask,
+                                  skidFileMeta_ptr meta)
+{
+    // LOCAL VARIABLES
+    int result = ENOSYS;        // Errno value
+    struct statx statx_struct;  // statx struct
+    struct stat stat_struct;    // fstatat() fallback
+
+    // TRY STATX
+    if (false == atomic_load(&sfmr_no_statx))
+    {
+        if (statx(dir_fd, pathname, flags, mask, &statx_struct))
+        {
+            result = errno;
+            if (ENOSYS == result || EPERM == result)
+            {
+                atomic_store(&sfmr_no_statx, true);  // Don't bother next time
+            }
+        }
+        else
+        {
+            store_statx(&statx_struct, meta);
+            result = ENOERR;
+        }
+    }
+
+    // FALL BACK TO FSTATAT
+    if (ENOSYS == result || EPERM == result)
+    {
+        if (fstatat(dir_fd, pathname, &stat_struct, flags))
+        {
+            result = errno;
+        }
+        else
+        {
+            store_stat(&stat_struct, meta);
+            result = ENOERR;
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void *run_sfmr_batch(void *arg)
+{
+    // LOCAL VARIABLES
+    skidMetaBatch_ptr batch = (skidMetaBatch_ptr)arg;  // The work to share
+    const char *pathname = NULL;                       // The pathname of the current entry
+    size_t first = 0;                                  // The first entry of a claimed chunk
+    size_t last = 0;                                   // One past the last entry of the chunk
+    size_t i = 0;                                      // Iterating variable
+
+    // GET THEM
+    while (true)
+    {
+        // Claim a chunk
+        first = atomic_fetch_add(&(batch->next), SKID_META_BATCH_CHUNK);
+        if (first >= batch->num_paths)
+        {
+            break;  // All claimed
+        }
+        last = first + SKID_META_BATCH_CHUNK;
+        if (last > batch->num_paths)
+        {
+            last = batch->num_paths;
+        }
+        // Take a snapshot of each entry
+        for (i = first; i < last; i++)
+        {
+            pathname = batch->pathnames[i];
+            if (!pathname)
+            {
+                batch->errnums[i] = EINVAL;  // NULL pointer
+            }
+            else
+            {
+                batch->errnums[i] = fetch_sfmr_meta(batch->dir_fd, pathname, batch->flags,
+                                                    batch->mask, batch->metas + i);
+            }
+        }
+    }
+
+    // DONE
+    return NULL;
+}
+
+
+SKID_INTERNAL void store_stat(const struct stat *statbuf, skidFileMeta_ptr meta)
+{
+    memset(meta, 0x0, sizeof(*meta));
+    meta->mask = SKID_META_BASIC;
+    meta->mode = statbuf->st_mode;
+    meta->nlink = statbuf->st_nlink;
+    meta->uid = statbuf->st_uid;
+    meta->gid = statbuf->st_gid;
+    meta->ino = statbuf->st_ino;
+    meta->size = statbuf->st_size;
+    meta->blocks = statbuf->st_blocks;
+    meta->blksize = statbuf->st_blksize;
+    meta->dev = statbuf->st_dev;
+    meta->rdev = statbuf->st_rdev;
+    meta->atime.tv_sec = statbuf->st_atim.tv_sec;
+    meta->atime.tv_nsec = statbuf->st_atim.tv_nsec;
+    meta->ctime.tv_sec = statbuf->st_ctim.tv_sec;
+    meta->ctime.tv_nsec = statbuf->st_ctim.tv_nsec;
+    meta->mtime.tv_sec = statbuf->st_mtim.tv_sec;
+    meta->mtime.tv_nsec = statbuf->st_mtim.tv_nsec;
+}
+
+
+SKID_INTERNAL void store_statx(const struct statx *statx_struct, skidFileMeta_ptr meta)
+{
+    memset(meta, 0x0, sizeof(*meta));
+    meta->mask = statx_struct->stx_mask & SKID_META_ALL;
+    meta->mode = statx_struct->stx_mode;
+    meta->nlink = statx_struct->stx_nlink;
+    meta->uid = statx_struct->stx_uid;
+    meta->gid = statx_struct->stx_gid;
+    meta->ino = statx_struct->stx_ino;
+    meta->size = statx_struct->stx_size;
+    meta->blocks = statx_struct->stx_blocks;
+    meta->blksize = statx_struct->stx_blksize;
+    meta->dev = makedev(statx_struct->stx_dev_major, statx_struct->stx_dev_minor);
+    meta->rdev = makedev(statx_struct->stx_rdev_major, statx_struct->stx_rdev_minor);
+    meta->atime.tv_sec = statx_struct->stx_atime.tv_sec;
+    meta->atime.tv_nsec = statx_struct->stx_atime.tv_nsec;
+    meta->btime.tv_sec = statx_struct->stx_btime.tv_sec;
+    meta->btime.tv_nsec = statx_struct->stx_btime.tv_nsec;
+    meta->ctime.tv_sec = statx_struct->stx_ctime.tv_sec;
+    meta->ctime.tv_nsec = statx_struct->stx_ctime.tv_nsec;
+    meta->mtime.tv_sec = statx_struct->stx_mtime.tv_sec;
+    meta->mtime.tv_nsec = statx_struct->stx_mtime.tv_nsec;
+}
+
+
 SKID_INTERNAL int validate_call_input(const char *pathname, struct stat *statbuf, int *errnum)
 {
     // LOCAL VARIABLES
@@ -992,6 +1673,42 @@ SKID_INTERNAL int validate_call_input(const char *pathname, struct stat *statbuf
 }
 
 
+SKID_INTERNAL int validate_meta_timestamp(const skidFileMeta *meta, unsigned int field,
+                                          time_t *seconds, long *nseconds)
+{
+    // LOCAL VARIABLES
+    int retval = ENOERR;  // The results of validation
+
+    // VALIDATE IT
+    // meta
+    if (!meta)
+    {
+        retval = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+    // seconds
+    else if (!seconds)
+    {
+        retval = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null seconds pointer);
+    }
+    // nseconds
+    else if (!nseconds)
+    {
+        retval = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null nseconds pointer);
+    }
+    // field
+    else if (field != (meta->mask & field))
+    {
+        retval = ENODATA;  // The snapshot doesn't have it
+    }
+
+    // DONE
+    return retval;
+}
+
+
 SKID_INTERNAL int validate_sfmr_input(const char *pathname, int *errnum)
 {
     // LOCAL VARIABLES
@@ -1015,6 +1732,33 @@ SKID_INTERNAL int validate_sfmr_input(const char *pathname, int *errnum)
 }
 
 
+SKID_INTERNAL int validate_sfmr_meta(const skidFileMeta *meta, unsigned int field, int *errnum)
+{
+    // LOCAL VARIABLES
+    int retval = validate_skid_err(errnum);  // The results of validation
+
+    // VALIDATE IT
+    // meta
+    if (ENOERR == retval && !meta)
+    {
+        retval = EINVAL;  // Invalid argument
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+    // field
+    if (ENOERR == retval && field != (meta->mask & field))
+    {
+        retval = ENODATA;  // The snapshot doesn't have it
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = retval;
+    }
+    return retval;
+}
+
+
 SKID_INTERNAL int validate_sfmr_pathname(const char *pathname)
 {
     return validate_skid_pathname(pathname, false);  // Refactored for backwards compatibility
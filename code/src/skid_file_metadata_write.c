@@ -2,16 +2,16 @@
  *    This library defines functionality to modify Linux file metadata.
  */
 
-#define _POSIX_C_SOURCE 200809L             // Expose utimensat()
+#define _POSIX_C_SOURCE 200809L             // Expose futimens(), utimensat()
 // #define SKID_DEBUG                          // Enable DEBUG logging
 
 #include <fcntl.h>                          // AT_FDCWD
 #include <stdbool.h>                        // false
 #include "skid_debug.h"                     // PRINT_ERRNO()
-#include "skid_file_metadata_read.h"        // get_file_perms()
+#include "skid_file_metadata_read.h"        // get_file_meta_fd(), get_file_perms()
 #include "skid_file_metadata_write.h"       // ENOERR, set_mode()
 #include "skid_macros.h"                    // SKID_INTERNAL
-#include "skid_validation.h"                // validate_skid_err()
+#include "skid_validation.h"                // validate_skid_err(), validate_skid_fd()
 
 #define SFMW_ATIME_INDEX 0  // Index of the atime timespec struct
 #define SFMW_MTIME_INDEX 1  // Index of the mtime timespec struct
@@ -52,6 +52,30 @@ SKID_INTERNAL int call_a_chown(const char *pathname, uid_t new_owner, gid_t new_
  */
 SKID_INTERNAL int call_chown(const char *pathname, uid_t new_owner, gid_t new_group);
 
+/*
+ *  Description:
+ *      Calls fchown(fd, new_owner, new_group).
+ *  Args:
+ *      fd: File descriptor to update with fchown().
+ *      new_owner: The UID of the new owner for fd.  Pass -1 to ignore this ID.
+ *      new_group: The GID of the new group for fd.  Pass -1 to ignore this ID.
+ *  Returns:
+ *      0 on success.  Errno value on failure.
+ */
+SKID_INTERNAL int call_fchown(int fd, uid_t new_owner, gid_t new_group);
+
+/*
+ *  Description:
+ *      A wrapper around the call to futimens().
+ *  Args:
+ *      fd: File descriptor to modify timestamps for.
+ *      times: The new file timestamps, as for call_utnsat().  If times is NULL, then both
+ *          timestamps are set to the current time.
+ *  Returns:
+ *      0 on success.  An errno value on failure.
+ */
+SKID_INTERNAL int call_futimens(int fd, const struct timespec times[2]);
+
 /*
  *  Description:
  *      Calls lchown(pathname, new_owner, new_group).
@@ -199,6 +223,43 @@ int add_mode(const char *pathname, mode_t more_mode)
 }
 
 
+int add_mode_fd(int fd, mode_t more_mode)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // 0 on success, errno on failure
+    skidFileMeta meta;    // Read the current mode with get_file_meta_fd()
+    mode_t old_mode = 0;  // Read this with get_meta_file_perms()
+    mode_t new_mode = 0;  // Set this with set_mode_fd()
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // ADD IT UP
+    // 1. Get current mode
+    if (ENOERR == result)
+    {
+        result = get_file_meta_fd(fd, SKID_META_MODE, &meta);
+    }
+    if (ENOERR == result)
+    {
+        old_mode = get_meta_file_perms(&meta, &result);
+    }
+    // 2. Add more_mode
+    if (ENOERR == result)
+    {
+        new_mode = old_mode | more_mode;
+    }
+    // 3. Call set_mode_fd()
+    if (ENOERR == result)
+    {
+        result = set_mode_fd(fd, new_mode);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int remove_mode(const char *pathname, mode_t less_mode)
 {
     // LOCAL VARIABLES
@@ -231,6 +292,43 @@ int remove_mode(const char *pathname, mode_t less_mode)
 }
 
 
+int remove_mode_fd(int fd, mode_t less_mode)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // 0 on success, errno on failure
+    skidFileMeta meta;    // Read the current mode with get_file_meta_fd()
+    mode_t old_mode = 0;  // Read this with get_meta_file_perms()
+    mode_t new_mode = 0;  // Set this with set_mode_fd()
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // ADD IT UP
+    // 1. Get current mode
+    if (ENOERR == result)
+    {
+        result = get_file_meta_fd(fd, SKID_META_MODE, &meta);
+    }
+    if (ENOERR == result)
+    {
+        old_mode = get_meta_file_perms(&meta, &result);
+    }
+    // 2. Remove less_mode
+    if (ENOERR == result)
+    {
+        new_mode = old_mode & (~less_mode);
+    }
+    // 3. Call set_mode_fd()
+    if (ENOERR == result)
+    {
+        result = set_mode_fd(fd, new_mode);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_atime(const char *pathname, bool follow_sym, time_t seconds, long nseconds)
 {
     // LOCAL VARIABLES
@@ -262,6 +360,37 @@ int set_atime(const char *pathname, bool follow_sym, time_t seconds, long nsecon
 }
 
 
+int set_atime_fd(int fd, time_t seconds, long nseconds)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;            // 0 on success, errno on failure
+    struct timespec times[2] = {};  // Communicate with futimens() using atime, mtime
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    // Prepare atime
+    if (ENOERR == result)
+    {
+        result = set_timespec(&(times[SFMW_ATIME_INDEX]), seconds, nseconds);
+    }
+    // Prepare mtime
+    if (ENOERR == result)
+    {
+        result = set_timespec_omit(&(times[SFMW_MTIME_INDEX]));
+    }
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        result = call_futimens(fd, times);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_atime_now(const char *pathname, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -293,6 +422,37 @@ int set_atime_now(const char *pathname, bool follow_sym)
 }
 
 
+int set_atime_now_fd(int fd)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;            // 0 on success, errno on failure
+    struct timespec times[2] = {};  // Communicate with futimens() using atime, mtime
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    // Prepare atime
+    if (ENOERR == result)
+    {
+        result = set_timespec_now(&(times[SFMW_ATIME_INDEX]));
+    }
+    // Prepare mtime
+    if (ENOERR == result)
+    {
+        result = set_timespec_omit(&(times[SFMW_MTIME_INDEX]));
+    }
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        result = call_futimens(fd, times);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_group_id(const char *pathname, gid_t new_group, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -313,6 +473,26 @@ int set_group_id(const char *pathname, gid_t new_group, bool follow_sym)
 }
 
 
+int set_group_id_fd(int fd, gid_t new_group)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;         // 0 on success, errno on failure
+    uid_t uid = SFMW_IGNORE_ID;  // Ignore the owner
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    if (ENOERR == result)
+    {
+        result = call_fchown(fd, uid, new_group);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_mode(const char *pathname, mode_t new_mode)
 {
     // LOCAL VARIABLES
@@ -337,6 +517,30 @@ int set_mode(const char *pathname, mode_t new_mode)
 }
 
 
+int set_mode_fd(int fd, mode_t new_mode)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // 0 on success, errno on failure
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    if (ENOERR == result)
+    {
+        if (fchmod(fd, new_mode))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fchmod() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_mtime(const char *pathname, bool follow_sym, time_t seconds, long nseconds)
 {
     // LOCAL VARIABLES
@@ -368,6 +572,37 @@ int set_mtime(const char *pathname, bool follow_sym, time_t seconds, long nsecon
 }
 
 
+int set_mtime_fd(int fd, time_t seconds, long nseconds)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;            // 0 on success, errno on failure
+    struct timespec times[2] = {};  // Communicate with futimens() using atime, mtime
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    // Prepare atime
+    if (ENOERR == result)
+    {
+        result = set_timespec_omit(&(times[SFMW_ATIME_INDEX]));
+    }
+    // Prepare mtime
+    if (ENOERR == result)
+    {
+        result = set_timespec(&(times[SFMW_MTIME_INDEX]), seconds, nseconds);
+    }
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        result = call_futimens(fd, times);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_mtime_now(const char *pathname, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -399,6 +634,37 @@ int set_mtime_now(const char *pathname, bool follow_sym)
 }
 
 
+int set_mtime_now_fd(int fd)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;            // 0 on success, errno on failure
+    struct timespec times[2] = {};  // Communicate with futimens() using atime, mtime
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    // Prepare atime
+    if (ENOERR == result)
+    {
+        result = set_timespec_omit(&(times[SFMW_ATIME_INDEX]));
+    }
+    // Prepare mtime
+    if (ENOERR == result)
+    {
+        result = set_timespec_now(&(times[SFMW_MTIME_INDEX]));
+    }
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        result = call_futimens(fd, times);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_owner_id(const char *pathname, uid_t new_owner, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -419,6 +685,26 @@ int set_owner_id(const char *pathname, uid_t new_owner, bool follow_sym)
 }
 
 
+int set_owner_id_fd(int fd, uid_t new_owner)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;         // 0 on success, errno on failure
+    gid_t gid = SFMW_IGNORE_ID;  // Ignore the group
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    if (ENOERR == result)
+    {
+        result = call_fchown(fd, new_owner, gid);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_ownership(const char *pathname, uid_t new_owner, gid_t new_group, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -438,6 +724,25 @@ int set_ownership(const char *pathname, uid_t new_owner, gid_t new_group, bool f
 }
 
 
+int set_ownership_fd(int fd, uid_t new_owner, gid_t new_group)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // 0 on success, errno on failure
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    if (ENOERR == result)
+    {
+        result = call_fchown(fd, new_owner, new_group);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_times(const char *pathname, bool follow_sym, time_t seconds, long nseconds)
 {
     // LOCAL VARIABLES
@@ -469,6 +774,37 @@ int set_times(const char *pathname, bool follow_sym, time_t seconds, long nsecon
 }
 
 
+int set_times_fd(int fd, time_t seconds, long nseconds)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;            // 0 on success, errno on failure
+    struct timespec times[2] = {};  // Communicate with futimens() using atime, mtime
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // SET IT
+    // Prepare atime
+    if (ENOERR == result)
+    {
+        result = set_timespec(&(times[SFMW_ATIME_INDEX]), seconds, nseconds);
+    }
+    // Prepare mtime
+    if (ENOERR == result)
+    {
+        result = set_timespec(&(times[SFMW_MTIME_INDEX]), seconds, nseconds);
+    }
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        result = call_futimens(fd, times);
+    }
+
+    // DONE
+    return result;
+}
+
+
 int set_times_now(const char *pathname, bool follow_sym)
 {
     // LOCAL VARIABLES
@@ -489,6 +825,26 @@ int set_times_now(const char *pathname, bool follow_sym)
 }
 
 
+int set_times_now_fd(int fd)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // 0 on success, errno on failure
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // Call call_futimens()
+    if (ENOERR == result)
+    {
+        // If times is NULL, then both timestamps are set to the current time.
+        result = call_futimens(fd, NULL);
+    }
+
+    // DONE
+    return result;
+}
+
+
 /**************************************************************************************************/
 /********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
 /**************************************************************************************************/
@@ -552,6 +908,54 @@ SKID_INTERNAL int call_chown(const char *pathname, uid_t new_owner, gid_t new_gr
 }
 
 
+SKID_INTERNAL int call_fchown(int fd, uid_t new_owner, gid_t new_group)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // The results of execution
+
+    // INPUT VALIDATION
+    result = validate_skid_fd(fd);
+
+    // CALL IT
+    if (ENOERR == result)
+    {
+        if (fchown(fd, new_owner, new_group))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fchown() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int call_futimens(int fd, const struct timespec times[2])
+{
+    // LOCAL VARIABLES
+    int retval = ENOERR;  // The results of validation
+
+    // INPUT VALIDATION
+    retval = validate_skid_fd(fd);
+
+    // CALL IT
+    if (ENOERR == retval)
+    {
+        if (futimens(fd, times))
+        {
+            retval = errno;
+            PRINT_ERROR(The call to futimens() failed);
+            PRINT_ERRNO(retval);
+        }
+    }
+
+    // DONE
+    return retval;
+}
+
+
 SKID_INTERNAL int call_lchown(const char *pathname, uid_t new_owner, gid_t new_group)
 {
     // LOCAL VARIABLES
@@ -2,30 +2,89 @@
  *  This library defines functionality to create, delete, and empty Linux files.
  */
 
+#define _GNU_SOURCE                         // Access to O_TMPFILE, readahead()
+
 // #define SKID_DEBUG                          // Enable DEBUG logging
 
 #include <errno.h>                          // errno
-#include <fcntl.h>                          // O_CREAT, O_WRONLY
+#include <fcntl.h>                          // O_CREAT, O_RDONLY, O_TMPFILE, linkat(), renameat()
 #include <stdbool.h>                        // false
-#include <stdio.h>                          // fclose(), fopen(), fread(), fwrite()
-#include <string.h>                         // strlen()
-#include <unistd.h>                         // unlink()
+#include <stdint.h>                         // intmax_t
+#include <stdio.h>                          // fclose(), fopen(), fread(), fwrite(), snprintf()
+#include <string.h>                         // memcpy(), memmove(), memset(), strlen(), strrchr()
+#include <sys/mman.h>                       // madvise()
+#include <sys/stat.h>                       // fchmod(), fstat(), fstatat()
+#include <time.h>                           // clock_gettime()
+#include <unistd.h>                         // fdatasync(), fsync(), ftruncate(), sysconf(), etc.
 #include "skid_debug.h"                     // PRINT_ERROR()
-#include "skid_file_descriptors.h"          // close_fd(), open_fd(), write_fd()
+#include "skid_file_descriptors.h"          // close_fd(), copy_fd(), open_fd(), write_fd*()
 #include "skid_file_metadata_read.h"        // get_size()
 #include "skid_file_operations.h"           // bool, empty_file(), false, true
 #include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
-#include "skid_memory.h"                    // alloc_skid_mem()
+#include "skid_memory.h"                    // alloc_skid_mem(), grow_skid_buffer(), map_skid_mem()
 #include "skid_validation.h"                // validate_skid_pathname()
 
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
 
+#define SKID_TMP_NAME_LEN 64  // Buffer size for temporary filenames and /proc/self/fd/ paths
+
 
 /**************************************************************************************************/
 /********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
 /**************************************************************************************************/
 
+/*
+ *  Description:
+ *      Hand a directory file descriptor over to batch, unless batch already holds the same
+ *      directory, in which case dir_fd is closed.
+ *
+ *  Args:
+ *      batch: [In/Out] The batch to add the directory to.
+ *      dir_fd: [In/Out] A pointer to the directory file descriptor.  Set to SKID_BAD_FD once
+ *          batch owns it (or it was closed).
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int add_sfo_sync_dir(skidSyncBatch_ptr batch, int *dir_fd);
+
+/*
+ *  Description:
+ *      Build a hidden temporary filename that is unique within this process.
+ *
+ *  Args:
+ *      tmp_name: [Out] The buffer to build the name in.
+ *      name_size: The size of tmp_name.
+ */
+SKID_INTERNAL void build_sfo_tmp_name(char *tmp_name, size_t name_size);
+
+/*
+ *  Description:
+ *      Calculate the number of milliseconds that have passed, on the monotonic clock, since
+ *      then.
+ *
+ *  Args:
+ *      then: A CLOCK_MONOTONIC timestamp.
+ *
+ *  Returns:
+ *      The elapsed milliseconds.  0 if then is in the future or the clock can't be read.
+ */
+SKID_INTERNAL unsigned long long calc_sfo_elapsed_ms(const struct timespec *then);
+
+/*
+ *  Description:
+ *      Write appender's buffer if its oldest entry has reached flush_ms and fdatasync() the file
+ *      if sync_ms has passed since the last sync.  This is where group commit happens.
+ *
+ *  Args:
+ *      appender: [In/Out] A validated appender.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int check_sfo_appender(skidAppender_ptr appender);
+
 /*
  *  Description:
  *      Closes *stream, if it's not NULL, using fclose() and sets it to NULL.  This is a
@@ -51,6 +110,43 @@ SKID_INTERNAL int close_stream(FILE **stream);
  */
 SKID_INTERNAL bool is_file(const char *filename);
 
+/*
+ *  Description:
+ *      Open a temporary file for writing in the directory dir_fd.  An unnamed O_TMPFILE is
+ *      preferred.  If the filesystem doesn't support one, a hidden file is created instead.
+ *
+ *  Args:
+ *      dir_fd: The directory to create the temporary file in.
+ *      tmp_name: [Out] The name of the hidden file.  Empty if the file is unnamed.
+ *      name_size: The size of tmp_name.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The temporary file descriptor, on success.  SKID_BAD_FD on error (check errnum for
+ *      details).
+ */
+SKID_INTERNAL int open_sfo_tmpfile(int dir_fd, char *tmp_name, size_t name_size, int *errnum);
+
+/*
+ *  Description:
+ *      Give the temporary file base_name within dir_fd.  When overwriting, the file is renamed
+ *      over base_name.  Otherwise, it is linked to base_name, which fails if base_name exists.
+ *
+ *  Args:
+ *      dir_fd: The directory holding the temporary file.
+ *      tmp_fd: The temporary file.
+ *      tmp_name: [In/Out] The temporary file's name, or empty if it's unnamed.  Emptied on
+ *          success.  On failure, holds the name of any temporary link left for the caller to
+ *          remove.  Must hold SKID_TMP_NAME_LEN bytes.
+ *      base_name: The final name.
+ *      overwrite: Replace a pre-existing base_name?
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int publish_sfo_tmpfile(int dir_fd, int tmp_fd, char *tmp_name,
+                                      const char *base_name, bool overwrite);
+
 /*
  *  Description:
  *      Reads a maximum of buff_size bytes from stream into contents.  This function does not
@@ -67,6 +163,42 @@ SKID_INTERNAL bool is_file(const char *filename);
  */
 SKID_INTERNAL int read_stream(FILE *stream, char *contents, size_t buff_size);
 
+/*
+ *  Description:
+ *      fdatasync() appender's file and record the time of the sync.
+ *
+ *  Args:
+ *      appender: [In/Out] A validated appender.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int sync_sfo_appender(skidAppender_ptr appender);
+
+/*
+ *  Description:
+ *      fsync() a directory so the names created or replaced within it survive a crash.
+ *
+ *  Args:
+ *      dir_fd: The directory to sync.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int sync_sfo_dir(int dir_fd);
+
+/*
+ *  Description:
+ *      Validates skidAppender arguments on behalf of this library.
+ *
+ *  Args:
+ *      appender: A pointer to an appender initialized by open_appender().
+ *
+ *  Returns:
+ *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ */
+SKID_INTERNAL int validate_sfo_appender(skidAppender_ptr appender);
+
 /*
  *  Description:
  *      Validates the pathname arguments on behalf of this library.
@@ -79,6 +211,20 @@ SKID_INTERNAL int read_stream(FILE *stream, char *contents, size_t buff_size);
  */
 SKID_INTERNAL int validate_sfo_pathname(const char *pathname);
 
+/*
+ *  Description:
+ *      Write appender's buffered entries, if any, to its file with a single write and empty the
+ *      buffer.  If the write fails part way, the bytes that made it to the file are trimmed from
+ *      the front of the buffer so a later flush never appends them twice.
+ *
+ *  Args:
+ *      appender: [In/Out] A validated appender.
+ *
+ *  Returns:
+ *      ENOERR, on success.  On failure, an errno value.
+ */
+SKID_INTERNAL int write_sfo_appender(skidAppender_ptr appender);
+
 /*
  *  Description:
  *      Writes contents to stream and responds to errors.  This function does not close stream.
@@ -154,78 +300,79 @@ int append_to_file(const char *filename, const char *entry, bool create)
 }
 
 
-int create_file(const char *filename, const char *contents, bool overwrite)
+int close_appender(skidAppender_ptr appender)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;  // Results of execution
-    FILE *fp = NULL;      // File pointer to filename
+    int result = ENOERR;      // Results of execution
+    int tmp_errnum = ENOERR;  // Errno values encountered during cleanup
 
     // INPUT VALIDATION
-    result = validate_sfo_pathname(filename);
+    result = validate_sfo_appender(appender);
+
+    // FINISH IT
+    // Write what's left
     if (ENOERR == result)
     {
-        if (true == is_file(filename) && false == overwrite)
-        {
-            result = EEXIST;
-        }
+        result = write_sfo_appender(appender);
     }
-
-    // CREATE IT
-    // Open it
-    if (ENOERR == result)
+    // Make it durable
+    if (ENOERR == result && appender->sync_ms > 0 && true == appender->unsynced)
     {
-        fp = fopen(filename, "w");  // Truncate file to zero length or create text file for writing.
-        if (!fp)
-        {
-            result = errno;
-            PRINT_ERROR(The call to fopen() failed);
-            PRINT_ERRNO(result);
-        }
+        result = sync_sfo_appender(appender);
     }
-    // Write to it
-    if (ENOERR == result)
+
+    // CLEANUP
+    if (NULL != appender)
     {
-        if (contents && *contents)
+        if (ENOERR == validate_skid_fd(appender->fd))
         {
-            result = write_stream(contents, fp);
-            if (ENOERR != result)
+            tmp_errnum = close_fd(&(appender->fd), false);
+            if (ENOERR == result)
             {
-                if (result > 0)
-                {
-                    PRINT_ERROR(The call to write_stream() failed);
-                    PRINT_ERRNO(result);
-                }
-                else
-                {
-                    PRINT_ERROR(The call to write_stream() failed with an unspecified error);
-                }
+                result = tmp_errnum;
             }
         }
+        free_skid_buffer(&(appender->buffer));  // Best effort
+        memset(appender, 0x0, sizeof(*appender));
+        appender->fd = SKID_BAD_FD;
     }
 
     // DONE
-    close_stream(&fp);  // Best effort
     return result;
 }
 
 
-int delete_file(const char *filename)
+int commit_sync_batch(skidSyncBatch_ptr batch)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;  // Results of execution
+    int result = ENOERR;      // Results of execution
+    int tmp_errnum = ENOERR;  // Errno value for one directory
+    size_t i = 0;             // Iterating variable
 
     // INPUT VALIDATION
-    result = validate_sfo_pathname(filename);
+    if (NULL == batch)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else if (batch->num_dirs > 0 && NULL == batch->dirs)
+    {
+        result = EINVAL;  // Corrupted batch
+    }
 
-    // DELETE IT
+    // COMMIT IT
     if (ENOERR == result)
     {
-        if (unlink(filename))
+        for (i = 0; i < batch->num_dirs; i++)
         {
-            result = errno;
-            PRINT_ERROR(The call to unlink() failed);
-            PRINT_ERRNO(result);
+            tmp_errnum = sync_sfo_dir(batch->dirs[i].fd);
+            if (ENOERR == result)
+            {
+                result = tmp_errnum;
+            }
+            close_fd(&(batch->dirs[i].fd), true);  // Best effort
         }
+        free_skid_mem((void **)&(batch->dirs));  // Best effort
+        memset(batch, 0x0, sizeof(*batch));
     }
 
     // DONE
@@ -233,155 +380,1133 @@ int delete_file(const char *filename)
 }
 
 
-int empty_file(const char *filename)
-{
-    // LOCAL VARIABLES
-    int result = ENOERR;  // Results of execution
-
-    // INPUT VALIDATION
-    // Let create_file() handle input validation
-
-    // CREATE IT
-    result = create_file(filename, NULL, true);
-
-    // DONE
-    return result;
-}
-
-
-char *read_file(const char *filename, int *errnum)
+int copy_file(const char *source, const char *destination, bool overwrite)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;    // Results of execution
-    char *contents = NULL;  // File contents
-    off_t file_size = 0;    // File size in bytes
-    FILE *fp = NULL;        // File pointer to filename
+    int result = ENOERR;                 // Results of execution
+    int src_fd = SKID_BAD_FD;            // A file descriptor for source
+    int dst_fd = SKID_BAD_FD;            // A file descriptor for destination
+    int flags = O_WRONLY | O_CREAT;      // See open(2) && open_fd()
+    struct stat src_stat = { 0 };        // Metadata for source
+    struct stat dst_stat = { 0 };        // Metadata for destination
 
     // INPUT VALIDATION
-    if (false == is_file(filename))
+    result = validate_sfo_pathname(source);
+    if (ENOERR == result)
     {
-        result = ENOENT;  // No such file
+        result = validate_sfo_pathname(destination);
     }
-    else if (!errnum)
+
+    // COPY IT
+    // Open source
+    if (ENOERR == result)
     {
-        result = EINVAL;  // Bad input
+        src_fd = open_fd(source, O_RDONLY, 0, &result);
     }
-
-    // READ IT
-    // Size it
     if (ENOERR == result)
     {
-        file_size = get_size(filename, &result);
-        if (ENOERR != result)
+        if (fstat(src_fd, &src_stat))
         {
-            PRINT_ERROR(The call to get_size() failed);
+            result = errno;
+            PRINT_ERROR(The call to fstat() failed);
             PRINT_ERRNO(result);
         }
+        else if (S_ISDIR(src_stat.st_mode))
+        {
+            result = EISDIR;
+        }
     }
-    // Allocate it
+    // Open destination (truncate it only once it's known not to be source)
     if (ENOERR == result)
     {
-        contents = alloc_skid_mem(file_size + 1, 1, &result);
-        if (ENOERR != result)
-        {
-            PRINT_ERROR(The call to alloc_skid_mem() failed);
-            PRINT_ERRNO(result);
-        }
+        flags |= (true == overwrite) ? 0 : O_EXCL;  // O_EXCL reports EEXIST for us
+        dst_fd = open_fd(destination, flags, src_stat.st_mode & 07777, &result);
     }
-    // Open it
     if (ENOERR == result)
     {
-        fp = fopen(filename, "r");
-        if (!fp)
+        if (fstat(dst_fd, &dst_stat))
         {
             result = errno;
-            PRINT_ERROR(The call to fopen() failed);
+            PRINT_ERROR(The call to fstat() failed);
             PRINT_ERRNO(result);
         }
+        else if (src_stat.st_dev == dst_stat.st_dev && src_stat.st_ino == dst_stat.st_ino)
+        {
+            result = EINVAL;  // Same file (or a hard link to it) so truncating would destroy it
+        }
     }
-    // Read it
-    if (ENOERR == result)
+    if (ENOERR == result && true == overwrite)
     {
-        result = read_stream(fp, contents, file_size);
-        if (ENOERR != result)
+        if (ftruncate(dst_fd, 0))
         {
-            PRINT_ERROR(The call to read_stream() failed);
+            result = errno;
+            PRINT_ERROR(The call to ftruncate() failed);
             PRINT_ERRNO(result);
         }
     }
-
-    // CLEANUP
-    close_stream(&fp);  // Best effort
-    if (ENOERR != result && contents)
+    // Copy it
+    if (ENOERR == result)
     {
-        free_skid_mem((void **)&contents);  // Free the memory since there was an error
+        result = copy_fd(src_fd, dst_fd, NULL);
     }
 
-    // DONE
-    if (errnum)
+    // CLEANUP
+    if (SKID_BAD_FD != src_fd)
     {
-        *errnum = result;
+        close_fd(&src_fd, true);  // Best effort
     }
-    return contents;
-}
-
-
-/**************************************************************************************************/
-/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
-/**************************************************************************************************/
-
-
-SKID_INTERNAL int close_stream(FILE **stream)
-{
-    // LOCAL VARIABLES
-    int errnum = ENOERR;  // Store errno values here
-
-    // INPUT VALIDATION
-    if (stream && *stream)
+    if (SKID_BAD_FD != dst_fd)
     {
-        if (fclose(*stream))
-        {
-            errnum = errno;
-            PRINT_ERROR(The call to fclose() failed);
-            PRINT_ERRNO(errnum);
-        }
-        *stream = NULL;  // Succeed or fail, we tried...
+        close_fd(&dst_fd, true);  // Best effort
     }
 
     // DONE
-    return errnum;
-}
-
-
-SKID_INTERNAL bool is_file(const char *filename)
-{
-    // LOCAL VARIABLES
-    bool is_a_file = false;  // Results of execution
-    int errnum = ENOERR;     // Store errno values here
-
-    // INPUT VALIDATION
-    is_a_file = is_regular_file(filename, &errnum);
-
-    // DONE
-    return is_a_file;
+    return result;
 }
 
 
-SKID_INTERNAL int read_stream(FILE *stream, char *contents, size_t buff_size)
+int create_file(const char *filename, const char *contents, bool overwrite)
 {
     // LOCAL VARIABLES
-    int result = ENOERR;    // The results of validation
-#ifdef SKID_DEBUG
-    size_t bytes_read = 0;  // Return value from fread()
-#endif  /* SKID_DEBUG */
+    int result = ENOERR;  // Results of execution
+    FILE *fp = NULL;      // File pointer to filename
 
     // INPUT VALIDATION
-    if (!stream || !contents || buff_size <= 0)
+    result = validate_sfo_pathname(filename);
+    if (ENOERR == result)
     {
-        result = EINVAL;  // Bad input
+        if (true == is_file(filename) && false == overwrite)
+        {
+            result = EEXIST;
+        }
     }
 
-    // READ IT
+    // CREATE IT
+    // Open it
+    if (ENOERR == result)
+    {
+        fp = fopen(filename, "w");  // Truncate file to zero length or create text file for writing.
+        if (!fp)
+        {
+            result = errno;
+            PRINT_ERROR(The call to fopen() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Write to it
+    if (ENOERR == result)
+    {
+        if (contents && *contents)
+        {
+            result = write_stream(contents, fp);
+            if (ENOERR != result)
+            {
+                if (result > 0)
+                {
+                    PRINT_ERROR(The call to write_stream() failed);
+                    PRINT_ERRNO(result);
+                }
+                else
+                {
+                    PRINT_ERROR(The call to write_stream() failed with an unspecified error);
+                }
+            }
+        }
+    }
+
+    // DONE
+    close_stream(&fp);  // Best effort
+    return result;
+}
+
+
+int create_file_atomic(const char *filename, const char *contents, size_t contents_len,
+                       bool overwrite, skidSyncBatch_ptr batch)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                       // Results of execution
+    char *dir_name = NULL;                     // Heap-allocated copy of filename's directory
+    const char *base_name = filename;          // filename's final component
+    char *slash = NULL;                        // The last slash in dir_name
+    int dir_fd = SKID_BAD_FD;                  // filename's directory
+    int tmp_fd = SKID_BAD_FD;                  // The temporary file
+    char tmp_name[SKID_TMP_NAME_LEN] = { 0 };  // Name of a named temporary file, if one is used
+    struct stat old_stat;                      // Metadata of the file being replaced
+    bool keep_mode = false;                    // Copy the replaced file's permission bits
+    struct iovec data = { 0 };                 // contents
+
+    // INPUT VALIDATION
+    result = validate_sfo_pathname(filename);
+    if (ENOERR == result && NULL == contents && contents_len > 0)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // SETUP
+    // Split filename into its directory and its final component
+    if (ENOERR == result)
+    {
+        dir_name = copy_skid_string(filename, &result);
+    }
+    if (ENOERR == result)
+    {
+        slash = strrchr(dir_name, '/');
+        if (NULL == slash)
+        {
+            dir_name[0] = '.';  // filename is in the current working directory
+            dir_name[1] = '\0';
+        }
+        else
+        {
+            base_name = filename + (slash - dir_name) + 1;
+            if (slash == dir_name)
+            {
+                slash++;  // filename is in /
+            }
+            *slash = '\0';
+        }
+        if ('\0' == *base_name || 0 == strcmp(base_name, ".") || 0 == strcmp(base_name, ".."))
+        {
+            result = EISDIR;  // Not a filename
+        }
+    }
+    // Open the directory
+    if (ENOERR == result)
+    {
+        dir_fd = open_fd(dir_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC, 0, &result);
+    }
+    // Check the file being replaced (a symbolic link is replaced, not followed)
+    if (ENOERR == result)
+    {
+        if (0 == fstatat(dir_fd, base_name, &old_stat, AT_SYMLINK_NOFOLLOW))
+        {
+            if (false == overwrite)
+            {
+                result = EEXIST;
+            }
+            else if (S_ISDIR(old_stat.st_mode))
+            {
+                result = EISDIR;
+            }
+            else
+            {
+                keep_mode = S_ISREG(old_stat.st_mode);
+            }
+        }
+        else if (ENOENT != errno)
+        {
+            result = errno;
+            PRINT_ERROR(The call to fstatat() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // WRITE IT
+    // Open a temporary file
+    if (ENOERR == result)
+    {
+        tmp_fd = open_sfo_tmpfile(dir_fd, tmp_name, sizeof(tmp_name), &result);
+    }
+    if (ENOERR == result && true == keep_mode)
+    {
+        if (fchmod(tmp_fd, old_stat.st_mode & 07777))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fchmod() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Fill it
+    if (ENOERR == result && contents_len > 0)
+    {
+        data.iov_base = (void *)contents;
+        data.iov_len = contents_len;
+        result = write_fd_v(tmp_fd, &data, 1, NULL);
+    }
+    // Make the contents durable before they get a name
+    if (ENOERR == result)
+    {
+        if (fdatasync(tmp_fd))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fdatasync() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // PUBLISH IT
+    if (ENOERR == result)
+    {
+        result = publish_sfo_tmpfile(dir_fd, tmp_fd, tmp_name, base_name, overwrite);
+    }
+    // Make the name durable
+    if (ENOERR == result)
+    {
+        if (NULL == batch)
+        {
+            result = sync_sfo_dir(dir_fd);
+        }
+        else
+        {
+            result = add_sfo_sync_dir(batch, &dir_fd);
+        }
+    }
+
+    // CLEANUP
+    if ('\0' != tmp_name[0])
+    {
+        unlinkat(dir_fd, tmp_name, 0);  // Best effort
+    }
+    if (SKID_BAD_FD != tmp_fd)
+    {
+        close_fd(&tmp_fd, true);  // Best effort
+    }
+    if (SKID_BAD_FD != dir_fd)
+    {
+        close_fd(&dir_fd, true);  // Best effort
+    }
+    free_skid_mem((void **)&dir_name);  // Best effort
+
+    // DONE
+    return result;
+}
+
+
+int delete_file(const char *filename)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // INPUT VALIDATION
+    result = validate_sfo_pathname(filename);
+
+    // DELETE IT
+    if (ENOERR == result)
+    {
+        if (unlink(filename))
+        {
+            result = errno;
+            PRINT_ERROR(The call to unlink() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int empty_file(const char *filename)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // INPUT VALIDATION
+    // Let create_file() handle input validation
+
+    // CREATE IT
+    result = create_file(filename, NULL, true);
+
+    // DONE
+    return result;
+}
+
+
+int flush_appender(skidAppender_ptr appender, bool sync)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // INPUT VALIDATION
+    result = validate_sfo_appender(appender);
+
+    // FLUSH IT
+    if (ENOERR == result)
+    {
+        result = write_sfo_appender(appender);
+    }
+    if (ENOERR == result && true == sync && true == appender->unsynced)
+    {
+        result = sync_sfo_appender(appender);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int map_file_view(const char *filename, skidMemMapRegion_ptr view, int hints)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;           // Results of execution
+    int fd = SKID_BAD_FD;          // A file descriptor for filename
+    struct stat file_stat = { 0 }; // Metadata for filename
+
+    // INPUT VALIDATION
+    result = validate_sfo_pathname(filename);
+    if (ENOERR == result)
+    {
+        if (NULL == view || NULL != view->addr)
+        {
+            result = EINVAL;  // NULL pointer or an existing mapping
+        }
+    }
+
+    // MAP IT
+    // Open it
+    if (ENOERR == result)
+    {
+        fd = open_fd(filename, O_RDONLY | O_CLOEXEC, 0, &result);
+    }
+    // Size it (one stat, from the fd we'll map)
+    if (ENOERR == result)
+    {
+        if (fstat(fd, &file_stat))
+        {
+            result = errno;
+            PRINT_ERROR(The call to fstat() failed);
+            PRINT_ERRNO(result);
+        }
+        else if (S_ISDIR(file_stat.st_mode))
+        {
+            result = EISDIR;
+        }
+        else if (!S_ISREG(file_stat.st_mode))
+        {
+            result = EINVAL;  // Only regular files have a meaningful size
+        }
+        else if ((unsigned long long)file_stat.st_size > SKID_MAX_SZ)
+        {
+            result = EFBIG;  // Too big to map in this address space
+        }
+    }
+    // Map it
+    if (ENOERR == result)
+    {
+        view->length = file_stat.st_size;
+        if (view->length > 0)
+        {
+            result = map_skid_mem_fd(view, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+    }
+    // Advise it (best effort)
+    if (ENOERR == result && NULL != view->addr)
+    {
+        if ((hints & SKID_VIEW_SEQUENTIAL) && madvise(view->addr, view->length, MADV_SEQUENTIAL))
+        {
+            PRINT_WARNG(The call to madvise(MADV_SEQUENTIAL) failed);
+        }
+        if ((hints & SKID_VIEW_WILLNEED) && madvise(view->addr, view->length, MADV_WILLNEED))
+        {
+            PRINT_WARNG(The call to madvise(MADV_WILLNEED) failed);
+        }
+    }
+
+    // CLEANUP
+    if (SKID_BAD_FD != fd)
+    {
+        close_fd(&fd, true);  // Best effort (the mapping holds its own reference)
+    }
+
+    // DONE
+    return result;
+}
+
+
+int open_appender(skidAppender_ptr appender, const char *filename, size_t flush_size,
+                  unsigned int flush_ms, unsigned int sync_ms, bool create)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                          // Results of execution
+    int flags = O_WRONLY | O_APPEND | O_CLOEXEC;  // See open(2) && open_fd()
+    // See open(2)
+    mode_t mode = SKID_MODE_OWNER_R | SKID_MODE_OWNER_W | SKID_MODE_GROUP_R | SKID_MODE_GROUP_W;
+
+    // INPUT VALIDATION
+    if (NULL == appender)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        // Never clean up whatever the caller left in appender
+        memset(appender, 0x0, sizeof(*appender));
+        appender->fd = SKID_BAD_FD;
+        result = validate_skid_pathname(filename, false);
+    }
+    if (ENOERR == result)
+    {
+        if (0 == flush_size)
+        {
+            flush_size = SKID_APPENDER_SIZE;
+        }
+        else if (SKID_MAX_SZ == flush_size)
+        {
+            result = EOVERFLOW;  // No room for the buffer's nul terminator
+        }
+    }
+
+    // ENVIRONMENT VALIDATION
+    if (ENOERR == result)
+    {
+        if (false == is_path(filename, &result))
+        {
+            if (true == create)
+            {
+                flags |= O_CREAT;  // Create it if it doesn't already exist
+            }
+            else if (ENOERR == result)
+            {
+                result = ENOENT;  // File didn't exist, no errs found, but we're not to create it.
+            }
+        }
+    }
+
+    // SETUP
+    if (ENOERR == result)
+    {
+        appender->flush_size = flush_size;
+        appender->flush_ms = flush_ms;
+        appender->sync_ms = sync_ms;
+        // Allocate the buffer once so appending never has to
+        result = grow_skid_buffer(&(appender->buffer), flush_size + 1);
+    }
+    if (ENOERR == result)
+    {
+        if (clock_gettime(CLOCK_MONOTONIC, &(appender->last_sync)))
+        {
+            result = errno;
+            PRINT_ERROR(The call to clock_gettime() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // OPEN IT
+    if (ENOERR == result)
+    {
+        appender->fd = open_fd(filename, flags, mode, &result);
+    }
+
+    // CLEANUP
+    if (ENOERR != result && NULL != appender)
+    {
+        if (SKID_BAD_FD != appender->fd)
+        {
+            close_fd(&(appender->fd), true);  // Best effort
+        }
+        free_skid_buffer(&(appender->buffer));  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+char *read_file(const char *filename, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;    // Results of execution
+    char *contents = NULL;  // File contents
+    off_t file_size = 0;    // File size in bytes
+    FILE *fp = NULL;        // File pointer to filename
+
+    // INPUT VALIDATION
+    if (false == is_file(filename))
+    {
+        result = ENOENT;  // No such file
+    }
+    else if (!errnum)
+    {
+        result = EINVAL;  // Bad input
+    }
+
+    // READ IT
+    // Size it
+    if (ENOERR == result)
+    {
+        file_size = get_size(filename, &result);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to get_size() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Allocate it
+    if (ENOERR == result)
+    {
+        contents = alloc_skid_mem(file_size + 1, 1, &result);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to alloc_skid_mem() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Open it
+    if (ENOERR == result)
+    {
+        fp = fopen(filename, "r");
+        if (!fp)
+        {
+            result = errno;
+            PRINT_ERROR(The call to fopen() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    // Read it
+    if (ENOERR == result)
+    {
+        result = read_stream(fp, contents, file_size);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to read_stream() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // CLEANUP
+    close_stream(&fp);  // Best effort
+    if (ENOERR != result && contents)
+    {
+        free_skid_mem((void **)&contents);  // Free the memory since there was an error
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return contents;
+}
+
+
+int stream_file(const char *filename, size_t chunk_size, ChunkHandler handler, void *context,
+                bool drop_pages)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                   // Results of execution
+    int fd = SKID_BAD_FD;                  // A file descriptor for filename
+    skidMemMapRegion buff = { 0 };         // Page-aligned chunk buffer, reused for every chunk
+    long page_size = sysconf(_SC_PAGESIZE);  // Alignment for the chunk size
+    off_t offset = 0;                      // File offset of the current chunk
+    size_t chunk_len = 0;                  // Number of bytes in the current chunk
+    ssize_t num_read = 0;                  // Number of bytes read by one read()
+
+    // INPUT VALIDATION
+    result = validate_sfo_pathname(filename);
+    if (ENOERR == result && NULL == handler)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // SETUP
+    // Size the chunk
+    if (ENOERR == result)
+    {
+        if (0 == chunk_size)
+        {
+            chunk_size = SKID_STREAM_CHUNK_SIZE;
+        }
+        if (page_size > 0 && chunk_size % page_size)
+        {
+            if (chunk_size > SKID_MAX_SZ - page_size)
+            {
+                result = EOVERFLOW;
+            }
+            else
+            {
+                chunk_size += page_size - (chunk_size % page_size);
+            }
+        }
+    }
+    // Map the buffer (mmap() is page-aligned)
+    if (ENOERR == result)
+    {
+        buff.length = chunk_size;
+        result = map_skid_mem(&buff, PROT_READ | PROT_WRITE, MAP_PRIVATE);
+    }
+    // Open it
+    if (ENOERR == result)
+    {
+        fd = open_fd(filename, O_RDONLY | O_CLOEXEC, 0, &result);
+    }
+    if (ENOERR == result)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);  // Best effort
+    }
+
+    // STREAM IT
+    while (ENOERR == result)
+    {
+        // Prefetch the next chunk while this one is read and handled
+        readahead(fd, offset + chunk_size, chunk_size);  // Best effort
+        // Fill the chunk
+        for (chunk_len = 0; chunk_len < chunk_size; chunk_len += num_read)
+        {
+            num_read = read(fd, (char *)buff.addr + chunk_len, chunk_size - chunk_len);
+            if (0 > num_read)
+            {
+                num_read = 0;
+                if (EINTR != errno)
+                {
+                    result = errno;
+                    PRINT_ERROR(The call to read() failed);
+                    PRINT_ERRNO(result);
+                    break;  // Stop on error
+                }
+            }
+            else if (0 == num_read)
+            {
+                break;  // EOF
+            }
+        }
+        if (ENOERR != result || 0 == chunk_len)
+        {
+            break;  // Error or EOF
+        }
+        // Handle it
+        result = handler(buff.addr, chunk_len, offset, context);
+        if (true == drop_pages)
+        {
+            posix_fadvise(fd, offset, chunk_len, POSIX_FADV_DONTNEED);  // Best effort
+        }
+        offset += chunk_len;
+        if (chunk_len < chunk_size)
+        {
+            break;  // That was the final chunk
+        }
+    }
+
+    // CLEANUP
+    if (SKID_BAD_FD != fd)
+    {
+        close_fd(&fd, true);  // Best effort
+    }
+    unmap_skid_mem(&buff);  // Best effort
+
+    // DONE
+    return result;
+}
+
+
+int unmap_file_view(skidMemMapRegion_ptr view)
+{
+    return unmap_skid_mem(view);  // Handles the NULL mapping of an empty file
+}
+
+
+int write_appender(skidAppender_ptr appender, const char *entry, size_t entry_len)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Results of execution
+    struct iovec entry_iov = { 0 };  // entry, as a single-element vector
+
+    // INPUT VALIDATION
+    if (NULL == entry)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // APPEND IT
+    if (ENOERR == result)
+    {
+        entry_iov.iov_base = (void *)entry;
+        entry_iov.iov_len = entry_len;
+        result = write_appender_v(appender, &entry_iov, 1);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int write_appender_v(skidAppender_ptr appender, const struct iovec *iov, int iovcnt)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;    // Results of execution
+    size_t entry_len = 0;   // Total length of the entry
+    char *dest = NULL;      // Where the next piece of the entry is copied to
+    int i = 0;              // Iterating variable
+
+    // INPUT VALIDATION
+    result = validate_sfo_appender(appender);
+    if (ENOERR == result && (NULL == iov || iovcnt < 1))
+    {
+        result = EINVAL;  // Bad vector
+    }
+    for (i = 0; ENOERR == result && i < iovcnt; i++)
+    {
+        if (NULL == iov[i].iov_base && iov[i].iov_len > 0)
+        {
+            result = EINVAL;  // NULL pointer
+        }
+        else if (iov[i].iov_len > SKID_MAX_SZ - entry_len)
+        {
+            result = EOVERFLOW;
+        }
+        else
+        {
+            entry_len += iov[i].iov_len;
+        }
+    }
+
+    // APPEND IT
+    // Make room
+    if (ENOERR == result && entry_len > appender->flush_size - appender->buffer.length)
+    {
+        result = write_sfo_appender(appender);
+    }
+    // Write large entries as-is
+    if (ENOERR == result && entry_len > 0 && entry_len >= appender->flush_size)
+    {
+        result = write_fd_v(appender->fd, iov, iovcnt, NULL);
+        if (ENOERR == result)
+        {
+            appender->unsynced = true;
+        }
+    }
+    // Buffer the rest
+    else if (ENOERR == result && entry_len > 0)
+    {
+        if (0 == appender->buffer.length)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &(appender->first_pending));  // Best effort
+        }
+        dest = appender->buffer.data + appender->buffer.length;
+        for (i = 0; i < iovcnt; i++)
+        {
+            if (iov[i].iov_len > 0)
+            {
+                memcpy(dest, iov[i].iov_base, iov[i].iov_len);
+                dest += iov[i].iov_len;
+            }
+        }
+        appender->buffer.length += entry_len;
+        appender->buffer.data[appender->buffer.length] = '\0';
+        if (appender->buffer.length >= appender->flush_size)
+        {
+            result = write_sfo_appender(appender);  // Full
+        }
+    }
+    // Check the time thresholds
+    if (ENOERR == result)
+    {
+        result = check_sfo_appender(appender);
+    }
+
+    // DONE
+    return result;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL int add_sfo_sync_dir(skidSyncBatch_ptr batch, int *dir_fd)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;          // Results of execution
+    struct stat dir_stat;         // The directory's device and inode
+    skidSyncDir_ptr dirs = NULL;  // Reallocated array of directories
+    size_t new_capacity = 0;      // Capacity of dirs
+    size_t i = 0;                 // Iterating variable
+
+    // INPUT VALIDATION
+    if (NULL == batch || NULL == dir_fd || (batch->num_dirs > 0 && NULL == batch->dirs))
+    {
+        result = EINVAL;  // Bad pointer
+    }
+    else if (fstat(*dir_fd, &dir_stat))
+    {
+        result = errno;
+        PRINT_ERROR(The call to fstat() failed);
+        PRINT_ERRNO(result);
+    }
+
+    // ADD IT
+    // Already held?
+    for (i = 0; ENOERR == result && i < batch->num_dirs; i++)
+    {
+        if (dir_stat.st_dev == batch->dirs[i].dev && dir_stat.st_ino == batch->dirs[i].ino)
+        {
+            close_fd(dir_fd, true);  // Best effort
+            break;
+        }
+    }
+    // Make room
+    if (ENOERR == result && SKID_BAD_FD != *dir_fd && batch->num_dirs == batch->capacity)
+    {
+        new_capacity = (0 == batch->capacity) ? 8 : batch->capacity * 2;
+        dirs = realloc_skid_mem(batch->dirs, new_capacity, sizeof(skidSyncDir), &result);
+        if (ENOERR == result)
+        {
+            batch->dirs = dirs;
+            batch->capacity = new_capacity;
+        }
+    }
+    // Take ownership
+    if (ENOERR == result && SKID_BAD_FD != *dir_fd)
+    {
+        batch->dirs[batch->num_dirs].fd = *dir_fd;
+        batch->dirs[batch->num_dirs].dev = dir_stat.st_dev;
+        batch->dirs[batch->num_dirs].ino = dir_stat.st_ino;
+        batch->num_dirs++;
+        *dir_fd = SKID_BAD_FD;
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL void build_sfo_tmp_name(char *tmp_name, size_t name_size)
+{
+    // LOCAL VARIABLES
+    static unsigned int counter = 0;  // Makes temporary filenames unique within this process
+
+    // BUILD IT
+    snprintf(tmp_name, name_size, ".skid_tmp.%jd.%u", (intmax_t)getpid(),
+             __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED));
+}
+
+
+SKID_INTERNAL unsigned long long calc_sfo_elapsed_ms(const struct timespec *then)
+{
+    // LOCAL VARIABLES
+    unsigned long long elapsed = 0;  // Elapsed milliseconds
+    struct timespec now = { 0 };     // Current CLOCK_MONOTONIC time
+
+    // CALCULATE IT
+    if (NULL != then && 0 == clock_gettime(CLOCK_MONOTONIC, &now))
+    {
+        if (now.tv_sec > then->tv_sec
+            || (now.tv_sec == then->tv_sec && now.tv_nsec > then->tv_nsec))
+        {
+            elapsed = (unsigned long long)(now.tv_sec - then->tv_sec) * 1000;
+            elapsed += (now.tv_nsec - then->tv_nsec) / 1000000;  // May be negative
+        }
+    }
+
+    // DONE
+    return elapsed;
+}
+
+
+SKID_INTERNAL int check_sfo_appender(skidAppender_ptr appender)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // CHECK IT
+    // Flush
+    if (appender->flush_ms > 0 && appender->buffer.length > 0
+        && calc_sfo_elapsed_ms(&(appender->first_pending)) >= appender->flush_ms)
+    {
+        result = write_sfo_appender(appender);
+    }
+    // Group commit
+    if (ENOERR == result && appender->sync_ms > 0 && true == appender->unsynced
+        && calc_sfo_elapsed_ms(&(appender->last_sync)) >= appender->sync_ms)
+    {
+        result = sync_sfo_appender(appender);
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int close_stream(FILE **stream)
+{
+    // LOCAL VARIABLES
+    int errnum = ENOERR;  // Store errno values here
+
+    // INPUT VALIDATION
+    if (stream && *stream)
+    {
+        if (fclose(*stream))
+        {
+            errnum = errno;
+            PRINT_ERROR(The call to fclose() failed);
+            PRINT_ERRNO(errnum);
+        }
+        *stream = NULL;  // Succeed or fail, we tried...
+    }
+
+    // DONE
+    return errnum;
+}
+
+
+SKID_INTERNAL bool is_file(const char *filename)
+{
+    // LOCAL VARIABLES
+    bool is_a_file = false;  // Results of execution
+    int errnum = ENOERR;     // Store errno values here
+
+    // INPUT VALIDATION
+    is_a_file = is_regular_file(filename, &errnum);
+
+    // DONE
+    return is_a_file;
+}
+
+
+SKID_INTERNAL int open_sfo_tmpfile(int dir_fd, char *tmp_name, size_t name_size, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;       // Results of execution
+    int tmp_fd = SKID_BAD_FD;  // The temporary file
+    int attempt = 0;           // Number of temporary filenames tried
+    // Same permissions fopen() would use (subject to the umask)
+    mode_t mode = SKID_MODE_OWNER_R | SKID_MODE_OWNER_W | SKID_MODE_GROUP_R | SKID_MODE_GROUP_W
+                  | SKID_MODE_OTHER_R | SKID_MODE_OTHER_W;
+
+    // OPEN IT
+    // Unnamed (linkat() needs /proc to give it a name later)
+    tmp_name[0] = '\0';
+    if (0 == access("/proc/self/fd", X_OK))
+    {
+        tmp_fd = openat(dir_fd, ".", O_TMPFILE | O_WRONLY | O_CLOEXEC, mode);
+        if (SKID_BAD_FD == tmp_fd)
+        {
+            result = errno;
+            if (EOPNOTSUPP == result || EISDIR == result || EINVAL == result)
+            {
+                result = ENOERR;  // The filesystem (or kernel) doesn't support O_TMPFILE
+            }
+            else
+            {
+                PRINT_ERROR(The call to openat(O_TMPFILE) failed);
+                PRINT_ERRNO(result);
+            }
+        }
+    }
+    // Named
+    for (attempt = 0; ENOERR == result && SKID_BAD_FD == tmp_fd && attempt < 100; attempt++)
+    {
+        build_sfo_tmp_name(tmp_name, name_size);
+        tmp_fd = openat(dir_fd, tmp_name, O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, mode);
+        if (SKID_BAD_FD == tmp_fd && EEXIST != errno)
+        {
+            result = errno;
+            PRINT_ERROR(The call to openat() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    if (ENOERR == result && SKID_BAD_FD == tmp_fd)
+    {
+        result = EEXIST;  // Ran out of names?!
+    }
+    if (ENOERR != result)
+    {
+        tmp_name[0] = '\0';  // Nothing to clean up
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return tmp_fd;
+}
+
+
+SKID_INTERNAL int publish_sfo_tmpfile(int dir_fd, int tmp_fd, char *tmp_name,
+                                      const char *base_name, bool overwrite)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                        // Results of execution
+    char proc_path[SKID_TMP_NAME_LEN] = { 0 };  // /proc/self/fd/ path of an unnamed tmp_fd
+    int attempt = 0;                            // Number of temporary link names tried
+
+    // NAME IT
+    if ('\0' == tmp_name[0])
+    {
+        snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", tmp_fd);
+        if (false == overwrite)
+        {
+            // linkat() refuses to replace an existing file so this publishes it in one step
+            if (linkat(AT_FDCWD, proc_path, dir_fd, base_name, AT_SYMLINK_FOLLOW))
+            {
+                result = errno;
+                PRINT_ERROR(The call to linkat() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+        else
+        {
+            // Only rename() replaces a file atomically and it needs a name to start from
+            result = EEXIST;
+            for (attempt = 0; EEXIST == result && attempt < 100; attempt++)
+            {
+                result = ENOERR;
+                build_sfo_tmp_name(tmp_name, SKID_TMP_NAME_LEN);
+                if (linkat(AT_FDCWD, proc_path, dir_fd, tmp_name, AT_SYMLINK_FOLLOW))
+                {
+                    result = errno;
+                }
+            }
+            if (ENOERR != result)
+            {
+                tmp_name[0] = '\0';  // Nothing was created
+                PRINT_ERROR(The call to linkat() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+    }
+    else if (false == overwrite)
+    {
+        // Same as above: fail, instead of replace, if base_name appeared in the meantime
+        if (linkat(dir_fd, tmp_name, dir_fd, base_name, 0))
+        {
+            result = errno;
+            PRINT_ERROR(The call to linkat() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            unlinkat(dir_fd, tmp_name, 0);  // Best effort
+            tmp_name[0] = '\0';  // The temporary name is gone
+        }
+    }
+
+    // REPLACE IT
+    if (ENOERR == result && true == overwrite)
+    {
+        if (renameat(dir_fd, tmp_name, dir_fd, base_name))
+        {
+            result = errno;
+            PRINT_ERROR(The call to renameat() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            tmp_name[0] = '\0';  // The temporary name is gone
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int read_stream(FILE *stream, char *contents, size_t buff_size)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;    // The results of validation
+#ifdef SKID_DEBUG
+    size_t bytes_read = 0;  // Return value from fread()
+#endif  /* SKID_DEBUG */
+
+    // INPUT VALIDATION
+    if (!stream || !contents || buff_size <= 0)
+    {
+        result = EINVAL;  // Bad input
+    }
+
+    // READ IT
     if (ENOERR == result)
     {
 #ifdef SKID_DEBUG
@@ -410,12 +1535,113 @@ SKID_INTERNAL int read_stream(FILE *stream, char *contents, size_t buff_size)
 }
 
 
+SKID_INTERNAL int sync_sfo_appender(skidAppender_ptr appender)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // SYNC IT
+    if (fdatasync(appender->fd))
+    {
+        result = errno;
+        PRINT_ERROR(The call to fdatasync() failed);
+        PRINT_ERRNO(result);
+    }
+    else
+    {
+        appender->unsynced = false;
+        clock_gettime(CLOCK_MONOTONIC, &(appender->last_sync));  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int sync_sfo_dir(int dir_fd)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of execution
+
+    // SYNC IT
+    if (fsync(dir_fd))
+    {
+        result = errno;
+        PRINT_ERROR(The call to fsync() failed);
+        PRINT_ERRNO(result);
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL int validate_sfo_appender(skidAppender_ptr appender)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // VALIDATE IT
+    if (NULL == appender)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else if (0 == appender->flush_size || NULL == appender->buffer.data)
+    {
+        result = EINVAL;  // Not opened by open_appender()
+    }
+    else
+    {
+        result = validate_skid_fd(appender->fd);
+    }
+
+    // DONE
+    return result;
+}
+
+
 SKID_INTERNAL int validate_sfo_pathname(const char *pathname)
 {
     return validate_skid_pathname(pathname, false);  // Refactored for backwards compatibility
 }
 
 
+SKID_INTERNAL int write_sfo_appender(skidAppender_ptr appender)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;           // Results of execution
+    struct iovec pending = { 0 };  // The buffered entries
+    size_t num_wrote = 0;          // Number of buffered bytes that made it to the file
+
+    // WRITE IT
+    if (appender->buffer.length > 0)
+    {
+        pending.iov_base = appender->buffer.data;
+        pending.iov_len = appender->buffer.length;
+        result = write_fd_v(appender->fd, &pending, 1, &num_wrote);
+        if (num_wrote > 0)
+        {
+            appender->unsynced = true;
+        }
+        if (ENOERR == result)
+        {
+            result = clear_skid_buffer(&(appender->buffer));
+        }
+        else if (num_wrote > 0)
+        {
+            // Keep only what's left to write
+            appender->buffer.length -= num_wrote;
+            memmove(appender->buffer.data, appender->buffer.data + num_wrote,
+                    appender->buffer.length);
+            appender->buffer.data[appender->buffer.length] = '\0';
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 SKID_INTERNAL int write_stream(const char *contents, FILE *stream)
 {
     // LOCAL VARIABLES
@@ -0,0 +1,886 @@
+/*
+ *  This library defines functionality to submit file descriptor I/O in batches.
+ */
+
+#define _GNU_SOURCE                         // Access to statx()
+
+// #define SKID_DEBUG                          // Enable DEBUG logging
+
+#include <errno.h>                          // EINVAL
+#include <fcntl.h>                          // openat()
+#include <stdint.h>                         // uint32_t, uintptr_t
+#include <string.h>                         // memset()
+#include <sys/stat.h>                       // statx()
+#include <sys/syscall.h>                    // SYS_io_uring_*
+#include <unistd.h>                         // close(), pread(), pwrite(), syscall()
+#include "skid_debug.h"                     // PRINT_ERROR()
+#include "skid_file_descriptors.h"          // close_fd()
+#include "skid_io_batch.h"                  // skidIoBatch, skidIoResult
+#include "skid_macros.h"                    // ENOERR, SKID_BAD_FD, SKID_INTERNAL
+#include "skid_memory.h"                    // alloc_skid_mem(), map_skid_mem_fd(), unmap_skid_mem()
+#include "skid_validation.h"                // validate_skid_err(), validate_skid_fd()
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(SYS_io_uring_setup)
+#define SKID_IO_URING                       // Build the io_uring backend
+#include <linux/io_uring.h>                 // struct io_uring_*, IORING_*
+#endif  /* <linux/io_uring.h> */
+#endif  /* __has_include */
+
+MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
+MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
+
+
+// The operations a batch knows how to perform
+typedef enum _skidIoOpcode
+{
+    SKID_IO_OP_READ = 1,  // read()/pread()
+    SKID_IO_OP_WRITE,     // write()/pwrite()
+    SKID_IO_OP_OPEN,      // openat()
+    SKID_IO_OP_CLOSE,     // close()
+    SKID_IO_OP_STATX      // statx()
+} skidIoOpcode;
+
+// One queued operation
+typedef struct _skidIoOp
+{
+    skidIoOpcode opcode;     // The operation to perform
+    int fd;                  // File descriptor to operate on (dirfd for open/statx)
+    const char *pathname;    // Open/statx pathname
+    void *buf;               // Read/write buffer
+    size_t count;            // Read/write size
+    off_t offset;            // Read/write offset (or SKID_IO_CUR_POS)
+    int flags;               // Open/statx flags
+    mode_t mode;             // Open mode
+    unsigned int mask;       // Statx mask
+    struct statx *statxbuf;  // Statx output
+    uint64_t user_data;      // Caller's cookie
+} skidIoOp, *skidIoOp_ptr;
+
+struct _skidIoBatch
+{
+    unsigned int depth;          // Maximum number of outstanding operations
+    unsigned int num_queued;     // Operations in ops that haven't been submitted
+    skidIoOp_ptr ops;            // Heap-allocated array of depth queued operations
+    // Synchronous fallback
+    skidIoResult_ptr done;       // Heap-allocated ring of depth completed operations
+    unsigned int done_head;      // Index of the oldest completion in done
+    unsigned int num_done;       // Number of completions in done
+    // io_uring
+    bool use_uring;              // Is this batch backed by io_uring?
+    int ring_fd;                 // The io_uring file descriptor
+    unsigned int num_in_sq;      // Operations in the SQ ring not yet consumed by the kernel
+    unsigned int num_inflight;   // Operations consumed by the kernel but not reaped
+    skidMemMapRegion sq_map;     // SQ ring mapping (and CQ ring with IORING_FEAT_SINGLE_MMAP)
+    skidMemMapRegion cq_map;     // CQ ring mapping, if mapped separately
+    skidMemMapRegion sqe_map;    // SQE array mapping
+    unsigned int *sq_head;       // SQ ring head (kernel-owned)
+    unsigned int *sq_tail;       // SQ ring tail (ours)
+    unsigned int *sq_mask;       // SQ ring mask
+    unsigned int *sq_array;      // SQ ring index array
+    unsigned int *cq_head;       // CQ ring head (ours)
+    unsigned int *cq_tail;       // CQ ring tail (kernel-owned)
+    unsigned int *cq_mask;       // CQ ring mask
+    void *sqes;                  // struct io_uring_sqe array
+    void *cqes;                  // struct io_uring_cqe array
+};
+
+
+/**************************************************************************************************/
+/********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
+/**************************************************************************************************/
+
+/*
+ *  Description:
+ *      Execute one operation with the synchronous system calls.
+ *
+ *  Args:
+ *      op: The operation to execute.
+ *      result: [Out] Where to store the operation's completion.
+ */
+SKID_INTERNAL void exec_sib_op(skidIoOp_ptr op, skidIoResult_ptr result);
+
+/*
+ *  Description:
+ *      Add an operation to the batch's queue after verifying there's room for it.
+ *
+ *  Args:
+ *      batch: The batch to queue the operation in.
+ *      op: The operation to copy into the queue.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.  EAGAIN if the batch is full.
+ */
+SKID_INTERNAL int queue_sib_op(skidIoBatch_ptr batch, skidIoOp_ptr op);
+
+/*
+ *  Description:
+ *      Collect completions from the io_uring CQ ring, waiting for min_results of them.
+ *
+ *  Args:
+ *      batch: An io_uring-backed batch.
+ *      results: [Out] Array to store completions in.
+ *      max_results: The number of entries in results.
+ *      min_results: The number of completions to wait for.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The number of entries stored in results.
+ */
+SKID_INTERNAL unsigned int reap_sib_uring(skidIoBatch_ptr batch, skidIoResult_ptr results,
+                                          unsigned int max_results, unsigned int min_results,
+                                          int *errnum);
+
+/*
+ *  Description:
+ *      Create an io_uring instance for batch, map its rings, and verify the kernel supports every
+ *      operation this library queues.  Cleans up after itself on failure.
+ *
+ *  Args:
+ *      batch: The batch to set up.  On success, batch->use_uring is true.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+SKID_INTERNAL int setup_sib_uring(skidIoBatch_ptr batch);
+
+/*
+ *  Description:
+ *      Move every queued operation into the SQ ring and hand the ring to the kernel.
+ *
+ *  Args:
+ *      batch: An io_uring-backed batch.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The number of operations the kernel consumed.
+ */
+SKID_INTERNAL unsigned int submit_sib_uring(skidIoBatch_ptr batch, int *errnum);
+
+/*
+ *  Description:
+ *      Release the io_uring resources of batch.  Safe to call on a partially set up batch.
+ *
+ *  Args:
+ *      batch: The batch to tear down.
+ */
+SKID_INTERNAL void teardown_sib_uring(skidIoBatch_ptr batch);
+
+/*
+ *  Description:
+ *      Validate a batch pointer on behalf of skid_io_batch.
+ *
+ *  Args:
+ *      batch: The batch pointer to validate.
+ *
+ *  Returns:
+ *      ENOERR on success, EINVAL for a NULL pointer.
+ */
+SKID_INTERNAL int validate_sib_batch(skidIoBatch_ptr batch);
+
+/**************************************************************************************************/
+/********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+
+skidIoBatch_ptr create_io_batch(unsigned int depth, bool force_sync, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Errno values
+    skidIoBatch_ptr batch = NULL;    // The new batch
+
+    // INPUT VALIDATION
+    result = validate_skid_err(errnum);
+    if (ENOERR == result && depth < 1)
+    {
+        result = EINVAL;
+        PRINT_ERROR(The depth argument must be positive);
+    }
+
+    // CREATE IT
+    if (ENOERR == result)
+    {
+        batch = alloc_skid_mem(1, sizeof(skidIoBatch), &result);
+    }
+    if (ENOERR == result)
+    {
+        batch->depth = depth;
+        batch->ring_fd = SKID_BAD_FD;
+        batch->ops = alloc_skid_mem(depth, sizeof(skidIoOp), &result);
+    }
+    if (ENOERR == result)
+    {
+        batch->done = alloc_skid_mem(depth, sizeof(skidIoResult), &result);
+    }
+    // Try io_uring
+    if (ENOERR == result && false == force_sync)
+    {
+        if (ENOERR != setup_sib_uring(batch))
+        {
+            FPRINTF_ERR("%s io_uring is unavailable so falling back to synchronous I/O\n",
+                        DEBUG_INFO_STR);
+        }
+    }
+
+    // CLEANUP
+    if (ENOERR != result && NULL != batch)
+    {
+        destroy_io_batch(&batch);  // Best effort
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return batch;
+}
+
+
+int destroy_io_batch(skidIoBatch_ptr *batch)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Errno values
+    skidIoResult leftovers[16];      // Discarded completions
+    int tmp_errnum = ENOERR;         // Errno values from reaping
+
+    // INPUT VALIDATION
+    if (NULL == batch)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        result = validate_sib_batch(*batch);
+    }
+
+    // DESTROY IT
+    if (ENOERR == result)
+    {
+        // Don't pull the buffers out from under the kernel
+        while ((*batch)->use_uring && (*batch)->num_inflight > 0 && ENOERR == tmp_errnum)
+        {
+            reap_sib_uring(*batch, leftovers, sizeof(leftovers) / sizeof(leftovers[0]),
+                           1, &tmp_errnum);
+        }
+        teardown_sib_uring(*batch);
+        free_skid_mem((void **)&((*batch)->ops));  // Best effort
+        free_skid_mem((void **)&((*batch)->done));  // Best effort
+        result = free_skid_mem((void **)batch);
+    }
+
+    // DONE
+    return result;
+}
+
+
+bool is_io_uring_batch(skidIoBatch_ptr batch)
+{
+    return (NULL != batch && true == batch->use_uring);
+}
+
+
+int queue_io_close(skidIoBatch_ptr batch, int fd, uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    skidIoOp op = { .opcode = SKID_IO_OP_CLOSE, .fd = fd, .user_data = user_data };  // The op
+    int result = validate_skid_fd(fd);                                               // Errno
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        result = queue_sib_op(batch, &op);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int queue_io_open(skidIoBatch_ptr batch, int dirfd, const char *pathname, int flags, mode_t mode,
+                  uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+    skidIoOp op = { .opcode = SKID_IO_OP_OPEN, .fd = dirfd, .pathname = pathname,
+                    .flags = flags, .mode = mode, .user_data = user_data };  // The operation
+
+    // INPUT VALIDATION
+    result = validate_skid_string(pathname, false);
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        result = queue_sib_op(batch, &op);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int queue_io_read(skidIoBatch_ptr batch, int fd, void *buf, size_t count, off_t offset,
+                  uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Errno values
+    skidIoOp op = { .opcode = SKID_IO_OP_READ, .fd = fd, .buf = buf, .count = count,
+                    .offset = offset, .user_data = user_data };  // The operation
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        if (NULL == buf || count < 1 || count > UINT32_MAX || offset < SKID_IO_CUR_POS)
+        {
+            result = EINVAL;  // Bad buffer or offset
+        }
+    }
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        result = queue_sib_op(batch, &op);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int queue_io_statx(skidIoBatch_ptr batch, int dirfd, const char *pathname, int flags,
+                   unsigned int mask, struct statx *statxbuf, uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+    skidIoOp op = { .opcode = SKID_IO_OP_STATX, .fd = dirfd, .pathname = pathname,
+                    .flags = flags, .mask = mask, .statxbuf = statxbuf,
+                    .user_data = user_data };  // The operation
+
+    // INPUT VALIDATION
+    result = validate_skid_string(pathname, (flags & AT_EMPTY_PATH) ? true : false);
+    if (ENOERR == result && NULL == statxbuf)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        result = queue_sib_op(batch, &op);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int queue_io_write(skidIoBatch_ptr batch, int fd, const void *buf, size_t count, off_t offset,
+                   uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_fd(fd);  // Errno values
+    skidIoOp op = { .opcode = SKID_IO_OP_WRITE, .fd = fd, .buf = (void *)buf, .count = count,
+                    .offset = offset, .user_data = user_data };  // The operation
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        if (NULL == buf || count < 1 || count > UINT32_MAX || offset < SKID_IO_CUR_POS)
+        {
+            result = EINVAL;  // Bad buffer or offset
+        }
+    }
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        result = queue_sib_op(batch, &op);
+    }
+
+    // DONE
+    return result;
+}
+
+
+unsigned int reap_io_batch(skidIoBatch_ptr batch, skidIoResult_ptr results,
+                           unsigned int max_results, unsigned int min_results, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;        // Errno values
+    unsigned int num_reaped = 0;  // Number of completions stored in results
+
+    // INPUT VALIDATION
+    result = validate_sib_batch(batch);
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+    if (ENOERR == result && (NULL == results || max_results < 1))
+    {
+        result = EINVAL;  // Nowhere to store completions
+    }
+
+    // REAP IT
+    if (ENOERR == result)
+    {
+        if (true == batch->use_uring)
+        {
+            num_reaped = reap_sib_uring(batch, results, max_results, min_results, &result);
+        }
+        else
+        {
+            // Everything submitted has already completed
+            while (num_reaped < max_results && batch->num_done > 0)
+            {
+                results[num_reaped++] = batch->done[batch->done_head];
+                batch->done_head = (batch->done_head + 1) % batch->depth;
+                batch->num_done--;
+            }
+        }
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return num_reaped;
+}
+
+
+unsigned int submit_io_batch(skidIoBatch_ptr batch, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Errno values
+    unsigned int num_submitted = 0;  // Number of operations submitted
+    unsigned int tail = 0;           // Index of the next free completion slot
+
+    // INPUT VALIDATION
+    result = validate_sib_batch(batch);
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+
+    // SUBMIT IT
+    if (ENOERR == result)
+    {
+        if (true == batch->use_uring)
+        {
+            num_submitted = submit_sib_uring(batch, &result);
+        }
+        else
+        {
+            // Queue space was reserved for every completion so there's always room
+            for (num_submitted = 0; num_submitted < batch->num_queued; num_submitted++)
+            {
+                tail = (batch->done_head + batch->num_done) % batch->depth;
+                exec_sib_op(&(batch->ops[num_submitted]), &(batch->done[tail]));
+                batch->num_done++;
+            }
+            batch->num_queued = 0;
+        }
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return num_submitted;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL void exec_sib_op(skidIoOp_ptr op, skidIoResult_ptr result)
+{
+    // EXECUTE IT
+    errno = ENOERR;
+    switch (op->opcode)
+    {
+        case SKID_IO_OP_READ:
+            result->result = (SKID_IO_CUR_POS == op->offset)
+                             ? read(op->fd, op->buf, op->count)
+                             : pread(op->fd, op->buf, op->count, op->offset);
+            break;
+        case SKID_IO_OP_WRITE:
+            result->result = (SKID_IO_CUR_POS == op->offset)
+                             ? write(op->fd, op->buf, op->count)
+                             : pwrite(op->fd, op->buf, op->count, op->offset);
+            break;
+        case SKID_IO_OP_OPEN:
+            result->result = openat(op->fd, op->pathname, op->flags, op->mode);
+            break;
+        case SKID_IO_OP_CLOSE:
+            result->result = close(op->fd);
+            break;
+        case SKID_IO_OP_STATX:
+            result->result = statx(op->fd, op->pathname, op->flags, op->mask, op->statxbuf);
+            break;
+        default:
+            result->result = -1;
+            errno = EINVAL;  // Unknown operation
+    }
+
+    // DONE
+    result->user_data = op->user_data;
+    result->errnum = (result->result < 0) ? errno : ENOERR;
+}
+
+
+SKID_INTERNAL int queue_sib_op(skidIoBatch_ptr batch, skidIoOp_ptr op)
+{
+    // LOCAL VARIABLES
+    int result = validate_sib_batch(batch);  // Errno values
+
+    // QUEUE IT
+    if (ENOERR == result)
+    {
+        if (batch->num_queued + batch->num_in_sq + batch->num_inflight + batch->num_done
+            >= batch->depth)
+        {
+            result = EAGAIN;  // Reap some completions first
+        }
+        else
+        {
+            batch->ops[batch->num_queued++] = *op;
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+#ifdef SKID_IO_URING
+
+
+SKID_INTERNAL unsigned int reap_sib_uring(skidIoBatch_ptr batch, skidIoResult_ptr results,
+                                          unsigned int max_results, unsigned int min_results,
+                                          int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                 // Errno values
+    unsigned int num_reaped = 0;         // Number of completions stored in results
+    unsigned int head = 0;               // Local copy of the CQ head
+    unsigned int tail = 0;               // Local copy of the CQ tail
+    struct io_uring_cqe *cqe = NULL;     // The current completion
+
+    // SETUP
+    if (min_results > batch->num_inflight)
+    {
+        min_results = batch->num_inflight;  // Don't wait on operations that don't exist
+    }
+    if (min_results > max_results)
+    {
+        min_results = max_results;  // Nowhere to store them
+    }
+
+    // REAP IT
+    while (ENOERR == result)
+    {
+        head = *(batch->cq_head);
+        tail = __atomic_load_n(batch->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail && num_reaped < max_results)
+        {
+            cqe = (struct io_uring_cqe *)batch->cqes + (head & *(batch->cq_mask));
+            results[num_reaped].user_data = cqe->user_data;
+            results[num_reaped].result = (cqe->res < 0) ? -1 : cqe->res;
+            results[num_reaped].errnum = (cqe->res < 0) ? -(cqe->res) : ENOERR;
+            num_reaped++;
+            head++;
+        }
+        __atomic_store_n(batch->cq_head, head, __ATOMIC_RELEASE);
+        if (num_reaped >= min_results)
+        {
+            break;  // Got what we came for
+        }
+        // Wait for more
+        if (0 > syscall(SYS_io_uring_enter, batch->ring_fd, 0, min_results - num_reaped,
+                        IORING_ENTER_GETEVENTS, NULL, 0))
+        {
+            result = errno;
+            if (EINTR == result)
+            {
+                result = ENOERR;  // Try again
+            }
+            else
+            {
+                PRINT_ERROR(The call to io_uring_enter() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+    }
+    batch->num_inflight -= num_reaped;
+
+    // DONE
+    *errnum = result;
+    return num_reaped;
+}
+
+
+SKID_INTERNAL int setup_sib_uring(skidIoBatch_ptr batch)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                       // Errno values
+    struct io_uring_params params = { 0 };     // io_uring_setup() parameters
+    struct io_uring_probe *probe = NULL;       // Supported operations
+    size_t probe_size = 0;                     // Size of probe
+    size_t sq_size = 0;                        // Size of the SQ ring
+    size_t cq_size = 0;                        // Size of the CQ ring
+    void *cq_base = NULL;                      // Base address of the CQ ring
+    // The operations this library needs
+    unsigned char needed[] = { IORING_OP_READ, IORING_OP_WRITE, IORING_OP_OPENAT,
+                               IORING_OP_CLOSE, IORING_OP_STATX };
+    size_t i = 0;                              // Iterating variable
+
+    // CREATE IT
+    batch->ring_fd = syscall(SYS_io_uring_setup, batch->depth, &params);
+    if (0 > batch->ring_fd)
+    {
+        result = errno;  // Likely ENOSYS or EPERM
+        batch->ring_fd = SKID_BAD_FD;
+    }
+    // Probe it
+    if (ENOERR == result)
+    {
+        probe_size = sizeof(*probe) + 256 * sizeof(struct io_uring_probe_op);
+        probe = alloc_skid_mem(1, probe_size, &result);
+    }
+    if (ENOERR == result)
+    {
+        if (0 > syscall(SYS_io_uring_register, batch->ring_fd, IORING_REGISTER_PROBE, probe, 256))
+        {
+            result = errno;
+        }
+        for (i = 0; ENOERR == result && i < sizeof(needed); i++)
+        {
+            if (needed[i] > probe->last_op
+                || !(probe->ops[needed[i]].flags & IO_URING_OP_SUPPORTED))
+            {
+                result = EOPNOTSUPP;  // Too old
+            }
+        }
+    }
+    // Map it
+    if (ENOERR == result)
+    {
+        sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            sq_size = (cq_size > sq_size) ? cq_size : sq_size;
+        }
+        batch->sq_map.length = sq_size;
+        result = map_skid_mem_fd(&(batch->sq_map), PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, batch->ring_fd, IORING_OFF_SQ_RING);
+    }
+    if (ENOERR == result)
+    {
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            cq_base = batch->sq_map.addr;
+        }
+        else
+        {
+            batch->cq_map.length = cq_size;
+            result = map_skid_mem_fd(&(batch->cq_map), PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, batch->ring_fd,
+                                     IORING_OFF_CQ_RING);
+            cq_base = batch->cq_map.addr;
+        }
+    }
+    if (ENOERR == result)
+    {
+        batch->sqe_map.length = params.sq_entries * sizeof(struct io_uring_sqe);
+        result = map_skid_mem_fd(&(batch->sqe_map), PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, batch->ring_fd, IORING_OFF_SQES);
+    }
+    // Find everything
+    if (ENOERR == result)
+    {
+        batch->sq_head = (unsigned int *)((char *)batch->sq_map.addr + params.sq_off.head);
+        batch->sq_tail = (unsigned int *)((char *)batch->sq_map.addr + params.sq_off.tail);
+        batch->sq_mask = (unsigned int *)((char *)batch->sq_map.addr + params.sq_off.ring_mask);
+        batch->sq_array = (unsigned int *)((char *)batch->sq_map.addr + params.sq_off.array);
+        batch->cq_head = (unsigned int *)((char *)cq_base + params.cq_off.head);
+        batch->cq_tail = (unsigned int *)((char *)cq_base + params.cq_off.tail);
+        batch->cq_mask = (unsigned int *)((char *)cq_base + params.cq_off.ring_mask);
+        batch->cqes = (char *)cq_base + params.cq_off.cqes;
+        batch->sqes = batch->sqe_map.addr;
+        batch->use_uring = true;
+    }
+
+    // CLEANUP
+    if (NULL != probe)
+    {
+        free_skid_mem((void **)&probe);  // Best effort
+    }
+    if (ENOERR != result)
+    {
+        teardown_sib_uring(batch);
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL unsigned int submit_sib_uring(skidIoBatch_ptr batch, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;               // Errno values
+    unsigned int tail = 0;             // Local copy of the SQ tail
+    unsigned int index = 0;            // SQ ring index
+    struct io_uring_sqe *sqe = NULL;   // The current submission
+    skidIoOp_ptr op = NULL;            // The current operation
+    int num_consumed = 0;              // Number of SQEs consumed by one io_uring_enter()
+    unsigned int total_consumed = 0;   // Number of SQEs consumed by the kernel
+    unsigned int i = 0;                // Iterating variable
+
+    // FILL THE SQ RING
+    // Room was reserved when the operations were queued
+    tail = *(batch->sq_tail);
+    for (i = 0; i < batch->num_queued; i++, tail++)
+    {
+        op = &(batch->ops[i]);
+        index = tail & *(batch->sq_mask);
+        sqe = (struct io_uring_sqe *)batch->sqes + index;
+        memset(sqe, 0x0, sizeof(*sqe));
+        sqe->fd = op->fd;
+        sqe->user_data = op->user_data;
+        switch (op->opcode)
+        {
+            case SKID_IO_OP_READ:
+            case SKID_IO_OP_WRITE:
+                sqe->opcode = (SKID_IO_OP_READ == op->opcode) ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe->addr = (uintptr_t)op->buf;
+                sqe->len = (uint32_t)op->count;
+                sqe->off = (uint64_t)op->offset;  // -1 means the current file offset
+                break;
+            case SKID_IO_OP_OPEN:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->addr = (uintptr_t)op->pathname;
+                sqe->len = op->mode;
+                sqe->open_flags = op->flags;
+                break;
+            case SKID_IO_OP_CLOSE:
+                sqe->opcode = IORING_OP_CLOSE;
+                break;
+            case SKID_IO_OP_STATX:
+                sqe->opcode = IORING_OP_STATX;
+                sqe->addr = (uintptr_t)op->pathname;
+                sqe->len = op->mask;
+                sqe->off = (uintptr_t)op->statxbuf;
+                sqe->statx_flags = op->flags;
+                break;
+        }
+        batch->sq_array[index] = index;
+    }
+    __atomic_store_n(batch->sq_tail, tail, __ATOMIC_RELEASE);
+    batch->num_in_sq += batch->num_queued;
+    batch->num_queued = 0;
+
+    // SUBMIT IT
+    while (ENOERR == result && batch->num_in_sq > 0)
+    {
+        num_consumed = syscall(SYS_io_uring_enter, batch->ring_fd, batch->num_in_sq, 0, 0,
+                               NULL, 0);
+        if (0 > num_consumed)
+        {
+            result = errno;
+            if (EINTR == result)
+            {
+                result = ENOERR;  // Try again
+            }
+            else
+            {
+                PRINT_ERROR(The call to io_uring_enter() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+        else if (0 == num_consumed)
+        {
+            break;  // The kernel is backed up; leave the rest for the next submission
+        }
+        else
+        {
+            batch->num_in_sq -= num_consumed;
+            batch->num_inflight += num_consumed;
+            total_consumed += num_consumed;
+        }
+    }
+
+    // DONE
+    *errnum = result;
+    return total_consumed;
+}
+
+
+SKID_INTERNAL void teardown_sib_uring(skidIoBatch_ptr batch)
+{
+    // Best effort
+    unmap_skid_mem(&(batch->sqe_map));
+    unmap_skid_mem(&(batch->cq_map));
+    unmap_skid_mem(&(batch->sq_map));
+    if (SKID_BAD_FD != batch->ring_fd)
+    {
+        close_fd(&(batch->ring_fd), true);
+    }
+    batch->use_uring = false;
+}
+
+
+#else
+
+
+SKID_INTERNAL unsigned int reap_sib_uring(skidIoBatch_ptr batch, skidIoResult_ptr results,
+                                          unsigned int max_results, unsigned int min_results,
+                                          int *errnum)
+{
+    *errnum = ENOSYS;  // Built without io_uring support
+    return 0;
+}
+
+
+SKID_INTERNAL int setup_sib_uring(skidIoBatch_ptr batch)
+{
+    return ENOSYS;  // Built without io_uring support
+}
+
+
+SKID_INTERNAL unsigned int submit_sib_uring(skidIoBatch_ptr batch, int *errnum)
+{
+    *errnum = ENOSYS;  // Built without io_uring support
+    return 0;
+}
+
+
+SKID_INTERNAL void teardown_sib_uring(skidIoBatch_ptr batch)
+{
+    return;  // Built without io_uring support
+}
+
+
+#endif  /* SKID_IO_URING */
+
+
+SKID_INTERNAL int validate_sib_batch(skidIoBatch_ptr batch)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Errno values
+
+    // VALIDATE IT
+    if (NULL == batch || NULL == batch->ops || NULL == batch->done)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid skidIoBatch pointer);
+    }
+
+    // DONE
+    return result;
+}
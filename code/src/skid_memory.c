@@ -6,7 +6,7 @@
 
 #include <errno.h>                          // errno
 #include <stdbool.h>                        // false
-#include <stdlib.h>                         // calloc()
+#include <stdlib.h>                         // calloc(), realloc()
 #include <string.h>                         // strlen()
 #include <unistd.h>                         // ftruncate()
 #include "skid_debug.h"                     // PRINT_ERROR(), PRINT_ERRNO()
@@ -15,6 +15,8 @@
 #include "skid_memory.h"                    // public functions, skidMemMapRegion*
 #include "skid_validation.h"                // validate_skid_*()
 
+#define SKID_BUFF_SIZE 1024  // Starting capacity of an empty skidBuffer
+
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
 
@@ -78,6 +80,19 @@ SKID_INTERNAL int validate_sm_standard_args(const char *pathname, int *err);
  */
 SKID_INTERNAL int validate_sm_pathname(const char *pathname);
 
+/*
+ *  Description:
+ *      Validate skidBuffer struct pointers on behalf of skid_memory.
+ *
+ *  Args:
+ *      buffer: A non-NULL, well-formed, struct.  A NULL data pointer must have a zero capacity
+ *          and length.  A non-NULL data pointer must have a capacity larger than its length.
+ *
+ *  Returns:
+ *      ENOERR for good input, errno for failed validation.
+ */
+SKID_INTERNAL int validate_sm_buffer(skidBuffer_ptr buffer);
+
 /*
  *  Description:
  *      Validate skidMemMapRegion struct pointers on behalf of skid_memory.
@@ -131,6 +146,26 @@ void *alloc_skid_mem(size_t num_elem, size_t size_elem, int *errnum)
 }
 
 
+int clear_skid_buffer(skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = validate_sm_buffer(buffer);  // Results from execution
+
+    // CLEAR IT
+    if (ENOERR == result)
+    {
+        buffer->length = 0;
+        if (NULL != buffer->data)
+        {
+            buffer->data[0] = '\0';  // Keep the contents a valid (empty) string
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 int close_shared_mem(int *shmfd, bool quiet)
 {
     // LOCAL VARIABLES
@@ -210,6 +245,30 @@ int delete_shared_mem(const char *name)
 }
 
 
+int free_skid_buffer(skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = validate_sm_buffer(buffer);  // Results from execution
+
+    // FREE IT
+    if (ENOERR == result)
+    {
+        if (NULL != buffer->data)
+        {
+            result = free_skid_mem((void **)&(buffer->data));
+        }
+    }
+    if (ENOERR == result)
+    {
+        buffer->length = 0;
+        buffer->capacity = 0;
+    }
+
+    // DONE
+    return result;
+}
+
+
 int free_skid_mem(void **old_mem)
 {
     // LOCAL VARIABLES
@@ -243,6 +302,61 @@ int free_skid_string(char **old_string)
 }
 
 
+int grow_skid_buffer(skidBuffer_ptr buffer, size_t min_capacity)
+{
+    // LOCAL VARIABLES
+    int result = validate_sm_buffer(buffer);  // Results from execution
+    size_t new_capacity = 0;                  // The capacity to grow to
+    char *tmp_ptr = NULL;                     // Return value from reallocation
+
+    // INPUT VALIDATION
+    if (ENOERR == result && 0 == min_capacity)
+    {
+        result = EINVAL;  // An empty buffer isn't much of a buffer
+    }
+
+    // GROW IT
+    // Size it
+    if (ENOERR == result && min_capacity > buffer->capacity)
+    {
+        new_capacity = (buffer->capacity > 0) ? buffer->capacity : SKID_BUFF_SIZE;
+        while (new_capacity < min_capacity)
+        {
+            if (new_capacity > (SKID_MAX_SZ - new_capacity))
+            {
+                new_capacity = min_capacity;  // Doubling would overflow so settle for the minimum
+            }
+            else
+            {
+                new_capacity *= 2;
+            }
+        }
+    }
+    // Reallocate it
+    if (ENOERR == result && new_capacity > 0)
+    {
+        tmp_ptr = realloc_skid_mem(buffer->data, new_capacity, sizeof(char), &result);
+        if (NULL == tmp_ptr)
+        {
+            PRINT_ERROR(The call to realloc_skid_mem() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            if (NULL == buffer->data)
+            {
+                tmp_ptr[0] = '\0';  // A brand new buffer starts as an empty string
+            }
+            buffer->data = tmp_ptr;
+            buffer->capacity = new_capacity;
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 int map_skid_mem(skidMemMapRegion_ptr new_map, int prot, int flags)
 {
     // LOCAL VARIABLES
@@ -397,6 +511,43 @@ int open_shared_mem(const char *name, int flags, mode_t mode, size_t size,
 }
 
 
+void *realloc_skid_mem(void *old_mem, size_t num_elem, size_t size_elem, int *errnum)
+{
+    // LOCAL VARIABLES
+    void *new_mem = NULL;  // Resized heap memory
+    int result = EINVAL;   // Store local errno values here
+
+    // INPUT VALIDATION
+    if (num_elem > 0 && size_elem > 0 && errnum)
+    {
+        result = ENOERR;  // Looks good
+        if (num_elem > (SKID_MAX_SZ / size_elem))
+        {
+            result = EOVERFLOW;  // The total size won't fit in a size_t
+        }
+    }
+
+    // REALLOCATE IT
+    if (ENOERR == result)
+    {
+        new_mem = realloc(old_mem, num_elem * size_elem);
+        if (!new_mem)
+        {
+            result = errno;
+            PRINT_ERROR(The call to realloc() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return new_mem;
+}
+
+
 int unmap_skid_mem(skidMemMapRegion_ptr old_map)
 {
     // LOCAL VARIABLES
@@ -495,6 +646,33 @@ SKID_INTERNAL void *call_mmap(void *addr, size_t length, int prot, int flags,
 }
 
 
+SKID_INTERNAL int validate_sm_buffer(skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Store errno values
+
+    // INPUT VALIDATION
+    if (NULL == buffer)
+    {
+        result = EINVAL;
+        PRINT_ERROR(Received an invalid skidBuffer pointer);
+    }
+    else if (NULL == buffer->data && (buffer->capacity > 0 || buffer->length > 0))
+    {
+        result = EINVAL;
+        PRINT_ERROR(An empty skidBuffer may not have a capacity or length);
+    }
+    else if (NULL != buffer->data && buffer->length >= buffer->capacity)
+    {
+        result = EINVAL;
+        PRINT_ERROR(A skidBuffer length must leave room for a nul-terminator);
+    }
+
+    // DONE
+    return result;
+}
+
+
 SKID_INTERNAL int validate_sm_standard_args(const char *pathname, int *err)
 {
     // LOCAL VARIABLES
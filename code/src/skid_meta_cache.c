@@ -0,0 +1,950 @@
+/*
+ *  This library defines functionality to cache file metadata and invalidate it with inotify.
+ */
+
+#define _GNU_SOURCE                         // PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP
+
+// #define SKID_DEBUG                          // Enable DEBUG logging
+
+#include <errno.h>                          // EINVAL, ENAMETOOLONG
+#include <limits.h>                         // PATH_MAX
+#include <poll.h>                           // poll()
+#include <pthread.h>                        // pthread_create(), pthread_rwlock_*()
+#include <stdatomic.h>                      // atomic_*
+#include <stdbool.h>                        // bool, false, true
+#include <string.h>                         // memcpy(), strcmp(), strlen(), strrchr()
+#include <sys/eventfd.h>                    // eventfd()
+#include <sys/inotify.h>                    // inotify_add_watch(), inotify_init1()
+#include <unistd.h>                         // read(), write()
+#include "skid_debug.h"                     // PRINT_ERROR()
+#include "skid_file_descriptors.h"          // close_fd()
+#include "skid_file_metadata_read.h"        // get_file_meta()
+#include "skid_macros.h"                    // ENOERR, SKID_BAD_FD, SKID_INTERNAL
+#include "skid_memory.h"                    // alloc_skid_mem(), copy_skid_string(), free_skid_mem()
+#include "skid_meta_cache.h"                // skidMetaCache, skidMetaCacheStats
+#include "skid_validation.h"                // validate_skid_err(), validate_skid_pathname()
+
+MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
+MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
+
+#define SKID_SMC_ANY_WD -1         // Matches every watch descriptor
+#define SKID_SMC_EVENT_BUF 4096    // Bytes of inotify events the watcher reads at a time
+// The inotify events that invalidate an entry, or every entry of a watched directory
+#define SKID_SMC_EVENTS (IN_ATTRIB | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | \
+                         IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+// The inotify events that mean a watched directory is gone (or no longer where it was)
+#define SKID_SMC_GONE (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT | IN_IGNORED)
+
+
+// One cached pathname
+typedef struct _skidCacheEntry
+{
+    struct _skidCacheEntry *next;  // The next entry in this bucket
+    uint64_t hash;                 // hash_smc_key(pathname)
+    int wd;                        // Watch descriptor of pathname's directory
+    char *pathname;                // Heap-allocated key
+    skidFileMeta meta;             // The cached metadata
+} skidCacheEntry, *skidCacheEntry_ptr;
+
+// One watched directory
+typedef struct _skidCacheDir
+{
+    struct _skidCacheDir *next;  // The next watched directory
+    int wd;                      // inotify watch descriptor
+    size_t dir_len;              // Length of dirname
+    char *dirname;               // Heap-allocated dirname, without trailing slashes
+} skidCacheDir, *skidCacheDir_ptr;
+
+struct _skidMetaCache
+{
+    pthread_rwlock_t lock;               // Guards buckets, num_entries, max_entries, and dirs
+    skidCacheEntry_ptr *buckets;         // Heap-allocated hash table of mask + 1 buckets
+    size_t mask;                         // Number of buckets - 1 (a power of two)
+    size_t num_entries;                  // Number of entries in the hash table
+    size_t max_entries;                  // Most entries the hash table will hold
+    skidCacheDir_ptr dirs;               // Watched directories
+    int inotify_fd;                      // inotify instance holding the watches
+    int stop_fd;                         // eventfd destroy_meta_cache() stops the watcher with
+    pthread_t watcher;                   // The watcher thread
+    bool lock_inited;                    // Was lock initialized?
+    bool watcher_started;                // Was the watcher thread created?
+    atomic_uint_fast64_t generation;     // Bumped before anything is invalidated
+    atomic_uint_fast64_t hits;           // Lookups answered from the cache
+    atomic_uint_fast64_t misses;         // Lookups that called statx()
+    atomic_uint_fast64_t invalidations;  // Entries thrown out because of an inotify event
+};
+
+
+/**************************************************************************************************/
+/********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
+/**************************************************************************************************/
+
+/*
+ *  Description:
+ *      Find the watched directory named by the first dir_len bytes of dirname.  The caller
+ *      must hold the cache's lock.
+ *
+ *  Args:
+ *      cache: The metadata cache to search.
+ *      dirname: The directory name.  Need not be nul-terminated.
+ *      dir_len: The length of dirname.
+ *
+ *  Returns:
+ *      The watched directory, or NULL if dirname isn't watched.
+ */
+SKID_INTERNAL skidCacheDir_ptr find_smc_dir(skidMetaCache_ptr cache, const char *dirname,
+                                            size_t dir_len);
+
+/*
+ *  Description:
+ *      Find pathname's entry in the hash table.  The caller must hold the cache's lock.
+ *
+ *  Args:
+ *      cache: The metadata cache to search.
+ *      pathname: The key.
+ *      hash: hash_smc_key(pathname).
+ *
+ *  Returns:
+ *      The entry, or NULL if pathname isn't cached.
+ */
+SKID_INTERNAL skidCacheEntry_ptr find_smc_entry(skidMetaCache_ptr cache, const char *pathname,
+                                                uint64_t hash);
+
+/*
+ *  Description:
+ *      Invalidate whatever one inotify event makes stale.  If the event means a watched
+ *      directory is gone, its entries and its watch are dropped.  The caller must hold the
+ *      cache's lock for writing.
+ *
+ *  Args:
+ *      cache: The metadata cache to update.
+ *      event: The inotify event.
+ */
+SKID_INTERNAL void handle_smc_event(skidMetaCache_ptr cache, const struct inotify_event *event);
+
+/*
+ *  Description:
+ *      Hash a pathname with 64-bit FNV-1a.
+ *
+ *  Args:
+ *      key: The nul-terminated pathname to hash.
+ *
+ *  Returns:
+ *      The hash.
+ */
+SKID_INTERNAL uint64_t hash_smc_key(const char *key);
+
+/*
+ *  Description:
+ *      Cache pathname's metadata if pathname is in a watched directory, the cache isn't full,
+ *      and nothing was invalidated since generation was read.  That last check keeps a
+ *      snapshot that raced a change out of the cache.
+ *
+ *  Args:
+ *      cache: The metadata cache to update.
+ *      pathname: The key.
+ *      hash: hash_smc_key(pathname).
+ *      meta: The metadata to cache.
+ *      generation: The cache's generation from before meta was fetched.
+ *
+ *  Returns:
+ *      ENOERR on success, including when pathname wasn't cached.  Errno value on failure.
+ */
+SKID_INTERNAL int insert_smc_entry(skidMetaCache_ptr cache, const char *pathname, uint64_t hash,
+                                   const skidFileMeta *meta, uint64_t generation);
+
+/*
+ *  Description:
+ *      Stop watching directories with the watch descriptor wd and drop their entries.  The
+ *      caller must hold the cache's lock for writing.
+ *
+ *  Args:
+ *      cache: The metadata cache to update.
+ *      wd: The watch descriptor, or SKID_SMC_ANY_WD for every watched directory.
+ *      rm_watch: If true, also remove the watch from the inotify instance.
+ *
+ *  Returns:
+ *      The number of entries dropped.
+ */
+SKID_INTERNAL size_t remove_smc_dirs(skidMetaCache_ptr cache, int wd, bool rm_watch);
+
+/*
+ *  Description:
+ *      Drop every entry whose directory has the watch descriptor wd.  The caller must hold the
+ *      cache's lock for writing.
+ *
+ *  Args:
+ *      cache: The metadata cache to update.
+ *      wd: The watch descriptor, or SKID_SMC_ANY_WD for every entry.
+ *
+ *  Returns:
+ *      The number of entries dropped.
+ */
+SKID_INTERNAL size_t remove_smc_entries(skidMetaCache_ptr cache, int wd);
+
+/*
+ *  Description:
+ *      Drop pathname's entry, if it's cached.  The caller must hold the cache's lock for writing.
+ *
+ *  Args:
+ *      cache: The metadata cache to update.
+ *      pathname: The key.
+ *      hash: hash_smc_key(pathname).
+ *
+ *  Returns:
+ *      The number of entries dropped (0 or 1).
+ */
+SKID_INTERNAL size_t remove_smc_entry(skidMetaCache_ptr cache, const char *pathname,
+                                      uint64_t hash);
+
+/*
+ *  Description:
+ *      Watcher thread entry point.  Reads inotify events and invalidates entries until
+ *      destroy_meta_cache() signals stop_fd.  If the inotify instance fails, the cache is
+ *      emptied and stops caching, since it can no longer be kept current.
+ *
+ *  Args:
+ *      arg: The skidMetaCache_ptr to service.
+ *
+ *  Returns:
+ *      NULL.
+ */
+SKID_INTERNAL void *run_smc_watcher(void *arg);
+
+/*
+ *  Description:
+ *      Validates the skidMetaCache_ptr arguments on behalf of this library.
+ *
+ *  Args:
+ *      cache: A pointer returned by create_meta_cache().
+ *
+ *  Returns:
+ *      An errno value indicating the results of validation.  ENOERR on successful validation.
+ */
+SKID_INTERNAL int validate_smc_cache(skidMetaCache_ptr cache);
+
+
+/**************************************************************************************************/
+/********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+
+skidMetaCache_ptr create_meta_cache(size_t max_entries, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;             // Errno values
+    skidMetaCache_ptr cache = NULL;  // The new metadata cache
+    size_t num_buckets = 2;          // Number of buckets, rounded up to a power of two
+    pthread_rwlockattr_t lock_attr;  // Lets the watcher cut in line ahead of new readers
+    bool attr_inited = false;        // Was lock_attr initialized?
+
+    // INPUT VALIDATION
+    result = validate_skid_err(errnum);
+
+    // SETUP
+    if (ENOERR == result)
+    {
+        if (0 == max_entries)
+        {
+            max_entries = SKID_META_CACHE_ENTRIES;
+        }
+        while (num_buckets < max_entries)
+        {
+            num_buckets <<= 1;
+        }
+        cache = alloc_skid_mem(1, sizeof(skidMetaCache), &result);
+    }
+    if (ENOERR == result)
+    {
+        cache->mask = num_buckets - 1;
+        cache->max_entries = max_entries;
+        cache->inotify_fd = SKID_BAD_FD;
+        cache->stop_fd = SKID_BAD_FD;
+        atomic_init(&(cache->generation), 0);
+        atomic_init(&(cache->hits), 0);
+        atomic_init(&(cache->misses), 0);
+        atomic_init(&(cache->invalidations), 0);
+        cache->buckets = alloc_skid_mem(num_buckets, sizeof(skidCacheEntry_ptr), &result);
+    }
+    // Initialize the lock
+    if (ENOERR == result)
+    {
+        result = pthread_rwlockattr_init(&lock_attr);
+        if (ENOERR == result)
+        {
+            attr_inited = true;
+            result = pthread_rwlockattr_setkind_np(&lock_attr,
+                                                   PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+        }
+    }
+    if (ENOERR == result)
+    {
+        result = pthread_rwlock_init(&(cache->lock), &lock_attr);
+        if (ENOERR == result)
+        {
+            cache->lock_inited = true;
+        }
+    }
+    // Create the file descriptors
+    if (ENOERR == result)
+    {
+        cache->inotify_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (SKID_BAD_FD == cache->inotify_fd)
+        {
+            result = errno;
+            PRINT_ERROR(The call to inotify_init1() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    if (ENOERR == result)
+    {
+        cache->stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (SKID_BAD_FD == cache->stop_fd)
+        {
+            result = errno;
+            PRINT_ERROR(The call to eventfd() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // START IT
+    if (ENOERR == result)
+    {
+        result = pthread_create(&(cache->watcher), NULL, run_smc_watcher, cache);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to pthread_create() failed);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            cache->watcher_started = true;
+        }
+    }
+
+    // CLEANUP
+    if (true == attr_inited)
+    {
+        pthread_rwlockattr_destroy(&lock_attr);
+    }
+    if (ENOERR != result && NULL != cache)
+    {
+        destroy_meta_cache(&cache);  // Best effort
+        cache = NULL;
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = result;
+    }
+    return cache;
+}
+
+
+int destroy_meta_cache(skidMetaCache_ptr *cache)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                 // Errno values
+    skidMetaCache_ptr tmp_cache = NULL;  // Local copy of *cache
+    uint64_t stop = 1;                   // Value to write to stop_fd
+
+    // INPUT VALIDATION
+    if (NULL == cache)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        tmp_cache = *cache;
+        result = validate_smc_cache(tmp_cache);
+    }
+
+    // STOP IT
+    if (ENOERR == result && true == tmp_cache->watcher_started)
+    {
+        if (sizeof(stop) != write(tmp_cache->stop_fd, &stop, sizeof(stop)))
+        {
+            result = errno;
+            PRINT_ERROR(The call to write() failed to stop the watcher thread);
+            PRINT_ERRNO(result);
+        }
+        else
+        {
+            result = pthread_join(tmp_cache->watcher, NULL);
+            if (ENOERR != result)
+            {
+                PRINT_ERROR(The call to pthread_join() failed);
+                PRINT_ERRNO(result);
+            }
+        }
+    }
+    // Tear it down (the watcher is gone so the lock is no longer needed)
+    if (ENOERR == result)
+    {
+        if (NULL != tmp_cache->buckets)
+        {
+            remove_smc_entries(tmp_cache, SKID_SMC_ANY_WD);
+        }
+        remove_smc_dirs(tmp_cache, SKID_SMC_ANY_WD, false);  // Closing inotify_fd removes them
+        if (SKID_BAD_FD != tmp_cache->inotify_fd)
+        {
+            close_fd(&(tmp_cache->inotify_fd), true);  // Best effort
+        }
+        if (SKID_BAD_FD != tmp_cache->stop_fd)
+        {
+            close_fd(&(tmp_cache->stop_fd), true);  // Best effort
+        }
+        if (true == tmp_cache->lock_inited)
+        {
+            pthread_rwlock_destroy(&(tmp_cache->lock));
+        }
+        free_skid_mem((void **)&(tmp_cache->buckets));  // Best effort
+        free_skid_mem((void **)cache);  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+int flush_meta_cache(skidMetaCache_ptr cache)
+{
+    // LOCAL VARIABLES
+    int result = validate_smc_cache(cache);  // Errno values
+
+    // FLUSH IT
+    if (ENOERR == result)
+    {
+        pthread_rwlock_wrlock(&(cache->lock));
+        atomic_fetch_add(&(cache->generation), 1);  // Keep in-flight misses out too
+        remove_smc_entries(cache, SKID_SMC_ANY_WD);
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_cached_meta(skidMetaCache_ptr cache, const char *pathname, skidFileMeta_ptr meta)
+{
+    // LOCAL VARIABLES
+    int result = validate_smc_cache(cache);  // Errno values
+    skidCacheEntry_ptr entry = NULL;         // pathname's entry
+    uint64_t hash = 0;                       // hash_smc_key(pathname)
+    uint64_t generation = 0;                 // The cache's generation before a miss's statx()
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_pathname(pathname, false);
+    }
+    if (ENOERR == result && !meta)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null meta pointer);
+    }
+
+    // LOOK IT UP
+    if (ENOERR == result)
+    {
+        hash = hash_smc_key(pathname);
+        pthread_rwlock_rdlock(&(cache->lock));
+        entry = find_smc_entry(cache, pathname, hash);
+        if (NULL != entry)
+        {
+            memcpy(meta, &(entry->meta), sizeof(*meta));
+        }
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // FETCH IT
+    if (ENOERR == result)
+    {
+        if (NULL != entry)
+        {
+            atomic_fetch_add_explicit(&(cache->hits), 1, memory_order_relaxed);
+        }
+        else
+        {
+            atomic_fetch_add_explicit(&(cache->misses), 1, memory_order_relaxed);
+            generation = atomic_load(&(cache->generation));
+            result = get_file_meta(pathname, SKID_META_BASIC, false, meta);
+            if (ENOERR == result && S_ISLNK(meta->mode))
+            {
+                // Follow it, but don't cache it
+                result = get_file_meta(pathname, SKID_META_BASIC, true, meta);
+            }
+            else if (ENOERR == result)
+            {
+                insert_smc_entry(cache, pathname, hash, meta, generation);  // Best effort
+            }
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_meta_cache_stats(skidMetaCache_ptr cache, skidMetaCacheStats_ptr stats)
+{
+    // LOCAL VARIABLES
+    int result = validate_smc_cache(cache);  // Errno values
+
+    // INPUT VALIDATION
+    if (ENOERR == result && !stats)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null stats pointer);
+    }
+
+    // GET IT
+    if (ENOERR == result)
+    {
+        stats->hits = atomic_load_explicit(&(cache->hits), memory_order_relaxed);
+        stats->misses = atomic_load_explicit(&(cache->misses), memory_order_relaxed);
+        stats->invalidations = atomic_load_explicit(&(cache->invalidations),
+                                                    memory_order_relaxed);
+        pthread_rwlock_rdlock(&(cache->lock));
+        stats->entries = cache->num_entries;
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // DONE
+    return result;
+}
+
+
+int watch_meta_cache_dir(skidMetaCache_ptr cache, const char *dirname)
+{
+    // LOCAL VARIABLES
+    int result = validate_smc_cache(cache);  // Errno values
+    skidCacheDir_ptr dir = NULL;             // The new watched directory
+    size_t dir_len = 0;                      // Length of dirname, without trailing slashes
+    bool is_new = true;                      // False if dirname is already watched
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_pathname(dirname, false);
+    }
+    if (ENOERR == result && '/' != dirname[0])
+    {
+        result = EINVAL;  // A relative key would change meaning with the working directory
+        PRINT_ERROR(Invalid Argument - Received a relative dirname);
+    }
+    if (ENOERR == result)
+    {
+        dir_len = strlen(dirname);
+        while (dir_len > 1 && '/' == dirname[dir_len - 1])
+        {
+            dir_len--;  // Trailing slashes don't count
+        }
+        if (dir_len >= PATH_MAX)
+        {
+            result = ENAMETOOLONG;
+        }
+    }
+
+    // SETUP
+    if (ENOERR == result)
+    {
+        dir = alloc_skid_mem(1, sizeof(skidCacheDir), &result);
+    }
+    if (ENOERR == result)
+    {
+        dir->dir_len = dir_len;
+        dir->dirname = copy_skid_string(dirname, &result);
+    }
+
+    // WATCH IT
+    if (ENOERR == result)
+    {
+        dir->dirname[dir_len] = '\0';
+        dir->wd = inotify_add_watch(cache->inotify_fd, dir->dirname, SKID_SMC_EVENTS);
+        if (-1 == dir->wd)
+        {
+            result = errno;
+            PRINT_ERROR(The call to inotify_add_watch() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+    if (ENOERR == result)
+    {
+        pthread_rwlock_wrlock(&(cache->lock));
+        if (NULL == find_smc_dir(cache, dir->dirname, dir_len))
+        {
+            dir->next = cache->dirs;
+            cache->dirs = dir;
+            // A miss that started before the watch existed may have missed a change
+            atomic_fetch_add(&(cache->generation), 1);
+        }
+        else
+        {
+            is_new = false;
+        }
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // CLEANUP
+    if ((ENOERR != result || false == is_new) && NULL != dir)
+    {
+        free_skid_string(&(dir->dirname));  // Best effort
+        free_skid_mem((void **)&dir);  // Best effort
+    }
+
+    // DONE
+    return result;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL skidCacheDir_ptr find_smc_dir(skidMetaCache_ptr cache, const char *dirname,
+                                            size_t dir_len)
+{
+    // LOCAL VARIABLES
+    skidCacheDir_ptr dir = cache->dirs;  // Current watched directory
+
+    // FIND IT
+    while (NULL != dir)
+    {
+        if (dir_len == dir->dir_len && 0 == strncmp(dirname, dir->dirname, dir_len))
+        {
+            break;
+        }
+        dir = dir->next;
+    }
+
+    // DONE
+    return dir;
+}
+
+
+SKID_INTERNAL skidCacheEntry_ptr find_smc_entry(skidMetaCache_ptr cache, const char *pathname,
+                                                uint64_t hash)
+{
+    // LOCAL VARIABLES
+    skidCacheEntry_ptr entry = cache->buckets[hash & cache->mask];  // Current entry
+
+    // FIND IT
+    while (NULL != entry)
+    {
+        if (hash == entry->hash && 0 == strcmp(pathname, entry->pathname))
+        {
+            break;
+        }
+        entry = entry->next;
+    }
+
+    // DONE
+    return entry;
+}
+
+
+SKID_INTERNAL void handle_smc_event(skidMetaCache_ptr cache, const struct inotify_event *event)
+{
+    // LOCAL VARIABLES
+    size_t num_dropped = 0;       // Number of entries invalidated
+    skidCacheDir_ptr dir = NULL;  // Current watched directory
+    size_t name_len = 0;          // Length of event->name
+    char pathname[PATH_MAX + 1];  // A watched directory's dirname + '/' + event->name
+
+    // HANDLE IT
+    if (event->mask & IN_Q_OVERFLOW)
+    {
+        // Events were lost so anything may be stale
+        num_dropped = remove_smc_entries(cache, SKID_SMC_ANY_WD);
+    }
+    else if (event->mask & SKID_SMC_GONE)
+    {
+        // IN_IGNORED means the kernel already removed the watch
+        num_dropped = remove_smc_dirs(cache, event->wd, !(event->mask & IN_IGNORED));
+    }
+    else if (event->len > 0)
+    {
+        // Rebuild the key under every name the directory is watched by
+        name_len = strlen(event->name);
+        for (dir = cache->dirs; NULL != dir; dir = dir->next)
+        {
+            if (event->wd == dir->wd && dir->dir_len + 1 + name_len <= PATH_MAX)
+            {
+                memcpy(pathname, dir->dirname, dir->dir_len);
+                if (1 == dir->dir_len && '/' == dir->dirname[0])
+                {
+                    memcpy(pathname + 1, event->name, name_len + 1);  // "/" + name
+                }
+                else
+                {
+                    pathname[dir->dir_len] = '/';
+                    memcpy(pathname + dir->dir_len + 1, event->name, name_len + 1);
+                }
+                num_dropped += remove_smc_entry(cache, pathname, hash_smc_key(pathname));
+            }
+        }
+    }
+
+    // DONE
+    if (num_dropped > 0)
+    {
+        atomic_fetch_add_explicit(&(cache->invalidations), num_dropped, memory_order_relaxed);
+    }
+}
+
+
+SKID_INTERNAL uint64_t hash_smc_key(const char *key)
+{
+    // LOCAL VARIABLES
+    uint64_t hash = 0xCBF29CE484222325ULL;  // FNV-1a 64-bit offset basis
+
+    // HASH IT
+    for (; '\0' != *key; key++)
+    {
+        hash ^= (unsigned char)*key;
+        hash *= 0x100000001B3ULL;  // FNV-1a 64-bit prime
+    }
+
+    // DONE
+    return hash;
+}
+
+
+SKID_INTERNAL int insert_smc_entry(skidMetaCache_ptr cache, const char *pathname, uint64_t hash,
+                                   const skidFileMeta *meta, uint64_t generation)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                         // Errno values
+    const char *slash = strrchr(pathname, '/');  // The end of pathname's directory
+    size_t dir_len = 0;                          // Length of pathname's directory
+    skidCacheDir_ptr dir = NULL;                 // pathname's watched directory
+    skidCacheEntry_ptr entry = NULL;             // The new entry
+    size_t bucket = hash & cache->mask;          // pathname's bucket
+
+    // INSERT IT
+    if (NULL != slash)
+    {
+        dir_len = (slash == pathname) ? 1 : (size_t)(slash - pathname);  // "/name" is in "/"
+        pthread_rwlock_wrlock(&(cache->lock));
+        if (generation == atomic_load(&(cache->generation))
+            && cache->num_entries < cache->max_entries)
+        {
+            dir = find_smc_dir(cache, pathname, dir_len);
+        }
+        if (NULL != dir && NULL == find_smc_entry(cache, pathname, hash))
+        {
+            entry = alloc_skid_mem(1, sizeof(skidCacheEntry), &result);
+            if (ENOERR == result)
+            {
+                entry->pathname = copy_skid_string(pathname, &result);
+            }
+            if (ENOERR == result)
+            {
+                entry->hash = hash;
+                entry->wd = dir->wd;
+                memcpy(&(entry->meta), meta, sizeof(entry->meta));
+                entry->next = cache->buckets[bucket];
+                cache->buckets[bucket] = entry;
+                cache->num_entries++;
+            }
+            else if (NULL != entry)
+            {
+                free_skid_mem((void **)&entry);  // Best effort
+            }
+        }
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL size_t remove_smc_dirs(skidMetaCache_ptr cache, int wd, bool rm_watch)
+{
+    // LOCAL VARIABLES
+    size_t num_dropped = 0;                   // Number of entries dropped
+    skidCacheDir_ptr *link = &(cache->dirs);  // Link to the current watched directory
+    skidCacheDir_ptr dir = NULL;              // The watched directory being removed
+
+    // REMOVE THEM
+    num_dropped = remove_smc_entries(cache, wd);
+    if (true == rm_watch && SKID_SMC_ANY_WD != wd)
+    {
+        inotify_rm_watch(cache->inotify_fd, wd);  // Best effort
+    }
+    while (NULL != *link)
+    {
+        dir = *link;
+        if (SKID_SMC_ANY_WD == wd || wd == dir->wd)
+        {
+            *link = dir->next;
+            free_skid_string(&(dir->dirname));  // Best effort
+            free_skid_mem((void **)&dir);  // Best effort
+        }
+        else
+        {
+            link = &(dir->next);
+        }
+    }
+
+    // DONE
+    return num_dropped;
+}
+
+
+SKID_INTERNAL size_t remove_smc_entries(skidMetaCache_ptr cache, int wd)
+{
+    // LOCAL VARIABLES
+    size_t num_dropped = 0;           // Number of entries dropped
+    skidCacheEntry_ptr *link = NULL;  // Link to the current entry
+    skidCacheEntry_ptr entry = NULL;  // The entry being removed
+    size_t i = 0;                     // Iterating variable
+
+    // REMOVE THEM
+    for (i = 0; i <= cache->mask; i++)
+    {
+        link = cache->buckets + i;
+        while (NULL != *link)
+        {
+            entry = *link;
+            if (SKID_SMC_ANY_WD == wd || wd == entry->wd)
+            {
+                *link = entry->next;
+                free_skid_string(&(entry->pathname));  // Best effort
+                free_skid_mem((void **)&entry);  // Best effort
+                num_dropped++;
+            }
+            else
+            {
+                link = &(entry->next);
+            }
+        }
+    }
+    cache->num_entries -= num_dropped;
+
+    // DONE
+    return num_dropped;
+}
+
+
+SKID_INTERNAL size_t remove_smc_entry(skidMetaCache_ptr cache, const char *pathname,
+                                      uint64_t hash)
+{
+    // LOCAL VARIABLES
+    size_t num_dropped = 0;                                            // Number of entries dropped
+    skidCacheEntry_ptr *link = cache->buckets + (hash & cache->mask);  // Link to the current entry
+    skidCacheEntry_ptr entry = NULL;                                   // The current entry
+
+    // REMOVE IT
+    while (NULL != *link)
+    {
+        entry = *link;
+        if (hash == entry->hash && 0 == strcmp(pathname, entry->pathname))
+        {
+            *link = entry->next;
+            free_skid_string(&(entry->pathname));  // Best effort
+            free_skid_mem((void **)&entry);  // Best effort
+            cache->num_entries--;
+            num_dropped++;
+            break;
+        }
+        link = &(entry->next);
+    }
+
+    // DONE
+    return num_dropped;
+}
+
+
+SKID_INTERNAL void *run_smc_watcher(void *arg)
+{
+    // LOCAL VARIABLES
+    skidMetaCache_ptr cache = (skidMetaCache_ptr)arg;  // The metadata cache to service
+    struct pollfd pfds[2];                             // inotify_fd and stop_fd
+    // Buffer of inotify events, aligned for struct inotify_event
+    char buf[SKID_SMC_EVENT_BUF] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t num_read = 0;                              // Bytes of events read
+    const struct inotify_event *event = NULL;          // Current event
+    int result = ENOERR;                               // Errno values
+    char *ptr = NULL;                                  // Cursor into buf
+
+    // SETUP
+    pfds[0].fd = cache->inotify_fd;
+    pfds[0].events = POLLIN;
+    pfds[1].fd = cache->stop_fd;
+    pfds[1].events = POLLIN;
+
+    // WATCH IT
+    while (ENOERR == result)
+    {
+        if (-1 == poll(pfds, 2, -1))
+        {
+            if (EINTR != errno)
+            {
+                result = errno;
+                PRINT_ERROR(The call to poll() failed);
+                PRINT_ERRNO(result);
+            }
+            continue;
+        }
+        if (pfds[1].revents)
+        {
+            break;  // destroy_meta_cache()
+        }
+        num_read = read(cache->inotify_fd, buf, sizeof(buf));
+        if (num_read > 0)
+        {
+            pthread_rwlock_wrlock(&(cache->lock));
+            atomic_fetch_add(&(cache->generation), 1);
+            for (ptr = buf; ptr < buf + num_read;
+                 ptr += sizeof(struct inotify_event) + event->len)
+            {
+                event = (const struct inotify_event *)ptr;
+                handle_smc_event(cache, event);
+            }
+            pthread_rwlock_unlock(&(cache->lock));
+        }
+        else if (-1 == num_read && EAGAIN != errno && EINTR != errno)
+        {
+            result = errno;
+            PRINT_ERROR(The call to read() failed);
+            PRINT_ERRNO(result);
+        }
+    }
+
+    // GIVE UP
+    if (ENOERR != result)
+    {
+        // Nothing can be invalidated anymore, so stop caching
+        pthread_rwlock_wrlock(&(cache->lock));
+        atomic_fetch_add(&(cache->generation), 1);
+        remove_smc_entries(cache, SKID_SMC_ANY_WD);
+        cache->max_entries = 0;
+        pthread_rwlock_unlock(&(cache->lock));
+    }
+
+    // DONE
+    return NULL;
+}
+
+
+SKID_INTERNAL int validate_smc_cache(skidMetaCache_ptr cache)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // VALIDATE IT
+    if (NULL == cache)
+    {
+        result = EINVAL;  // NULL pointer
+        PRINT_ERROR(Invalid Argument - Received a null cache pointer);
+    }
+
+    // DONE
+    return result;
+}
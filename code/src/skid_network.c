@@ -7,7 +7,7 @@
 #include "skid_file_descriptors.h"          // close_fd()
 #include "skid_debug.h"                     // PRINT_ERRNO(), PRINT_ERROR()
 #include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
-#include "skid_memory.h"                    // alloc_skid_mem()
+#include "skid_memory.h"                    // *_skid_buffer()
 #include "skid_network.h"                   // SKID_BAD_FD
 #include "skid_validation.h"                // validate_skid_err(), validate_skid_sockfd()
 #include <arpa/inet.h>                      // inet_ntop()
@@ -25,8 +25,6 @@
 #define PRINT_GAI_ERR(errcode) ;;;
 #endif  /* SKID_DEBUG */
 
-#define SKID_NET_BUFF_SIZE 1024  // Starting buffer size to read into
-
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
 
@@ -35,36 +33,6 @@ MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destruct
 /********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
 /**************************************************************************************************/
 
-/*
- *  Description:
- *      Check for an existing buffer pointer.  If one does not exist, make the first allocation.
- *
- *  Args:
- *      output_buf: [Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [Out] Pointer to the size of output_buf.
- *
- *  Returns:
- *      ENOERR on success, errno on failure.
- */
-SKID_INTERNAL int check_sn_pre_alloc(char **output_buf, size_t *output_size);
-
-/*
- *  Description:
- *      Determine if the bytes_read can fit into the output buffer based on its size and current
- *      length.
- *
- *  Args:
- *      bytes_read: The number of bytes to append to the output buffer.
- *      output_len: The number of bytes currently in the buffer.
- *      output_size: Total size of the output buffer.
- *
- *  Returns:
- *      True if there's room.  False if there isn't (time to reallocate), on for invalid args.
- */
-SKID_INTERNAL bool check_sn_space(size_t bytes_read, size_t output_len, size_t output_size);
-
 /*
  *  Description:
  *      Retrieve the relevant address pointer based on the struct's sa_family value.
@@ -123,24 +91,6 @@ SKID_INTERNAL sa_family_t get_socket_family(int sockfd, int *errnum);
 SKID_INTERNAL int get_socket_option(int sockfd, int level, int option_name,
                                     void *restrict option_value, socklen_t *restrict option_len);
 
-/*
- *  Description:
- *      Reallocate a buffer: allocate a new buffer double the *output_size, copy the contents of
- *      *output_buf into the new buffer, free the old buffer, update the Out arguments.
- *      It is the caller's responsibility to free the buffer with free_skid_mem().
- *
- *  Args:
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
- *
- *  Returns:
- *      ENOERR on success, errno on failure.  EOVERFLOW is used to indicate the output_size can not
- *      be doubled without overflowing the size_t data type.
- */
-SKID_INTERNAL int realloc_sock_dynamic(char **output_buf, size_t *output_size);
-
 /*
  *  Description:
  *      Determine the size of the data waiting to be read from sockfd.  Calls recvfrom() with
@@ -164,48 +114,22 @@ SKID_INTERNAL ssize_t recv_from_size(int sockfd, int *errnum);
 
 /*
  *  Description:
- *      Read the contents of the file descriptor into a heap-allocated buffer.  If the buffer ever
- *      fills then this function will (effectively) reallocate more space.  It will read until
- *      no other data can be read or an error occurred.  It is the caller's responsibility to
- *      free the buffer with free_skid_mem().
- *
- *  Args:
- *      sockfd: Socket file descriptor to recv from.
- *      flags: A bit-wise OR of zero or more flags (see: recvfrom(2)).
- *      src_addr: [Optional/Out] Passed directly to recvfrom() without validation.
- *      addrlen: [Optional/Out] Passed directly to recvfrom() without validation.
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
- *
- *  Returns:
- *      ENOERR on success, errno on failure.
- */
-SKID_INTERNAL int recv_from_socket_dynamic(int sockfd, int flags, struct sockaddr *src_addr,
-                                           socklen_t *addrlen, char **output_buf,
-                                           size_t *output_size);
-
-/*
- *  Description:
- *      Read the contents of the file descriptor into a heap-allocated buffer.  If the buffer ever
- *      fills then this function will (effectively) reallocate more space.  It will read until
- *      no other data can be read or an error occurred.  It is the caller's responsibility to
- *      free the buffer with free_skid_mem().
+ *      Receive from the socket directly into a skidBuffer, appending to any existing contents.
+ *      If the buffer ever fills then this function will grow it.  It will read until no other
+ *      data can be read or an error occurred.  One byte is always reserved so the buffer can be
+ *      nul-terminated.
  *
  *  Args:
  *      sockfd: Socket file descriptor to recv from.
  *      flags: A bit-wise OR of zero or more flags (see: recv(2), recv_socket()).
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
+ *      buffer: [In/Out] The skidBuffer to receive into.  New data is stored starting at
+ *          buffer->length and buffer->length is updated as data is received.
  *
  *  Returns:
- *      ENOERR on success, errno on failure.
+ *      ENOERR on success, errno on failure.  On failure, the buffer is left allocated (but may
+ *      contain partial data) and remains the caller's responsibility.
  */
-SKID_INTERNAL int recv_socket_dynamic(int sockfd, int flags, char **output_buf,
-                                      size_t *output_size);
+SKID_INTERNAL int recv_socket_dynamic(int sockfd, int flags, skidBuffer_ptr buffer);
 
 /*
  *  Description:
@@ -255,21 +179,6 @@ SKID_INTERNAL ssize_t send_to_chunk(int sockfd, const void *buf, size_t len, int
                                     const struct sockaddr *dest_addr, socklen_t addrlen,
                                     int *errnum);
 
-/*
- *  Description:
- *      Validate common In/Out args on behalf of the library.
- *
- *  Args:
- *      output_buf: [In/Out] Pointer to the working heap-allocated buffer.  If this pointer holds
- *          a NULL pointer, heap memory will be allocated, the pointer will be stored here, and
- *          output_size will be updated.
- *      output_size: [In/Out] Pointer to the size of output_buf.
- *
- *  Returns:
- *      ENOERR on success, errno on failed validation.
- */
-SKID_INTERNAL int validate_sn_args(char **output_buf, size_t *output_size);
-
 /**************************************************************************************************/
 /********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
 /**************************************************************************************************/
@@ -675,9 +584,9 @@ char *receive_socket(int sockfd, int flags, int protocol, int *errnum)
 char *recv_socket(int sockfd, int flags, int *errnum)
 {
     // LOCAL VARIABLES
-    char *msg = NULL;     // Heap-allocated copy of the msg read from sockfd
-    size_t msg_len = 0;   // The length of msg (after it's recv()'d)
-    int result = ENOERR;  // Errno values
+    char *msg = NULL;           // Heap-allocated copy of the msg read from sockfd
+    skidBuffer buffer = { 0 };  // Working buffer for the msg read from sockfd
+    int result = ENOERR;        // Errno values
 
     // INPUT VALIDATION
     result = validate_skid_sockfd(sockfd);
@@ -689,7 +598,15 @@ char *recv_socket(int sockfd, int flags, int *errnum)
     // RECEIVE IT
     if (ENOERR == result)
     {
-        result = recv_socket_dynamic(sockfd, flags, &msg, &msg_len);
+        result = recv_socket_dynamic(sockfd, flags, &buffer);
+    }
+    if (ENOERR == result)
+    {
+        msg = buffer.data;  // The caller now owns the allocation
+    }
+    else
+    {
+        free_skid_buffer(&buffer);  // Best effort
     }
 
     // DONE
@@ -701,11 +618,70 @@ char *recv_socket(int sockfd, int flags, int *errnum)
 }
 
 
+int recv_socket_buf(int sockfd, int flags, skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_sockfd(sockfd);  // Errno values
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = clear_skid_buffer(buffer);  // Also validates buffer
+    }
+
+    // RECEIVE IT
+    if (ENOERR == result)
+    {
+        result = recv_socket_dynamic(sockfd, flags, buffer);
+        if (ENOERR != result)
+        {
+            clear_skid_buffer(buffer);  // Don't report partial data
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
 char *recv_from_socket(int sockfd, int flags, struct sockaddr *src_addr, socklen_t *addrlen,
                        int *errnum)
 {
     // LOCAL VARIABLES
-    char *msg = NULL;       // Heap-allocated copy of the msg read from sockfd
+    char *msg = NULL;           // Heap-allocated copy of the msg read from sockfd
+    skidBuffer buffer = { 0 };  // Working buffer for the msg read from sockfd
+    int result = ENOERR;        // Errno values
+
+    // INPUT VALIDATION
+    result = validate_skid_err(errnum);
+
+    // RECEIVE IT
+    if (ENOERR == result)
+    {
+        result = recv_from_socket_buf(sockfd, flags, src_addr, addrlen, &buffer);
+    }
+    if (ENOERR == result)
+    {
+        msg = buffer.data;  // The caller now owns the allocation
+    }
+    else
+    {
+        free_skid_buffer(&buffer);  // Best effort
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return msg;
+}
+
+
+int recv_from_socket_buf(int sockfd, int flags, struct sockaddr *src_addr, socklen_t *addrlen,
+                         skidBuffer_ptr buffer)
+{
+    // LOCAL VARIABLES
     ssize_t data_size = 0;  // Size of the data waiting in sockfd
     int result = ENOERR;    // Errno values
 
@@ -713,7 +689,7 @@ char *recv_from_socket(int sockfd, int flags, struct sockaddr *src_addr, socklen
     result = validate_skid_sockfd(sockfd);
     if (ENOERR == result)
     {
-        result = validate_skid_err(errnum);
+        result = clear_skid_buffer(buffer);  // Also validates buffer
     }
 
     // RECEIVE IT
@@ -731,33 +707,39 @@ char *recv_from_socket(int sockfd, int flags, struct sockaddr *src_addr, socklen
             result = ENODATA;  // No data to receive
         }
     }
-    // Allocate
+    // Make room (only allocates if the buffer is too small)
     if (ENOERR == result)
     {
-        msg = alloc_skid_mem(data_size + 1, 1, &result);
+        result = grow_skid_buffer(buffer, data_size + 1);
     }
     // Read
     if (ENOERR == result)
     {
-        if (data_size != call_recvfrom(sockfd, flags, src_addr, addrlen, msg, data_size, &result))
+        if (data_size != call_recvfrom(sockfd, flags, src_addr, addrlen, buffer->data, data_size,
+                                       &result))
         {
             PRINT_ERROR(The call to call_recvfrom() failed);
             PRINT_ERRNO(result);
+            if (ENOERR == result)
+            {
+                result = EIO;  // The datagram size changed out from under us
+            }
+        }
+        else
+        {
+            buffer->length = data_size;
+            buffer->data[data_size] = '\0';
         }
     }
 
     // CLEANUP
     if (ENOERR != result)
     {
-        free_skid_mem((void **)&msg);  // Best effort
+        clear_skid_buffer(buffer);  // Best effort
     }
 
     // DONE
-    if (errnum)
-    {
-        *errnum = result;
-    }
-    return msg;
+    return result;
 }
 
 
@@ -971,59 +953,6 @@ int send_to_socket(int sockfd, const char *msg, int flags, const struct sockaddr
 /**************************************************************************************************/
 
 
-SKID_INTERNAL int check_sn_pre_alloc(char **output_buf, size_t *output_size)
-{
-    // LOCAL VARIABLES
-    int result = ENOERR;   // Success of execution
-    char *tmp_ptr = NULL;  // Return value from allocation
-
-    // INPUT VALIDATION
-    result = validate_sn_args(output_buf, output_size);
-
-    // CHECK IT
-    if (ENOERR == result)
-    {
-        if (NULL == *output_buf)
-        {
-            tmp_ptr = alloc_skid_mem(SKID_NET_BUFF_SIZE, sizeof(char), &result);
-            if (NULL == tmp_ptr)
-            {
-                PRINT_ERROR(The call to alloc_skid_mem() failed);
-                PRINT_ERRNO(result);
-            }
-            else
-            {
-                *output_buf = tmp_ptr;  // Store the pointer
-                *output_size = SKID_NET_BUFF_SIZE;  // Update the size
-            }
-        }
-    }
-
-    // DONE
-    return result;
-}
-
-
-SKID_INTERNAL bool check_sn_space(size_t bytes_read, size_t output_len, size_t output_size)
-{
-    // LOCAL VARIABLES
-    bool has_room = false;  // Is there enough room in the output buffer to store bytes_read
-
-    // CHECK IT
-    if (bytes_read > 0 && output_size > 0)
-    {
-        // Leave an extra byte for the nul-terminator
-        if ((output_size - output_len) >= (bytes_read + 1))
-        {
-            has_room = true;
-        }
-    }
-
-    // DONE
-    return has_room;
-}
-
-
 SKID_INTERNAL void *get_inet_addr(struct sockaddr *sa, int *errnum)
 {
     // LOCAL VARIABLES
@@ -1126,75 +1055,6 @@ SKID_INTERNAL int get_socket_option(int sockfd, int level, int option_name,
 }
 
 
-SKID_INTERNAL int realloc_sock_dynamic(char **output_buf, size_t *output_size)
-{
-    // LOCAL VARIABLES
-    int result = ENOERR;   // Success of execution
-    size_t new_size = 0;   // New size of the allocation
-    char *tmp_ptr = NULL;  // Return value from allocation
-
-    // INPUT VALIDATION
-    result = validate_sn_args(output_buf, output_size);
-    if (ENOERR == result)
-    {
-        if (0 >= *output_size)
-        {
-            result = EINVAL;  // They should have called check_sn_pre_alloc()
-        }
-    }
-
-    // REALLOCATE
-    // Determine new size
-    if (ENOERR == result)
-    {
-        // Check for maximum
-        if (SKID_MAX_SZ == *output_size)
-        {
-            result = EOVERFLOW;  // Buffer size is already at its maximum value
-        }
-        // Check for overflow
-        else if (*output_size > (SKID_MAX_SZ - *output_size))
-        {
-            result = EOVERFLOW;  // Not enough room left to double it
-        }
-        else
-        {
-            new_size = 2 * (*output_size);
-        }
-    }
-    // Allocate
-    if (ENOERR == result)
-    {
-        tmp_ptr = alloc_skid_mem(new_size, sizeof(char), &result);
-        if (NULL == tmp_ptr)
-        {
-            PRINT_ERROR(The call to alloc_skid_mem() failed);
-            PRINT_ERRNO(result);
-        }
-    }
-    // Copy old into new
-    if (ENOERR == result)
-    {
-        strncpy(tmp_ptr, *output_buf, *output_size);
-    }
-    // Free old
-    if (ENOERR == result)
-    {
-        result = free_skid_mem((void **)output_buf);
-        *output_size = 0;  // Zero out the size
-    }
-    // Update out arguments
-    if (ENOERR == result)
-    {
-        *output_buf = tmp_ptr;  // Store the pointer
-        *output_size = new_size;  // Update the size
-    }
-
-    // DONE
-    return result;
-}
-
-
 SKID_INTERNAL ssize_t recv_from_size(int sockfd, int *errnum)
 {
     // LOCAL VARIABLES
@@ -1255,188 +1115,70 @@ SKID_INTERNAL ssize_t recv_from_size(int sockfd, int *errnum)
 }
 
 
-SKID_INTERNAL int recv_from_socket_dynamic(int sockfd, int flags, struct sockaddr *src_addr,
-                                           socklen_t *addrlen, char **output_buf,
-                                           size_t *output_size)
+SKID_INTERNAL int recv_socket_dynamic(int sockfd, int flags, skidBuffer_ptr buffer)
 {
     // LOCAL VARIABLES
-    int result = validate_skid_fd(sockfd);           // Success of execution
-    char local_buf[SKID_NET_BUFF_SIZE + 1] = { 0 };  // Local buffer
-    ssize_t num_read = 0;                            // Number of bytes read
-    size_t output_len = 0;                           // The length of *output_buf's string
-    char *tmp_ptr = NULL;                            // Temp pointer
+    int result = validate_skid_fd(sockfd);  // Success of execution
+    ssize_t num_read = 0;                   // Number of bytes read
+    bool read_something = false;            // Did one recv() work?
 
     // INPUT VALIDATION
-    if (ENOERR == result)
+    if (ENOERR == result && NULL == buffer)
     {
-        result = validate_sn_args(output_buf, output_size);
-    }
-
-    // SETUP
-    if (ENOERR == result)
-    {
-        result = check_sn_pre_alloc(output_buf, output_size);
+        result = EINVAL;  // NULL pointer
     }
 
-    // RECVFROM DYNAMIC
+    // READ DYNAMIC
     if (ENOERR == result)
     {
-        output_len = strlen(*output_buf);  // Get the current length of output_buf
-        // Read into local buff
-        num_read = call_recvfrom(sockfd, flags, src_addr, addrlen, local_buf,
-                                 SKID_NET_BUFF_SIZE * sizeof(char), &result);
-        if (num_read > 0)
+        while (1)
         {
-            // Check for room
-            if (false == check_sn_space(num_read, output_len, *output_size))
+            // Check for room (always keep one byte in reserve for the nul-terminator)
+            if (buffer->length + 1 >= buffer->capacity)
             {
-                // Not enough room?  Reallocate.
-                result = realloc_sock_dynamic(output_buf, output_size);
+                // Not enough room?  Grow it.
+                result = grow_skid_buffer(buffer, buffer->length + 2);
                 if (ENOERR != result)
                 {
-                    PRINT_ERROR(The call to realloc_sock_dynamic() failed);
+                    PRINT_ERROR(The call to grow_skid_buffer() failed);
                     PRINT_ERRNO(result);
+                    break;  // Stop on error
                 }
             }
-            if (ENOERR == result)
+            // Receive directly into the unused portion of the buffer
+            num_read = recv(sockfd, buffer->data + buffer->length,
+                            buffer->capacity - buffer->length - 1, flags);
+            if (0 > num_read)
             {
-                // Copy local buff into *output_buf
-                if (true == check_sn_space(num_read, output_len, *output_size))
+                result = errno;
+                if ((EAGAIN == result || EWOULDBLOCK == result) && true == read_something)
                 {
-                    // Add local to output
-                    strncat(*output_buf, local_buf, (*output_size) - output_len);
-                    memset(local_buf, 0x0, sizeof(local_buf));  // Zeroize the local buffer
+                    result = ENOERR;  // At least one recv() worked so we're gonna roll with it.
                 }
                 else
                 {
-                    PRINT_ERROR(Logic Failure - realloc_sock_dynamic succeeded incorrectly);
-                    result = EOVERFLOW;
+                    PRINT_ERROR(The call to recv() failed);
+                    PRINT_ERRNO(result);
                 }
+                break;  // Error... let's stop
             }
-        }
-    }
-
-    // VERIFY NUL-TERMINATED
-    if (ENOERR == result)
-    {
-        if (output_len == *output_size)
-        {
-            tmp_ptr = copy_skid_string(*output_buf, &result);
-            if (ENOERR == result)
-            {
-                free_skid_mem((void **)output_buf);  // Free the old buffer
-                *output_buf = tmp_ptr;  // Save the new buffer
-                *output_size += 1;  // Made room for nul-termination
-            }
-        }
-    }
-
-    // CLEANUP
-    if (ENOERR != result)
-    {
-        // output_buf
-        free_skid_mem((void **)output_buf);
-        // output_size
-        if (output_size)
-        {
-            *output_size = 0;
-        }
-        // tmp_ptr
-        free_skid_mem((void **)&tmp_ptr);
-    }
-
-    // DONE
-    return result;
-}
-
-
-SKID_INTERNAL int recv_socket_dynamic(int sockfd, int flags, char **output_buf, size_t *output_size)
-{
-    // LOCAL VARIABLES
-    int result = validate_skid_fd(sockfd);       // Success of execution
-    char local_buf[SKID_NET_BUFF_SIZE] = { 0 };  // Local buffer
-    ssize_t num_read = 0;                        // Number of bytes read
-    size_t output_len = 0;                       // The length of *output_buf's string
-    char *tmp_ptr = NULL;                        // Temp pointer
-
-    // INPUT VALIDATION
-    if (ENOERR == result)
-    {
-        result = validate_sn_args(output_buf, output_size);
-    }
-
-    // SETUP
-    if (ENOERR == result)
-    {
-        result = check_sn_pre_alloc(output_buf, output_size);
-    }
-
-    // READ DYNAMIC
-    if (ENOERR == result)
-    {
-        while (1)
-        {
-            output_len = strlen(*output_buf);  // Get the current length of output_buf
-            // Read into local buff
-            num_read = recv(sockfd, local_buf, sizeof(local_buf), flags);
-            if (0 == num_read)
+            else if (0 == num_read)
             {
                  FPRINTF_ERR("%s - Call to recv() reached EOF\n", DEBUG_INFO_STR);
                  break;  // Done reading
             }
-            // Check for room
-            if (false == check_sn_space(num_read, output_len, *output_size))
-            {
-                // Not enough room?  Reallocate.
-                result = realloc_sock_dynamic(output_buf, output_size);
-                if (ENOERR != result)
-                {
-                    PRINT_ERROR(The call to realloc_sock_dynamic() failed);
-                    PRINT_ERRNO(result);
-                    break;  // Stop on error
-                }
-            }
-            // Copy local buff into *output_buf
-            if (true == check_sn_space(num_read, output_len, *output_size))
-            {
-                strncat(*output_buf, local_buf, *output_size - output_len);  // Add local to output
-                memset(local_buf, 0x0, sizeof(local_buf));  // Zeroize the local buffer
-            }
             else
             {
-                PRINT_ERROR(Logic Failure - realloc_sock_dynamic succeeded incorrectly);
-                result = EOVERFLOW;
+                read_something = true;  // At least one recv() worked
+                buffer->length += num_read;  // Keep track of what's been stored
             }
         }
     }
 
-    // VERIFY NUL-TERMINATED
+    // NUL-TERMINATE IT
     if (ENOERR == result)
     {
-        if (output_len == *output_size)
-        {
-            tmp_ptr = copy_skid_string(*output_buf, &result);
-            if (ENOERR == result)
-            {
-                free_skid_mem((void **)output_buf);  // Free the old buffer
-                *output_buf = tmp_ptr;  // Save the new buffer
-                *output_size += 1;  // Made room for nul-termination
-            }
-        }
-    }
-
-    // CLEANUP
-    if (ENOERR != result)
-    {
-        // output_buf
-        free_skid_mem((void **)output_buf);
-        // output_size
-        if (output_size)
-        {
-            *output_size = 0;
-        }
-        // tmp_ptr
-        free_skid_mem((void **)&tmp_ptr);
+        buffer->data[buffer->length] = '\0';  // Room was reserved for this
     }
 
     // DONE
@@ -1587,34 +1329,3 @@ SKID_INTERNAL ssize_t send_to_chunk(int sockfd, const void *buf, size_t len, int
     }
     return bytes_sent;
 }
-
-
-SKID_INTERNAL int validate_sn_args(char **output_buf, size_t *output_size)
-{
-    // LOCAL VARIABLES
-    int result = ENOERR;  // Validation result
-
-    // VALIDATE IT
-    // output_buf
-    if (NULL == output_buf)
-    {
-        result = EINVAL;  // NULL pointer
-    }
-    // output_size
-    else if (NULL == output_size)
-    {
-        result = EINVAL;  // NULL pointer
-    }
-    // output_buf && output_size
-    else
-    {
-        if (NULL != *output_buf && *output_size <= 0)
-        {
-            result = EINVAL;  // Buffer pointer exists but size is invalid
-            PRINT_ERROR(Invalid size of an existing buffer pointer);
-        }
-    }
-
-    // DONE
-    return result;
-}
@@ -7,7 +7,8 @@
 #include <errno.h>                          // EINVAL
 #include <stdbool.h>                        // bool, false, true
 #include "skid_debug.h"                     // PRINT_ERROR()
-#include "skid_file_descriptors.h"          // read_fd()
+#include "skid_file_descriptors.h"          // read_fd_buf()
+#include "skid_memory.h"                    // clear_skid_buffer(), free_skid_buffer()
 #include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
 #include "skid_poll.h"                      // struct pollfd
 #include "skid_validation.h"                // validate_skid_err()
@@ -129,23 +130,55 @@ int call_poll(struct pollfd *fds, nfds_t nfds, int timeout, int *errnum)
 
 
 char *read_pollfd(struct pollfd *poll_fd, int *revents, int *errnum)
+{
+    // LOCAL VARIABLES
+    int results = ENOERR;       // Store errno value
+    char *read_msg = NULL;      // The message read from a ready fd
+    skidBuffer buffer = { 0 };  // Working buffer for the message read from a ready fd
+
+    // INPUT VALIDATION
+    results = validate_skid_err(errnum);
+
+    // READ IT
+    if (ENOERR == results)
+    {
+        results = read_pollfd_buf(poll_fd, revents, &buffer);
+    }
+    if (ENOERR == results)
+    {
+        read_msg = buffer.data;  // NULL if there was nothing to read; the caller owns it otherwise
+    }
+    else
+    {
+        free_skid_buffer(&buffer);  // Best effort
+    }
+
+    // DONE
+    if (NULL != errnum)
+    {
+        *errnum = results;
+    }
+    return read_msg;
+}
+
+
+int read_pollfd_buf(struct pollfd *poll_fd, int *revents, skidBuffer_ptr buffer)
 {
     // LOCAL VARIABLES
     int results = ENOERR;      // Store errno value
     int local_revents = 0;     // Local variable storing poll_fd->revents
-    char *read_msg = NULL;     // The message read from a ready fd
     bool it_is_good = false;   // Is the pollfd struct valid?
     bool it_has_data = false;  // Is there data to be read?
     bool has_hup = false;      // Special case a POLLHUP
 
     // INPUT VALIDATION
-    results = validate_skid_err(errnum);
+    if (NULL == revents)
+    {
+        results = EINVAL;  // Suffer not the NULL pointer
+    }
     if (ENOERR == results)
     {
-        if (NULL == revents)
-        {
-            results = EINVAL;  // Suffer not the NULL pointer
-        }
+        results = clear_skid_buffer(buffer);  // Also validates buffer
     }
 
     // READ IT
@@ -189,7 +222,7 @@ char *read_pollfd(struct pollfd *poll_fd, int *revents, int *errnum)
     {
         if (true == it_has_data || true == has_hup)
         {
-            read_msg = read_fd(poll_fd->fd, &results);
+            results = read_fd_buf(poll_fd->fd, buffer);
             if (ENOERR != results)
             {
                 if (true == has_hup)
@@ -198,7 +231,7 @@ char *read_pollfd(struct pollfd *poll_fd, int *revents, int *errnum)
                 }
                 else
                 {
-                    PRINT_ERROR(The call to read_fd() has failed to read data);
+                    PRINT_ERROR(The call to read_fd_buf() has failed to read data);
                     PRINT_ERRNO(results);
                 }
             }
@@ -219,11 +252,7 @@ char *read_pollfd(struct pollfd *poll_fd, int *revents, int *errnum)
     {
         *revents = local_revents;
     }
-    if (NULL != errnum)
-    {
-        *errnum = results;
-    }
-    return read_msg;
+    return results;
 }
 
 
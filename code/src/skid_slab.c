@@ -0,0 +1,656 @@
+/*
+ *  This library defines functionality to allocate fixed-size objects from pools of mapped slabs.
+ */
+
+// #define SKID_DEBUG                          // Enable DEBUG logging
+
+#include <errno.h>                          // EINVAL, EOVERFLOW
+#include <pthread.h>                        // pthread_key_create(), pthread_mutex_*()
+#include <stdatomic.h>                      // atomic_*
+#include <stdbool.h>                        // bool, false, true
+#include <stddef.h>                         // max_align_t
+#include <stdint.h>                         // SIZE_MAX
+#include <string.h>                         // memset()
+#include "skid_debug.h"                     // PRINT_ERROR(), PRINT_ERRNO()
+#include "skid_macros.h"                    // ENOERR, SKID_INTERNAL
+#include "skid_memory.h"                    // alloc_skid_mem(), map_skid_mem(), unmap_skid_mem()
+#include "skid_slab.h"                      // public functions, skidSlabPool, skidSlabStats
+#include "skid_validation.h"                // validate_skid_err()
+
+MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
+MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
+
+#ifndef SKID_SLAB_CACHE_BATCH
+#define SKID_SLAB_CACHE_BATCH 32  // Objects a thread cache moves to or from its pool at a time
+#endif  /* SKID_SLAB_CACHE_BATCH */
+
+// Every object is aligned to this, like malloc()
+#define SKID_SLAB_ALIGN __alignof__(max_align_t)
+// Round size up to the next multiple of align (which must be a power of two)
+#define SKID_SLAB_ROUND(size, align) (((size) + ((align) - 1)) & ~((size_t)(align) - 1))
+// Number of bytes at the start of each slab reserved for the slab's header
+#define SKID_SLAB_HEADER SKID_SLAB_ROUND(sizeof(skidSlab), SKID_SLAB_ALIGN)
+
+
+// A free object, linked into a free list through its own storage
+typedef struct _skidSlabFree
+{
+    struct _skidSlabFree *next;  // The next free object
+} skidSlabFree, *skidSlabFree_ptr;
+
+// The header at the start of each slab
+typedef struct _skidSlab
+{
+    struct _skidSlab *next;  // The slab mapped before this one
+    size_t length;           // Size of this slab's mapping, header included
+} skidSlab, *skidSlab_ptr;
+
+// One thread's cache of free objects for one pool
+typedef struct _skidSlabCache
+{
+    struct _skidSlabCache *next;  // The next cache in pool->caches
+    struct _skidSlabCache *prev;  // The previous cache in pool->caches
+    skidSlabPool_ptr pool;        // The pool this cache belongs to
+    skidSlabFree_ptr free_list;   // Free objects only this thread touches
+    size_t count;                 // Number of objects in free_list
+} skidSlabCache, *skidSlabCache_ptr;
+
+struct _skidSlabPool
+{
+    pthread_mutex_t lock;             // Guards everything but the thread caches' free lists
+    bool lock_inited;                 // Was lock initialized?
+    size_t obj_size;                  // Bytes per object, rounded up to SKID_SLAB_ALIGN
+    size_t objs_per_slab;             // Objects per slab
+    skidSlabFree_ptr free_list;       // Objects returned to the pool
+    char *fresh;                      // The next never-used object in the newest slab
+    char *fresh_end;                  // The end of the newest slab's objects
+    skidSlab_ptr slabs;               // Every mapped slab, newest first
+    uint64_t num_slabs;               // Number of slabs mapped
+    bool thread_cache;                // Does each thread get a cache?
+    pthread_key_t cache_key;          // Each thread's skidSlabCache, if thread_cache
+    skidSlabCache_ptr caches;         // Every thread cache, for destroy_slab_pool()
+    atomic_uint_fast64_t live;        // Objects allocated and not yet freed
+    atomic_uint_fast64_t high_water;  // The most objects live at once
+};
+
+
+/**************************************************************************************************/
+/********************************* PRIVATE FUNCTION DECLARATIONS **********************************/
+/**************************************************************************************************/
+
+/*
+ *  Description:
+ *      Count one more live object and raise the pool's high-water mark to match.
+ *
+ *  Args:
+ *      pool: The pool that allocated an object.
+ */
+SKID_INTERNAL void count_slab_alloc(skidSlabPool_ptr pool);
+
+/*
+ *  Description:
+ *      Return a thread cache's free objects to its pool until only keep are left.
+ *
+ *  Args:
+ *      cache: [In/Out] The thread cache to flush.
+ *      keep: The number of objects to leave in the cache.
+ */
+SKID_INTERNAL void flush_slab_cache(skidSlabCache_ptr cache, size_t keep);
+
+/*
+ *  Description:
+ *      Fetch the calling thread's cache for pool, creating it on first use.
+ *
+ *  Args:
+ *      pool: A pool created with thread caches.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      The calling thread's cache, on success.  NULL on error (check errnum for details).
+ */
+SKID_INTERNAL skidSlabCache_ptr get_slab_cache(skidSlabPool_ptr pool, int *errnum);
+
+/*
+ *  Description:
+ *      Map a new slab and make its objects the pool's fresh objects.  The caller must hold the
+ *      pool's lock.
+ *
+ *  Args:
+ *      pool: [In/Out] The pool to grow.
+ *
+ *  Returns:
+ *      ENOERR on success, errno on error.
+ */
+SKID_INTERNAL int map_slab(skidSlabPool_ptr pool);
+
+/*
+ *  Description:
+ *      Take one object from the pool: a freed one if there is one, else a fresh one, else one
+ *      from a newly mapped slab.  The caller must hold the pool's lock.  The object is not
+ *      zeroized.
+ *
+ *  Args:
+ *      pool: [In/Out] The pool to take an object from.
+ *      errnum: [Out] Storage location for errno values encountered.
+ *
+ *  Returns:
+ *      An object, on success.  NULL on error (check errnum for details).
+ */
+SKID_INTERNAL skidSlabFree_ptr pop_slab_obj(skidSlabPool_ptr pool, int *errnum);
+
+/*
+ *  Description:
+ *      Thread-specific data destructor for a pool's cache_key.  Returns the exiting thread's
+ *      cached objects to the pool and frees the cache.
+ *
+ *  Args:
+ *      cache: The exiting thread's skidSlabCache.
+ */
+SKID_INTERNAL void release_slab_cache(void *cache);
+
+/*
+ *  Description:
+ *      Validate a slab pool pointer.
+ *
+ *  Args:
+ *      pool: A non-NULL slab pool pointer.
+ *
+ *  Returns:
+ *      ENOERR for good input, EINVAL otherwise.
+ */
+SKID_INTERNAL int validate_slab_pool(skidSlabPool_ptr pool);
+
+
+/**************************************************************************************************/
+/********************************** PUBLIC FUNCTION DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+
+void *alloc_slab_obj(skidSlabPool_ptr pool, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = validate_slab_pool(pool);  // Errno values
+    skidSlabFree_ptr obj = NULL;            // The object to hand out
+    skidSlabCache_ptr cache = NULL;         // The calling thread's cache, if pool has them
+
+    // INPUT VALIDATION
+    if (ENOERR == result)
+    {
+        result = validate_skid_err(errnum);
+    }
+
+    // ALLOCATE IT
+    // From the thread cache
+    if (ENOERR == result && true == pool->thread_cache)
+    {
+        cache = get_slab_cache(pool, &result);
+        if (ENOERR == result && NULL == cache->free_list)
+        {
+            // Refill it in one trip to the pool
+            pthread_mutex_lock(&(pool->lock));
+            while (ENOERR == result && cache->count < SKID_SLAB_CACHE_BATCH)
+            {
+                obj = pop_slab_obj(pool, &result);
+                if (ENOERR == result)
+                {
+                    obj->next = cache->free_list;
+                    cache->free_list = obj;
+                    cache->count++;
+                }
+            }
+            pthread_mutex_unlock(&(pool->lock));
+            if (cache->count > 0)
+            {
+                result = ENOERR;  // Settle for a partial refill
+            }
+        }
+        if (ENOERR == result)
+        {
+            obj = cache->free_list;
+            cache->free_list = obj->next;
+            cache->count--;
+        }
+    }
+    // From the pool
+    else if (ENOERR == result)
+    {
+        pthread_mutex_lock(&(pool->lock));
+        obj = pop_slab_obj(pool, &result);
+        pthread_mutex_unlock(&(pool->lock));
+    }
+    // Hand it out
+    if (ENOERR == result)
+    {
+        memset(obj, 0, pool->obj_size);
+        count_slab_alloc(pool);
+    }
+    else
+    {
+        obj = NULL;
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return obj;
+}
+
+
+skidSlabPool_ptr create_slab_pool(size_t obj_size, size_t objs_per_slab, bool thread_cache,
+                                  int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = validate_skid_err(errnum);  // Errno values
+    skidSlabPool_ptr pool = NULL;            // The new slab pool
+
+    // INPUT VALIDATION
+    if (ENOERR == result && 0 == obj_size)
+    {
+        result = EINVAL;  // Nothing to allocate
+    }
+    if (ENOERR == result && obj_size > SIZE_MAX - SKID_SLAB_HEADER - SKID_SLAB_ALIGN)
+    {
+        result = EOVERFLOW;  // Too big to map
+    }
+
+    // SETUP
+    if (ENOERR == result)
+    {
+        // Keeps every object aligned, and big enough to hold a free list link
+        obj_size = SKID_SLAB_ROUND(obj_size, SKID_SLAB_ALIGN);
+        if (0 == objs_per_slab)
+        {
+            objs_per_slab = (SKID_SLAB_SIZE - SKID_SLAB_HEADER) / obj_size;
+            if (0 == objs_per_slab)
+            {
+                objs_per_slab = 1;  // Big objects get a slab apiece
+            }
+        }
+        if (objs_per_slab > (SIZE_MAX - SKID_SLAB_HEADER) / obj_size)
+        {
+            result = EOVERFLOW;  // Slabs too big to map
+        }
+    }
+    if (ENOERR == result)
+    {
+        pool = alloc_skid_mem(1, sizeof(skidSlabPool), &result);
+    }
+    if (ENOERR == result)
+    {
+        pool->obj_size = obj_size;
+        pool->objs_per_slab = objs_per_slab;
+        pool->thread_cache = thread_cache;
+        atomic_init(&(pool->live), 0);
+        atomic_init(&(pool->high_water), 0);
+        result = pthread_mutex_init(&(pool->lock), NULL);
+        if (ENOERR == result)
+        {
+            pool->lock_inited = true;
+        }
+    }
+    if (ENOERR == result && true == thread_cache)
+    {
+        result = pthread_key_create(&(pool->cache_key), release_slab_cache);
+        if (ENOERR != result)
+        {
+            PRINT_ERROR(The call to pthread_key_create() failed);
+            PRINT_ERRNO(result);
+            pool->thread_cache = false;  // Don't delete a key that was never created
+        }
+    }
+
+    // CLEANUP
+    if (ENOERR != result && NULL != pool)
+    {
+        destroy_slab_pool(&pool);  // Best effort
+    }
+
+    // DONE
+    if (errnum)
+    {
+        *errnum = result;
+    }
+    return pool;
+}
+
+
+int destroy_slab_pool(skidSlabPool_ptr *pool)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;               // Errno values
+    int tmp_result = ENOERR;           // Results of each unmap_skid_mem() call
+    skidSlabPool_ptr old_pool = NULL;  // The pool to destroy
+    skidSlabCache_ptr cache = NULL;    // A thread cache to free
+    skidSlab_ptr slab = NULL;          // A slab to unmap
+    skidMemMapRegion region = { 0 };   // Argument to unmap_skid_mem()
+
+    // INPUT VALIDATION
+    if (NULL == pool)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+    else
+    {
+        result = validate_slab_pool(*pool);
+    }
+
+    // DESTROY IT
+    if (ENOERR == result)
+    {
+        old_pool = *pool;
+        // Thread caches
+        if (true == old_pool->thread_cache)
+        {
+            pthread_key_delete(old_pool->cache_key);  // No more destructor calls
+            while (old_pool->caches)
+            {
+                cache = old_pool->caches;
+                old_pool->caches = cache->next;
+                free_skid_mem((void **)&cache);  // Best effort
+            }
+        }
+        // Slabs
+        while (old_pool->slabs)
+        {
+            slab = old_pool->slabs;
+            old_pool->slabs = slab->next;  // Read it before it's unmapped
+            region.addr = slab;
+            region.length = slab->length;
+            tmp_result = unmap_skid_mem(&region);
+            if (ENOERR != tmp_result)
+            {
+                PRINT_ERROR(The call to unmap_skid_mem() failed);
+                PRINT_ERRNO(tmp_result);
+                if (ENOERR == result)
+                {
+                    result = tmp_result;  // Report the first error but unmap the rest
+                }
+            }
+        }
+        // The pool
+        if (true == old_pool->lock_inited)
+        {
+            pthread_mutex_destroy(&(old_pool->lock));
+        }
+        free_skid_mem((void **)pool);
+    }
+
+    // DONE
+    return result;
+}
+
+
+int free_slab_obj(skidSlabPool_ptr pool, void **obj)
+{
+    // LOCAL VARIABLES
+    int result = validate_slab_pool(pool);  // Errno values
+    skidSlabFree_ptr old_obj = NULL;        // The object to return
+    skidSlabCache_ptr cache = NULL;         // The calling thread's cache, if pool has them
+
+    // INPUT VALIDATION
+    if (ENOERR == result && (NULL == obj || NULL == *obj))
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // FREE IT
+    if (ENOERR == result)
+    {
+        old_obj = *obj;
+        if (true == pool->thread_cache)
+        {
+            cache = get_slab_cache(pool, &result);
+        }
+    }
+    // To the thread cache
+    if (ENOERR == result && NULL != cache)
+    {
+        old_obj->next = cache->free_list;
+        cache->free_list = old_obj;
+        cache->count++;
+        if (cache->count > 2 * SKID_SLAB_CACHE_BATCH)
+        {
+            flush_slab_cache(cache, SKID_SLAB_CACHE_BATCH);  // Share the surplus
+        }
+    }
+    // To the pool
+    else if (ENOERR == result)
+    {
+        pthread_mutex_lock(&(pool->lock));
+        old_obj->next = pool->free_list;
+        pool->free_list = old_obj;
+        pthread_mutex_unlock(&(pool->lock));
+    }
+    if (ENOERR == result)
+    {
+        atomic_fetch_sub(&(pool->live), 1);
+        *obj = NULL;
+    }
+
+    // DONE
+    return result;
+}
+
+
+int get_slab_stats(skidSlabPool_ptr pool, skidSlabStats_ptr stats, bool reset)
+{
+    // LOCAL VARIABLES
+    int result = validate_slab_pool(pool);  // Errno values
+
+    // INPUT VALIDATION
+    if (ENOERR == result && NULL == stats)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // GET THEM
+    if (ENOERR == result)
+    {
+        stats->obj_size = pool->obj_size;
+        stats->live = atomic_load(&(pool->live));
+        stats->high_water = atomic_load(&(pool->high_water));
+        pthread_mutex_lock(&(pool->lock));
+        stats->slabs = pool->num_slabs;
+        pthread_mutex_unlock(&(pool->lock));
+        stats->capacity = stats->slabs * pool->objs_per_slab;
+        if (true == reset)
+        {
+            atomic_store(&(pool->high_water), stats->live);
+        }
+    }
+
+    // DONE
+    return result;
+}
+
+
+/**************************************************************************************************/
+/********************************** PRIVATE FUNCTION DEFINITIONS **********************************/
+/**************************************************************************************************/
+
+
+SKID_INTERNAL void count_slab_alloc(skidSlabPool_ptr pool)
+{
+    // LOCAL VARIABLES
+    // Live objects, counting this one
+    uint_fast64_t live = atomic_fetch_add(&(pool->live), 1) + 1;
+    // The high-water mark to beat
+    uint_fast64_t peak = atomic_load(&(pool->high_water));
+
+    // COUNT IT
+    while (live > peak && !atomic_compare_exchange_weak(&(pool->high_water), &peak, live))
+    {
+        // Another thread moved the high-water mark so try again against its value
+    }
+}
+
+
+SKID_INTERNAL void flush_slab_cache(skidSlabCache_ptr cache, size_t keep)
+{
+    // LOCAL VARIABLES
+    skidSlabPool_ptr pool = cache->pool;  // The pool to return objects to
+    skidSlabFree_ptr obj = NULL;          // The object being returned
+
+    // FLUSH IT
+    pthread_mutex_lock(&(pool->lock));
+    while (cache->count > keep)
+    {
+        obj = cache->free_list;
+        cache->free_list = obj->next;
+        cache->count--;
+        obj->next = pool->free_list;
+        pool->free_list = obj;
+    }
+    pthread_mutex_unlock(&(pool->lock));
+}
+
+
+SKID_INTERNAL skidSlabCache_ptr get_slab_cache(skidSlabPool_ptr pool, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;                                             // Errno values
+    skidSlabCache_ptr cache = pthread_getspecific(pool->cache_key);  // This thread's cache
+
+    // CREATE IT
+    if (NULL == cache)
+    {
+        cache = alloc_skid_mem(1, sizeof(skidSlabCache), &result);
+        if (ENOERR == result)
+        {
+            cache->pool = pool;
+            result = pthread_setspecific(pool->cache_key, cache);
+            if (ENOERR != result)
+            {
+                PRINT_ERROR(The call to pthread_setspecific() failed);
+                PRINT_ERRNO(result);
+                free_skid_mem((void **)&cache);  // Best effort
+            }
+        }
+        if (ENOERR == result)
+        {
+            // Track it so destroy_slab_pool() can free it
+            pthread_mutex_lock(&(pool->lock));
+            cache->next = pool->caches;
+            if (pool->caches)
+            {
+                pool->caches->prev = cache;
+            }
+            pool->caches = cache;
+            pthread_mutex_unlock(&(pool->lock));
+        }
+    }
+
+    // DONE
+    *errnum = result;
+    return cache;
+}
+
+
+SKID_INTERNAL int map_slab(skidSlabPool_ptr pool)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;              // Errno values
+    skidMemMapRegion region = { 0 };  // Argument to map_skid_mem()
+    skidSlab_ptr slab = NULL;         // The new slab
+
+    // MAP IT
+    region.length = SKID_SLAB_HEADER + pool->objs_per_slab * pool->obj_size;
+    result = map_skid_mem(&region, PROT_READ | PROT_WRITE, MAP_PRIVATE);
+    if (ENOERR != result)
+    {
+        PRINT_ERROR(The call to map_skid_mem() failed);
+        PRINT_ERRNO(result);
+    }
+
+    // LINK IT
+    if (ENOERR == result)
+    {
+        slab = region.addr;
+        slab->length = region.length;
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->num_slabs++;
+        pool->fresh = (char *)slab + SKID_SLAB_HEADER;
+        pool->fresh_end = pool->fresh + pool->objs_per_slab * pool->obj_size;
+    }
+
+    // DONE
+    return result;
+}
+
+
+SKID_INTERNAL skidSlabFree_ptr pop_slab_obj(skidSlabPool_ptr pool, int *errnum)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;          // Errno values
+    skidSlabFree_ptr obj = NULL;  // The object to take
+
+    // TAKE IT
+    // A freed object
+    if (pool->free_list)
+    {
+        obj = pool->free_list;
+        pool->free_list = obj->next;
+    }
+    // A fresh object
+    else
+    {
+        if (pool->fresh == pool->fresh_end)
+        {
+            result = map_slab(pool);  // Every slab is full
+        }
+        if (ENOERR == result)
+        {
+            obj = (skidSlabFree_ptr)pool->fresh;
+            pool->fresh += pool->obj_size;
+        }
+    }
+
+    // DONE
+    *errnum = result;
+    return obj;
+}
+
+
+SKID_INTERNAL void release_slab_cache(void *cache)
+{
+    // LOCAL VARIABLES
+    skidSlabCache_ptr old_cache = cache;      // The exiting thread's cache
+    skidSlabPool_ptr pool = old_cache->pool;  // The pool it belongs to
+
+    // RELEASE IT
+    flush_slab_cache(old_cache, 0);
+    pthread_mutex_lock(&(pool->lock));
+    if (old_cache->prev)
+    {
+        old_cache->prev->next = old_cache->next;
+    }
+    else
+    {
+        pool->caches = old_cache->next;
+    }
+    if (old_cache->next)
+    {
+        old_cache->next->prev = old_cache->prev;
+    }
+    pthread_mutex_unlock(&(pool->lock));
+    free_skid_mem((void **)&old_cache);  // Best effort
+}
+
+
+SKID_INTERNAL int validate_slab_pool(skidSlabPool_ptr pool)
+{
+    // LOCAL VARIABLES
+    int result = ENOERR;  // Results of validation
+
+    // INPUT VALIDATION
+    if (NULL == pool)
+    {
+        result = EINVAL;  // NULL pointer
+    }
+
+    // DONE
+    return result;
+}
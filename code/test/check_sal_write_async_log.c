@@ -0,0 +1,358 @@
+/*
+ *  Check unit test suit for skid_async_log.h's write_async_log() function (and the functions
+ *  that share an asynchronous log with it).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sal_write_async_log.bin
+code/dist/check_sal_write_async_log.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sal_write_async_log.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EAGAIN, EINVAL, ENOENT
+#include <inttypes.h>                 // SCNu64
+#include <pthread.h>                  // pthread_create(), pthread_join()
+#include <stdint.h>                   // intptr_t, uint64_t
+#include <stdio.h>                    // fgets(), fopen(), snprintf(), sscanf()
+#include <stdlib.h>
+#include <string.h>                   // memset(), strerror(), strlen()
+#include <unistd.h>                   // unlink()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_async_log.h"           // start_async_log(), stop_async_log(), write_async_log()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define MAX_ATTEMPTS 1000000       // Most messages a drop test will write while waiting for drops
+#define MIN_DROPS 10               // Number of drops a drop test waits for
+#define MSGS_PER_THREAD 500        // Number of messages each producer thread writes
+#define NUM_THREADS 4              // Number of producer threads
+#define STAMP_LEN 18               // Length of "[YYYYMMDD-HHMMSS] "
+#define TINY_RING 4                // Ring size that makes producers outpace the writer
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_log_path;  // Heap array with the test log resolved to the repo
+
+// Arguments to produce_msgs()
+typedef struct _producerArgs
+{
+    skidAsyncLog_ptr async_log;  // The log to write to
+    int thread_num;              // This producer's number
+} producerArgs;
+
+/*
+ *  Thread start routine: write MSGS_PER_THREAD messages, "<thread_num>-<msg_num>", to the log
+ *  in the producerArgs.  Returns the first errno value encountered.
+ */
+void *produce_msgs(void *arg);
+
+/*
+ *  Resolve the test log's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test log.
+ */
+void teardown(void);
+
+
+void *produce_msgs(void *arg)
+{
+    // LOCAL VARIABLES
+    producerArgs *args = (producerArgs *)arg;  // This producer's arguments
+    int errnum = ENOERR;                       // Errno from the function calls
+    char msg[32] = { 0 };                      // The message to log
+
+    // PRODUCE
+    for (int i = 0; ENOERR == errnum && i < MSGS_PER_THREAD; i++)
+    {
+        snprintf(msg, sizeof(msg), "%d-%d", args->thread_num, i);
+        errnum = write_async_log(args->async_log, msg);
+    }
+
+    // DONE
+    return (void *)(intptr_t)errnum;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_log_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sal_test.log",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    unlink(test_log_path);  // Leftovers from a previous run
+}
+
+
+void teardown(void)
+{
+    unlink(test_log_path);
+    free_devops_mem((void **)&test_log_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_one_message)
+{
+    int errnum = CANARY_INT;            // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;  // The log under test
+    FILE *log_file = NULL;              // The log file, read back
+    char line[512] = { 0 };             // One line of the log file
+
+    async_log = start_async_log(test_log_path, 0, SKID_LOG_BLOCK, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(0, write_async_log(async_log, "Hello, world\n"));  // Newline is optional
+    ck_assert_int_eq(0, write_async_log(async_log, "Goodbye"));
+    ck_assert_int_eq(0, stop_async_log(&async_log));
+    ck_assert_ptr_null(async_log);
+    log_file = fopen(test_log_path, "r");
+    ck_assert_ptr_nonnull(log_file);
+    ck_assert_ptr_nonnull(fgets(line, sizeof(line), log_file));
+    ck_assert_int_eq('[', line[0]);
+    ck_assert_int_eq('-', line[9]);
+    ck_assert_int_eq(']', line[16]);
+    ck_assert_str_eq("Hello, world\n", line + STAMP_LEN);
+    ck_assert_ptr_nonnull(fgets(line, sizeof(line), log_file));
+    ck_assert_str_eq("Goodbye\n", line + STAMP_LEN);
+    ck_assert_ptr_null(fgets(line, sizeof(line), log_file));
+    fclose(log_file);
+}
+END_TEST
+
+
+START_TEST(test_n02_block_many_producers)
+{
+    int errnum = CANARY_INT;                             // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;                   // The log under test
+    pthread_t threads[NUM_THREADS];                      // Producer threads
+    producerArgs args[NUM_THREADS];                      // Producer thread arguments
+    void *thread_ret = NULL;                             // A thread's return value
+    int seen[NUM_THREADS][MSGS_PER_THREAD] = { { 0 } };  // Times each message was logged
+    FILE *log_file = NULL;                               // The log file, read back
+    char line[512] = { 0 };                              // One line of the log file
+    int thread_num = 0;                                  // Thread number parsed from a line
+    int msg_num = 0;                                     // Message number parsed from a line
+
+    // A tiny ring makes the producers block on the writer
+    async_log = start_async_log(test_log_path, TINY_RING, SKID_LOG_BLOCK, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        args[i].async_log = async_log;
+        args[i].thread_num = i;
+        ck_assert_int_eq(0, pthread_create(&threads[i], NULL, produce_msgs, &args[i]));
+    }
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        ck_assert_int_eq(0, pthread_join(threads[i], &thread_ret));
+        ck_assert_int_eq(0, (intptr_t)thread_ret);
+    }
+    ck_assert_int_eq(0, get_async_log_drops(async_log));
+    ck_assert_int_eq(0, stop_async_log(&async_log));
+    // Every message appears exactly once
+    log_file = fopen(test_log_path, "r");
+    ck_assert_ptr_nonnull(log_file);
+    while (NULL != fgets(line, sizeof(line), log_file))
+    {
+        ck_assert_int_eq(2, sscanf(line + STAMP_LEN, "%d-%d", &thread_num, &msg_num));
+        ck_assert(thread_num >= 0 && thread_num < NUM_THREADS);
+        ck_assert(msg_num >= 0 && msg_num < MSGS_PER_THREAD);
+        seen[thread_num][msg_num]++;
+    }
+    fclose(log_file);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        for (int j = 0; j < MSGS_PER_THREAD; j++)
+        {
+            ck_assert_msg(1 == seen[i][j], "Message %d-%d was logged %d times", i, j, seen[i][j]);
+        }
+    }
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_drop_policies)
+{
+    int errnum = CANARY_INT;            // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;  // The log under test
+    // Index 0 is SKID_LOG_DROP and index 1 is SKID_LOG_COUNT
+    skidLogOverflow policy = (0 == _i) ? SKID_LOG_DROP : SKID_LOG_COUNT;
+    uint64_t num_written = 0;           // Messages accepted
+    uint64_t num_dropped = 0;           // Messages refused with EAGAIN
+    uint64_t num_lines = 0;             // Message lines in the log file
+    uint64_t num_noticed = 0;           // Drops reported in the log file
+    uint64_t notice = 0;                // Drops reported by one line
+    FILE *log_file = NULL;              // The log file, read back
+    char line[512] = { 0 };             // One line of the log file
+
+    async_log = start_async_log(test_log_path, TINY_RING, policy, &errnum);
+    ck_assert_int_eq(0, errnum);
+    // Outpace the writer
+    for (int i = 0; i < MAX_ATTEMPTS && num_dropped < MIN_DROPS; i++)
+    {
+        errnum = write_async_log(async_log, "Message");
+        if (EAGAIN == errnum)
+        {
+            num_dropped++;
+        }
+        else
+        {
+            ck_assert_int_eq(0, errnum);
+            num_written++;
+        }
+    }
+    ck_assert_int_ge(num_dropped, MIN_DROPS);
+    ck_assert_int_eq(num_dropped, get_async_log_drops(async_log));
+    ck_assert_int_eq(0, stop_async_log(&async_log));
+    // Every accepted message was logged and SKID_LOG_COUNT reported the rest
+    log_file = fopen(test_log_path, "r");
+    ck_assert_ptr_nonnull(log_file);
+    while (NULL != fgets(line, sizeof(line), log_file))
+    {
+        if (0 == strcmp("Message\n", line + STAMP_LEN))
+        {
+            num_lines++;
+        }
+        else
+        {
+            ck_assert_int_eq(1, sscanf(line + STAMP_LEN, "%" SCNu64 " log messages dropped",
+                                       &notice));
+            num_noticed += notice;
+        }
+    }
+    fclose(log_file);
+    ck_assert_int_eq(num_written, num_lines);
+    ck_assert_int_eq((SKID_LOG_COUNT == policy) ? num_dropped : 0, num_noticed);
+}
+END_TEST
+
+
+START_TEST(test_e02_stop_after_failed_start)
+{
+    int errnum = CANARY_INT;            // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;  // The log under test
+
+    async_log = start_async_log("/this/dir/does/not/exist.log", 0, SKID_LOG_BLOCK, &errnum);
+    ck_assert_int_eq(ENOENT, errnum);
+    ck_assert_ptr_null(async_log);
+    ck_assert_int_eq(EINVAL, stop_async_log(&async_log));
+    ck_assert_int_eq(EINVAL, stop_async_log(NULL));
+    ck_assert_int_eq(EINVAL, write_async_log(async_log, "Nobody home"));
+    ck_assert_int_eq(0, get_async_log_drops(async_log));
+}
+END_TEST
+
+
+START_TEST(test_e03_bad_args)
+{
+    int errnum = CANARY_INT;            // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;  // The log under test
+
+    ck_assert_ptr_null(start_async_log(NULL, 0, SKID_LOG_BLOCK, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(start_async_log(test_log_path, 0, (skidLogOverflow)0, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(start_async_log(test_log_path, 0, SKID_LOG_BLOCK, NULL));
+    async_log = start_async_log(test_log_path, 0, SKID_LOG_BLOCK, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(EINVAL, write_async_log(async_log, NULL));
+    ck_assert_int_eq(0, stop_async_log(&async_log));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_long_message_truncated)
+{
+    int errnum = CANARY_INT;                  // Errno from the function calls
+    skidAsyncLog_ptr async_log = NULL;        // The log under test
+    char msg[SKID_LOG_MSG_MAX * 2] = { 0 };   // Too long to log in full
+    char line[SKID_LOG_MSG_MAX * 4] = { 0 };  // One line of the log file
+    FILE *log_file = NULL;                    // The log file, read back
+
+    memset(msg, 'A', sizeof(msg) - 1);
+    async_log = start_async_log(test_log_path, 0, SKID_LOG_BLOCK, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(0, write_async_log(async_log, msg));
+    ck_assert_int_eq(0, stop_async_log(&async_log));
+    log_file = fopen(test_log_path, "r");
+    ck_assert_ptr_nonnull(log_file);
+    ck_assert_ptr_nonnull(fgets(line, sizeof(line), log_file));
+    fclose(log_file);
+    ck_assert_int_eq(STAMP_LEN + SKID_LOG_MSG_MAX + 1, strlen(line));  // Stamp, msg, newline
+    ck_assert_int_eq('A', line[STAMP_LEN + SKID_LOG_MSG_MAX - 1]);
+    ck_assert_int_eq('\n', line[STAMP_LEN + SKID_LOG_MSG_MAX]);
+}
+END_TEST
+
+
+Suite *write_async_log_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SAL_Write_Async_Log");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_one_message);
+    tcase_add_test(tc_core, test_n02_block_many_producers);
+    tcase_add_loop_test(tc_core, test_e01_drop_policies, 0, 2);
+    tcase_add_test(tc_core, test_e02_stop_after_failed_start);
+    tcase_add_test(tc_core, test_e03_bad_args);
+    tcase_add_test(tc_core, test_b01_long_message_truncated);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sal_write_async_log.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = write_async_log_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,435 @@
+/*
+ *  Check unit test suit for skid_arena.h's alloc_skid_arena() function (and the functions that
+ *  share an arena with it).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sar_alloc_skid_arena.bin
+code/dist/check_sar_alloc_skid_arena.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sar_alloc_skid_arena.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EINVAL, EOVERFLOW
+#include <fcntl.h>                    // open()
+#include <pthread.h>                  // pthread_create(), pthread_join()
+#include <stdint.h>                   // SIZE_MAX, uintptr_t
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>
+#include <string.h>                   // strcmp(), strlen()
+#include <sys/stat.h>                 // mkdir()
+#include <unistd.h>                   // close(), pipe(), rmdir(), unlink(), write()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_arena.h"               // alloc_skid_arena(), clear_skid_arena(), free_skid_arena()
+#include "skid_dir_operations.h"      // read_dir_contents_arena()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TEST_CHUNK_SIZE 4096       // Small chunks so the tests cross chunk boundaries
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+skidArena test_arena;       // The arena under test
+char *test_dir_path;        // Heap array with the test directory resolved to the repo
+char test_file_path[4096];  // test_dir_path + "/file.txt"
+
+/*
+ *  Fill a pipe with num_bytes of a repeating pattern and read it back with read_fd_arena().
+ */
+void check_read_pipe(size_t num_bytes);
+
+/*
+ *  Create the test directory, with one file, and an empty arena with small chunks.
+ */
+void setup(void);
+
+/*
+ *  Free the arena and delete the test directory.
+ */
+void teardown(void);
+
+/*
+ *  Thread start routine: use the thread's arena and report what it was.
+ */
+void *use_thread_arena(void *arg);
+
+
+void check_read_pipe(size_t num_bytes)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;       // Errno from the function calls
+    int pipe_fds[2] = { -1, -1 };  // Read and write ends of the pipe
+    char *output = NULL;           // read_fd_arena()'s return value
+    size_t output_len = 0;         // Number of bytes read
+    char chunk[512];               // Bytes to write at a time
+    size_t written = 0;            // Bytes written so far
+
+    // SETUP
+    for (size_t i = 0; i < sizeof(chunk); i++)
+    {
+        chunk[i] = 'a' + (i % 26);
+    }
+    ck_assert_int_eq(0, pipe(pipe_fds));
+    ck_assert_msg(num_bytes <= 65536, "Don't fill the pipe beyond its default capacity");
+    while (written < num_bytes)
+    {
+        size_t len = (num_bytes - written < sizeof(chunk)) ? num_bytes - written : sizeof(chunk);
+        ck_assert_int_eq(len, write(pipe_fds[1], chunk, len));
+        written += len;
+    }
+    close(pipe_fds[1]);
+
+    // TEST
+    output = read_fd_arena(&test_arena, pipe_fds[0], &output_len, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(output);
+    ck_assert_int_eq(num_bytes, output_len);
+    ck_assert_int_eq('\0', output[output_len]);
+    for (size_t i = 0; i < output_len; i++)
+    {
+        ck_assert_int_eq('a' + ((i % sizeof(chunk)) % 26), output[i]);
+    }
+
+    // CLEANUP
+    close(pipe_fds[0]);
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor for the test file
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sar_test_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_file_path, sizeof(test_file_path), "%s/file.txt", test_dir_path);
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    fd = open(test_file_path, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(5, write(fd, "Test\n", 5));
+    close(fd);
+    memset(&test_arena, 0, sizeof(test_arena));
+    test_arena.chunk_size = TEST_CHUNK_SIZE;
+}
+
+
+void teardown(void)
+{
+    ck_assert_int_eq(0, free_skid_arena(&test_arena));
+    ck_assert_ptr_null(test_arena.first);
+    ck_assert_int_eq(0, test_arena.mapped);
+    unlink(test_file_path);
+    rmdir(test_dir_path);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+void *use_thread_arena(void *arg)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;     // Errno from the function calls
+    skidArena_ptr arena = NULL;  // This thread's arena
+
+    // GET IT
+    arena = get_thread_arena(&errnum);
+
+    // USE IT
+    if (0 == errnum && arena)
+    {
+        alloc_skid_arena(arena, 1, 64, &errnum);  // Freed when this thread exits
+    }
+
+    // DONE
+    *(skidArena_ptr *)arg = (0 == errnum) ? arena : NULL;
+    return NULL;
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_alloc_zeroized_and_aligned)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    char *mem = NULL;         // alloc_skid_arena()'s return value
+
+    // Make a byte-sized allocation first so the next one needs realignment
+    ck_assert_ptr_nonnull(alloc_skid_arena(&test_arena, 1, 1, &errnum));
+    mem = alloc_skid_arena(&test_arena, 10, sizeof(long double), &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(mem);
+    ck_assert_int_eq(0, (uintptr_t)mem % __alignof__(max_align_t));
+    for (size_t i = 0; i < 10 * sizeof(long double); i++)
+    {
+        ck_assert_int_eq(0, mem[i]);
+    }
+}
+END_TEST
+
+
+START_TEST(test_n02_clear_reuses_chunks)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    char *first = NULL;       // The first allocation
+    size_t mapped = 0;        // Bytes mapped before the clear
+
+    // Span a few chunks and dirty them
+    first = alloc_skid_arena(&test_arena, 1, 100, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < 10; i++)
+    {
+        memset(alloc_skid_arena(&test_arena, 1, 1000, &errnum), 0xFF, 1000);
+        ck_assert_int_eq(0, errnum);
+    }
+    mapped = test_arena.mapped;
+    ck_assert_int_ge(mapped, 3 * TEST_CHUNK_SIZE);
+    // Clear it and do it all again
+    ck_assert_int_eq(0, clear_skid_arena(&test_arena));
+    ck_assert_ptr_eq(first, alloc_skid_arena(&test_arena, 1, 100, &errnum));
+    for (int i = 0; i < 10; i++)
+    {
+        char *mem = alloc_skid_arena(&test_arena, 1, 1000, &errnum);
+        ck_assert_int_eq(0, errnum);
+        ck_assert_int_eq(0, mem[0]);    // Rezeroized
+        ck_assert_int_eq(0, mem[999]);  // Rezeroized
+    }
+    ck_assert_int_eq(mapped, test_arena.mapped);  // Nothing new was mapped
+}
+END_TEST
+
+
+START_TEST(test_n03_copy_string)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    char *copy = copy_skid_string_arena(&test_arena, "Hello, arena", &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_str_eq("Hello, arena", copy);
+}
+END_TEST
+
+
+START_TEST(test_n04_read_fd_small)
+{
+    check_read_pipe(5);
+}
+END_TEST
+
+
+START_TEST(test_n05_read_fd_spans_chunks)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    ck_assert_ptr_nonnull(copy_skid_string_arena(&test_arena, "Start mid-chunk", &errnum));
+    check_read_pipe(3 * TEST_CHUNK_SIZE + 7);
+}
+END_TEST
+
+
+START_TEST(test_n06_read_dir_contents)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    size_t capacity = 0;      // Number of indices in contents
+    char **contents = read_dir_contents_arena(&test_arena, test_dir_path, false, &errnum,
+                                              &capacity);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(2, capacity);
+    ck_assert_str_eq(test_file_path, contents[0]);
+    ck_assert_ptr_null(contents[1]);
+}
+END_TEST
+
+
+START_TEST(test_n07_thread_arenas)
+{
+    int errnum = CANARY_INT;      // Errno from the function calls
+    skidArena_ptr mine = NULL;    // This thread's arena
+    skidArena_ptr theirs = NULL;  // Another thread's arena
+    pthread_t thread;             // The other thread
+
+    mine = get_thread_arena(&errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(mine);
+    ck_assert_ptr_eq(mine, get_thread_arena(&errnum));
+    ck_assert_int_eq(0, pthread_create(&thread, NULL, use_thread_arena, &theirs));
+    ck_assert_int_eq(0, pthread_join(thread, NULL));
+    ck_assert_ptr_nonnull(theirs);
+    ck_assert_ptr_ne(mine, theirs);
+    ck_assert_ptr_nonnull(copy_skid_string_arena(mine, "Mine", &errnum));
+    ck_assert_int_eq(0, free_skid_arena(mine));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_arena)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    size_t capacity = 0;      // Number of indices
+    ck_assert_ptr_null(alloc_skid_arena(NULL, 1, 1, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(copy_skid_string_arena(NULL, "Test", &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(read_fd_arena(NULL, STDIN_FILENO, NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(read_dir_contents_arena(NULL, test_dir_path, false, &errnum, &capacity));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(EINVAL, clear_skid_arena(NULL));
+    ck_assert_int_eq(EINVAL, free_skid_arena(NULL));
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    ck_assert_ptr_null(alloc_skid_arena(&test_arena, 0, 1, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(copy_skid_string_arena(&test_arena, NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(read_fd_arena(&test_arena, -1, NULL, &errnum));
+    ck_assert_int_ne(0, errnum);
+    ck_assert_ptr_null(alloc_skid_arena(&test_arena, 1, 1, NULL));
+    ck_assert_int_eq(0, test_arena.mapped);  // Nothing was mapped
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_overflow)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    ck_assert_ptr_null(alloc_skid_arena(&test_arena, SIZE_MAX / 2, 3, &errnum));
+    ck_assert_int_eq(EOVERFLOW, errnum);
+    ck_assert_ptr_null(alloc_skid_arena(&test_arena, 1, SIZE_MAX - 1, &errnum));
+    ck_assert_int_eq(EOVERFLOW, errnum);
+}
+END_TEST
+
+
+START_TEST(test_b02_oversized_gets_own_chunk)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    char *small = NULL;       // An allocation before the big one
+    char *big = NULL;         // Bigger than a chunk
+
+    small = alloc_skid_arena(&test_arena, 1, 16, &errnum);
+    ck_assert_int_eq(0, errnum);
+    big = alloc_skid_arena(&test_arena, 4, TEST_CHUNK_SIZE, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(big);
+    big[4 * TEST_CHUNK_SIZE - 1] = 'X';  // Touch the last byte
+    ck_assert_int_eq(0, small[0]);
+    ck_assert_int_gt(test_arena.mapped, 4 * TEST_CHUNK_SIZE);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_empty_dir)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    size_t capacity = 1;      // Number of indices
+    ck_assert_int_eq(0, unlink(test_file_path));
+    ck_assert_ptr_null(read_dir_contents_arena(&test_arena, test_dir_path, true, &errnum,
+                                               &capacity));
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(0, capacity);
+}
+END_TEST
+
+
+START_TEST(test_s02_read_empty_fd)
+{
+    check_read_pipe(0);
+}
+END_TEST
+
+
+START_TEST(test_s03_free_then_reuse)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    ck_assert_ptr_nonnull(alloc_skid_arena(&test_arena, 1, 1, &errnum));
+    ck_assert_int_eq(0, free_skid_arena(&test_arena));
+    ck_assert_int_eq(TEST_CHUNK_SIZE, test_arena.chunk_size);  // Kept
+    ck_assert_ptr_nonnull(alloc_skid_arena(&test_arena, 1, 1, &errnum));
+    ck_assert_int_eq(TEST_CHUNK_SIZE, test_arena.mapped);
+    ck_assert_int_eq(0, clear_skid_arena(&test_arena));
+    ck_assert_int_eq(0, free_skid_arena(&test_arena));
+    ck_assert_int_eq(0, free_skid_arena(&test_arena));  // Freeing an empty arena is fine
+}
+END_TEST
+
+
+Suite *alloc_skid_arena_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SAR_Alloc_Skid_Arena");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_alloc_zeroized_and_aligned);
+    tcase_add_test(tc_core, test_n02_clear_reuses_chunks);
+    tcase_add_test(tc_core, test_n03_copy_string);
+    tcase_add_test(tc_core, test_n04_read_fd_small);
+    tcase_add_test(tc_core, test_n05_read_fd_spans_chunks);
+    tcase_add_test(tc_core, test_n06_read_dir_contents);
+    tcase_add_test(tc_core, test_n07_thread_arenas);
+    tcase_add_test(tc_core, test_e01_null_arena);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_b01_overflow);
+    tcase_add_test(tc_core, test_b02_oversized_gets_own_chunk);
+    tcase_add_test(tc_core, test_s01_empty_dir);
+    tcase_add_test(tc_core, test_s02_read_empty_fd);
+    tcase_add_test(tc_core, test_s03_free_then_reuse);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sar_alloc_skid_arena.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = alloc_skid_arena_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
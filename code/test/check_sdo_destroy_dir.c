@@ -586,6 +586,59 @@ START_TEST(test_s02_not_a_dir)
 END_TEST
 
 
+START_TEST(test_s03_symlink_to_outside_dir)
+{
+	// LOCAL VARIABLES
+	int errnum = CANARY_INT;                      // Errno values
+	char *input_test_path = get_test_dir_name();  // Test case input: directory name
+	char *outside_path = get_test_dir_name();     // The directory the symlink points to
+	char *link_path = NULL;                       // input_test_path's symlink to outside_path
+	char **input_arr = NULL;                      // Paths create_path_tree() made for input
+	char **outside_arr = NULL;                    // Paths create_path_tree() made for outside
+
+	// SETUP
+	// Two trees, one with a link to the other
+	input_arr = create_path_tree(input_test_path, 2, 2, 2, &errnum);
+	ck_assert_msg(0 == errnum, "create_path_tree(%s) failed with [%d] '%s'\n",
+		          input_test_path, errnum, strerror(errnum));
+	outside_arr = create_path_tree(outside_path, 2, 2, 2, &errnum);
+	ck_assert_msg(0 == errnum, "create_path_tree(%s) failed with [%d] '%s'\n",
+		          outside_path, errnum, strerror(errnum));
+	link_path = join_dir_to_path(input_test_path, "link_to_outside", false, &errnum);
+	ck_assert_msg(0 == errnum, "join_dir_to_path() failed with [%d] '%s'\n",
+		          errnum, strerror(errnum));
+	errnum = make_a_symlink(outside_path, link_path);
+	ck_assert_msg(0 == errnum, "make_a_symlink(%s, %s) failed with [%d] '%s'\n",
+		          outside_path, link_path, errnum, strerror(errnum));
+
+	// RUN TEST
+	// The link is removed but it is never followed
+	errnum = destroy_dir(input_test_path);
+	ck_assert_msg(0 == errnum, "destroy_dir(%s) failed with [%d] '%s'\n",
+		          input_test_path, errnum, strerror(errnum));
+	ck_assert_msg(false == is_path_there(input_test_path), "Located '%s'\n", input_test_path);
+	for (char **tmp_arr = outside_arr; NULL != *tmp_arr; tmp_arr++)
+	{
+		ck_assert_msg(true == is_path_there(*tmp_arr), "Lost '%s'\n", *tmp_arr);
+	}
+
+	// CLEANUP
+	if (true == is_path_there(input_test_path))
+	{
+		destroy_shell_tree(input_arr);  // Best effort
+	}
+	errnum = destroy_shell_tree(outside_arr);
+	ck_assert_msg(0 == errnum, "The destroy_shell_tree(%p) call failed with [%d] '%s'\n",
+				  outside_arr, errnum, strerror(errnum));
+	free_path_tree(&input_arr);
+	free_path_tree(&outside_arr);
+	free_devops_mem((void **)&link_path);
+	free_devops_mem((void **)&outside_path);
+	free_devops_mem((void **)&input_test_path);
+}
+END_TEST
+
+
 Suite *destroy_dir_suite(void)
 {
 	// LOCAL VARIABLES
@@ -612,6 +665,7 @@ Suite *destroy_dir_suite(void)
 	tcase_add_test(tc_boundary, test_b02_longest_dir_name);
 	tcase_add_test(tc_special, test_s01_dirname_in_filename_format);
 	tcase_add_test(tc_special, test_s02_not_a_dir);
+	tcase_add_test(tc_special, test_s03_symlink_to_outside_dir);
 	suite_add_tcase(suite, tc_normal);
 	suite_add_tcase(suite, tc_error);
 	suite_add_tcase(suite, tc_boundary);
@@ -0,0 +1,252 @@
+/*
+ *  Check unit test suit for skid_dir_operations.h's destroy_dir_parallel() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sdo_destroy_dir_parallel.bin
+code/dist/check_sdo_destroy_dir_parallel.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sdo_destroy_dir_parallel.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // O_DIRECTORY
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EACCES, EINVAL, ENOENT, ENOTDIR
+#include <fcntl.h>                    // open(), O_DIRECTORY
+#include <stdatomic.h>                // atomic_load()
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // strerror()
+#include <sys/stat.h>                 // chmod(), mkdir()
+#include <unistd.h>                   // close(), geteuid()
+// Local includes
+#include "devops_code.h"              /* is_path_there(), make_a_tree(), remove_a_tree(),
+                                         resolve_to_repo(), SKID_REPO_NAME */
+#include "skid_dir_operations.h"      // destroy_dir_parallel(), skidDestroyProgress
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TREE_WIDTH 4               // Number of sub-directories in each directory
+#define TREE_DEPTH 3               // Number of sub-directory levels
+#define TREE_FILES 3               // Number of files in each directory
+// Every directory in the tree, beneath dirname
+#define TREE_DIRS (TREE_WIDTH + TREE_WIDTH * TREE_WIDTH + TREE_WIDTH * TREE_WIDTH * TREE_WIDTH)
+// Every file in the tree: each directory, and dirname, holds TREE_FILES files
+#define TREE_NUM_FILES ((TREE_DIRS + 1) * TREE_FILES)
+#define NUM_THREADS 4              // Number of workers for the parallel deletions
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_dir_path;     // Heap array with the test directory resolved to the repo
+char locked_dir[4096];   // test_dir_path + "/locked", a read-only sub-directory, if any
+char locked_file[4096];  // locked_dir + "/file.txt"
+
+/*
+ *  Create the test directory and fill it with make_a_tree().
+ */
+void setup(void);
+
+/*
+ *  Delete whatever remains of the test directory.
+ */
+void teardown(void);
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;    // Errno from the function call
+    int dir_fd = -1;            // File descriptor for the test directory
+    unsigned int num_made = 0;  // Number of entries make_a_tree() created
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sdo_destroy_par_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(locked_dir, sizeof(locked_dir), "%s/locked", test_dir_path);
+    snprintf(locked_file, sizeof(locked_file), "%s/locked/file.txt", test_dir_path);
+    chmod(locked_dir, 0755);  // Leftovers from a previous run
+    remove_a_tree(test_dir_path, true);
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    dir_fd = open(test_dir_path, O_RDONLY | O_DIRECTORY);
+    ck_assert_int_ne(-1, dir_fd);
+    errnum = make_a_tree(dir_fd, TREE_FILES, TREE_WIDTH, TREE_DEPTH, &num_made);
+    ck_assert_msg(0 == errnum, "make_a_tree() failed with [%d] %s", errnum, strerror(errnum));
+    close(dir_fd);
+    ck_assert_int_eq(TREE_NUM_FILES + TREE_DIRS, num_made);
+}
+
+
+void teardown(void)
+{
+    chmod(locked_dir, 0755);  // Best effort
+    remove_a_tree(test_dir_path, true);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_multi_level_tree)
+{
+    skidDestroyProgress progress = { 0 };  // Entries deleted
+
+    ck_assert_int_eq(0, destroy_dir_parallel(test_dir_path, NUM_THREADS, &progress));
+    ck_assert_int_eq(false, is_path_there(test_dir_path));
+    ck_assert_int_eq(TREE_NUM_FILES, atomic_load(&(progress.files_deleted)));
+    ck_assert_int_eq(TREE_DIRS + 1, atomic_load(&(progress.dirs_deleted)));  // dirname too
+}
+END_TEST
+
+
+START_TEST(test_n02_one_thread)
+{
+    skidDestroyProgress progress = { 0 };  // Entries deleted
+
+    ck_assert_int_eq(0, destroy_dir_parallel(test_dir_path, 1, &progress));
+    ck_assert_int_eq(false, is_path_there(test_dir_path));
+    ck_assert_int_eq(TREE_NUM_FILES, atomic_load(&(progress.files_deleted)));
+    ck_assert_int_eq(TREE_DIRS + 1, atomic_load(&(progress.dirs_deleted)));
+}
+END_TEST
+
+
+START_TEST(test_n03_no_progress)
+{
+    ck_assert_int_eq(0, destroy_dir_parallel(test_dir_path, 0, NULL));
+    ck_assert_int_eq(false, is_path_there(test_dir_path));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_read_only_sub_dir)
+{
+    // LOCAL VARIABLES
+    skidDestroyProgress progress = { 0 };  // Entries deleted
+    FILE *file = NULL;                     // A file in locked_dir
+
+    // SETUP
+    ck_assert_int_eq(0, mkdir(locked_dir, 0755));
+    file = fopen(locked_file, "w");
+    ck_assert_ptr_nonnull(file);
+    fclose(file);
+    ck_assert_int_eq(0, chmod(locked_dir, 0555));
+
+    // TEST
+    if (0 != geteuid())
+    {
+        ck_assert_int_eq(EACCES, destroy_dir_parallel(test_dir_path, NUM_THREADS, &progress));
+        ck_assert_int_eq(true, is_path_there(locked_file));
+        ck_assert_int_eq(true, is_path_there(test_dir_path));
+        // Some of the tree may already be gone but never locked_file, locked_dir, or dirname
+        ck_assert_int_le(atomic_load(&(progress.files_deleted)), TREE_NUM_FILES);
+        ck_assert_int_le(atomic_load(&(progress.dirs_deleted)), TREE_DIRS);
+    }
+    else
+    {
+        // Root ignores directory permissions
+        ck_assert_int_eq(0, destroy_dir_parallel(test_dir_path, NUM_THREADS, &progress));
+        ck_assert_int_eq(false, is_path_there(test_dir_path));
+        ck_assert_int_eq(TREE_NUM_FILES + 1, atomic_load(&(progress.files_deleted)));
+        ck_assert_int_eq(TREE_DIRS + 2, atomic_load(&(progress.dirs_deleted)));
+    }
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    skidDestroyProgress progress = { 0 };  // Entries deleted
+    char file_path[4096] = { 0 };          // A file in test_dir_path
+
+    // make_a_tree() names the first file it creates "e00000"
+    snprintf(file_path, sizeof(file_path), "%s/e00000", test_dir_path);
+    ck_assert_int_eq(EINVAL, destroy_dir_parallel(NULL, NUM_THREADS, &progress));
+    ck_assert_int_eq(EINVAL, destroy_dir_parallel("", NUM_THREADS, &progress));
+    ck_assert_int_eq(ENOENT, destroy_dir_parallel("/this/dir/does/not/exist", NUM_THREADS,
+                                                  &progress));
+    ck_assert_int_eq(ENOTDIR, destroy_dir_parallel(file_path, NUM_THREADS, &progress));
+    ck_assert_int_eq(true, is_path_there(file_path));
+    ck_assert_int_eq(0, atomic_load(&(progress.files_deleted)));
+    ck_assert_int_eq(0, atomic_load(&(progress.dirs_deleted)));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_empty_dir)
+{
+    skidDestroyProgress progress = { 0 };  // Entries deleted
+
+    ck_assert_int_eq(0, mkdir(locked_dir, 0755));  // Never locked, just empty
+    ck_assert_int_eq(0, destroy_dir_parallel(locked_dir, NUM_THREADS, &progress));
+    ck_assert_int_eq(false, is_path_there(locked_dir));
+    ck_assert_int_eq(0, atomic_load(&(progress.files_deleted)));
+    ck_assert_int_eq(1, atomic_load(&(progress.dirs_deleted)));
+}
+END_TEST
+
+
+Suite *destroy_dir_parallel_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SDO_Destroy_Dir_Parallel");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+    tcase_set_timeout(tc_core, 60);  // A hung deletion fails instead of blocking forever
+
+    tcase_add_test(tc_core, test_n01_multi_level_tree);
+    tcase_add_test(tc_core, test_n02_one_thread);
+    tcase_add_test(tc_core, test_n03_no_progress);
+    tcase_add_test(tc_core, test_e01_read_only_sub_dir);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_b01_empty_dir);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sdo_destroy_dir_parallel.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = destroy_dir_parallel_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,420 @@
+/*
+ *  Check unit test suit for skid_dir_operations.h's read_dir_listing() function (and
+ *  free_dir_listing() and get_dir_listing_path(), which share a skidDirListing with it).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sdo_read_dir_listing.bin
+code/dist/check_sdo_read_dir_listing.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sdo_read_dir_listing.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // openat()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EINVAL, ENAMETOOLONG, ENOENT
+#include <fcntl.h>                    // openat(), O_DIRECTORY
+#include <linux/limits.h>             // NAME_MAX, PATH_MAX
+#include <stdint.h>                   // SIZE_MAX
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memset(), strerror(), strlen()
+#include <sys/stat.h>                 // mkdir(), mkdirat()
+#include <unistd.h>                   // close(), unlinkat()
+// Local includes
+#include "devops_code.h"              // remove_a_tree(), resolve_to_repo(), SKID_REPO_NAME
+#include "skid_dir_operations.h"      // read_dir_listing(), skidDirListing
+#include "skid_macros.h"              // ENOERR
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define FLAT_ENTRIES 3             // Number of entries directly in flat_dir
+#define FLAT_TREE_ENTRIES 4        // Number of entries in flat_dir's whole tree
+#define DEEP_NAME_LEN 250          // Length of each directory name in the deep tree
+#define DEEP_MAX_LEVELS 32         // Deepest the deep tree can get
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_dir_path;                // Heap array with the test directory resolved to the repo
+char flat_dir[4096];                // test_dir_path + "/flat"
+char deep_dir[4096];                // test_dir_path + "/deep"
+int deep_fds[DEEP_MAX_LEVELS + 1];  // Directory file descriptors, deep_dir on down
+int deep_levels;                    // Number of deep directories created beneath deep_dir
+char deep_name[DEEP_NAME_LEN + 1];  // The name of every deep directory
+char deep_file[NAME_MAX + 1];       // The name of the file in the deepest directory, if any
+
+/*
+ *  Verify the first count paths in listing match the copies in exp_paths.
+ */
+void check_paths(const skidDirListing *listing, char **exp_paths, size_t count);
+
+/*
+ *  Heap-allocate a copy of the first count paths in listing.  Free it with free_paths().
+ */
+char **copy_paths(const skidDirListing *listing, size_t count);
+
+/*
+ *  Free a copy_paths() return value.
+ */
+void free_paths(char **paths, size_t count);
+
+/*
+ *  Create a chain of DEEP_NAME_LEN directories beneath deep_dir, and a file in the deepest one
+ *  whose path is one character too long for the walker to build.
+ */
+void make_deep_tree(void);
+
+/*
+ *  Create the test directory with a small flat_dir tree and an empty deep_dir.
+ */
+void setup(void);
+
+/*
+ *  Delete the test directory and everything in it, including a deep tree.
+ */
+void teardown(void);
+
+
+void check_paths(const skidDirListing *listing, char **exp_paths, size_t count)
+{
+    ck_assert_int_ge(listing->count, count);
+    for (size_t i = 0; i < count; i++)
+    {
+        ck_assert_ptr_nonnull(get_dir_listing_path(listing, i));
+        ck_assert_str_eq(exp_paths[i], get_dir_listing_path(listing, i));
+    }
+}
+
+
+char **copy_paths(const skidDirListing *listing, size_t count)
+{
+    // LOCAL VARIABLES
+    char **paths = calloc(count + 1, sizeof(char *));  // Copies of the paths
+
+    // COPY THEM
+    ck_assert_ptr_nonnull(paths);
+    for (size_t i = 0; i < count; i++)
+    {
+        ck_assert_ptr_nonnull(get_dir_listing_path(listing, i));
+        paths[i] = strdup(get_dir_listing_path(listing, i));
+        ck_assert_ptr_nonnull(paths[i]);
+    }
+
+    // DONE
+    return paths;
+}
+
+
+void free_paths(char **paths, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        free(paths[i]);
+    }
+    free(paths);
+}
+
+
+void make_deep_tree(void)
+{
+    // LOCAL VARIABLES
+    size_t base_len = strlen(deep_dir) + 1;  // Length of a deep directory's path plus '/'
+    int fd = -1;                             // File descriptor for the deep file
+
+    // MAKE IT
+    // Paths this long can't be used whole so create each directory relative to its parent
+    memset(deep_name, 'd', DEEP_NAME_LEN);
+    while ((PATH_MAX - 1 - base_len) > 253)
+    {
+        ck_assert_int_lt(deep_levels, DEEP_MAX_LEVELS);
+        ck_assert_int_eq(0, mkdirat(deep_fds[deep_levels], deep_name, 0755));
+        deep_fds[deep_levels + 1] = openat(deep_fds[deep_levels], deep_name,
+                                           O_RDONLY | O_DIRECTORY);
+        ck_assert_int_ne(-1, deep_fds[deep_levels + 1]);
+        deep_levels++;
+        base_len += DEEP_NAME_LEN + 1;
+    }
+    // One character past the walker's PATH_MAX limit
+    memset(deep_file, 'x', PATH_MAX + 1 - base_len);
+    fd = openat(deep_fds[deep_levels], deep_file, O_CREAT | O_WRONLY, 0644);
+    ck_assert_int_ne(-1, fd);
+    close(fd);
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+    char path[4096] = { 0 };  // A file to create in flat_dir's tree
+    FILE *file = NULL;        // The file to create
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sdo_listing_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(flat_dir, sizeof(flat_dir), "%s/flat", test_dir_path);
+    snprintf(deep_dir, sizeof(deep_dir), "%s/deep", test_dir_path);
+    remove_a_tree(test_dir_path, true);  // Leftovers from a previous run
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    ck_assert_int_eq(0, mkdir(flat_dir, 0755));
+    ck_assert_int_eq(0, mkdir(deep_dir, 0755));
+    // flat/a.txt, flat/b.txt, flat/sub/, and flat/sub/c.txt
+    snprintf(path, sizeof(path), "%s/flat/sub", test_dir_path);
+    ck_assert_int_eq(0, mkdir(path, 0755));
+    for (const char *name = "abc"; '\0' != *name; name++)
+    {
+        snprintf(path, sizeof(path), "%s/flat/%s%c.txt", test_dir_path,
+                 'c' == *name ? "sub/" : "", *name);
+        file = fopen(path, "w");
+        ck_assert_ptr_nonnull(file);
+        fclose(file);
+    }
+    deep_levels = 0;
+    deep_file[0] = '\0';
+    deep_fds[0] = open(deep_dir, O_RDONLY | O_DIRECTORY);
+    ck_assert_int_ne(-1, deep_fds[0]);
+}
+
+
+void teardown(void)
+{
+    // The deep tree is too deep for remove_a_tree() so unwind it one directory at a time
+    if ('\0' != deep_file[0])
+    {
+        unlinkat(deep_fds[deep_levels], deep_file, 0);
+    }
+    for (int i = deep_levels; i > 0; i--)
+    {
+        close(deep_fds[i]);
+        unlinkat(deep_fds[i - 1], deep_name, AT_REMOVEDIR);
+    }
+    close(deep_fds[0]);
+    remove_a_tree(test_dir_path, true);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_flat)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    ck_assert_int_eq(FLAT_ENTRIES, listing.count);
+    for (size_t i = 0; i < listing.count; i++)
+    {
+        ck_assert_ptr_nonnull(get_dir_listing_path(&listing, i));
+        ck_assert_int_eq(0, strncmp(flat_dir, get_dir_listing_path(&listing, i),
+                                    strlen(flat_dir)));
+    }
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+START_TEST(test_n02_append)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+    char **first_paths = NULL;       // Copies of the first read's paths
+    size_t exp_arena_len = 0;        // Sum of every path's length, nul-terminators included
+
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    first_paths = copy_paths(&listing, listing.count);
+    // A second read appends to the first
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, true, &listing));
+    ck_assert_int_eq(FLAT_ENTRIES + FLAT_TREE_ENTRIES, listing.count);
+    check_paths(&listing, first_paths, FLAT_ENTRIES);
+    for (size_t i = 0; i < listing.count; i++)
+    {
+        exp_arena_len += strlen(get_dir_listing_path(&listing, i)) + 1;
+    }
+    ck_assert_int_eq(exp_arena_len, listing.arena_len);
+    free_paths(first_paths, FLAT_ENTRIES);
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+START_TEST(test_n03_matches_read_dir_contents)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+    int errnum = CANARY_INT;         // Errno from the function call
+    size_t capacity = 0;             // Capacity of contents
+    char **contents = NULL;          // read_dir_contents() of the same tree
+
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, true, &listing));
+    contents = read_dir_contents(flat_dir, true, &errnum, &capacity);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(contents);
+    ck_assert_int_eq(listing.count + 1, capacity);
+    check_paths(&listing, contents, listing.count);
+    ck_assert_ptr_null(contents[listing.count]);
+    ck_assert_int_eq(0, free_skid_dir_contents(&contents));
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_rollback)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+    char **first_paths = NULL;       // Copies of the first read's paths
+    size_t orig_arena_len = 0;       // listing.arena_len before the failed read
+
+    // SETUP
+    make_deep_tree();
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, true, &listing));
+    first_paths = copy_paths(&listing, listing.count);
+    orig_arena_len = listing.arena_len;
+
+    // TEST
+    // Every deep directory is appended before the walk fails on the deep file
+    ck_assert_int_eq(ENAMETOOLONG, read_dir_listing(deep_dir, true, &listing));
+    ck_assert_int_eq(FLAT_TREE_ENTRIES, listing.count);
+    ck_assert_int_eq(orig_arena_len, listing.arena_len);
+    check_paths(&listing, first_paths, FLAT_TREE_ENTRIES);
+    ck_assert_ptr_null(get_dir_listing_path(&listing, FLAT_TREE_ENTRIES));
+    // The listing is still usable
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    ck_assert_int_eq(FLAT_TREE_ENTRIES + FLAT_ENTRIES, listing.count);
+    check_paths(&listing, first_paths, FLAT_TREE_ENTRIES);
+
+    // CLEANUP
+    free_paths(first_paths, FLAT_TREE_ENTRIES);
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    ck_assert_int_eq(EINVAL, read_dir_listing(NULL, false, &listing));
+    ck_assert_int_eq(EINVAL, read_dir_listing("", false, &listing));
+    ck_assert_int_eq(EINVAL, read_dir_listing(flat_dir, false, NULL));
+    ck_assert_int_eq(ENOENT, read_dir_listing("/this/dir/does/not/exist", false, &listing));
+    ck_assert_int_eq(FLAT_ENTRIES, listing.count);
+    ck_assert_int_eq(EINVAL, free_dir_listing(NULL));
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_out_of_range)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+
+    ck_assert_ptr_null(get_dir_listing_path(&listing, 0));  // Empty
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    ck_assert_ptr_nonnull(get_dir_listing_path(&listing, FLAT_ENTRIES - 1));
+    ck_assert_ptr_null(get_dir_listing_path(&listing, FLAT_ENTRIES));
+    ck_assert_ptr_null(get_dir_listing_path(&listing, SIZE_MAX));
+    ck_assert_ptr_null(get_dir_listing_path(NULL, 0));
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+START_TEST(test_b02_free_and_reuse)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, true, &listing));
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+    ck_assert_ptr_null(listing.arena);
+    ck_assert_ptr_null(listing.offsets);
+    ck_assert_int_eq(0, listing.arena_len);
+    ck_assert_int_eq(0, listing.arena_size);
+    ck_assert_int_eq(0, listing.count);
+    ck_assert_int_eq(0, listing.capacity);
+    ck_assert_ptr_null(get_dir_listing_path(&listing, 0));
+    ck_assert_int_eq(0, free_dir_listing(&listing));  // Freeing twice is harmless
+    // A freed listing may be reused
+    ck_assert_int_eq(0, read_dir_listing(flat_dir, false, &listing));
+    ck_assert_int_eq(FLAT_ENTRIES, listing.count);
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+START_TEST(test_b03_empty_dir)
+{
+    skidDirListing listing = { 0 };  // The listing to read into
+
+    ck_assert_int_eq(0, read_dir_listing(deep_dir, true, &listing));
+    ck_assert_int_eq(0, listing.count);
+    ck_assert_ptr_null(get_dir_listing_path(&listing, 0));
+    ck_assert_int_eq(0, free_dir_listing(&listing));
+}
+END_TEST
+
+
+Suite *read_dir_listing_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SDO_Read_Dir_Listing");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_flat);
+    tcase_add_test(tc_core, test_n02_append);
+    tcase_add_test(tc_core, test_n03_matches_read_dir_contents);
+    tcase_add_test(tc_core, test_e01_rollback);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_b01_out_of_range);
+    tcase_add_test(tc_core, test_b02_free_and_reuse);
+    tcase_add_test(tc_core, test_b03_empty_dir);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sdo_read_dir_listing.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = read_dir_listing_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
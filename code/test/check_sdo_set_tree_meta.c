@@ -0,0 +1,426 @@
+/*
+ *  Check unit test suit for skid_dir_operations.h's set_tree_meta() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sdo_set_tree_meta.bin
+code/dist/check_sdo_set_tree_meta.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sdo_set_tree_meta.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EACCES, EINVAL, ENOENT
+#include <fcntl.h>                    // open()
+#include <libgen.h>                   // dirname()
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <sys/stat.h>                 // lstat(), mkdir(), stat()
+#include <unistd.h>                   // chdir(), close(), getcwd(), seteuid(), symlink(), unlink()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_dir_operations.h"      // set_tree_meta(), skidTreeMeta
+#include "skid_macros.h"              // ENOERR
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TREE_SIZE 7                // tree_dir, its two sub-directories, three files, and a link
+#define TREE_THREADS 3             // Number of workers to use (more than there are directories)
+#define TREE_NAME "stm_test_dir"   // tree_dir, relative to its parent
+#define UNPRIV_ID 65534            // The user and group root hands the tree to (AKA nobody)
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *tree_dir;            // Heap array with the test directory resolved to the repo
+char *tree_outside;        // Heap array with the symbolic link's target, outside tree_dir
+char tree_paths[6][4096];  // Every entry in tree_dir, directories first
+char tree_cwd[4096];       // The working directory before enter_tree_parent(), if it was called
+
+/*
+ *  Change to tree_dir's parent, so TREE_NAME needs no access to the directories above it, and
+ *  enforce permissions: if running as root, hand the tree to UNPRIV_ID and become UNPRIV_ID
+ *  (effective IDs only).  leave_tree_parent() undoes it.
+ */
+void enter_tree_parent(void);
+
+/*
+ *  Undo enter_tree_parent(), if it was called.
+ */
+void leave_tree_parent(void);
+
+/*
+ *  Verify pathname's permission bits (and, if mtime isn't -1, its modification time).
+ */
+void check_entry(const char *pathname, mode_t exp_mode, time_t exp_mtime);
+
+/*
+ *  Create tree_dir/, tree_dir/sub1/, tree_dir/sub1/sub2/, a file in each, and tree_dir/link.txt,
+ *  a symbolic link to tree_outside.  Every directory is 0755 and every file is 0644.
+ */
+void tree_setup(void);
+
+/*
+ *  Remove everything tree_setup() created.
+ */
+void tree_teardown(void);
+
+
+void check_entry(const char *pathname, mode_t exp_mode, time_t exp_mtime)
+{
+    struct stat statbuf;  // pathname's metadata
+
+    ck_assert_int_eq(0, stat(pathname, &statbuf));
+    ck_assert_msg(exp_mode == (statbuf.st_mode & 07777), "%s has mode %o instead of %o",
+                  pathname, statbuf.st_mode & 07777, exp_mode);
+    if ((time_t)-1 != exp_mtime)
+    {
+        ck_assert_int_eq(exp_mtime, statbuf.st_mtim.tv_sec);
+    }
+}
+
+
+void enter_tree_parent(void)
+{
+    // LOCAL VARIABLES
+    char parent[4096];     // tree_dir's parent
+    char link_path[4096];  // tree_dir + "/link.txt"
+
+    // ENTER IT
+    snprintf(parent, sizeof(parent), "%s", tree_dir);
+    ck_assert_ptr_nonnull(getcwd(tree_cwd, sizeof(tree_cwd)));
+    ck_assert_int_eq(0, chdir(dirname(parent)));
+    if (0 == geteuid())
+    {
+        snprintf(link_path, sizeof(link_path), "%s/link.txt", tree_dir);
+        ck_assert_int_eq(0, lchown(link_path, UNPRIV_ID, UNPRIV_ID));
+        for (int i = 0; i < 6; i++)
+        {
+            ck_assert_int_eq(0, chown(tree_paths[i], UNPRIV_ID, UNPRIV_ID));
+        }
+        ck_assert_int_eq(0, setegid(UNPRIV_ID));
+        ck_assert_int_eq(0, seteuid(UNPRIV_ID));
+    }
+}
+
+
+void leave_tree_parent(void)
+{
+    if ('\0' != tree_cwd[0])
+    {
+        seteuid(getuid());  // Best effort
+        setegid(getgid());  // Best effort
+        chdir(tree_cwd);  // Best effort
+        tree_cwd[0] = '\0';
+    }
+}
+
+
+void tree_setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor of a file being created
+    char link_path[4096];     // tree_dir + "/link.txt"
+
+    // SETUP
+    tree_dir = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/stm_test_dir", false,
+                               &errnum);
+    ck_assert_int_eq(0, errnum);
+    tree_outside = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/stm_outside.txt",
+                                   false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    snprintf(tree_paths[0], sizeof(tree_paths[0]), "%s", tree_dir);
+    snprintf(tree_paths[1], sizeof(tree_paths[1]), "%s/sub1", tree_dir);
+    snprintf(tree_paths[2], sizeof(tree_paths[2]), "%s/sub1/sub2", tree_dir);
+    snprintf(tree_paths[3], sizeof(tree_paths[3]), "%s/a.txt", tree_dir);
+    snprintf(tree_paths[4], sizeof(tree_paths[4]), "%s/sub1/b.txt", tree_dir);
+    snprintf(tree_paths[5], sizeof(tree_paths[5]), "%s/sub1/sub2/c.txt", tree_dir);
+    snprintf(link_path, sizeof(link_path), "%s/link.txt", tree_dir);
+    for (int i = 0; i < 3; i++)
+    {
+        ck_assert_int_eq(0, mkdir(tree_paths[i], 0755));
+        ck_assert_int_eq(0, chmod(tree_paths[i], 0755));  // Ignore the umask
+    }
+    for (int i = 3; i < 6; i++)
+    {
+        fd = open(tree_paths[i], O_CREAT | O_WRONLY | O_TRUNC, 0644);
+        ck_assert_int_ne(-1, fd);
+        ck_assert_int_eq(0, fchmod(fd, 0644));  // Ignore the umask
+        close(fd);
+    }
+    fd = open(tree_outside, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(0, fchmod(fd, 0644));  // Ignore the umask
+    close(fd);
+    ck_assert_int_eq(0, symlink(tree_outside, link_path));
+}
+
+
+void tree_teardown(void)
+{
+    // LOCAL VARIABLES
+    char link_path[4096];  // tree_dir + "/link.txt"
+
+    // CLEANUP
+    leave_tree_parent();
+    snprintf(link_path, sizeof(link_path), "%s/link.txt", tree_dir);
+    unlink(link_path);
+    unlink(tree_outside);
+    for (int i = 5; i >= 0; i--)
+    {
+        chmod(tree_paths[i], 0755);  // In case a test locked us out
+        if (i < 3)
+        {
+            rmdir(tree_paths[i]);
+        }
+        else
+        {
+            unlink(tree_paths[i]);
+        }
+    }
+    free_devops_mem((void **)&tree_dir);
+    free_devops_mem((void **)&tree_outside);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_set_mode)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    skidTreeMetaProgress progress = { 0 };       // Progress counters
+
+    changes.set_mode = true;
+    changes.file_mode = 0640;
+    changes.dir_mode = 0750;
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, TREE_THREADS, &progress));
+    for (int i = 0; i < 6; i++)
+    {
+        check_entry(tree_paths[i], i < 3 ? 0750 : 0640, -1);
+    }
+    check_entry(tree_outside, 0644, -1);  // The symbolic link was not followed
+    ck_assert_int_eq(TREE_SIZE, atomic_load(&(progress.entries_checked)));
+    ck_assert_int_eq(6, atomic_load(&(progress.entries_changed)));
+}
+END_TEST
+
+
+START_TEST(test_n02_already_in_target_state)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    skidTreeMetaProgress progress = { 0 };       // Progress counters
+
+    changes.set_mode = true;
+    changes.file_mode = 0644;
+    changes.dir_mode = 0755;
+    changes.owner = getuid();
+    changes.group = getgid();
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, TREE_THREADS, &progress));
+    ck_assert_int_eq(TREE_SIZE, atomic_load(&(progress.entries_checked)));
+    ck_assert_int_eq(0, atomic_load(&(progress.entries_changed)));
+}
+END_TEST
+
+
+START_TEST(test_n03_add_and_remove_mode)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+
+    changes.remove_mode = S_IROTH | S_IXOTH;
+    changes.add_mode = S_IWGRP;
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, 1, NULL));
+    for (int i = 0; i < 6; i++)
+    {
+        check_entry(tree_paths[i], i < 3 ? 0770 : 0660, -1);
+    }
+}
+END_TEST
+
+
+START_TEST(test_n04_set_mtime_twice)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    skidTreeMetaProgress progress = { 0 };       // Progress counters
+
+    changes.mtime.tv_sec = 1000000000;
+    changes.mtime.tv_nsec = 0;
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, TREE_THREADS, &progress));
+    for (int i = 0; i < 6; i++)
+    {
+        check_entry(tree_paths[i], i < 3 ? 0755 : 0644, 1000000000);
+    }
+    ck_assert_int_eq(TREE_SIZE, atomic_load(&(progress.entries_changed)));
+    // The second pass has nothing left to do
+    atomic_store(&(progress.entries_changed), 0);
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, TREE_THREADS, &progress));
+    ck_assert_int_eq(0, atomic_load(&(progress.entries_changed)));
+}
+END_TEST
+
+
+START_TEST(test_n05_restrictive_dir_mode)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+
+    // The owner's read and search bits are turned off after a directory is read
+    changes.set_mode = true;
+    changes.file_mode = 0400;
+    changes.dir_mode = 0100;
+    ck_assert_int_eq(0, set_tree_meta(tree_dir, &changes, TREE_THREADS, NULL));
+    ck_assert_int_eq(0, chmod(tree_paths[0], 0700));
+    ck_assert_int_eq(0, chmod(tree_paths[1], 0700));
+    ck_assert_int_eq(0, chmod(tree_paths[2], 0700));
+    check_entry(tree_paths[5], 0400, -1);
+}
+END_TEST
+
+
+START_TEST(test_n06_add_mode_opens_locked_dir)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    int result = CANARY_INT;                     // Return value from set_tree_meta()
+
+    // Like chmod -R, a directory is changed before it's read
+    ck_assert_int_eq(0, chmod(tree_paths[1], 0));
+    changes.add_mode = S_IRWXU;
+    enter_tree_parent();
+    result = set_tree_meta(TREE_NAME, &changes, TREE_THREADS, NULL);
+    leave_tree_parent();
+    ck_assert_int_eq(0, result);
+    check_entry(tree_paths[1], 0700, -1);
+    check_entry(tree_paths[2], 0755, -1);
+    check_entry(tree_paths[5], 0744, -1);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_dirname)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    ck_assert_int_eq(EINVAL, set_tree_meta(NULL, &changes, 1, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e02_null_changes)
+{
+    ck_assert_int_eq(EINVAL, set_tree_meta(tree_dir, NULL, 1, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e03_bad_mode)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+
+    changes.add_mode = S_IFREG;
+    ck_assert_int_eq(EINVAL, set_tree_meta(tree_dir, &changes, 1, NULL));
+    check_entry(tree_paths[3], 0644, -1);  // Nothing was touched
+}
+END_TEST
+
+
+START_TEST(test_e04_bad_timestamp)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+
+    changes.atime.tv_nsec = 1000000000L;
+    ck_assert_int_eq(EINVAL, set_tree_meta(tree_dir, &changes, 1, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e05_missing_dir)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    ck_assert_int_eq(ENOENT, set_tree_meta("/does/not/exist/", &changes, 1, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e06_locked_dir_does_not_stop_tree)
+{
+    skidTreeMeta changes = SKID_TREE_META_INIT;  // The changes to make
+    skidTreeMetaProgress progress = { 0 };       // Progress counters
+    int result = CANARY_INT;                     // Return value from set_tree_meta()
+
+    // sub1 can't be read but everything else is changed
+    ck_assert_int_eq(0, chmod(tree_paths[1], 0));
+    changes.remove_mode = S_IROTH;
+    enter_tree_parent();
+    result = set_tree_meta(TREE_NAME, &changes, TREE_THREADS, &progress);
+    leave_tree_parent();
+    ck_assert_int_eq(EACCES, result);
+    check_entry(tree_paths[0], 0751, -1);
+    check_entry(tree_paths[1], 0, -1);
+    check_entry(tree_paths[3], 0640, -1);
+    ck_assert_int_eq(4, atomic_load(&(progress.entries_checked)));  // tree_dir and its entries
+}
+END_TEST
+
+
+Suite *set_tree_meta_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SDO_Set_Tree_Meta");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, tree_setup, tree_teardown);
+
+    tcase_add_test(tc_core, test_n01_set_mode);
+    tcase_add_test(tc_core, test_n02_already_in_target_state);
+    tcase_add_test(tc_core, test_n03_add_and_remove_mode);
+    tcase_add_test(tc_core, test_n04_set_mtime_twice);
+    tcase_add_test(tc_core, test_n05_restrictive_dir_mode);
+    tcase_add_test(tc_core, test_n06_add_mode_opens_locked_dir);
+    tcase_add_test(tc_core, test_e01_null_dirname);
+    tcase_add_test(tc_core, test_e02_null_changes);
+    tcase_add_test(tc_core, test_e03_bad_mode);
+    tcase_add_test(tc_core, test_e04_bad_timestamp);
+    tcase_add_test(tc_core, test_e05_missing_dir);
+    tcase_add_test(tc_core, test_e06_locked_dir_does_not_stop_tree);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sdo_set_tree_meta.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = set_tree_meta_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
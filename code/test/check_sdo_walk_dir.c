@@ -0,0 +1,538 @@
+/*
+ *  Check unit test suit for skid_dir_operations.h's walk_dir() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sdo_walk_dir.bin
+code/dist/check_sdo_walk_dir.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sdo_walk_dir.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // DT_*, symlinkat()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EINVAL, ENAMETOOLONG, ENOENT
+#include <fcntl.h>                    // openat(), O_DIRECTORY
+#include <linux/limits.h>             // PATH_MAX
+#include <stdint.h>                   // int64_t, uint64_t
+#include <stdio.h>                    // snprintf(), sscanf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memset(), strcmp(), strerror(), strlen()
+#include <sys/stat.h>                 // mkdir(), mkdirat()
+#include <unistd.h>                   // close(), symlinkat(), unlinkat()
+// Local includes
+#include "devops_code.h"              // remove_a_tree(), resolve_to_repo(), SKID_REPO_NAME
+#include "skid_dir_operations.h"      // walk_dir(), skidDirEntry
+#include "skid_file_metadata_read.h"  // get_file_meta_at(), get_meta_file_type()
+#include "skid_macros.h"              // ENOERR
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+// Enough 40 character names that their getdents64() records (64 bytes each) overflow even the
+// largest getdents64() buffer, so reading them takes several calls
+#define MANY_ENTRIES 20000
+#define DEEP_NAME_LEN 250          // Length of each directory name in the deep tree
+#define DEEP_MAX_LEVELS 32         // Deepest the deep tree can get
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+// A tally of the entries a walk visited
+typedef struct _walkTally
+{
+    size_t num_entries;   // Number of entries visited
+    size_t num_dirs;      // Number of DT_DIR entries visited
+    size_t num_links;     // Number of DT_LNK entries visited
+    size_t max_depth;     // Deepest entry visited
+    size_t max_path_len;  // Longest path visited
+    int *seen;            // [Optional] Number of times each numbered entry was visited
+    char *prune_name;     // [Optional] Return SKID_WALK_PRUNE for entries with this name
+    size_t stop_after;    // [Optional] Return SKID_WALK_STOP once this many entries are visited
+    bool check_meta;      // [Optional] Check each entry's get_file_meta_at() snapshot
+    size_t num_metas;     // Number of entries whose snapshot matched their type
+} walkTally;
+
+// Mirrors the internal getdents64() record (see: getdents64(2))
+typedef struct _skidDirent64
+{
+    uint64_t d_ino;           // Inode number
+    int64_t d_off;            // Offset to the next record
+    unsigned short d_reclen;  // Size of this record, padding included
+    unsigned char d_type;     // File type (DT_*)
+    char d_name[];            // Nul-terminated filename
+} skidDirent64, *skidDirent64_ptr;
+
+char *test_dir_path;                // Heap array with the test directory resolved to the repo
+int deep_fds[DEEP_MAX_LEVELS + 1];  // Directory file descriptors, test_dir_path on down
+int deep_levels;                    // Number of deep directories created beneath test_dir_path
+char deep_name[DEEP_NAME_LEN + 1];  // The name of every deep directory
+char deep_file[NAME_MAX + 1];       // The name of the file in the deepest directory, if any
+
+/*
+ *  Internal skid_dir_operations function.  Only hidden in release builds.  There's no way to
+ *  make a filesystem report DT_UNKNOWN on demand so the fstatat() fallback is tested directly.
+ */
+unsigned char get_dirent_type(int dir_fd, skidDirent64_ptr direntp);
+
+/*
+ *  Create a chain of DEEP_NAME_LEN directories beneath test_dir_path until a file name of at
+ *  most 253 characters brings a path to PATH_MAX - 1 characters.  Returns that name length.
+ */
+size_t make_deep_tree(void);
+
+/*
+ *  Create MANY_ENTRIES files, named "NNNNN_fff...", 40 characters each, in test_dir_path.
+ */
+void make_many_entries(void);
+
+/*
+ *  Create a file, named with name_len copies of fill, in the deepest deep directory.
+ */
+void make_deep_file(size_t name_len, char fill);
+
+/*
+ *  Create a small tree in test_dir_path: top.txt, sub/, sub/a.txt, sub/inner/, sub/inner/b.txt,
+ *  and link, a symbolic link to sub.
+ */
+void make_small_tree(void);
+
+/*
+ *  Create an empty test directory.
+ */
+void setup(void);
+
+/*
+ *  DirVisitor that counts each entry in the walkTally context.  Entries named with a number
+ *  are also counted in the tally's seen array.  If the tally asks, takes a snapshot of each
+ *  entry relative to its parent's file descriptor.  Prunes or stops as the tally asks.
+ */
+skidWalkAction tally_entry(const skidDirEntry *entry, void *context);
+
+/*
+ *  Delete the test directory and everything in it, including a deep tree.
+ */
+void teardown(void);
+
+
+size_t make_deep_tree(void)
+{
+    // LOCAL VARIABLES
+    size_t base_len = strlen(test_dir_path) + 1;  // Length of a deep directory's path plus '/'
+
+    // MAKE IT
+    // Paths this long can't be used whole so create each directory relative to its parent
+    memset(deep_name, 'd', DEEP_NAME_LEN);
+    while ((PATH_MAX - 1 - base_len) > 253)
+    {
+        ck_assert_int_lt(deep_levels, DEEP_MAX_LEVELS);
+        ck_assert_int_eq(0, mkdirat(deep_fds[deep_levels], deep_name, 0755));
+        deep_fds[deep_levels + 1] = openat(deep_fds[deep_levels], deep_name,
+                                           O_RDONLY | O_DIRECTORY);
+        ck_assert_int_ne(-1, deep_fds[deep_levels + 1]);
+        deep_levels++;
+        base_len += DEEP_NAME_LEN + 1;
+    }
+
+    // DONE
+    return PATH_MAX - 1 - base_len;
+}
+
+
+void make_deep_file(size_t name_len, char fill)
+{
+    // LOCAL VARIABLES
+    int fd = -1;  // File descriptor for the new file
+
+    // MAKE IT
+    ck_assert_int_le(name_len, NAME_MAX);
+    memset(deep_file, fill, name_len);
+    deep_file[name_len] = '\0';
+    fd = openat(deep_fds[deep_levels], deep_file, O_CREAT | O_WRONLY, 0644);
+    ck_assert_int_ne(-1, fd);
+    close(fd);
+}
+
+
+void make_many_entries(void)
+{
+    // LOCAL VARIABLES
+    char name[64] = { 0 };  // The filename
+    int fd = -1;            // File descriptor for a new file
+
+    // MAKE THEM
+    for (int i = 0; i < MANY_ENTRIES; i++)
+    {
+        snprintf(name, sizeof(name), "%05d_fffffffffffffffffffffffffffffffffff", i);
+        fd = openat(deep_fds[0], name, O_CREAT | O_WRONLY, 0644);
+        ck_assert_int_ne(-1, fd);
+        close(fd);
+    }
+}
+
+
+void make_small_tree(void)
+{
+    // LOCAL VARIABLES
+    const char *files[] = { "top.txt", "sub/a.txt", "sub/inner/b.txt" };  // Files to create
+    int fd = -1;                                                           // A new file
+
+    // MAKE IT
+    ck_assert_int_eq(0, mkdirat(deep_fds[0], "sub", 0755));
+    ck_assert_int_eq(0, mkdirat(deep_fds[0], "sub/inner", 0755));
+    for (size_t i = 0; i < sizeof(files) / sizeof(*files); i++)
+    {
+        fd = openat(deep_fds[0], files[i], O_CREAT | O_WRONLY, 0644);
+        ck_assert_int_ne(-1, fd);
+        close(fd);
+    }
+    ck_assert_int_eq(0, symlinkat("sub", deep_fds[0], "link"));
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sdo_walk_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    remove_a_tree(test_dir_path, true);  // Leftovers from a previous run
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    deep_levels = 0;
+    deep_file[0] = '\0';
+    deep_fds[0] = open(test_dir_path, O_RDONLY | O_DIRECTORY);
+    ck_assert_int_ne(-1, deep_fds[0]);
+}
+
+
+skidWalkAction tally_entry(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    walkTally *tally = (walkTally *)context;  // The tally to update
+    int index = -1;                           // The number an entry is named with
+    skidFileMeta meta;                        // The entry's metadata snapshot
+    int errnum = CANARY_INT;                  // Errno from get_meta_file_type()
+
+    // TALLY IT
+    tally->num_entries++;
+    if (DT_DIR == entry->type)
+    {
+        tally->num_dirs++;
+    }
+    else if (DT_LNK == entry->type)
+    {
+        tally->num_links++;
+    }
+    if (entry->depth > tally->max_depth)
+    {
+        tally->max_depth = entry->depth;
+    }
+    if (entry->path_len > tally->max_path_len)
+    {
+        tally->max_path_len = entry->path_len;
+    }
+    ck_assert_int_eq(entry->path_len, strlen(entry->path));
+    ck_assert_ptr_eq(entry->path + entry->path_len - strlen(entry->name), entry->name);
+    if (NULL != tally->seen && 1 == sscanf(entry->name, "%d_", &index))
+    {
+        ck_assert(index >= 0 && index < MANY_ENTRIES);
+        tally->seen[index]++;
+    }
+    if (true == tally->check_meta)
+    {
+        ck_assert_int_eq(0, get_file_meta_at(entry->dir_fd, entry->name, SKID_META_TYPE, false,
+                                             &meta));
+        ck_assert_int_eq(DTTOIF(entry->type), get_meta_file_type(&meta, &errnum));
+        ck_assert_int_eq(0, errnum);
+        tally->num_metas++;
+    }
+
+    // DONE
+    if (tally->stop_after > 0 && tally->num_entries >= tally->stop_after)
+    {
+        return SKID_WALK_STOP;
+    }
+    if (NULL != tally->prune_name && 0 == strcmp(tally->prune_name, entry->name))
+    {
+        return SKID_WALK_PRUNE;
+    }
+    return SKID_WALK_CONTINUE;
+}
+
+
+void teardown(void)
+{
+    // The deep tree is too deep for remove_a_tree() so unwind it one directory at a time
+    if ('\0' != deep_file[0])
+    {
+        unlinkat(deep_fds[deep_levels], deep_file, 0);
+    }
+    for (int i = deep_levels; i > 0; i--)
+    {
+        close(deep_fds[i]);
+        unlinkat(deep_fds[i - 1], deep_name, AT_REMOVEDIR);
+    }
+    close(deep_fds[0]);
+    remove_a_tree(test_dir_path, true);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_empty_dir)
+{
+    walkTally tally = { 0 };  // Entries visited
+
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(0, tally.num_entries);
+}
+END_TEST
+
+
+START_TEST(test_n02_prune)
+{
+    walkTally tally = { .prune_name = "sub" };  // Entries visited
+
+    // sub is reported but a.txt, inner, and b.txt are skipped
+    make_small_tree();
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(3, tally.num_entries);
+    ck_assert_int_eq(1, tally.num_dirs);
+    ck_assert_int_eq(1, tally.max_depth);
+}
+END_TEST
+
+
+START_TEST(test_n03_stop)
+{
+    walkTally tally = { .stop_after = 2 };  // Entries visited
+
+    make_small_tree();
+    ck_assert_int_eq(ENOERR, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(2, tally.num_entries);
+}
+END_TEST
+
+
+START_TEST(test_n04_max_depth_one)
+{
+    walkTally tally = { 0 };  // Entries visited
+
+    // Only top.txt, sub, and link
+    make_small_tree();
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 1, tally_entry, &tally));
+    ck_assert_int_eq(3, tally.num_entries);
+    ck_assert_int_eq(1, tally.max_depth);
+}
+END_TEST
+
+
+START_TEST(test_n05_entry_meta_at)
+{
+    walkTally tally = { .check_meta = true };  // Entries visited
+
+    // top.txt, sub, sub/a.txt, sub/inner, sub/inner/b.txt, and link, found by name in dir_fd
+    make_small_tree();
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(6, tally.num_entries);
+    ck_assert_int_eq(6, tally.num_metas);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_path_too_long)
+{
+    walkTally tally = { 0 };             // Entries visited
+    size_t near_len = make_deep_tree();  // Filename length that reaches PATH_MAX - 1
+
+    // One character past the walker's PATH_MAX limit
+    make_deep_file(near_len + 2, 'x');
+    ck_assert_int_eq(ENAMETOOLONG, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(deep_levels, tally.num_dirs);  // Every directory was still visited
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    walkTally tally = { 0 };  // Entries visited
+
+    ck_assert_int_eq(EINVAL, walk_dir(NULL, 0, tally_entry, &tally));
+    ck_assert_int_eq(EINVAL, walk_dir("", 0, tally_entry, &tally));
+    ck_assert_int_eq(EINVAL, walk_dir(test_dir_path, 0, NULL, &tally));
+    ck_assert_int_eq(ENOENT, walk_dir("/this/dir/does/not/exist", 0, tally_entry, &tally));
+    ck_assert_int_eq(0, tally.num_entries);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_many_getdents_calls)
+{
+    walkTally tally = { 0 };                        // Entries visited
+    int *seen = calloc(MANY_ENTRIES, sizeof(int));  // Number of times each entry was visited
+
+    ck_assert_ptr_nonnull(seen);
+    tally.seen = seen;
+    make_many_entries();
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(MANY_ENTRIES, tally.num_entries);
+    for (int i = 0; i < MANY_ENTRIES; i++)
+    {
+        ck_assert_msg(1 == seen[i], "Entry %d was visited %d times", i, seen[i]);
+    }
+    free(seen);
+}
+END_TEST
+
+
+START_TEST(test_b02_path_near_path_max)
+{
+    walkTally tally = { 0 };             // Entries visited
+    size_t near_len = make_deep_tree();  // Filename length that reaches PATH_MAX - 1
+
+    make_deep_file(near_len, 'n');
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(deep_levels + 1, tally.num_entries);
+    ck_assert_int_eq(deep_levels, tally.num_dirs);
+    ck_assert_int_eq(deep_levels + 1, tally.max_depth);
+    ck_assert_int_eq(PATH_MAX - 1, tally.max_path_len);
+}
+END_TEST
+
+
+START_TEST(test_b03_path_at_path_max)
+{
+    walkTally tally = { 0 };             // Entries visited
+    size_t near_len = make_deep_tree();  // Filename length that reaches PATH_MAX - 1
+
+    // The working path buffer holds PATH_MAX characters plus the nul terminator
+    make_deep_file(near_len + 1, 'n');
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(PATH_MAX, tally.max_path_len);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_dt_unknown_fallback)
+{
+    // LOCAL VARIABLES
+    // One getdents64() record (uint64_t keeps it aligned)
+    uint64_t record_buff[(sizeof(skidDirent64) + NAME_MAX + 1) / sizeof(uint64_t) + 1] = { 0 };
+    skidDirent64_ptr record = (skidDirent64_ptr)record_buff;  // A record without a d_type
+    int fd = -1;                                              // File descriptor
+
+    // SETUP
+    fd = openat(deep_fds[0], "file.txt", O_CREAT | O_WRONLY, 0644);
+    ck_assert_int_ne(-1, fd);
+    close(fd);
+    ck_assert_int_eq(0, mkdirat(deep_fds[0], "sub_dir", 0755));
+    ck_assert_int_eq(0, symlinkat("sub_dir", deep_fds[0], "link"));
+    record->d_type = DT_UNKNOWN;  // As some filesystems report every entry
+
+    // TEST
+    snprintf(record->d_name, NAME_MAX + 1, "%s", "file.txt");
+    ck_assert_int_eq(DT_REG, get_dirent_type(deep_fds[0], record));
+    snprintf(record->d_name, NAME_MAX + 1, "%s", "sub_dir");
+    ck_assert_int_eq(DT_DIR, get_dirent_type(deep_fds[0], record));
+    snprintf(record->d_name, NAME_MAX + 1, "%s", "link");
+    ck_assert_int_eq(DT_LNK, get_dirent_type(deep_fds[0], record));  // Not followed
+    snprintf(record->d_name, NAME_MAX + 1, "%s", "missing");
+    ck_assert_int_eq(DT_UNKNOWN, get_dirent_type(deep_fds[0], record));
+    // A d_type that's reported is trusted
+    record->d_type = DT_FIFO;
+    ck_assert_int_eq(DT_FIFO, get_dirent_type(deep_fds[0], record));
+    ck_assert_int_eq(DT_UNKNOWN, get_dirent_type(deep_fds[0], NULL));
+}
+END_TEST
+
+
+START_TEST(test_s02_symlinked_dir)
+{
+    walkTally tally = { 0 };  // Entries visited
+
+    // link is reported, as a link, but not descended into (that would add three more entries)
+    make_small_tree();
+    ck_assert_int_eq(0, walk_dir(test_dir_path, 0, tally_entry, &tally));
+    ck_assert_int_eq(6, tally.num_entries);
+    ck_assert_int_eq(2, tally.num_dirs);
+    ck_assert_int_eq(1, tally.num_links);
+    ck_assert_int_eq(3, tally.max_depth);
+}
+END_TEST
+
+
+Suite *walk_dir_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SDO_Walk_Dir");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+    tcase_set_timeout(tc_core, 60);  // Creating MANY_ENTRIES files takes a moment
+
+    tcase_add_test(tc_core, test_n01_empty_dir);
+    tcase_add_test(tc_core, test_n02_prune);
+    tcase_add_test(tc_core, test_n03_stop);
+    tcase_add_test(tc_core, test_n04_max_depth_one);
+    tcase_add_test(tc_core, test_n05_entry_meta_at);
+    tcase_add_test(tc_core, test_e01_path_too_long);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_b01_many_getdents_calls);
+    tcase_add_test(tc_core, test_b02_path_near_path_max);
+    tcase_add_test(tc_core, test_b03_path_at_path_max);
+    tcase_add_test(tc_core, test_s01_dt_unknown_fallback);
+    tcase_add_test(tc_core, test_s02_symlinked_dir);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sdo_walk_dir.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = walk_dir_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,358 @@
+/*
+ *  Check unit test suit for skid_dir_operations.h's walk_dir_parallel() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sdo_walk_dir_parallel.bin
+code/dist/check_sdo_walk_dir_parallel.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sdo_walk_dir_parallel.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // O_DIRECTORY
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <dirent.h>                   // opendir(), readdir()
+#include <errno.h>                    // EINVAL, ENOENT
+#include <fcntl.h>                    // open(), O_DIRECTORY
+#include <stdatomic.h>                // atomic_fetch_add(), atomic_int
+#include <stdio.h>                    // sscanf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // strerror()
+#include <sys/stat.h>                 // mkdir()
+#include <unistd.h>                   // close()
+// Local includes
+#include "devops_code.h"              /* make_a_tree(), remove_a_tree(), resolve_to_repo(),
+                                         SKID_REPO_NAME */
+#include "skid_dir_operations.h"      // walk_dir_parallel(), skidDirEntry
+#include "skid_macros.h"              // ENOERR
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TREE_WIDTH 8               // Number of sub-directories in each directory
+#define TREE_DEPTH 3               // Number of sub-directory levels
+#define TREE_FILES 4               // Number of files in each directory
+// Every directory in the tree, beneath dirname
+#define TREE_DIRS (TREE_WIDTH + TREE_WIDTH * TREE_WIDTH + TREE_WIDTH * TREE_WIDTH * TREE_WIDTH)
+// Every entry in the tree: each directory, and dirname, holds TREE_FILES files
+#define TREE_ENTRIES (TREE_DIRS + (TREE_DIRS + 1) * TREE_FILES)
+#define NUM_THREADS 4              // Number of workers for the parallel walks
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+// A tally of the entries a parallel walk visited
+typedef struct _parallelTally
+{
+    atomic_int seen[TREE_ENTRIES];             // Number of times each entry was visited
+    size_t per_worker[SKID_WALK_MAX_THREADS];  // Number of entries each worker visited
+    atomic_int num_entries;                    // Entries visited by every worker
+    atomic_int num_strays;                     // Entries visited by an out-of-range worker
+    int stop_after;                            // [Optional] SKID_WALK_STOP after this many
+} parallelTally;
+
+char *test_dir_path;  // Heap array with the test directory resolved to the repo
+
+/*
+ *  Count the file descriptors this process has open.
+ */
+int count_open_fds(void);
+
+/*
+ *  Create the test directory and fill it with make_a_tree().
+ */
+void setup(void);
+
+/*
+ *  DirVisitor that counts each entry, and the worker that visited it, in the parallelTally
+ *  context.  Stops the walk once stop_after entries have been visited.
+ */
+skidWalkAction tally_entry(const skidDirEntry *entry, void *context);
+
+/*
+ *  Delete the test directory and everything in it.
+ */
+void teardown(void);
+
+
+int count_open_fds(void)
+{
+    // LOCAL VARIABLES
+    int count = 0;                        // Number of open file descriptors
+    DIR *dir = opendir("/proc/self/fd");  // This process' file descriptors
+    struct dirent *entry = NULL;          // One file descriptor
+
+    // COUNT THEM
+    ck_assert_ptr_nonnull(dir);
+    while (NULL != (entry = readdir(dir)))
+    {
+        if ('.' != entry->d_name[0])
+        {
+            count++;
+        }
+    }
+    closedir(dir);
+
+    // DONE
+    return count;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;    // Errno from the function call
+    int dir_fd = -1;            // File descriptor for the test directory
+    unsigned int num_made = 0;  // Number of entries make_a_tree() created
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sdo_parallel_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    remove_a_tree(test_dir_path, true);  // Leftovers from a previous run
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    dir_fd = open(test_dir_path, O_RDONLY | O_DIRECTORY);
+    ck_assert_int_ne(-1, dir_fd);
+    errnum = make_a_tree(dir_fd, TREE_FILES, TREE_WIDTH, TREE_DEPTH, &num_made);
+    ck_assert_msg(0 == errnum, "make_a_tree() failed with [%d] %s", errnum, strerror(errnum));
+    close(dir_fd);
+    ck_assert_int_eq(TREE_ENTRIES, num_made);
+}
+
+
+skidWalkAction tally_entry(const skidDirEntry *entry, void *context)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = (parallelTally *)context;  // The tally to update
+    int index = -1;                                   // The number the entry is named with
+    int visited = 0;                                  // Entries visited, this one included
+
+    // TALLY IT
+    visited = atomic_fetch_add(&(tally->num_entries), 1) + 1;
+    if (1 == sscanf(entry->name, "e%d", &index) && index >= 0 && index < TREE_ENTRIES)
+    {
+        atomic_fetch_add(&(tally->seen[index]), 1);
+    }
+    // Each worker only touches its own counter
+    if (entry->worker < SKID_WALK_MAX_THREADS)
+    {
+        tally->per_worker[entry->worker]++;
+    }
+    else
+    {
+        atomic_fetch_add(&(tally->num_strays), 1);
+    }
+
+    // DONE
+    if (tally->stop_after > 0 && visited >= tally->stop_after)
+    {
+        return SKID_WALK_STOP;
+    }
+    return SKID_WALK_CONTINUE;
+}
+
+
+void teardown(void)
+{
+    remove_a_tree(test_dir_path, true);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_every_entry_once)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+    size_t total = 0;                                         // Sum of every worker's visits
+    int busy_workers = 0;                                     // Workers that visited anything
+
+    // TEST
+    ck_assert_ptr_nonnull(tally);
+    ck_assert_int_eq(0, walk_dir_parallel(test_dir_path, 0, NUM_THREADS, tally_entry, tally));
+    ck_assert_int_eq(TREE_ENTRIES, atomic_load(&(tally->num_entries)));
+    for (int i = 0; i < TREE_ENTRIES; i++)
+    {
+        ck_assert_msg(1 == atomic_load(&(tally->seen[i])), "Entry e%05d was visited %d times",
+                      i, atomic_load(&(tally->seen[i])));
+    }
+    ck_assert_int_eq(0, atomic_load(&(tally->num_strays)));
+    for (int i = 0; i < SKID_WALK_MAX_THREADS; i++)
+    {
+        if (i >= NUM_THREADS)
+        {
+            ck_assert_int_eq(0, tally->per_worker[i]);  // Only num_threads workers
+        }
+        total += tally->per_worker[i];
+        busy_workers += (tally->per_worker[i] > 0) ? 1 : 0;
+    }
+    ck_assert_int_eq(TREE_ENTRIES, total);
+    ck_assert_int_ge(busy_workers, 1);
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+START_TEST(test_n02_one_thread)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+
+    // TEST
+    ck_assert_ptr_nonnull(tally);
+    ck_assert_int_eq(0, walk_dir_parallel(test_dir_path, 0, 1, tally_entry, tally));
+    ck_assert_int_eq(TREE_ENTRIES, atomic_load(&(tally->num_entries)));
+    ck_assert_int_eq(TREE_ENTRIES, tally->per_worker[0]);
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+START_TEST(test_n03_stop)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+    int fds_before = count_open_fds();                        // Open file descriptors
+
+    // TEST
+    // Visits already underway finish, but the walk ends well short of the whole tree
+    ck_assert_ptr_nonnull(tally);
+    tally->stop_after = 10;
+    ck_assert_int_eq(ENOERR, walk_dir_parallel(test_dir_path, 0, NUM_THREADS, tally_entry,
+                                               tally));
+    ck_assert_int_ge(atomic_load(&(tally->num_entries)), 10);
+    ck_assert_int_lt(atomic_load(&(tally->num_entries)), TREE_ENTRIES);
+    ck_assert_int_eq(fds_before, count_open_fds());
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+START_TEST(test_n04_max_depth_one)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+
+    // TEST
+    ck_assert_ptr_nonnull(tally);
+    ck_assert_int_eq(0, walk_dir_parallel(test_dir_path, 1, NUM_THREADS, tally_entry, tally));
+    ck_assert_int_eq(TREE_FILES + TREE_WIDTH, atomic_load(&(tally->num_entries)));
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_args)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+    int fds_before = count_open_fds();                        // Open file descriptors
+
+    // TEST
+    ck_assert_ptr_nonnull(tally);
+    ck_assert_int_eq(EINVAL, walk_dir_parallel(NULL, 0, NUM_THREADS, tally_entry, tally));
+    ck_assert_int_eq(EINVAL, walk_dir_parallel("", 0, NUM_THREADS, tally_entry, tally));
+    ck_assert_int_eq(EINVAL, walk_dir_parallel(test_dir_path, 0, NUM_THREADS, NULL, tally));
+    ck_assert_int_eq(ENOENT, walk_dir_parallel("/this/dir/does/not/exist", 0, NUM_THREADS,
+                                               tally_entry, tally));
+    ck_assert_int_eq(0, atomic_load(&(tally->num_entries)));
+    ck_assert_int_eq(fds_before, count_open_fds());
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_too_many_threads)
+{
+    // LOCAL VARIABLES
+    parallelTally *tally = calloc(1, sizeof(parallelTally));  // Entries visited
+    int fds_before = count_open_fds();                        // Open file descriptors
+
+    // TEST
+    // Capped at SKID_WALK_MAX_THREADS workers
+    ck_assert_ptr_nonnull(tally);
+    ck_assert_int_eq(0, walk_dir_parallel(test_dir_path, 0, SKID_WALK_MAX_THREADS * 4,
+                                          tally_entry, tally));
+    ck_assert_int_eq(TREE_ENTRIES, atomic_load(&(tally->num_entries)));
+    ck_assert_int_eq(0, atomic_load(&(tally->num_strays)));
+    ck_assert_int_eq(fds_before, count_open_fds());
+
+    // CLEANUP
+    free(tally);
+}
+END_TEST
+
+
+Suite *walk_dir_parallel_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SDO_Walk_Dir_Parallel");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+    tcase_set_timeout(tc_core, 60);  // A hung walk fails instead of blocking forever
+
+    tcase_add_test(tc_core, test_n01_every_entry_once);
+    tcase_add_test(tc_core, test_n02_one_thread);
+    tcase_add_test(tc_core, test_n03_stop);
+    tcase_add_test(tc_core, test_n04_max_depth_one);
+    tcase_add_test(tc_core, test_e01_bad_args);
+    tcase_add_test(tc_core, test_b01_too_many_threads);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sdo_walk_dir_parallel.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = walk_dir_parallel_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,422 @@
+/*
+ *  Check unit test suit for skid_file_control.h's lock session functions and lock counters:
+ *  begin_lock_session(), end_lock_session(), get_lock_stats(), read_lock_session(),
+ *  seek_lock_session(), and write_lock_session().
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfc_begin_lock_session.bin && \
+code/dist/check_sfc_begin_lock_session.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfc_begin_lock_session.bin
+
+ *
+ *  The test cases have been split up by normal, error, boundary, and special (NEBS).
+ *  Execute this command to run just one NEBS category:
+ *
+
+export CK_RUN_CASE="Normal" && ./code/dist/check_sfc_begin_lock_session.bin; unset CK_RUN_CASE  # Just run the Normal test cases
+export CK_RUN_CASE="Error" && ./code/dist/check_sfc_begin_lock_session.bin; unset CK_RUN_CASE  # Just run the Error test cases
+
+ *
+ */
+
+#include <check.h>                      // START_TEST(), END_TEST
+#include <errno.h>                      // EAGAIN, EINVAL, EPERM
+#include <fcntl.h>                      // F_RDLCK, F_WRLCK, O_CREAT, O_RDWR
+#include <pthread.h>                    // pthread_create(), pthread_join()
+#include <stdlib.h>                     // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                     // strcmp()
+#include <unistd.h>                     // lseek(), unlink(), usleep()
+// Local includes
+#include "devops_code.h"                // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_control.h"          // begin_lock_session(), SKID_AUTO_LOCK_SESSION
+#include "skid_file_descriptors.h"      // close_fd(), open_fd(), read_fd(), write_fd()
+#include "skid_memory.h"                // free_skid_mem(), SKID_AUTO_FREE_CHAR
+#include "unit_test_code.h"             // CANARY_INT
+
+
+/**************************************************************************************************/
+/************************************ HELPER CODE DECLARATION *************************************/
+/**************************************************************************************************/
+
+
+char *session_file_path;  // Heap array with this suite's scratch file resolved to the repo
+
+
+/*
+ *  Create the Check test suite.
+ */
+Suite *create_test_suite(void);
+
+/*
+ *  Open session_file_path, read/write, with its own open file description.
+ */
+int open_session_fd(void);
+
+/*
+ *  Thread start routine: sleep for a twentieth of a second and then release the whole file on
+ *  the file descriptor arg points to.
+ */
+void *release_soon(void *arg);
+
+/*
+ *  Create session_file_path holding "0000" and zero the lock counters.
+ */
+void session_setup(void);
+
+/*
+ *  Delete session_file_path.
+ */
+void session_teardown(void);
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+
+
+START_TEST(test_n01_read_modify_write)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;        // Errno from the function calls
+    int fd = open_session_fd();     // The updater
+    int other = open_session_fd();  // Someone else
+    skidLockStats stats = { 0 };    // Lock counters
+
+    // TEST START
+    {
+        SKID_AUTO_LOCK_SESSION skidLockSession session = SKID_LOCK_SESSION_INIT;
+        ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_WRLCK, 0, 0, &session));
+        SKID_AUTO_FREE_CHAR char *record = read_lock_session(&session, &errnum);
+        ck_assert_int_eq(ENOERR, errnum);
+        ck_assert_str_eq("0000", record);
+        record[3] = '1';
+        ck_assert_int_eq(ENOERR, seek_lock_session(&session, 0, SEEK_SET, NULL));
+        ck_assert_int_eq(ENOERR, write_lock_session(&session, record));
+        ck_assert_int_eq(EAGAIN, try_range_lock(other, F_RDLCK, 0, 1));  // Still held
+    }
+    // The session went out of scope so the lock is gone
+    ck_assert_int_eq(ENOERR, try_range_lock(other, F_RDLCK, 0, 0));
+    SKID_AUTO_FREE_CHAR char *updated = read_fd(other, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_str_eq("0001", updated);
+    ck_assert_int_eq(ENOERR, get_lock_stats(&stats, false));
+    ck_assert_int_eq(2, stats.acquired);  // The session and the final try
+    ck_assert_int_eq(1, stats.contended);
+
+    // CLEANUP
+    close_fd(&fd, true);
+    close_fd(&other, true);
+}
+END_TEST
+
+
+START_TEST(test_n02_seek_reports_offset)
+{
+    // LOCAL VARIABLES
+    int fd = open_session_fd();                        // The reader
+    off_t offset = -1;                                 // New offset
+    skidLockSession session = SKID_LOCK_SESSION_INIT;  // Read lock session
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_RDLCK, 0, 4, &session));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, -1, SEEK_END, &offset));
+    ck_assert_int_eq(3, offset);
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+    ck_assert_int_eq(SKID_BAD_FD, session.fd);
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+START_TEST(test_n03_contention_is_counted)
+{
+    // LOCAL VARIABLES
+    int holder = open_session_fd();  // Holds the lock
+    int waiter = open_session_fd();  // Waits for the lock
+    pthread_t thread;                // Releases holder's lock
+    skidLockStats stats = { 0 };     // Lock counters
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, get_range_lock(holder, F_WRLCK, 0, 0));
+    ck_assert_int_eq(0, pthread_create(&thread, NULL, release_soon, &holder));
+    ck_assert_int_eq(ENOERR, get_range_lock(waiter, F_WRLCK, 0, 0));
+    ck_assert_int_eq(0, pthread_join(thread, NULL));
+    ck_assert_int_eq(ENOERR, get_lock_stats(&stats, true));
+    ck_assert_int_eq(2, stats.acquired);
+    ck_assert_int_eq(1, stats.contended);
+    ck_assert_msg(stats.wait_ns > 0, "No time was spent waiting");
+    // Reading with reset zeroed them
+    ck_assert_int_eq(ENOERR, get_lock_stats(&stats, false));
+    ck_assert_int_eq(0, stats.acquired);
+    ck_assert_int_eq(0, stats.contended);
+    ck_assert_int_eq(0, stats.wait_ns);
+
+    // CLEANUP
+    close_fd(&holder, true);
+    close_fd(&waiter, true);
+}
+END_TEST
+
+
+START_TEST(test_n04_read_stays_in_range)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                           // Errno from the function calls
+    int fd = open_session_fd();                        // The reader
+    char *contents = NULL;                             // Contents read from the session
+    skidLockSession session = SKID_LOCK_SESSION_INIT;  // Read lock session
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, write_fd(fd, "0123"));
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_RDLCK, 1, 2, &session));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 1, SEEK_SET, NULL));
+    // Stops at the end of the locked range, not EOF
+    contents = read_lock_session(&session, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_str_eq("12", contents);
+    free_skid_mem((void **)&contents);
+    // Nothing locked is left
+    contents = read_lock_session(&session, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_str_eq("", contents);
+    free_skid_mem((void **)&contents);
+    // Before the locked range
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 0, SEEK_SET, NULL));
+    ck_assert_ptr_null(read_lock_session(&session, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+    // A range past EOF stops at EOF
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_RDLCK, 2, 100, &session));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 2, SEEK_SET, NULL));
+    contents = read_lock_session(&session, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_str_eq("23", contents);
+    free_skid_mem((void **)&contents);
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+START_TEST(test_n05_write_stays_in_range)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                           // Errno from the function calls
+    int fd = open_session_fd();                        // The writer
+    char *contents = NULL;                             // The file's contents
+    skidLockSession session = SKID_LOCK_SESSION_INIT;  // Write lock session
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, write_fd(fd, "0123"));
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_WRLCK, 1, 2, &session));
+    // Exactly fills the locked range
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 1, SEEK_SET, NULL));
+    ck_assert_int_eq(ENOERR, write_lock_session(&session, "ab"));
+    // Runs past the end of the locked range
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 2, SEEK_SET, NULL));
+    ck_assert_int_eq(EINVAL, write_lock_session(&session, "xy"));
+    // Starts before, and after, the locked range
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 0, SEEK_SET, NULL));
+    ck_assert_int_eq(EINVAL, write_lock_session(&session, "x"));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 4, SEEK_SET, NULL));
+    ck_assert_int_eq(EINVAL, write_lock_session(&session, "x"));
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+    // Everything from start on is locked
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_WRLCK, 3, 0, &session));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 3, SEEK_SET, NULL));
+    ck_assert_int_eq(ENOERR, write_lock_session(&session, "3456"));
+    ck_assert_int_eq(ENOERR, seek_lock_session(&session, 0, SEEK_SET, NULL));
+    contents = read_lock_session(&session, &errnum);
+    ck_assert_ptr_null(contents);  // Offset 0 is before the locked range
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+    // Only the writes inside the range landed
+    ck_assert_int_eq(0, lseek(fd, 0, SEEK_SET));
+    contents = read_fd(fd, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_str_eq("0ab3456", contents);
+    free_skid_mem((void **)&contents);
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+
+
+START_TEST(test_e01_null_pointers)
+{
+    skidLockSession session = SKID_LOCK_SESSION_INIT;  // Never begun
+    ck_assert_int_eq(EINVAL, begin_lock_session(STDIN_FILENO, F_RDLCK, 0, 0, NULL));
+    ck_assert_int_eq(EINVAL, get_lock_stats(NULL, false));
+    ck_assert_int_eq(ENOERR, end_lock_session(NULL));  // Harmless
+    ck_assert_int_eq(EINVAL, write_lock_session(NULL, "1"));
+    ck_assert_int_eq(EINVAL, seek_lock_session(&session, 0, SEEK_SET, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e02_write_under_read_lock)
+{
+    // LOCAL VARIABLES
+    int fd = open_session_fd();  // The reader
+    // Read lock session, ended automatically
+    SKID_AUTO_LOCK_SESSION skidLockSession session = SKID_LOCK_SESSION_INIT;
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_RDLCK, 0, 0, &session));
+    ck_assert_int_eq(EPERM, write_lock_session(&session, "1"));
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+START_TEST(test_e03_ended_session)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                           // Errno from the function call
+    int fd = open_session_fd();                        // The writer
+    skidLockSession session = SKID_LOCK_SESSION_INIT;  // Write lock session
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, begin_lock_session(fd, F_WRLCK, 0, 0, &session));
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));  // Ending twice is harmless
+    ck_assert_int_eq(EINVAL, write_lock_session(&session, "1"));
+    ck_assert_ptr_null(read_lock_session(&session, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+START_TEST(test_e04_failed_begin)
+{
+    skidLockSession session = { .fd = CANARY_INT };  // Garbage
+    ck_assert_int_eq(EINVAL, begin_lock_session(STDIN_FILENO, F_UNLCK, 0, 0, &session));
+    ck_assert_int_eq(SKID_BAD_FD, session.fd);  // Safe to end
+    ck_assert_int_eq(ENOERR, end_lock_session(&session));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************* HELPER CODE DEFINITION *************************************/
+/**************************************************************************************************/
+
+
+Suite *create_test_suite(void)
+{
+    // LOCAL VARIABLES
+    Suite *suite = suite_create("SFC_Begin_Lock_Session");  // Test suite
+    TCase *tc_normal = tcase_create("Normal");                // Normal test cases
+    TCase *tc_error = tcase_create("Error");                  // Error test cases
+
+    // SETUP TEST CASES
+    tcase_add_checked_fixture(tc_normal, session_setup, session_teardown);
+    tcase_add_checked_fixture(tc_error, session_setup, session_teardown);
+    tcase_add_test(tc_normal, test_n01_read_modify_write);
+    tcase_add_test(tc_normal, test_n02_seek_reports_offset);
+    tcase_add_test(tc_normal, test_n03_contention_is_counted);
+    tcase_add_test(tc_normal, test_n04_read_stays_in_range);
+    tcase_add_test(tc_normal, test_n05_write_stays_in_range);
+    tcase_add_test(tc_error, test_e01_null_pointers);
+    tcase_add_test(tc_error, test_e02_write_under_read_lock);
+    tcase_add_test(tc_error, test_e03_ended_session);
+    tcase_add_test(tc_error, test_e04_failed_begin);
+    suite_add_tcase(suite, tc_normal);
+    suite_add_tcase(suite, tc_error);
+
+    return suite;
+}
+
+
+int open_session_fd(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                                  // Errno from the function call
+    int fd = open_fd(session_file_path, O_RDWR, 0, &errnum);  // File descriptor to lock
+
+    // VALIDATION
+    ck_assert_msg(ENOERR == errnum, "open_fd(%s) failed with [%d] %s", session_file_path, errnum,
+                  strerror(errnum));
+    return fd;
+}
+
+
+void *release_soon(void *arg)
+{
+    usleep(50000);
+    release_range_lock(*(int *)arg, 0, 0);
+    return NULL;
+}
+
+
+void session_setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = SKID_BAD_FD;     // File descriptor for session_file_path
+    skidLockStats stats;      // Discarded lock counters
+
+    // SETUP
+    session_file_path = resolve_to_repo(SKID_REPO_NAME,
+                                        "./code/test/test_output/sfc_lock_session.txt", false,
+                                        &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    fd = open_fd(session_file_path, O_CREAT | O_WRONLY | O_TRUNC, 0644, &errnum);
+    ck_assert_int_eq(ENOERR, errnum);
+    ck_assert_int_eq(ENOERR, write_fd(fd, "0000"));
+    close_fd(&fd, true);
+    get_lock_stats(&stats, true);
+}
+
+
+void session_teardown(void)
+{
+    unlink(session_file_path);
+    free_devops_mem((void **)&session_file_path);
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfc_begin_lock_session.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = create_test_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
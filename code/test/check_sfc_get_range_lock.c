@@ -0,0 +1,341 @@
+/*
+ *  Check unit test suit for skid_file_control.h's OFD range lock functions: get_range_lock(),
+ *  get_range_lock_timed(), release_range_lock(), and try_range_lock().
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfc_get_range_lock.bin && \
+code/dist/check_sfc_get_range_lock.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfc_get_range_lock.bin
+
+ *
+ *  The test cases have been split up by normal, error, boundary, and special (NEBS).
+ *  Execute this command to run just one NEBS category:
+ *
+
+export CK_RUN_CASE="Normal" && ./code/dist/check_sfc_get_range_lock.bin; unset CK_RUN_CASE  # Just run the Normal test cases
+export CK_RUN_CASE="Error" && ./code/dist/check_sfc_get_range_lock.bin; unset CK_RUN_CASE  # Just run the Error test cases
+export CK_RUN_CASE="Special" && ./code/dist/check_sfc_get_range_lock.bin; unset CK_RUN_CASE  # Just run the Special test cases
+
+ *
+ */
+
+#include <check.h>                      // START_TEST(), END_TEST
+#include <errno.h>                      // EAGAIN, EINVAL, ETIMEDOUT
+#include <fcntl.h>                      // F_RDLCK, F_WRLCK, O_RDWR
+#include <pthread.h>                    // pthread_create(), pthread_join()
+#include <stdlib.h>                     // EXIT_FAILURE, EXIT_SUCCESS
+#include <time.h>                       // clock_gettime()
+#include <unistd.h>                     // usleep()
+// Local includes
+#include "devops_code.h"                // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_control.h"          // get_range_lock(), try_range_lock()
+#include "skid_file_descriptors.h"      // close_fd(), open_fd()
+#include "skid_macros.h"                // SKID_BAD_FD
+#include "unit_test_code.h"             // CANARY_INT, globals, setup(), teardown()
+
+
+/**************************************************************************************************/
+/************************************ HELPER CODE DECLARATION *************************************/
+/**************************************************************************************************/
+
+
+/*
+ *  Create the Check test suite.
+ */
+Suite *create_test_suite(void);
+
+/*
+ *  Open test_file_path, read/write, with its own open file description.
+ */
+int open_lock_fd(void);
+
+/*
+ *  Thread start routine: sleep for a tenth of a second and then release the whole file on the
+ *  file descriptor arg points to.
+ */
+void *release_later(void *arg);
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+
+
+START_TEST(test_n01_disjoint_write_locks)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // One writer
+    int fd_b = open_lock_fd();  // Another writer
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, get_range_lock(fd_a, F_WRLCK, 0, 4));
+    ck_assert_int_eq(ENOERR, get_range_lock(fd_b, F_WRLCK, 4, 4));
+    ck_assert_int_eq(ENOERR, release_range_lock(fd_a, 0, 4));
+    ck_assert_int_eq(ENOERR, release_range_lock(fd_b, 4, 4));
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+START_TEST(test_n02_overlapping_write_locks)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // One writer
+    int fd_b = open_lock_fd();  // Another writer
+
+    // TEST START
+    // Unlike process-associated locks, OFD locks conflict within the same process
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_a, F_WRLCK, 0, 8));
+    ck_assert_int_eq(EAGAIN, try_range_lock(fd_b, F_WRLCK, 4, 8));
+    ck_assert_int_eq(EAGAIN, try_range_lock(fd_b, F_RDLCK, 0, 1));
+    ck_assert_int_eq(ENOERR, release_range_lock(fd_a, 0, 8));
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_b, F_WRLCK, 4, 8));
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+START_TEST(test_n03_shared_read_locks)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // One reader
+    int fd_b = open_lock_fd();  // Another reader
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_a, F_RDLCK, 0, 0));
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_b, F_RDLCK, 0, 0));
+    ck_assert_int_eq(EAGAIN, try_range_lock(fd_b, F_WRLCK, 0, 0));  // fd_a's lock conflicts
+
+    // CLEANUP
+    close_fd(&fd_a, true);  // Also releases the locks
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+START_TEST(test_n04_timed_lock_acquired)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // The holder
+    int fd_b = open_lock_fd();  // The waiter
+    pthread_t thread;           // Releases fd_a's lock
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, get_range_lock(fd_a, F_WRLCK, 0, 0));
+    ck_assert_int_eq(0, pthread_create(&thread, NULL, release_later, &fd_a));
+    ck_assert_int_eq(ENOERR, get_range_lock_timed(fd_b, F_WRLCK, 0, 0, 5000));
+    ck_assert_int_eq(0, pthread_join(thread, NULL));
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+START_TEST(test_n05_timed_lock_times_out)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();       // The holder
+    int fd_b = open_lock_fd();       // The waiter
+    struct timespec before = { 0 };  // Before the timed lock
+    struct timespec after = { 0 };   // After the timed lock
+    long elapsed_ms = 0;             // Milliseconds spent waiting
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, get_range_lock(fd_a, F_WRLCK, 10, 10));
+    clock_gettime(CLOCK_MONOTONIC, &before);
+    ck_assert_int_eq(ETIMEDOUT, get_range_lock_timed(fd_b, F_RDLCK, 15, 1, 100));
+    clock_gettime(CLOCK_MONOTONIC, &after);
+    elapsed_ms = (after.tv_sec - before.tv_sec) * 1000
+                 + (after.tv_nsec - before.tv_nsec) / 1000000;
+    ck_assert_msg(elapsed_ms >= 100, "Gave up after %ld ms", elapsed_ms);
+    ck_assert_int_eq(ETIMEDOUT, get_range_lock_timed(fd_b, F_RDLCK, 15, 1, 0));  // One try
+    ck_assert_int_eq(ENOERR, get_range_lock_timed(fd_b, F_RDLCK, 20, 1, 0));  // No conflict
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+
+
+START_TEST(test_e01_bad_fd)
+{
+    ck_assert_int_eq(EBADF, get_range_lock(SKID_BAD_FD, F_WRLCK, 0, 0));
+    ck_assert_int_eq(EBADF, try_range_lock(SKID_BAD_FD, F_WRLCK, 0, 0));
+    ck_assert_int_eq(EBADF, release_range_lock(SKID_BAD_FD, 0, 0));
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_lock_type)
+{
+    // LOCAL VARIABLES
+    int fd = open_lock_fd();  // File descriptor to lock
+
+    // TEST START
+    ck_assert_int_eq(EINVAL, get_range_lock(fd, F_UNLCK, 0, 0));
+    ck_assert_int_eq(EINVAL, try_range_lock(fd, F_UNLCK, 0, 0));
+    ck_assert_int_eq(EINVAL, get_range_lock_timed(fd, (short)CANARY_INT, 0, 0, 10));
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+START_TEST(test_e03_negative_range)
+{
+    // LOCAL VARIABLES
+    int fd = open_lock_fd();  // File descriptor to lock
+
+    // TEST START
+    ck_assert_int_eq(EINVAL, get_range_lock(fd, F_WRLCK, -1, 0));
+    ck_assert_int_eq(EINVAL, try_range_lock(fd, F_WRLCK, 0, -1));
+    ck_assert_int_eq(EINVAL, release_range_lock(fd, -1, -1));
+
+    // CLEANUP
+    close_fd(&fd, true);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+
+
+START_TEST(test_s01_dup_shares_locks)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // The original
+    int fd_b = dup(fd_a);       // Shares fd_a's open file description
+
+    // TEST START
+    ck_assert_int_ne(-1, fd_b);
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_a, F_WRLCK, 0, 0));
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_b, F_WRLCK, 0, 0));  // Same owner, no conflict
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+START_TEST(test_s02_partial_release_splits)
+{
+    // LOCAL VARIABLES
+    int fd_a = open_lock_fd();  // One writer
+    int fd_b = open_lock_fd();  // Another writer
+
+    // TEST START
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_a, F_WRLCK, 0, 30));
+    ck_assert_int_eq(ENOERR, release_range_lock(fd_a, 10, 10));
+    ck_assert_int_eq(ENOERR, try_range_lock(fd_b, F_WRLCK, 10, 10));
+    ck_assert_int_eq(EAGAIN, try_range_lock(fd_b, F_WRLCK, 0, 1));
+    ck_assert_int_eq(EAGAIN, try_range_lock(fd_b, F_WRLCK, 29, 1));
+
+    // CLEANUP
+    close_fd(&fd_a, true);
+    close_fd(&fd_b, true);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************* HELPER CODE DEFINITION *************************************/
+/**************************************************************************************************/
+
+
+Suite *create_test_suite(void)
+{
+    // LOCAL VARIABLES
+    Suite *suite = suite_create("SFC_Get_Range_Lock");  // Test suite
+    TCase *tc_normal = tcase_create("Normal");            // Normal test cases
+    TCase *tc_error = tcase_create("Error");              // Error test cases
+    TCase *tc_special = tcase_create("Special");          // Special test cases
+
+    // SETUP TEST CASES
+    tcase_add_checked_fixture(tc_normal, setup, teardown);
+    tcase_add_checked_fixture(tc_error, setup, teardown);
+    tcase_add_checked_fixture(tc_special, setup, teardown);
+    tcase_add_test(tc_normal, test_n01_disjoint_write_locks);
+    tcase_add_test(tc_normal, test_n02_overlapping_write_locks);
+    tcase_add_test(tc_normal, test_n03_shared_read_locks);
+    tcase_add_test(tc_normal, test_n04_timed_lock_acquired);
+    tcase_add_test(tc_normal, test_n05_timed_lock_times_out);
+    tcase_add_test(tc_error, test_e01_bad_fd);
+    tcase_add_test(tc_error, test_e02_bad_lock_type);
+    tcase_add_test(tc_error, test_e03_negative_range);
+    tcase_add_test(tc_special, test_s01_dup_shares_locks);
+    tcase_add_test(tc_special, test_s02_partial_release_splits);
+    suite_add_tcase(suite, tc_normal);
+    suite_add_tcase(suite, tc_error);
+    suite_add_tcase(suite, tc_special);
+
+    return suite;
+}
+
+
+int open_lock_fd(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                               // Errno from the function call
+    int fd = open_fd(test_file_path, O_RDWR, 0, &errnum);  // File descriptor to lock
+
+    // VALIDATION
+    ck_assert_msg(ENOERR == errnum, "open_fd(%s) failed with [%d] %s", test_file_path, errnum,
+                  strerror(errnum));
+    return fd;
+}
+
+
+void *release_later(void *arg)
+{
+    usleep(100000);
+    release_range_lock(*(int *)arg, 0, 0);
+    return NULL;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfc_get_range_lock.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = create_test_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,180 @@
+/*
+ *  Check unit test suit for skid_file_descriptors.h's read_fd_chunk() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfd_read_fd_chunk.bin
+code/dist/check_sfd_read_fd_chunk.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfd_read_fd_chunk.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // pipe2()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EAGAIN, EBADF, EINVAL
+#include <fcntl.h>                    // O_NONBLOCK
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp()
+#include <unistd.h>                   // pipe2(), write()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_descriptors.h"    // close_fd(), read_fd_chunk()
+
+
+#define CANARY_SIZE (size_t)0xBADC0DE  // Highlights a num_read that wasn't updated
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+int pipe_fds[2];  // Read and write ends of the test pipe
+
+/*
+ *  Create a non-blocking test pipe.
+ */
+void setup(void);
+
+/*
+ *  Close the test pipe.
+ */
+void teardown(void);
+
+
+void setup(void)
+{
+    pipe_fds[0] = SKID_BAD_FD;
+    pipe_fds[1] = SKID_BAD_FD;
+    ck_assert_int_eq(0, pipe2(pipe_fds, O_NONBLOCK));
+}
+
+
+void teardown(void)
+{
+    close_fd(&(pipe_fds[0]), true);
+    close_fd(&(pipe_fds[1]), true);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_reads_what_fits)
+{
+    char buf[4] = { 0 };            // Smaller than the data
+    size_t num_read = CANARY_SIZE;  // Number of bytes read
+
+    ck_assert_int_eq(6, write(pipe_fds[1], "ab\0def", 6));
+    ck_assert_int_eq(0, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), false, &num_read));
+    ck_assert_int_eq(4, num_read);
+    ck_assert_int_eq(0, memcmp("ab\0d", buf, 4));
+    ck_assert_int_eq(0, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), true, &num_read));
+    ck_assert_int_eq(2, num_read);
+    ck_assert_int_eq(0, memcmp("ef", buf, 2));
+}
+END_TEST
+
+
+START_TEST(test_n02_eof_stops)
+{
+    char buf[4] = { 0 };            // Nothing to read into it
+    size_t num_read = CANARY_SIZE;  // Number of bytes read
+
+    close_fd(&(pipe_fds[1]), true);
+    ck_assert_int_eq(0, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), false, &num_read));
+    ck_assert_int_eq(0, num_read);
+}
+END_TEST
+
+
+START_TEST(test_n03_eagain_after_a_read_stops)
+{
+    char buf[4] = { 0 };            // Nothing to read into it
+    size_t num_read = CANARY_SIZE;  // Number of bytes read
+
+    // The write end is still open so the pipe is merely empty
+    ck_assert_int_eq(0, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), true, &num_read));
+    ck_assert_int_eq(0, num_read);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_eagain_before_a_read)
+{
+    char buf[4] = { 0 };            // Nothing to read into it
+    size_t num_read = CANARY_SIZE;  // Number of bytes read
+
+    ck_assert_int_eq(EAGAIN, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), false, &num_read));
+    ck_assert_int_eq(0, num_read);
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    char buf[4] = { 0 };            // Buffer to read into
+    size_t num_read = CANARY_SIZE;  // Number of bytes read
+
+    ck_assert_int_eq(EBADF, read_fd_chunk(SKID_BAD_FD, buf, sizeof(buf), false, &num_read));
+    ck_assert_int_eq(EINVAL, read_fd_chunk(pipe_fds[0], NULL, sizeof(buf), false, &num_read));
+    ck_assert_int_eq(EINVAL, read_fd_chunk(pipe_fds[0], buf, 0, false, &num_read));
+    ck_assert_int_eq(EINVAL, read_fd_chunk(pipe_fds[0], buf, sizeof(buf), false, NULL));
+    ck_assert_int_eq(CANARY_SIZE, num_read);
+}
+END_TEST
+
+
+Suite *read_fd_chunk_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFD_Read_FD_Chunk");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_reads_what_fits);
+    tcase_add_test(tc_core, test_n02_eof_stops);
+    tcase_add_test(tc_core, test_n03_eagain_after_a_read_stops);
+    tcase_add_test(tc_core, test_e01_eagain_before_a_read);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfd_read_fd_chunk.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = read_fd_chunk_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
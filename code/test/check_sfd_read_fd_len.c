@@ -0,0 +1,323 @@
+/*
+ *  Check unit test suit for skid_file_descriptors.h's read_fd_len() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfd_read_fd_len.bin
+code/dist/check_sfd_read_fd_len.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfd_read_fd_len.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // pipe2()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EAGAIN, EBADF, EINVAL
+#include <fcntl.h>                    // open(), O_NONBLOCK
+#include <stdio.h>                    // remove()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp(), strerror()
+#include <unistd.h>                   // close(), pipe2(), write()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_descriptors.h"    // read_fd_len()
+#include "skid_memory.h"              // free_skid_mem()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define BIG_PAYLOAD_LEN (size_t)(1024 * 1024 + 13)  // Large enough to grow the buffer many times
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+
+/*
+ *  Read fd with read_fd_len() and verify it returned exactly exp_len bytes matching exp_data,
+ *  followed by a nul-terminator.
+ */
+void check_read(int fd, const char *exp_data, size_t exp_len);
+
+/*
+ *  Heap-allocate len bytes of binary data: every byte value, nul included, over and over.
+ */
+char *make_payload(size_t len);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test file.
+ */
+void teardown(void);
+
+/*
+ *  Write data to the test file, replacing it, and return a read-only fd for it.
+ */
+int write_test_file(const char *data, size_t data_len);
+
+
+void check_read(int fd, const char *exp_data, size_t exp_len)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                                    // Errno from the function call
+    size_t actual_len = 0xBADC0DE;                              // Number of bytes read
+    char *actual_data = read_fd_len(fd, &actual_len, &errnum);  // The contents of fd
+
+    // CHECK IT
+    ck_assert_msg(0 == errnum, "read_fd_len() failed with [%d] %s", errnum, strerror(errnum));
+    ck_assert_ptr_nonnull(actual_data);
+    ck_assert_int_eq(exp_len, actual_len);
+    ck_assert_int_eq(0, memcmp(exp_data, actual_data, exp_len));
+    ck_assert_int_eq('\0', actual_data[actual_len]);
+    free_skid_mem((void **)&actual_data);
+}
+
+
+char *make_payload(size_t len)
+{
+    // LOCAL VARIABLES
+    char *payload = malloc(len);  // The binary data
+
+    // MAKE IT
+    ck_assert_ptr_nonnull(payload);
+    for (size_t i = 0; i < len; i++)
+    {
+        payload[i] = (char)(i % 256);
+    }
+
+    // DONE
+    return payload;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfd_read_fd_len.bin",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    remove(test_file_path);  // Leftovers from a previous run
+}
+
+
+void teardown(void)
+{
+    remove(test_file_path);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+int write_test_file(const char *data, size_t data_len)
+{
+    // LOCAL VARIABLES
+    int fd = open(test_file_path, O_CREAT | O_TRUNC | O_WRONLY, 0644);  // The test file
+
+    // WRITE IT
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(data_len, write(fd, data, data_len));
+    close(fd);
+    fd = open(test_file_path, O_RDONLY);
+    ck_assert_int_ne(-1, fd);
+
+    // DONE
+    return fd;
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_text)
+{
+    char text[] = { "Just some text\n" };              // Plain string data
+    int fd = write_test_file(text, sizeof(text) - 1);  // The test file
+
+    check_read(fd, text, sizeof(text) - 1);
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_n02_embedded_nuls)
+{
+    char payload[] = { 'a', '\0', 'b', '\0', '\0', 'c', '\xFF', '\0' };  // Binary data
+    int fd = write_test_file(payload, sizeof(payload));                  // The test file
+
+    // Every byte is counted, trailing nul included
+    check_read(fd, payload, sizeof(payload));
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_n03_pipe)
+{
+    char *payload = make_payload(4096);  // Binary data
+    int pipe_fds[2] = { -1, -1 };        // Read and write ends of a pipe
+
+    // A pipe has no size to size the buffer by
+    ck_assert_int_eq(0, pipe2(pipe_fds, 0));
+    ck_assert_int_eq(4096, write(pipe_fds[1], payload, 4096));
+    close(pipe_fds[1]);
+    check_read(pipe_fds[0], payload, 4096);
+    close(pipe_fds[0]);
+    free(payload);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_args)
+{
+    int errnum = CANARY_INT;        // Errno from the function call
+    size_t actual_len = 0xBADC0DE;  // Number of bytes read
+
+    ck_assert_ptr_null(read_fd_len(-1, &actual_len, &errnum));
+    ck_assert_int_eq(EBADF, errnum);
+    ck_assert_int_eq(0, actual_len);
+    errnum = CANARY_INT;
+    ck_assert_ptr_null(read_fd_len(STDIN_FILENO, NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    actual_len = 0xBADC0DE;
+    ck_assert_ptr_null(read_fd_len(STDIN_FILENO, &actual_len, NULL));
+    ck_assert_int_eq(0, actual_len);
+}
+END_TEST
+
+
+START_TEST(test_e02_empty_nonblocking_pipe)
+{
+    int errnum = CANARY_INT;        // Errno from the function call
+    size_t actual_len = 0xBADC0DE;  // Number of bytes read
+    int pipe_fds[2] = { -1, -1 };   // Read and write ends of a pipe
+
+    // Nothing was ever read so EAGAIN is an error
+    ck_assert_int_eq(0, pipe2(pipe_fds, O_NONBLOCK));
+    ck_assert_ptr_null(read_fd_len(pipe_fds[0], &actual_len, &errnum));
+    ck_assert_int_eq(EAGAIN, errnum);
+    ck_assert_int_eq(0, actual_len);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_empty_file)
+{
+    int fd = write_test_file("", 0);  // The test file
+
+    check_read(fd, "", 0);
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_b02_one_nul)
+{
+    int fd = write_test_file("", 1);  // The test file
+
+    check_read(fd, "", 1);
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_b03_big_binary_file)
+{
+    char *payload = make_payload(BIG_PAYLOAD_LEN);       // Binary data
+    int fd = write_test_file(payload, BIG_PAYLOAD_LEN);  // The test file
+
+    check_read(fd, payload, BIG_PAYLOAD_LEN);
+    close(fd);
+    free(payload);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_partial_nonblocking_read)
+{
+    char *payload = make_payload(512);  // Binary data
+    int pipe_fds[2] = { -1, -1 };       // Read and write ends of a pipe
+
+    // The write end stays open so the read ends with EAGAIN, after reading what was there
+    ck_assert_int_eq(0, pipe2(pipe_fds, O_NONBLOCK));
+    ck_assert_int_eq(512, write(pipe_fds[1], payload, 512));
+    check_read(pipe_fds[0], payload, 512);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    free(payload);
+}
+END_TEST
+
+
+Suite *read_fd_len_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFD_Read_FD_Len");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_text);
+    tcase_add_test(tc_core, test_n02_embedded_nuls);
+    tcase_add_test(tc_core, test_n03_pipe);
+    tcase_add_test(tc_core, test_e01_bad_args);
+    tcase_add_test(tc_core, test_e02_empty_nonblocking_pipe);
+    tcase_add_test(tc_core, test_b01_empty_file);
+    tcase_add_test(tc_core, test_b02_one_nul);
+    tcase_add_test(tc_core, test_b03_big_binary_file);
+    tcase_add_test(tc_core, test_s01_partial_nonblocking_read);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfd_read_fd_len.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = read_fd_len_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,455 @@
+/*
+ *  Check unit test suit for skid_file_descriptors.h's write_fd_v() function (and read_fd_v(),
+ *  its scatter read counterpart).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfd_write_fd_v.bin
+code/dist/check_sfd_write_fd_v.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfd_write_fd_v.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // IOV_MAX
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EBADF, EINVAL
+#include <fcntl.h>                    // open()
+#include <limits.h>                   // IOV_MAX
+#include <pthread.h>                  // pthread_create(), pthread_join()
+#include <stdio.h>                    // remove()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp(), strerror()
+#include <sys/uio.h>                  // struct iovec
+#include <unistd.h>                   // close(), pipe()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_descriptors.h"    // read_fd_len(), read_fd_v(), write_fd_v()
+#include "skid_memory.h"              // free_skid_mem()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define MANY_IOVECS (IOV_MAX * 3 + 7)  // Enough iovecs to need several IOV_MAX-sized batches
+#define PIPE_PAYLOAD_LEN (size_t)(256 * 1024)  // More than a pipe holds at once
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+// The reading end of a pipe and everything read from it
+typedef struct _pipeReader
+{
+    int fd;      // File descriptor to read until EOF
+    char *data;  // Heap-allocated contents read from fd
+    size_t len;  // Number of bytes in data
+    int errnum;  // Errno value from read_fd_len()
+} pipeReader;
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+
+/*
+ *  Verify the test file holds exactly exp_len bytes matching exp_data.
+ */
+void check_test_file(const char *exp_data, size_t exp_len);
+
+/*
+ *  Fill count iovecs, with lengths cycling through 0 to 4 bytes, from one heap-allocated
+ *  buffer of binary data.  Returns the buffer and stores its length in total_len.
+ */
+char *make_iovecs(struct iovec *iov, int count, size_t *total_len);
+
+/*
+ *  Open the test file with flags.
+ */
+int open_test_file(int flags);
+
+/*
+ *  Thread start routine that reads a pipeReader's fd until EOF.
+ */
+void *read_pipe(void *reader);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test file.
+ */
+void teardown(void);
+
+
+void check_test_file(const char *exp_data, size_t exp_len)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;            // Errno from the function call
+    size_t actual_len = 0;              // Number of bytes read
+    char *actual_data = NULL;           // The contents of the test file
+    int fd = open_test_file(O_RDONLY);  // The test file
+
+    // CHECK IT
+    actual_data = read_fd_len(fd, &actual_len, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(exp_len, actual_len);
+    ck_assert_int_eq(0, memcmp(exp_data, actual_data, exp_len));
+    free_skid_mem((void **)&actual_data);
+    close(fd);
+}
+
+
+char *make_iovecs(struct iovec *iov, int count, size_t *total_len)
+{
+    // LOCAL VARIABLES
+    char *data = malloc(count * 4 + 1);  // Binary data for every iovec
+    size_t len = 0;                      // Number of bytes handed out
+
+    // MAKE THEM
+    ck_assert_ptr_nonnull(data);
+    for (int i = 0; i < count; i++)
+    {
+        iov[i].iov_base = data + len;
+        iov[i].iov_len = i % 5;
+        for (size_t j = 0; j < iov[i].iov_len; j++)
+        {
+            data[len++] = (char)((i + j) % 256);
+        }
+    }
+
+    // DONE
+    *total_len = len;
+    return data;
+}
+
+
+int open_test_file(int flags)
+{
+    // LOCAL VARIABLES
+    int fd = open(test_file_path, flags, 0644);  // The test file
+
+    // DONE
+    ck_assert_int_ne(-1, fd);
+    return fd;
+}
+
+
+void *read_pipe(void *reader)
+{
+    // LOCAL VARIABLES
+    pipeReader *pipe_reader = (pipeReader *)reader;  // The pipe to read
+
+    // READ IT
+    pipe_reader->data = read_fd_len(pipe_reader->fd, &(pipe_reader->len), &(pipe_reader->errnum));
+
+    // DONE
+    return NULL;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfd_write_fd_v.bin",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    remove(test_file_path);  // Leftovers from a previous run
+}
+
+
+void teardown(void)
+{
+    remove(test_file_path);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_framed_write)
+{
+    // LOCAL VARIABLES
+    char header[] = { 'H', 'D', 'R', '\0' };                // Frame header, nul included
+    char payload[] = { 'a', '\0', 'b', '\0', 'c' };         // Frame payload
+    char trailer[] = { '\0', 'E', 'N', 'D' };               // Frame trailer
+    // Header, payload, and trailer back to back
+    char expected[] = { 'H', 'D', 'R', '\0', 'a', '\0', 'b', '\0', 'c', '\0', 'E', 'N', 'D' };
+    // The frame, in three pieces
+    struct iovec iov[] = { { header, sizeof(header) }, { payload, sizeof(payload) },
+                           { trailer, sizeof(trailer) } };
+    size_t bytes_written = 0;                               // Number of bytes written
+    int fd = open_test_file(O_CREAT | O_TRUNC | O_WRONLY);  // The test file
+
+    // TEST
+    ck_assert_int_eq(0, write_fd_v(fd, iov, 3, &bytes_written));
+    ck_assert_int_eq(sizeof(expected), bytes_written);
+    close(fd);
+    check_test_file(expected, sizeof(expected));
+}
+END_TEST
+
+
+START_TEST(test_n02_scatter_read)
+{
+    // LOCAL VARIABLES
+    char contents[] = { "HDR\0payload\0END" };              // File contents, nuls included
+    char header[4] = { 0 };                                 // Read the header into this
+    char payload[8] = { 0 };                                // Read the payload into this
+    char trailer[4] = { 0 };                                // Read the trailer into this
+    // The frame, in three pieces
+    struct iovec iov[] = { { header, sizeof(header) }, { payload, sizeof(payload) },
+                           { trailer, sizeof(trailer) } };
+    size_t bytes_read = 0;                                  // Number of bytes read
+    int fd = open_test_file(O_CREAT | O_TRUNC | O_WRONLY);  // The test file
+
+    // SETUP
+    ck_assert_int_eq(sizeof(contents) - 1, write(fd, contents, sizeof(contents) - 1));
+    close(fd);
+    fd = open_test_file(O_RDONLY);
+
+    // TEST
+    ck_assert_int_eq(0, read_fd_v(fd, iov, 3, &bytes_read));
+    ck_assert_int_eq(sizeof(contents) - 1, bytes_read);
+    ck_assert_int_eq(0, memcmp("HDR\0", header, 4));
+    ck_assert_int_eq(0, memcmp("payload\0", payload, 8));
+    ck_assert_int_eq(0, memcmp("END", trailer, 3));
+    close(fd);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_args)
+{
+    char buff[4] = { "abc" };        // Data to write
+    struct iovec iov = { buff, 3 };  // One buffer
+    size_t num_bytes = 0xBADC0DE;    // Number of bytes read or written
+
+    ck_assert_int_eq(EBADF, write_fd_v(-1, &iov, 1, &num_bytes));
+    ck_assert_int_eq(0, num_bytes);
+    ck_assert_int_eq(EINVAL, write_fd_v(STDOUT_FILENO, NULL, 1, NULL));
+    ck_assert_int_eq(EINVAL, write_fd_v(STDOUT_FILENO, &iov, 0, NULL));
+    ck_assert_int_eq(EINVAL, write_fd_v(STDOUT_FILENO, &iov, -1, NULL));
+    ck_assert_int_eq(EBADF, read_fd_v(-1, &iov, 1, &num_bytes));
+    ck_assert_int_eq(EINVAL, read_fd_v(STDIN_FILENO, NULL, 1, &num_bytes));
+    ck_assert_int_eq(EINVAL, read_fd_v(STDIN_FILENO, &iov, 0, &num_bytes));
+    ck_assert_int_eq(EINVAL, read_fd_v(STDIN_FILENO, &iov, 1, NULL));  // Not optional
+}
+END_TEST
+
+
+START_TEST(test_e02_wrong_direction)
+{
+    char buff[4] = { "abc" };                     // Data to write
+    struct iovec iov = { buff, 3 };               // One buffer
+    size_t num_bytes = 0xBADC0DE;                 // Number of bytes read or written
+    int fd = open_test_file(O_CREAT | O_RDONLY);  // Read-only test file
+
+    ck_assert_int_eq(EBADF, write_fd_v(fd, &iov, 1, &num_bytes));
+    ck_assert_int_eq(0, num_bytes);
+    close(fd);
+    fd = open_test_file(O_WRONLY);
+    num_bytes = 0xBADC0DE;
+    ck_assert_int_eq(EBADF, read_fd_v(fd, &iov, 1, &num_bytes));
+    ck_assert_int_eq(0, num_bytes);
+    close(fd);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_more_than_iov_max)
+{
+    // LOCAL VARIABLES
+    struct iovec *iov = calloc(MANY_IOVECS, sizeof(struct iovec));       // Buffers to write
+    struct iovec *read_iov = calloc(MANY_IOVECS, sizeof(struct iovec));  // Buffers to read into
+    size_t total_len = 0;                                                // Bytes in every iovec
+    char *data = NULL;                                                   // Data to write
+    char *read_data = NULL;                                              // Data read back
+    size_t num_bytes = 0;                                                // Bytes read or written
+    int fd = -1;                                                         // The test file
+
+    // SETUP
+    ck_assert_ptr_nonnull(iov);
+    ck_assert_ptr_nonnull(read_iov);
+    data = make_iovecs(iov, MANY_IOVECS, &total_len);
+    read_data = calloc(total_len + 1, 1);
+    ck_assert_ptr_nonnull(read_data);
+    for (int i = 0; i < MANY_IOVECS; i++)
+    {
+        read_iov[i].iov_base = read_data + ((char *)iov[i].iov_base - data);
+        read_iov[i].iov_len = iov[i].iov_len;
+    }
+
+    // TEST
+    // Written in batches
+    fd = open_test_file(O_CREAT | O_TRUNC | O_WRONLY);
+    ck_assert_int_eq(0, write_fd_v(fd, iov, MANY_IOVECS, &num_bytes));
+    ck_assert_int_eq(total_len, num_bytes);
+    close(fd);
+    check_test_file(data, total_len);
+    // Read back in batches
+    fd = open_test_file(O_RDONLY);
+    num_bytes = 0;
+    ck_assert_int_eq(0, read_fd_v(fd, read_iov, MANY_IOVECS, &num_bytes));
+    ck_assert_int_eq(total_len, num_bytes);
+    ck_assert_int_eq(0, memcmp(data, read_data, total_len));
+    close(fd);
+
+    // CLEANUP
+    free(data);
+    free(read_data);
+    free(iov);
+    free(read_iov);
+}
+END_TEST
+
+
+START_TEST(test_b02_all_empty_iovecs)
+{
+    char buff[1] = { 0 };                                             // Never touched
+    struct iovec iov[3] = { { buff, 0 }, { buff, 0 }, { buff, 0 } };  // Nothing to do
+    size_t num_bytes = 0xBADC0DE;                                     // Bytes read or written
+    int fd = open_test_file(O_CREAT | O_TRUNC | O_RDWR);              // The test file
+
+    ck_assert_int_eq(0, write_fd_v(fd, iov, 3, &num_bytes));
+    ck_assert_int_eq(0, num_bytes);
+    num_bytes = 0xBADC0DE;
+    ck_assert_int_eq(0, read_fd_v(fd, iov, 3, &num_bytes));
+    ck_assert_int_eq(0, num_bytes);
+    close(fd);
+    check_test_file("", 0);
+}
+END_TEST
+
+
+START_TEST(test_b03_short_read_at_eof)
+{
+    char first[4] = { 0 };                                                // Filled
+    char second[16] = { 0 };                                              // Partially filled
+    char third[8] = { "unused" };                                         // Untouched
+    struct iovec iov[] = { { first, 4 }, { second, 16 }, { third, 8 } };  // Larger than the file
+    size_t num_bytes = 0;                                                 // Bytes read
+    int fd = open_test_file(O_CREAT | O_TRUNC | O_WRONLY);                // The test file
+
+    ck_assert_int_eq(7, write(fd, "1234567", 7));
+    close(fd);
+    fd = open_test_file(O_RDONLY);
+    ck_assert_int_eq(0, read_fd_v(fd, iov, 3, &num_bytes));  // EOF isn't an error
+    ck_assert_int_eq(7, num_bytes);
+    ck_assert_int_eq(0, memcmp("1234", first, 4));
+    ck_assert_int_eq(0, memcmp("567", second, 3));
+    ck_assert_str_eq("unused", third);
+    close(fd);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_pipe_larger_than_buffer)
+{
+    // LOCAL VARIABLES
+    char *data = malloc(PIPE_PAYLOAD_LEN);  // Data to write
+    size_t quarter = PIPE_PAYLOAD_LEN / 4;  // Length of each iovec
+    struct iovec iov[4] = { { 0 } };        // Four quarters of data
+    int pipe_fds[2] = { -1, -1 };           // Read and write ends of a pipe
+    pipeReader reader = { 0 };              // Reads the pipe
+    pthread_t reader_thread;                // Runs read_pipe()
+    size_t num_bytes = 0;                   // Bytes written
+
+    // SETUP
+    ck_assert_ptr_nonnull(data);
+    for (size_t i = 0; i < PIPE_PAYLOAD_LEN; i++)
+    {
+        data[i] = (char)(i % 251);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        iov[i].iov_base = data + i * quarter;
+        iov[i].iov_len = quarter;
+    }
+    ck_assert_int_eq(0, pipe(pipe_fds));
+    reader.fd = pipe_fds[0];
+    ck_assert_int_eq(0, pthread_create(&reader_thread, NULL, read_pipe, &reader));
+
+    // TEST
+    // The pipe fills up so the writer can only finish as the reader drains it
+    ck_assert_int_eq(0, write_fd_v(pipe_fds[1], iov, 4, &num_bytes));
+    ck_assert_int_eq(PIPE_PAYLOAD_LEN, num_bytes);
+    close(pipe_fds[1]);
+    ck_assert_int_eq(0, pthread_join(reader_thread, NULL));
+    ck_assert_int_eq(0, reader.errnum);
+    ck_assert_int_eq(PIPE_PAYLOAD_LEN, reader.len);
+    ck_assert_int_eq(0, memcmp(data, reader.data, PIPE_PAYLOAD_LEN));
+
+    // CLEANUP
+    close(pipe_fds[0]);
+    free_skid_mem((void **)&(reader.data));
+    free(data);
+}
+END_TEST
+
+
+Suite *write_fd_v_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFD_Write_FD_V");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_framed_write);
+    tcase_add_test(tc_core, test_n02_scatter_read);
+    tcase_add_test(tc_core, test_e01_bad_args);
+    tcase_add_test(tc_core, test_e02_wrong_direction);
+    tcase_add_test(tc_core, test_b01_more_than_iov_max);
+    tcase_add_test(tc_core, test_b02_all_empty_iovecs);
+    tcase_add_test(tc_core, test_b03_short_read_at_eof);
+    tcase_add_test(tc_core, test_s01_pipe_larger_than_buffer);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfd_write_fd_v.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = write_fd_v_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,296 @@
+/*
+ *  Check unit test suit for skid_file_metadata_read.h's get_file_meta() function and its
+ *  get_meta_*() accessors.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfmr_get_file_meta.bin
+code/dist/check_sfmr_get_file_meta.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfmr_get_file_meta.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <limits.h>                   // PATH_MAX
+#include <stdio.h>                    // printf()
+#include <stdlib.h>
+#include <sys/stat.h>                 // stat()
+#include <unistd.h>                   // get_current_dir_name()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_metadata_read.h"  // get_file_meta(), get_meta_*()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+/*
+ *  Internal skid_file_metadata_read function.  Only hidden in release builds.  There's no way to
+ *  make statx() fail with ENOSYS on demand so the fstatat() fallback is tested directly.
+ */
+void store_stat(const struct stat *statbuf, skidFileMeta_ptr meta);
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_regular_file)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;  // Repo name
+    int result = CANARY_INT;                 // Return value from function call
+    int errnum = CANARY_INT;                 // Errno from the function calls
+    skidFileMeta meta;                       // Metadata snapshot
+    off_t exp_size = 0;                      // Expected size
+    uid_t exp_owner = 0;                     // Expected owner
+    time_t exp_mtime = 0;                    // Expected modification time
+    time_t seconds = 0;                      // Modification time from the snapshot
+    long nseconds = 0;                       // Modification time nanoseconds from the snapshot
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/regular_file.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    exp_size = get_shell_size(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_size() failed with [%d] %s", errnum, strerror(errnum));
+    exp_owner = get_shell_owner(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_owner() failed with [%d] %s", errnum, strerror(errnum));
+    exp_mtime = get_shell_mtime(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_mtime() failed with [%d] %s", errnum, strerror(errnum));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    result = get_file_meta(input_abs_path, SKID_META_SIZE | SKID_META_UID | SKID_META_MTIME,
+                           true, &meta);
+    ck_assert_int_eq(0, result);
+    ck_assert_msg(exp_size == get_meta_size(&meta, &errnum), "get_meta_size() returned %ld "
+                  "instead of %ld", get_meta_size(&meta, &errnum), exp_size);
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    errnum = CANARY_INT;  // Reset this temp var
+    ck_assert_int_eq(exp_owner, get_meta_owner(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    ck_assert_int_eq(0, get_meta_mod_timestamp(&meta, &seconds, &nseconds));
+    ck_assert_int_eq(exp_mtime, seconds);
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+
+    // CLEANUP
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+START_TEST(test_n02_symbolic_link_followed)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;  // Repo name
+    int errnum = CANARY_INT;                 // Errno from the function calls
+    skidFileMeta meta;                       // Metadata snapshot
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/sym_link.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta(input_abs_path, SKID_META_TYPE, true, &meta));
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+
+    // CLEANUP
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+START_TEST(test_n03_symbolic_link_not_followed)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;  // Repo name
+    int errnum = CANARY_INT;                 // Errno from the function calls
+    skidFileMeta meta;                       // Metadata snapshot
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/sym_link.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta(input_abs_path, SKID_META_TYPE, false, &meta));
+    ck_assert_int_eq(S_IFLNK, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+
+    // CLEANUP
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_pathname)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(EINVAL, get_file_meta(NULL, SKID_META_ALL, true, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e02_empty_pathname)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(EINVAL, get_file_meta("\0 NOT HERE!", SKID_META_ALL, true, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e03_null_meta)
+{
+    ck_assert_int_eq(EINVAL, get_file_meta("/dev/null", SKID_META_ALL, true, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e04_accessor_null_meta)
+{
+    int errnum = CANARY_INT;  // Errno from the function call
+    time_t seconds = 0;       // Timestamp seconds
+    long nseconds = 0;        // Timestamp nanoseconds
+    ck_assert_int_eq(0, get_meta_size(NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(EINVAL, get_meta_mod_timestamp(NULL, &seconds, &nseconds));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_missing_pathname)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(ENOENT, get_file_meta("/does/not/exist.txt", SKID_META_ALL, true, &meta));
+}
+END_TEST
+
+
+START_TEST(test_s02_field_not_in_snapshot)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    skidFileMeta meta;        // Metadata snapshot
+    time_t seconds = 0;       // Timestamp seconds
+    long nseconds = 0;        // Timestamp nanoseconds
+
+    ck_assert_int_eq(0, get_file_meta("/dev/null", SKID_META_SIZE, true, &meta));
+    meta.mask = SKID_META_SIZE;  // The filesystem may have volunteered more
+    ck_assert_int_eq(0, get_meta_owner(&meta, &errnum));
+    ck_assert_int_eq(ENODATA, errnum);
+    ck_assert_int_eq(ENODATA, get_meta_access_timestamp(&meta, &seconds, &nseconds));
+    // These fields are always there
+    errnum = CANARY_INT;  // Reset this temp var
+    get_meta_file_device_id(&meta, &errnum);
+    ck_assert_int_eq(0, errnum);
+}
+END_TEST
+
+
+START_TEST(test_s03_fstatat_fallback)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    struct stat stat_struct;  // stat() results
+    skidFileMeta exp_meta;    // Snapshot taken by statx()
+    skidFileMeta meta;        // Snapshot translated from stat_struct
+    time_t seconds = 0;       // Timestamp seconds
+    long nseconds = 0;        // Timestamp nanoseconds
+
+    ck_assert_int_eq(0, get_file_meta("/dev/null", SKID_META_BASIC, true, &exp_meta));
+    ck_assert_int_eq(0, stat("/dev/null", &stat_struct));
+    store_stat(&stat_struct, &meta);
+    ck_assert_int_eq(SKID_META_BASIC, meta.mask);
+    ck_assert_int_eq(get_meta_file_type(&exp_meta, &errnum), get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(get_meta_serial_num(&exp_meta, &errnum), get_meta_serial_num(&meta, &errnum));
+    ck_assert_int_eq(get_meta_owner(&exp_meta, &errnum), get_meta_owner(&meta, &errnum));
+    ck_assert_int_eq(get_meta_container_device_id(&exp_meta, &errnum),
+                     get_meta_container_device_id(&meta, &errnum));
+    ck_assert_int_eq(get_meta_file_device_id(&exp_meta, &errnum),
+                     get_meta_file_device_id(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);
+    // stat has no birth time
+    ck_assert_int_eq(ENODATA, get_meta_birth_timestamp(&meta, &seconds, &nseconds));
+}
+END_TEST
+
+
+Suite *get_file_meta_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFMR_Get_File_Meta");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    tcase_add_test(tc_core, test_n01_regular_file);
+    tcase_add_test(tc_core, test_n02_symbolic_link_followed);
+    tcase_add_test(tc_core, test_n03_symbolic_link_not_followed);
+    tcase_add_test(tc_core, test_e01_null_pathname);
+    tcase_add_test(tc_core, test_e02_empty_pathname);
+    tcase_add_test(tc_core, test_e03_null_meta);
+    tcase_add_test(tc_core, test_e04_accessor_null_meta);
+    tcase_add_test(tc_core, test_s01_missing_pathname);
+    tcase_add_test(tc_core, test_s02_field_not_in_snapshot);
+    tcase_add_test(tc_core, test_s03_fstatat_fallback);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfmr_get_file_meta.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = get_file_meta_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,244 @@
+/*
+ *  Check unit test suit for skid_file_metadata_read.h's get_file_meta_at() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfmr_get_file_meta_at.bin
+code/dist/check_sfmr_get_file_meta_at.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfmr_get_file_meta_at.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EBADF, EINVAL, ENOENT, ENOTDIR
+#include <fcntl.h>                    // AT_FDCWD, open(), O_DIRECTORY
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // strerror()
+#include <unistd.h>                   // close()
+// Local includes
+#include "devops_code.h"              // get_shell_size(), resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_metadata_read.h"  // get_file_meta_at(), get_meta_*()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_dir_path;   // Heap array with the test input directory resolved to the repo
+char *test_file_path;  // Heap array with the test input regular file resolved to the repo
+int test_dir_fd;       // File descriptor for test_dir_path
+
+/*
+ *  Resolve the test input directory and regular file to the repo and open the directory.
+ */
+void setup(void);
+
+/*
+ *  Close the test input directory and free the heap memory arrays.
+ */
+void teardown(void);
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_input", true, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_input/regular_file.txt",
+                                     true, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    test_dir_fd = open(test_dir_path, O_RDONLY | O_DIRECTORY);
+    ck_assert_msg(test_dir_fd > -1, "open(%s) failed with [%d] %s", test_dir_path, errno,
+                  strerror(errno));
+}
+
+
+void teardown(void)
+{
+    close(test_dir_fd);
+    test_dir_fd = -1;
+    free_devops_mem((void **)&test_dir_path);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_relative_to_dir_fd)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    skidFileMeta meta;        // Metadata snapshot
+    off_t exp_size = 0;       // Expected size
+
+    // SETUP
+    exp_size = get_shell_size(test_file_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_size() failed with [%d] %s", errnum, strerror(errnum));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_at(test_dir_fd, "regular_file.txt", SKID_META_SIZE, true,
+                                         &meta));
+    ck_assert_int_eq(exp_size, get_meta_size(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    errnum = CANARY_INT;  // Reset this temp var
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+}
+END_TEST
+
+
+START_TEST(test_n02_symbolic_link)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    skidFileMeta meta;        // Metadata snapshot
+
+    // Don't follow it
+    ck_assert_int_eq(0, get_file_meta_at(test_dir_fd, "sym_link.txt", SKID_META_TYPE, false,
+                                         &meta));
+    ck_assert_int_eq(S_IFLNK, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    errnum = CANARY_INT;  // Reset this temp var
+    // Follow it
+    ck_assert_int_eq(0, get_file_meta_at(test_dir_fd, "sym_link.txt", SKID_META_TYPE, true,
+                                         &meta));
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+}
+END_TEST
+
+
+START_TEST(test_n03_at_fdcwd)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    skidFileMeta at_meta;     // get_file_meta_at() snapshot
+    skidFileMeta path_meta;   // get_file_meta() snapshot
+    ino_t exp_ino = 0;        // Expected inode number
+
+    // SETUP
+    ck_assert_int_eq(0, get_file_meta(test_file_path, SKID_META_INO, true, &path_meta));
+    exp_ino = get_meta_serial_num(&path_meta, &errnum);
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_at(AT_FDCWD, test_file_path, SKID_META_INO, true,
+                                         &at_meta));
+    ck_assert_int_eq(exp_ino, get_meta_serial_num(&at_meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_dir_fd)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(EBADF, get_file_meta_at(-1, "regular_file.txt", SKID_META_ALL, true, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e02_null_args)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(EINVAL, get_file_meta_at(test_dir_fd, NULL, SKID_META_ALL, true, &meta));
+    ck_assert_int_eq(EINVAL, get_file_meta_at(test_dir_fd, "regular_file.txt", SKID_META_ALL,
+                                              true, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e03_missing_entry)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(ENOENT, get_file_meta_at(test_dir_fd, "not_there.txt", SKID_META_ALL, true,
+                                              &meta));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_dir_fd_not_a_dir)
+{
+    // LOCAL VARIABLES
+    skidFileMeta meta;                        // Metadata snapshot
+    int fd = open(test_file_path, O_RDONLY);  // A regular file, not a directory
+
+    // TEST START
+    ck_assert_msg(fd > -1, "open(%s) failed with [%d] %s", test_file_path, errno, strerror(errno));
+    ck_assert_int_eq(ENOTDIR, get_file_meta_at(fd, "regular_file.txt", SKID_META_ALL, true,
+                                               &meta));
+
+    // CLEANUP
+    close(fd);
+}
+END_TEST
+
+
+Suite *get_file_meta_at_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFMR_Get_File_Meta_At");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_relative_to_dir_fd);
+    tcase_add_test(tc_core, test_n02_symbolic_link);
+    tcase_add_test(tc_core, test_n03_at_fdcwd);
+    tcase_add_test(tc_core, test_e01_bad_dir_fd);
+    tcase_add_test(tc_core, test_e02_null_args);
+    tcase_add_test(tc_core, test_e03_missing_entry);
+    tcase_add_test(tc_core, test_s01_dir_fd_not_a_dir);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfmr_get_file_meta_at.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = get_file_meta_at_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,281 @@
+/*
+ *  Check unit test suit for skid_file_metadata_read.h's get_file_meta_batch() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfmr_get_file_meta_batch.bin
+code/dist/check_sfmr_get_file_meta_batch.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfmr_get_file_meta_batch.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <fcntl.h>                    // AT_FDCWD, open()
+#include <stdlib.h>
+#include <unistd.h>                   // close()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_metadata_read.h"  // get_file_meta_batch(), get_meta_*()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define NUM_MANY 1000              // Enough entries for every worker to claim several chunks
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+/*
+ *  Open the test input directory, resolved to SKID_REPO_NAME.  Fails the test on error.
+ */
+int open_test_input_dir(void);
+
+
+int open_test_input_dir(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int dir_fd = -1;          // File descriptor for the test input directory
+    // Absolute path for the test input directory as resolved against the repo name
+    char *abs_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_input/", true, &errnum);
+
+    // OPEN IT
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    dir_fd = open(abs_path, O_RDONLY | O_DIRECTORY);
+    ck_assert_msg(dir_fd > -1, "open(%s) failed with [%d] %s", abs_path, errno, strerror(errno));
+
+    // DONE
+    free_devops_mem((void **)&abs_path);
+    return dir_fd;
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_relative_to_dir_fd)
+{
+    // LOCAL VARIABLES
+    int dir_fd = open_test_input_dir();  // Resolve the pathnames against this
+    int errnum = CANARY_INT;             // Errno from the function calls
+    // Test input
+    const char *pathnames[] = { "regular_file.txt", "sym_link.txt", "does_not_exist.txt" };
+    skidFileMeta metas[3];  // Snapshots
+    // Per-entry results
+    int errnums[3] = { CANARY_INT, CANARY_INT, CANARY_INT };
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_batch(dir_fd, pathnames, 3, SKID_META_TYPE, false, 2,
+                                            metas, errnums));
+    ck_assert_int_eq(0, errnums[0]);
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(metas, &errnum));
+    ck_assert_int_eq(0, errnums[1]);
+    ck_assert_int_eq(S_IFLNK, get_meta_file_type(metas + 1, &errnum));
+    ck_assert_int_eq(ENOENT, errnums[2]);
+
+    // CLEANUP
+    close(dir_fd);
+}
+END_TEST
+
+
+START_TEST(test_n02_absolute_pathnames)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;       // Repo name
+    int errnum = CANARY_INT;                      // Errno from the function calls
+    off_t exp_size = 0;                           // Expected size
+    skidFileMeta metas[2];                        // Snapshots
+    int errnums[2] = { CANARY_INT, CANARY_INT };  // Per-entry results
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/regular_file.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+    const char *pathnames[] = { input_abs_path, "/dev/null" };  // Test input
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    exp_size = get_shell_size(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_size() failed with [%d] %s", errnum, strerror(errnum));
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_batch(AT_FDCWD, pathnames, 2, SKID_META_SIZE, true, 0,
+                                            metas, errnums));
+    ck_assert_int_eq(0, errnums[0]);
+    ck_assert_int_eq(exp_size, get_meta_size(metas, &errnum));
+    ck_assert_int_eq(0, errnums[1]);
+
+    // CLEANUP
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_pathnames)
+{
+    skidFileMeta meta;        // Snapshot
+    int errnum = CANARY_INT;  // Per-entry result
+    ck_assert_int_eq(EINVAL, get_file_meta_batch(AT_FDCWD, NULL, 1, SKID_META_ALL, true, 1,
+                                                 &meta, &errnum));
+    ck_assert_int_eq(CANARY_INT, errnum);  // No entry was attempted
+}
+END_TEST
+
+
+START_TEST(test_e02_null_metas)
+{
+    const char *pathnames[] = { "/dev/null" };  // Test input
+    int errnum = CANARY_INT;                    // Per-entry result
+    ck_assert_int_eq(EINVAL, get_file_meta_batch(AT_FDCWD, pathnames, 1, SKID_META_ALL, true, 1,
+                                                 NULL, &errnum));
+}
+END_TEST
+
+
+START_TEST(test_e03_null_errnums)
+{
+    const char *pathnames[] = { "/dev/null" };  // Test input
+    skidFileMeta meta;                          // Snapshot
+    ck_assert_int_eq(EINVAL, get_file_meta_batch(AT_FDCWD, pathnames, 1, SKID_META_ALL, true, 1,
+                                                 &meta, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e04_bad_dir_fd)
+{
+    const char *pathnames[] = { "regular_file.txt" };  // Test input
+    skidFileMeta meta;                                 // Snapshot
+    int errnum = CANARY_INT;                           // Per-entry result
+    ck_assert_int_eq(EBADF, get_file_meta_batch(-1, pathnames, 1, SKID_META_ALL, true, 1,
+                                                &meta, &errnum));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_no_entries)
+{
+    const char *pathnames[] = { "/dev/null" };  // Test input
+    skidFileMeta meta;                          // Snapshot
+    int errnum = CANARY_INT;                    // Per-entry result
+    ck_assert_int_eq(0, get_file_meta_batch(AT_FDCWD, pathnames, 0, SKID_META_ALL, true, 1,
+                                            &meta, &errnum));
+    ck_assert_int_eq(CANARY_INT, errnum);  // No entry was attempted
+}
+END_TEST
+
+
+START_TEST(test_s02_null_entry)
+{
+    const char *pathnames[] = { "/dev/null", NULL };  // Test input
+    skidFileMeta metas[2];                            // Snapshots
+    int errnums[2] = { CANARY_INT, CANARY_INT };      // Per-entry results
+    ck_assert_int_eq(0, get_file_meta_batch(AT_FDCWD, pathnames, 2, SKID_META_ALL, true, 1,
+                                            metas, errnums));
+    ck_assert_int_eq(0, errnums[0]);
+    ck_assert_int_eq(EINVAL, errnums[1]);
+}
+END_TEST
+
+
+START_TEST(test_s03_many_entries_many_threads)
+{
+    // LOCAL VARIABLES
+    int dir_fd = open_test_input_dir();  // Resolve the pathnames against this
+    int errnum = CANARY_INT;             // Errno from the function calls
+    const char *pathnames[NUM_MANY];     // Test input
+    skidFileMeta metas[NUM_MANY];        // Snapshots
+    int errnums[NUM_MANY];               // Per-entry results
+
+    // SETUP
+    for (int i = 0; i < NUM_MANY; i++)
+    {
+        pathnames[i] = (i % 2) ? "regular_file.txt" : "does_not_exist.txt";
+        errnums[i] = CANARY_INT;
+    }
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_batch(dir_fd, pathnames, NUM_MANY, SKID_META_TYPE, true, 8,
+                                            metas, errnums));
+    for (int i = 0; i < NUM_MANY; i++)
+    {
+        if (i % 2)
+        {
+            ck_assert_int_eq(0, errnums[i]);
+            ck_assert_int_eq(S_IFREG, get_meta_file_type(metas + i, &errnum));
+        }
+        else
+        {
+            ck_assert_int_eq(ENOENT, errnums[i]);
+        }
+    }
+
+    // CLEANUP
+    close(dir_fd);
+}
+END_TEST
+
+
+Suite *get_file_meta_batch_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFMR_Get_File_Meta_Batch");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    tcase_add_test(tc_core, test_n01_relative_to_dir_fd);
+    tcase_add_test(tc_core, test_n02_absolute_pathnames);
+    tcase_add_test(tc_core, test_e01_null_pathnames);
+    tcase_add_test(tc_core, test_e02_null_metas);
+    tcase_add_test(tc_core, test_e03_null_errnums);
+    tcase_add_test(tc_core, test_e04_bad_dir_fd);
+    tcase_add_test(tc_core, test_s01_no_entries);
+    tcase_add_test(tc_core, test_s02_null_entry);
+    tcase_add_test(tc_core, test_s03_many_entries_many_threads);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfmr_get_file_meta_batch.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = get_file_meta_batch_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
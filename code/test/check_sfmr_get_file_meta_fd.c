@@ -0,0 +1,197 @@
+/*
+ *  Check unit test suit for skid_file_metadata_read.h's get_file_meta_fd() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfmr_get_file_meta_fd.bin
+code/dist/check_sfmr_get_file_meta_fd.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfmr_get_file_meta_fd.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // O_PATH
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <fcntl.h>                    // open()
+#include <stdlib.h>
+#include <unistd.h>                   // close()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_metadata_read.h"  // get_file_meta_fd(), get_meta_*()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_regular_file)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;  // Repo name
+    int errnum = CANARY_INT;                 // Errno from the function calls
+    int fd = -1;                             // File descriptor for the input
+    skidFileMeta meta;                       // Metadata snapshot
+    off_t exp_size = 0;                      // Expected size
+    uid_t exp_owner = 0;                     // Expected owner
+    time_t exp_mtime = 0;                    // Expected modification time
+    time_t seconds = 0;                      // Modification time from the snapshot
+    long nseconds = 0;                       // Modification time nanoseconds from the snapshot
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/regular_file.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    exp_size = get_shell_size(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_size() failed with [%d] %s", errnum, strerror(errnum));
+    exp_owner = get_shell_owner(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_owner() failed with [%d] %s", errnum, strerror(errnum));
+    exp_mtime = get_shell_mtime(input_abs_path, &errnum);
+    ck_assert_msg(0 == errnum, "get_shell_mtime() failed with [%d] %s", errnum, strerror(errnum));
+    fd = open(input_abs_path, O_RDONLY);
+    ck_assert_msg(fd > -1, "open(%s) failed with [%d] %s", input_abs_path, errno,
+                  strerror(errno));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_fd(fd, SKID_META_SIZE | SKID_META_UID | SKID_META_MTIME,
+                                         &meta));
+    ck_assert_msg(exp_size == get_meta_size(&meta, &errnum), "get_meta_size() returned %ld "
+                  "instead of %ld", get_meta_size(&meta, &errnum), exp_size);
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    errnum = CANARY_INT;  // Reset this temp var
+    ck_assert_int_eq(exp_owner, get_meta_owner(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+    ck_assert_int_eq(0, get_meta_mod_timestamp(&meta, &seconds, &nseconds));
+    ck_assert_int_eq(exp_mtime, seconds);
+
+    // CLEANUP
+    close(fd);
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+START_TEST(test_n02_symbolic_link_opath)
+{
+    // LOCAL VARIABLES
+    const char *repo_name = SKID_REPO_NAME;  // Repo name
+    int errnum = CANARY_INT;                 // Errno from the function calls
+    int fd = -1;                             // O_PATH file descriptor for the symbolic link
+    skidFileMeta meta;                       // Metadata snapshot
+    // Relative path for this test case's input
+    char input_rel_path[] = { "./code/test/test_input/sym_link.txt" };
+    // Absolute path for input_rel_path as resolved against the repo name
+    char *input_abs_path = resolve_to_repo(repo_name, input_rel_path, true, &errnum);
+
+    // VALIDATION
+    // It is important resolve_to_repo() succeeds
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", repo_name,
+                  input_rel_path, errnum, strerror(errnum));
+    fd = open(input_abs_path, O_PATH | O_NOFOLLOW);
+    ck_assert_msg(fd > -1, "open(%s) failed with [%d] %s", input_abs_path, errno,
+                  strerror(errno));
+    errnum = CANARY_INT;  // Reset this temp var
+
+    // TEST START
+    ck_assert_int_eq(0, get_file_meta_fd(fd, SKID_META_TYPE, &meta));
+    ck_assert_int_eq(S_IFLNK, get_meta_file_type(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);  // The out param should be zeroized on success
+
+    // CLEANUP
+    close(fd);
+    free_devops_mem((void **)&input_abs_path);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_fd)
+{
+    skidFileMeta meta;  // Metadata snapshot
+    ck_assert_int_eq(EBADF, get_file_meta_fd(-1, SKID_META_ALL, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e02_null_meta)
+{
+    ck_assert_int_eq(EINVAL, get_file_meta_fd(STDIN_FILENO, SKID_META_ALL, NULL));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_closed_fd)
+{
+    // LOCAL VARIABLES
+    skidFileMeta meta;                     // Metadata snapshot
+    int fd = open("/dev/null", O_RDONLY);  // File descriptor to close before the test
+
+    // TEST START
+    ck_assert_msg(fd > -1, "open(/dev/null) failed with [%d] %s", errno, strerror(errno));
+    close(fd);
+    ck_assert_int_eq(EBADF, get_file_meta_fd(fd, SKID_META_ALL, &meta));
+}
+END_TEST
+
+
+Suite *get_file_meta_fd_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFMR_Get_File_Meta_Fd");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    tcase_add_test(tc_core, test_n01_regular_file);
+    tcase_add_test(tc_core, test_n02_symbolic_link_opath);
+    tcase_add_test(tc_core, test_e01_bad_fd);
+    tcase_add_test(tc_core, test_e02_null_meta);
+    tcase_add_test(tc_core, test_s01_closed_fd);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfmr_get_file_meta_fd.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = get_file_meta_fd_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
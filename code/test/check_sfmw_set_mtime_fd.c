@@ -0,0 +1,200 @@
+/*
+ *  Check unit test suit for skid_file_metadata_write.h's set_mtime_fd() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfmw_set_mtime_fd.bin
+code/dist/check_sfmw_set_mtime_fd.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfmw_set_mtime_fd.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                    // O_PATH
+
+#include <check.h>                     // START_TEST(), END_TEST
+#include <fcntl.h>                     // open()
+#include <stdlib.h>
+#include <unistd.h>                    // close()
+// Local includes
+#include "devops_code.h"               // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_metadata_read.h"   // get_file_meta_fd(), get_meta_mod_timestamp()
+#include "skid_file_metadata_write.h"  // set_mtime_fd(), set_times_now_fd()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TEST_SECONDS (time_t)1234567890  // An arbitrary mtime, in epoch seconds
+#define TEST_NSECONDS 123456789l         // An arbitrary mtime, in nanoseconds
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+/*
+ *  Open pathname, resolved to SKID_REPO_NAME, with flags.  Fails the test on error.
+ */
+int open_test_input(const char *pathname, int flags);
+
+/*
+ *  Call set_mtime_fd(fd), verify the results with get_file_meta_fd(), and then reset the
+ *  timestamps with set_times_now_fd().
+ */
+void run_test_case(int fd, time_t new_sec, long new_nsec, int exp_ret);
+
+
+int open_test_input(const char *pathname, int flags)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor for pathname
+    // Absolute path for pathname as resolved against the repo name
+    char *abs_path = resolve_to_repo(SKID_REPO_NAME, pathname, true, &errnum);
+
+    // OPEN IT
+    ck_assert_msg(0 == errnum, "resolve_to_repo(%s, %s) failed with [%d] %s", SKID_REPO_NAME,
+                  pathname, errnum, strerror(errnum));
+    fd = open(abs_path, flags);
+    ck_assert_msg(fd > -1, "open(%s) failed with [%d] %s", abs_path, errno, strerror(errno));
+
+    // DONE
+    free_devops_mem((void **)&abs_path);
+    return fd;
+}
+
+
+void run_test_case(int fd, time_t new_sec, long new_nsec, int exp_ret)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    skidFileMeta meta;        // Metadata snapshot
+    time_t seconds = 0;       // Modification time from the snapshot
+    long nseconds = 0;        // Modification time nanoseconds from the snapshot
+
+    // RUN IT
+    errnum = set_mtime_fd(fd, new_sec, new_nsec);
+    ck_assert_msg(exp_ret == errnum, "set_mtime_fd(%d) returned [%d] '%s' instead of [%d] '%s'",
+                  fd, errnum, strerror(errnum), exp_ret, strerror(exp_ret));
+    if (0 == exp_ret)
+    {
+        ck_assert_int_eq(0, get_file_meta_fd(fd, SKID_META_MTIME, &meta));
+        ck_assert_int_eq(0, get_meta_mod_timestamp(&meta, &seconds, &nseconds));
+        ck_assert_int_eq(new_sec, seconds);
+        ck_assert_int_eq(new_nsec, nseconds);
+        ck_assert_int_eq(0, set_times_now_fd(fd));
+    }
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_regular_file)
+{
+    int fd = open_test_input("./code/test/test_input/regular_file.txt", O_RDONLY);
+    run_test_case(fd, TEST_SECONDS, TEST_NSECONDS, 0);
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_n02_directory)
+{
+    int fd = open_test_input("./code/test/test_input/", O_RDONLY | O_DIRECTORY);
+    run_test_case(fd, TEST_SECONDS, TEST_NSECONDS, 0);
+    close(fd);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_fd)
+{
+    run_test_case(-1, TEST_SECONDS, TEST_NSECONDS, EBADF);
+}
+END_TEST
+
+
+START_TEST(test_e02_nsec_out_of_range)
+{
+    int fd = open_test_input("./code/test/test_input/regular_file.txt", O_RDONLY);
+    run_test_case(fd, TEST_SECONDS, 1000000000l, EINVAL);
+    close(fd);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_closed_fd)
+{
+    int fd = open_test_input("./code/test/test_input/regular_file.txt", O_RDONLY);
+    close(fd);
+    run_test_case(fd, TEST_SECONDS, TEST_NSECONDS, EBADF);
+}
+END_TEST
+
+
+START_TEST(test_s02_opath_fd)
+{
+    // futimens() needs a file descriptor that refers to an open file, not just a location
+    int fd = open_test_input("./code/test/test_input/regular_file.txt", O_PATH);
+    run_test_case(fd, TEST_SECONDS, TEST_NSECONDS, EBADF);
+    close(fd);
+}
+END_TEST
+
+
+Suite *set_mtime_fd_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFMW_Set_Mtime_Fd");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    tcase_add_test(tc_core, test_n01_regular_file);
+    tcase_add_test(tc_core, test_n02_directory);
+    tcase_add_test(tc_core, test_e01_bad_fd);
+    tcase_add_test(tc_core, test_e02_nsec_out_of_range);
+    tcase_add_test(tc_core, test_s01_closed_fd);
+    tcase_add_test(tc_core, test_s02_opath_fd);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfmw_set_mtime_fd.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = set_mtime_fd_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+/*
+ *  Check unit test suit for skid_file_operations.h's copy_file() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfo_copy_file.bin
+code/dist/check_sfo_copy_file.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfo_copy_file.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EEXIST, EINVAL
+#include <fcntl.h>                    // open()
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>
+#include <string.h>                   // memcmp(), strerror()
+#include <sys/stat.h>                 // mkdir(), stat()
+#include <unistd.h>                   // close(), link(), read(), rmdir(), unlink(), write()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_operations.h"     // copy_file()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TEST_CONTENTS "Some\0binary\0data\n"  // Source file's contents, embedded nuls and all
+#define TEST_CONTENTS_LEN (sizeof(TEST_CONTENTS) - 1)  // Length of TEST_CONTENTS
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_dir_path;        // Heap array with the test directory resolved to the repo
+char test_src_path[4096];   // test_dir_path + "/source.txt"
+char test_dst_path[4096];   // test_dir_path + "/destination.txt"
+char test_link_path[4096];  // test_dir_path + "/hard_link.txt"
+
+/*
+ *  Verify pathname holds exactly TEST_CONTENTS.
+ */
+void check_contents(const char *pathname);
+
+/*
+ *  Create the test directory with one source file.
+ */
+void setup(void);
+
+/*
+ *  Delete the test directory.
+ */
+void teardown(void);
+
+
+void check_contents(const char *pathname)
+{
+    // LOCAL VARIABLES
+    char buff[256] = { 0 };  // Contents of pathname
+    int fd = open(pathname, O_RDONLY);  // File descriptor for pathname
+
+    // CHECK IT
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(TEST_CONTENTS_LEN, read(fd, buff, sizeof(buff)));
+    ck_assert_int_eq(0, memcmp(TEST_CONTENTS, buff, TEST_CONTENTS_LEN));
+    close(fd);
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor for the source file
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfo_copy_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_src_path, sizeof(test_src_path), "%s/source.txt", test_dir_path);
+    snprintf(test_dst_path, sizeof(test_dst_path), "%s/destination.txt", test_dir_path);
+    snprintf(test_link_path, sizeof(test_link_path), "%s/hard_link.txt", test_dir_path);
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    fd = open(test_src_path, O_CREAT | O_WRONLY | O_TRUNC, 0640);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(TEST_CONTENTS_LEN, write(fd, TEST_CONTENTS, TEST_CONTENTS_LEN));
+    close(fd);
+}
+
+
+void teardown(void)
+{
+    unlink(test_link_path);
+    unlink(test_dst_path);
+    unlink(test_src_path);
+    rmdir(test_dir_path);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_new_destination)
+{
+    ck_assert_int_eq(0, copy_file(test_src_path, test_dst_path, false));
+    check_contents(test_dst_path);
+}
+END_TEST
+
+
+START_TEST(test_n02_overwrite_longer_destination)
+{
+    // LOCAL VARIABLES
+    int fd = open(test_dst_path, O_CREAT | O_WRONLY | O_TRUNC, 0644);  // Pre-existing destination
+
+    // SETUP
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(64, write(fd, "0123456789012345678901234567890123456789012345678901234567890123",
+                               64));
+    close(fd);
+
+    // TEST
+    ck_assert_int_eq(0, copy_file(test_src_path, test_dst_path, true));
+    check_contents(test_dst_path);  // Truncated, then copied
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_existing_destination_no_overwrite)
+{
+    ck_assert_int_eq(0, copy_file(test_src_path, test_dst_path, false));
+    ck_assert_int_eq(EEXIST, copy_file(test_src_path, test_dst_path, false));
+    check_contents(test_dst_path);
+}
+END_TEST
+
+
+START_TEST(test_e02_null_args)
+{
+    ck_assert_int_eq(EINVAL, copy_file(NULL, test_dst_path, true));
+    ck_assert_int_eq(EINVAL, copy_file(test_src_path, NULL, true));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_same_file)
+{
+    ck_assert_int_eq(EINVAL, copy_file(test_src_path, test_src_path, true));
+    check_contents(test_src_path);  // Not truncated
+}
+END_TEST
+
+
+START_TEST(test_s02_hard_link_to_source)
+{
+    ck_assert_int_eq(0, link(test_src_path, test_link_path));
+    ck_assert_int_eq(EINVAL, copy_file(test_src_path, test_link_path, true));
+    check_contents(test_src_path);  // Not truncated
+    check_contents(test_link_path);
+}
+END_TEST
+
+
+START_TEST(test_s03_same_file_no_overwrite)
+{
+    ck_assert_int_eq(EEXIST, copy_file(test_src_path, test_src_path, false));
+    check_contents(test_src_path);
+}
+END_TEST
+
+
+Suite *copy_file_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFO_Copy_File");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_new_destination);
+    tcase_add_test(tc_core, test_n02_overwrite_longer_destination);
+    tcase_add_test(tc_core, test_e01_existing_destination_no_overwrite);
+    tcase_add_test(tc_core, test_e02_null_args);
+    tcase_add_test(tc_core, test_s01_same_file);
+    tcase_add_test(tc_core, test_s02_hard_link_to_source);
+    tcase_add_test(tc_core, test_s03_same_file_no_overwrite);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfo_copy_file.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = copy_file_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
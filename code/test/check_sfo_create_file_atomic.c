@@ -0,0 +1,340 @@
+/*
+ *  Check unit test suit for skid_file_operations.h's create_file_atomic() function (and
+ *  commit_sync_batch(), which shares a skidSyncBatch with it).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfo_create_file_atomic.bin
+code/dist/check_sfo_create_file_atomic.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfo_create_file_atomic.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <dirent.h>                   // opendir(), readdir()
+#include <errno.h>                    // EEXIST, EFAULT, EINVAL, EISDIR
+#include <fcntl.h>                    // fcntl(), F_GETFD
+#include <stdio.h>                    // snprintf()
+#include <stdlib.h>
+#include <string.h>                   // strerror(), strlen(), strncmp()
+#include <sys/stat.h>                 // chmod(), lstat(), mkdir(), stat()
+#include <unistd.h>                   // access(), symlink()
+// Local includes
+#include "devops_code.h"              /* read_a_file(), remove_a_tree(), resolve_to_repo(),
+                                         SKID_REPO_NAME */
+#include "skid_file_operations.h"     // commit_sync_batch(), create_file_atomic()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define NEW_CONTENTS "New contents\n"  // Contents create_file_atomic() writes
+#define OLD_CONTENTS "Old contents\n"  // Contents of files the tests replace
+#define TMP_PREFIX ".skid_tmp."        // Prefix of create_file_atomic()'s named temporary files
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_dir_path;       // Heap array with the test directory resolved to the repo
+char test_file[4096];      // test_dir_path + "/file.txt"
+char test_sub_dir[4096];   // test_dir_path + "/sub_dir"
+char test_sub_file[4096];  // test_dir_path + "/sub_dir/file.txt"
+
+/*
+ *  Verify filename holds exactly exp_contents.
+ */
+void check_contents(const char *filename, const char *exp_contents);
+
+/*
+ *  Count the named temporary files create_file_atomic() left behind in dirname.
+ */
+int count_tmp_files(const char *dirname);
+
+/*
+ *  Create an empty test directory with an empty sub-directory.
+ */
+void setup(void);
+
+/*
+ *  Delete the test directory and everything in it.
+ */
+void teardown(void);
+
+/*
+ *  Create filename with OLD_CONTENTS and mode.
+ */
+void write_old_file(const char *filename, mode_t mode);
+
+
+void check_contents(const char *filename, const char *exp_contents)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                          // Errno from the function call
+    char *contents = read_a_file(filename, &errnum);  // filename's contents
+
+    // CHECK IT
+    ck_assert_int_eq(0, errnum);
+    ck_assert_str_eq(exp_contents, contents);
+    free_devops_mem((void **)&contents);
+}
+
+
+int count_tmp_files(const char *dirname)
+{
+    // LOCAL VARIABLES
+    int count = 0;                // Number of temporary files found
+    DIR *dir = opendir(dirname);  // Directory stream for dirname
+    struct dirent *entry = NULL;  // One directory entry
+
+    // COUNT THEM
+    ck_assert_ptr_nonnull(dir);
+    while (NULL != (entry = readdir(dir)))
+    {
+        if (0 == strncmp(TMP_PREFIX, entry->d_name, strlen(TMP_PREFIX)))
+        {
+            count++;
+        }
+    }
+    closedir(dir);
+
+    // DONE
+    return count;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfo_atomic_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_file, sizeof(test_file), "%s/file.txt", test_dir_path);
+    snprintf(test_sub_dir, sizeof(test_sub_dir), "%s/sub_dir", test_dir_path);
+    snprintf(test_sub_file, sizeof(test_sub_file), "%s/sub_dir/file.txt", test_dir_path);
+    remove_a_tree(test_dir_path, true);  // Leftovers from a previous run
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    ck_assert_int_eq(0, mkdir(test_sub_dir, 0755));
+}
+
+
+void teardown(void)
+{
+    remove_a_tree(test_dir_path, true);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+void write_old_file(const char *filename, mode_t mode)
+{
+    ck_assert_int_eq(0, create_file_atomic(filename, OLD_CONTENTS, strlen(OLD_CONTENTS), false,
+                                           NULL));
+    ck_assert_int_eq(0, chmod(filename, mode));
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_new_file)
+{
+    ck_assert_int_eq(0, create_file_atomic(test_file, NEW_CONTENTS, strlen(NEW_CONTENTS), false,
+                                           NULL));
+    check_contents(test_file, NEW_CONTENTS);
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+}
+END_TEST
+
+
+START_TEST(test_n02_replace_keeps_mode)
+{
+    struct stat file_stat;  // Metadata for test_file
+
+    write_old_file(test_file, 0604);
+    ck_assert_int_eq(0, create_file_atomic(test_file, NEW_CONTENTS, strlen(NEW_CONTENTS), true,
+                                           NULL));
+    check_contents(test_file, NEW_CONTENTS);
+    ck_assert_int_eq(0, stat(test_file, &file_stat));
+    ck_assert_int_eq(0604, file_stat.st_mode & 07777);
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+}
+END_TEST
+
+
+START_TEST(test_n03_batch_two_dirs)
+{
+    skidSyncBatch batch = { 0 };  // Directories awaiting a sync
+
+    ck_assert_int_eq(0, create_file_atomic(test_file, NEW_CONTENTS, strlen(NEW_CONTENTS), false,
+                                           &batch));
+    ck_assert_int_eq(1, batch.num_dirs);
+    // Another file in the same directory shares its fd
+    ck_assert_int_eq(0, create_file_atomic(test_file, NEW_CONTENTS, strlen(NEW_CONTENTS), true,
+                                           &batch));
+    ck_assert_int_eq(1, batch.num_dirs);
+    ck_assert_int_eq(0, create_file_atomic(test_sub_file, NEW_CONTENTS, strlen(NEW_CONTENTS),
+                                           false, &batch));
+    ck_assert_int_eq(2, batch.num_dirs);
+    ck_assert_ptr_nonnull(batch.dirs);
+    for (size_t i = 0; i < batch.num_dirs; i++)
+    {
+        ck_assert_int_ne(-1, fcntl(batch.dirs[i].fd, F_GETFD));  // Held open
+    }
+    ck_assert_int_eq(0, commit_sync_batch(&batch));
+    ck_assert_ptr_null(batch.dirs);
+    ck_assert_int_eq(0, batch.num_dirs);
+    ck_assert_int_eq(0, batch.capacity);
+    check_contents(test_file, NEW_CONTENTS);
+    check_contents(test_sub_file, NEW_CONTENTS);
+}
+END_TEST
+
+
+START_TEST(test_n04_empty_contents)
+{
+    ck_assert_int_eq(0, create_file_atomic(test_file, NULL, 0, false, NULL));
+    check_contents(test_file, "");
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_exists_no_overwrite)
+{
+    write_old_file(test_file, 0644);
+    ck_assert_int_eq(EEXIST, create_file_atomic(test_file, NEW_CONTENTS, strlen(NEW_CONTENTS),
+                                                false, NULL));
+    check_contents(test_file, OLD_CONTENTS);
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+}
+END_TEST
+
+
+START_TEST(test_e02_directory)
+{
+    // LOCAL VARIABLES
+    char trailing_slash[4096] = { 0 };  // test_dir_path + "/file.txt/"
+
+    // SETUP
+    snprintf(trailing_slash, sizeof(trailing_slash), "%s/file.txt/", test_dir_path);
+
+    // TEST
+    ck_assert_int_eq(EISDIR, create_file_atomic(test_sub_dir, NEW_CONTENTS, strlen(NEW_CONTENTS),
+                                                true, NULL));
+    ck_assert_int_eq(EISDIR, create_file_atomic(trailing_slash, NEW_CONTENTS,
+                                                strlen(NEW_CONTENTS), true, NULL));
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+}
+END_TEST
+
+
+START_TEST(test_e03_failed_write_leaves_nothing)
+{
+    // An unreadable buffer fails the write after the temporary file exists
+    ck_assert_int_eq(EFAULT, create_file_atomic(test_file, (const char *)1, 16, false, NULL));
+    ck_assert_int_eq(-1, access(test_file, F_OK));
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+    // Same for a replacement, which leaves the old file untouched
+    write_old_file(test_file, 0644);
+    ck_assert_int_eq(EFAULT, create_file_atomic(test_file, (const char *)1, 16, true, NULL));
+    check_contents(test_file, OLD_CONTENTS);
+    ck_assert_int_eq(0, count_tmp_files(test_dir_path));
+}
+END_TEST
+
+
+START_TEST(test_e04_bad_args)
+{
+    ck_assert_int_eq(EINVAL, create_file_atomic(NULL, NEW_CONTENTS, 1, true, NULL));
+    ck_assert_int_eq(EINVAL, create_file_atomic("", NEW_CONTENTS, 1, true, NULL));
+    ck_assert_int_eq(EINVAL, create_file_atomic(test_file, NULL, 1, true, NULL));
+    ck_assert_int_eq(-1, access(test_file, F_OK));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_symlink_replaced)
+{
+    // LOCAL VARIABLES
+    char link_path[4096] = { 0 };  // test_dir_path + "/link.txt"
+    struct stat link_stat;         // Metadata for link_path
+
+    // SETUP
+    snprintf(link_path, sizeof(link_path), "%s/link.txt", test_dir_path);
+    write_old_file(test_file, 0644);
+    ck_assert_int_eq(0, symlink("file.txt", link_path));
+
+    // TEST
+    // The link itself is replaced by a regular file and its target is untouched
+    ck_assert_int_eq(0, create_file_atomic(link_path, NEW_CONTENTS, strlen(NEW_CONTENTS), true,
+                                           NULL));
+    ck_assert_int_eq(0, lstat(link_path, &link_stat));
+    ck_assert(S_ISREG(link_stat.st_mode));
+    check_contents(link_path, NEW_CONTENTS);
+    check_contents(test_file, OLD_CONTENTS);
+}
+END_TEST
+
+
+Suite *create_file_atomic_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFO_Create_File_Atomic");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_new_file);
+    tcase_add_test(tc_core, test_n02_replace_keeps_mode);
+    tcase_add_test(tc_core, test_n03_batch_two_dirs);
+    tcase_add_test(tc_core, test_n04_empty_contents);
+    tcase_add_test(tc_core, test_e01_exists_no_overwrite);
+    tcase_add_test(tc_core, test_e02_directory);
+    tcase_add_test(tc_core, test_e03_failed_write_leaves_nothing);
+    tcase_add_test(tc_core, test_e04_bad_args);
+    tcase_add_test(tc_core, test_s01_symlink_replaced);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfo_create_file_atomic.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = create_file_atomic_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
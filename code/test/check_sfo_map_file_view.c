@@ -0,0 +1,301 @@
+/*
+ *  Check unit test suit for skid_file_operations.h's map_file_view() function (and
+ *  unmap_file_view(), which releases its views).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfo_map_file_view.bin
+code/dist/check_sfo_map_file_view.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfo_map_file_view.bin
+
+ *
+ */
+
+#define _XOPEN_SOURCE 500             // symlink()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EINVAL, EISDIR, ENOENT
+#include <stdio.h>                    // fopen(), fwrite(), remove(), snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp(), strerror()
+#include <sys/stat.h>                 // mkdir()
+#include <unistd.h>                   // rmdir(), symlink(), unlink()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_operations.h"     // map_file_view(), unmap_file_view()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define BIG_FILE_LEN (size_t)(1024 * 1024 + 13)  // Spans many pages, the last one partially
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+char test_dir[4096];   // test_file_path + ".dir"
+char test_link[4096];  // test_file_path + ".lnk"
+
+/*
+ *  Map the test file and verify the view holds exactly exp_len bytes matching exp_data.  Unmaps
+ *  the view, and verifies it was zeroized, before returning.
+ */
+void check_view(const char *exp_data, size_t exp_len, int hints);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test file, directory, and link.
+ */
+void teardown(void);
+
+/*
+ *  Write data to the test file, replacing it.
+ */
+void write_test_file(const char *data, size_t data_len);
+
+
+void check_view(const char *exp_data, size_t exp_len, int hints)
+{
+    // LOCAL VARIABLES
+    skidMemMapRegion view = { 0 };  // The view of the test file
+
+    // CHECK IT
+    ck_assert_int_eq(0, map_file_view(test_file_path, &view, hints));
+    ck_assert_int_eq(exp_len, view.length);
+    ck_assert_ptr_nonnull(view.addr);
+    ck_assert_int_eq(0, memcmp(exp_data, view.addr, exp_len));
+    ck_assert_int_eq(0, unmap_file_view(&view));
+    ck_assert_ptr_null(view.addr);
+    ck_assert_int_eq(0, view.length);
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfo_map_view.bin",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_dir, sizeof(test_dir), "%s.dir", test_file_path);
+    snprintf(test_link, sizeof(test_link), "%s.lnk", test_file_path);
+    remove(test_file_path);  // Leftovers from a previous run
+    rmdir(test_dir);
+    unlink(test_link);
+}
+
+
+void teardown(void)
+{
+    remove(test_file_path);
+    rmdir(test_dir);
+    unlink(test_link);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+void write_test_file(const char *data, size_t data_len)
+{
+    // LOCAL VARIABLES
+    FILE *file = fopen(test_file_path, "wb");  // The test file
+
+    // WRITE IT
+    ck_assert_ptr_nonnull(file);
+    ck_assert_int_eq(data_len, fwrite(data, 1, data_len, file));
+    fclose(file);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_text)
+{
+    char text[] = { "Just some text\n" };  // Plain string data
+
+    write_test_file(text, sizeof(text) - 1);
+    check_view(text, sizeof(text) - 1, 0);
+}
+END_TEST
+
+
+START_TEST(test_n02_binary_with_hints)
+{
+    char payload[] = { 'a', '\0', 'b', '\0', '\0', 'c', '\xFF', '\0' };  // Binary data
+
+    write_test_file(payload, sizeof(payload));
+    check_view(payload, sizeof(payload), SKID_VIEW_SEQUENTIAL | SKID_VIEW_WILLNEED);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_args)
+{
+    skidMemMapRegion view = { 0 };                             // The view of the test file
+    skidMemMapRegion in_use = { .addr = &view, .length = 1 };  // A view that's already mapped
+
+    write_test_file("abc", 3);
+    ck_assert_int_eq(EINVAL, map_file_view(NULL, &view, 0));
+    ck_assert_int_eq(EINVAL, map_file_view("", &view, 0));
+    ck_assert_int_eq(EINVAL, map_file_view(test_file_path, NULL, 0));
+    ck_assert_int_eq(EINVAL, map_file_view(test_file_path, &in_use, 0));
+    ck_assert_ptr_eq(&view, in_use.addr);  // Untouched
+    ck_assert_ptr_null(view.addr);
+    ck_assert_int_eq(EINVAL, unmap_file_view(NULL));
+}
+END_TEST
+
+
+START_TEST(test_e02_not_a_regular_file)
+{
+    skidMemMapRegion view = { 0 };  // The view
+
+    ck_assert_int_eq(ENOENT, map_file_view(test_file_path, &view, 0));
+    ck_assert_int_eq(0, mkdir(test_dir, 0755));
+    ck_assert_int_eq(EISDIR, map_file_view(test_dir, &view, 0));
+    ck_assert_int_eq(EINVAL, map_file_view("/dev/null", &view, 0));
+    ck_assert_ptr_null(view.addr);
+    ck_assert_int_eq(0, view.length);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_empty_file)
+{
+    skidMemMapRegion view = { 0 };  // The view of the test file
+
+    // Nothing is mapped but it's still a valid view
+    write_test_file("", 0);
+    ck_assert_int_eq(0, map_file_view(test_file_path, &view, SKID_VIEW_WILLNEED));
+    ck_assert_ptr_null(view.addr);
+    ck_assert_int_eq(0, view.length);
+    ck_assert_int_eq(0, unmap_file_view(&view));
+    ck_assert_ptr_null(view.addr);
+    ck_assert_int_eq(0, view.length);
+}
+END_TEST
+
+
+START_TEST(test_b02_one_byte)
+{
+    write_test_file("", 1);  // A lone nul
+    check_view("", 1, 0);
+}
+END_TEST
+
+
+START_TEST(test_b03_big_file)
+{
+    char *payload = malloc(BIG_FILE_LEN);  // Binary data
+
+    ck_assert_ptr_nonnull(payload);
+    for (size_t i = 0; i < BIG_FILE_LEN; i++)
+    {
+        payload[i] = (char)(i % 253);
+    }
+    write_test_file(payload, BIG_FILE_LEN);
+    check_view(payload, BIG_FILE_LEN, SKID_VIEW_SEQUENTIAL);
+    free(payload);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_outlives_the_file)
+{
+    skidMemMapRegion view = { 0 };  // The view of the test file
+
+    // The mapping holds its own reference to the file
+    write_test_file("Still here", 10);
+    ck_assert_int_eq(0, map_file_view(test_file_path, &view, 0));
+    ck_assert_int_eq(0, remove(test_file_path));
+    ck_assert_int_eq(10, view.length);
+    ck_assert_int_eq(0, memcmp("Still here", view.addr, 10));
+    ck_assert_int_eq(0, unmap_file_view(&view));
+}
+END_TEST
+
+
+START_TEST(test_s02_symlink_followed)
+{
+    skidMemMapRegion view = { 0 };  // The view of the link's target
+
+    write_test_file("Target", 6);
+    ck_assert_int_eq(0, symlink(test_file_path, test_link));
+    ck_assert_int_eq(0, map_file_view(test_link, &view, 0));
+    ck_assert_int_eq(6, view.length);
+    ck_assert_int_eq(0, memcmp("Target", view.addr, 6));
+    ck_assert_int_eq(0, unmap_file_view(&view));
+}
+END_TEST
+
+
+Suite *map_file_view_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFO_Map_File_View");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_text);
+    tcase_add_test(tc_core, test_n02_binary_with_hints);
+    tcase_add_test(tc_core, test_e01_bad_args);
+    tcase_add_test(tc_core, test_e02_not_a_regular_file);
+    tcase_add_test(tc_core, test_b01_empty_file);
+    tcase_add_test(tc_core, test_b02_one_byte);
+    tcase_add_test(tc_core, test_b03_big_file);
+    tcase_add_test(tc_core, test_s01_outlives_the_file);
+    tcase_add_test(tc_core, test_s02_symlink_followed);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfo_map_file_view.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = map_file_view_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,454 @@
+/*
+ *  Check unit test suit for skid_file_operations.h's skidAppender functions: open_appender(),
+ *  write_appender(), write_appender_v(), flush_appender(), and close_appender().
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfo_open_appender.bin
+code/dist/check_sfo_open_appender.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfo_open_appender.bin
+
+ *
+ */
+
+#define _XOPEN_SOURCE 500             // usleep()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EFBIG, EINVAL, EISDIR, ENOENT, EOVERFLOW
+#include <fcntl.h>                    // fcntl()
+#include <signal.h>                   // signal(), SIGXFSZ
+#include <stdio.h>                    // fopen(), fread(), fwrite(), remove(), snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp(), memset(), strerror()
+#include <sys/resource.h>             // getrlimit(), setrlimit()
+#include <sys/stat.h>                 // mkdir()
+#include <sys/uio.h>                  // struct iovec
+#include <unistd.h>                   // close(), dup(), rmdir(), usleep()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_operations.h"     // open_appender(), skidAppender
+#include "skid_macros.h"              // SKID_BAD_FD, SKID_MAX_SZ
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define MAX_CONTENTS_LEN 4096      // Largest test file read_test_file() can read
+#define THRESHOLD_MS 5             // A time threshold short enough to wait out
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+char test_dir[4096];   // test_file_path + ".dir"
+
+/*
+ *  Verify the test file holds exactly exp_len bytes matching exp_data.
+ */
+void check_test_file(const char *exp_data, size_t exp_len);
+
+/*
+ *  Read the test file into contents and return the number of bytes read.
+ */
+size_t read_test_file(char *contents, size_t contents_size);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test file and directory.
+ */
+void teardown(void);
+
+
+void check_test_file(const char *exp_data, size_t exp_len)
+{
+    // LOCAL VARIABLES
+    char contents[MAX_CONTENTS_LEN] = { 0 };  // The test file's contents
+    // Number of bytes in contents
+    size_t contents_len = read_test_file(contents, sizeof(contents));
+
+    // CHECK IT
+    ck_assert_int_eq(exp_len, contents_len);
+    ck_assert_int_eq(0, memcmp(exp_data, contents, exp_len));
+}
+
+
+size_t read_test_file(char *contents, size_t contents_size)
+{
+    // LOCAL VARIABLES
+    size_t contents_len = 0;                   // Number of bytes read
+    FILE *file = fopen(test_file_path, "rb");  // The test file
+
+    // READ IT
+    ck_assert_ptr_nonnull(file);
+    contents_len = fread(contents, 1, contents_size, file);
+    fclose(file);
+
+    // DONE
+    return contents_len;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfo_appender.txt",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_dir, sizeof(test_dir), "%s.dir", test_file_path);
+    remove(test_file_path);  // Leftovers from a previous run
+    rmdir(test_dir);
+}
+
+
+void teardown(void)
+{
+    remove(test_file_path);
+    rmdir(test_dir);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_flush_size_threshold)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 8, 0, 0, true));
+    check_test_file("", 0);  // Created, but empty
+    // Below the threshold: buffered
+    ck_assert_int_eq(0, write_appender(&appender, "abc", 3));
+    ck_assert_int_eq(0, write_appender(&appender, "def", 3));
+    ck_assert_int_eq(6, appender.buffer.length);
+    check_test_file("", 0);
+    // At the threshold: written with one write
+    ck_assert_int_eq(0, write_appender(&appender, "gh", 2));
+    ck_assert_int_eq(0, appender.buffer.length);
+    ck_assert_int_eq(true, appender.unsynced);
+    check_test_file("abcdefgh", 8);
+    ck_assert_int_eq(0, close_appender(&appender));
+}
+END_TEST
+
+
+START_TEST(test_n02_flush_appender)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 0, true));
+    ck_assert_int_eq(0, write_appender(&appender, "pending", 7));
+    check_test_file("", 0);
+    ck_assert_int_eq(0, flush_appender(&appender, false));
+    check_test_file("pending", 7);
+    ck_assert_int_eq(true, appender.unsynced);
+    ck_assert_int_eq(0, flush_appender(&appender, true));
+    ck_assert_int_eq(false, appender.unsynced);
+    ck_assert_int_eq(0, flush_appender(&appender, true));  // Nothing left to do
+    ck_assert_int_eq(0, close_appender(&appender));
+}
+END_TEST
+
+
+START_TEST(test_n03_close_flushes)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 1000, true));
+    ck_assert_int_eq(0, write_appender(&appender, "first\n", 6));
+    ck_assert_int_eq(0, write_appender(&appender, "second\n", 7));
+    check_test_file("", 0);
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("first\nsecond\n", 13);
+    ck_assert_int_eq(SKID_BAD_FD, appender.fd);
+    ck_assert_ptr_null(appender.buffer.data);
+    ck_assert_int_eq(false, appender.unsynced);
+}
+END_TEST
+
+
+START_TEST(test_n04_write_appender_v)
+{
+    skidAppender appender = { 0 };  // The appender
+    // One framed entry
+    struct iovec iov[] = { { "[", 1 }, { NULL, 0 }, { "entry", 5 }, { "]\n", 2 } };
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 0, true));
+    ck_assert_int_eq(0, write_appender_v(&appender, iov, 4));
+    ck_assert_int_eq(0, write_appender_v(&appender, iov, 4));
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("[entry]\n[entry]\n", 16);
+}
+END_TEST
+
+
+START_TEST(test_n05_flush_ms_threshold)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, THRESHOLD_MS, 0, true));
+    ck_assert_int_eq(0, write_appender(&appender, "a", 1));
+    check_test_file("", 0);
+    usleep(THRESHOLD_MS * 2 * 1000);
+    check_test_file("", 0);  // Thresholds are only checked by calls
+    ck_assert_int_eq(0, write_appender(&appender, "b", 1));
+    check_test_file("ab", 2);
+    ck_assert_int_eq(0, appender.buffer.length);
+    ck_assert_int_eq(0, close_appender(&appender));
+}
+END_TEST
+
+
+START_TEST(test_n06_sync_ms_threshold)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    // Every entry is written immediately; syncs are rationed
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 1, 0, THRESHOLD_MS, true));
+    usleep(THRESHOLD_MS * 2 * 1000);
+    ck_assert_int_eq(0, write_appender(&appender, "a", 1));
+    check_test_file("a", 1);
+    ck_assert_int_eq(false, appender.unsynced);  // The last sync was long enough ago
+    ck_assert_int_eq(0, close_appender(&appender));
+
+    // Never sync
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 1, 0, 0, false));
+    usleep(THRESHOLD_MS * 2 * 1000);
+    ck_assert_int_eq(0, write_appender(&appender, "b", 1));
+    check_test_file("ab", 2);
+    ck_assert_int_eq(true, appender.unsynced);
+    ck_assert_int_eq(0, flush_appender(&appender, false));
+    ck_assert_int_eq(true, appender.unsynced);
+    ck_assert_int_eq(0, close_appender(&appender));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_bad_open_args)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(EINVAL, open_appender(NULL, test_file_path, 0, 0, 0, true));
+    ck_assert_int_eq(EINVAL, open_appender(&appender, NULL, 0, 0, 0, true));
+    ck_assert_int_eq(EINVAL, open_appender(&appender, "", 0, 0, 0, true));
+    ck_assert_int_eq(EOVERFLOW, open_appender(&appender, test_file_path, SKID_MAX_SZ, 0, 0,
+                                              true));
+    ck_assert_int_eq(ENOENT, open_appender(&appender, test_file_path, 0, 0, 0, false));
+    ck_assert_int_eq(0, mkdir(test_dir, 0755));
+    ck_assert_int_eq(EISDIR, open_appender(&appender, test_dir, 0, 0, 0, true));
+    ck_assert_int_eq(SKID_BAD_FD, appender.fd);
+    ck_assert_ptr_null(appender.buffer.data);
+}
+END_TEST
+
+
+START_TEST(test_e02_not_opened)
+{
+    skidAppender appender = { 0 };       // Never opened
+    struct iovec iov = { "abc", 3 };     // An entry
+    struct iovec bad_iov = { NULL, 3 };  // A NULL entry
+
+    ck_assert_int_eq(EINVAL, write_appender(&appender, "abc", 3));
+    ck_assert_int_eq(EINVAL, write_appender_v(&appender, &iov, 1));
+    ck_assert_int_eq(EINVAL, flush_appender(&appender, true));
+    ck_assert_int_eq(EINVAL, close_appender(NULL));
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 0, true));
+    ck_assert_int_eq(EINVAL, write_appender(NULL, "abc", 3));
+    ck_assert_int_eq(EINVAL, write_appender(&appender, NULL, 3));
+    ck_assert_int_eq(EINVAL, write_appender_v(&appender, NULL, 1));
+    ck_assert_int_eq(EINVAL, write_appender_v(&appender, &iov, 0));
+    ck_assert_int_eq(EINVAL, write_appender_v(&appender, &bad_iov, 1));
+    ck_assert_int_eq(0, appender.buffer.length);
+    ck_assert_int_eq(0, close_appender(&appender));
+    ck_assert_int_eq(EINVAL, close_appender(&appender));  // Already closed
+    check_test_file("", 0);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_empty_entry)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 0, true));
+    ck_assert_int_eq(SKID_APPENDER_SIZE, appender.flush_size);  // The default
+    ck_assert_int_eq(0, write_appender(&appender, "", 0));
+    ck_assert_int_eq(0, appender.buffer.length);
+    ck_assert_int_eq(false, appender.unsynced);
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("", 0);
+}
+END_TEST
+
+
+START_TEST(test_b02_entry_larger_than_buffer)
+{
+    skidAppender appender = { 0 };                  // The appender
+    char big_entry[] = { "0123456789ABCDEFGHIJ" };  // Twenty bytes
+
+    // The pending entry is written first, then the big one, unbuffered
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 8, 0, 0, true));
+    ck_assert_int_eq(0, write_appender(&appender, "abc", 3));
+    ck_assert_int_eq(0, write_appender(&appender, big_entry, 20));
+    ck_assert_int_eq(0, appender.buffer.length);
+    check_test_file("abc0123456789ABCDEFGHIJ", 23);
+    ck_assert_int_eq(0, close_appender(&appender));
+}
+END_TEST
+
+
+START_TEST(test_b03_entry_does_not_fit)
+{
+    skidAppender appender = { 0 };  // The appender
+
+    // The buffer is written to make room, then the new entry is buffered
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 8, 0, 0, true));
+    ck_assert_int_eq(0, write_appender(&appender, "abcde", 5));
+    ck_assert_int_eq(0, write_appender(&appender, "fghi", 4));
+    check_test_file("abcde", 5);
+    ck_assert_int_eq(4, appender.buffer.length);
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("abcdefghi", 9);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_appends_to_existing)
+{
+    skidAppender appender = { 0 };  // The appender
+    FILE *file = NULL;              // The test file
+
+    file = fopen(test_file_path, "w");
+    ck_assert_ptr_nonnull(file);
+    ck_assert_int_eq(4, fwrite("old\n", 1, 4, file));
+    fclose(file);
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 0, 0, 0, false));
+    ck_assert_int_eq(0, write_appender(&appender, "new\n", 4));
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("old\nnew\n", 8);
+}
+END_TEST
+
+
+START_TEST(test_s02_failed_open_leaves_caller_fd)
+{
+    skidAppender appender = { 0 };  // The appender
+    int fd = dup(STDERR_FILENO);    // A file descriptor the appender doesn't own
+
+    // The previous contents are overwritten, never closed or freed
+    ck_assert_int_ne(-1, fd);
+    memset(&appender, 0x0, sizeof(appender));
+    appender.fd = fd;
+    ck_assert_int_eq(EINVAL, open_appender(&appender, "", 0, 0, 0, true));
+    ck_assert_int_ne(-1, fcntl(fd, F_GETFD));
+    ck_assert_int_eq(SKID_BAD_FD, appender.fd);
+    appender.fd = 0;  // A zeroed appender's fd is stdin
+    ck_assert_int_eq(ENOENT, open_appender(&appender, test_file_path, 0, 0, 0, false));
+    ck_assert_int_ne(-1, fcntl(STDIN_FILENO, F_GETFD));
+    close(fd);
+}
+END_TEST
+
+
+START_TEST(test_s03_short_write_not_repeated)
+{
+    skidAppender appender = { 0 };  // The appender
+    struct rlimit orig_limit;       // The original file size limit, restored before returning
+    struct rlimit short_limit;      // A file size limit that cuts the flush short
+    void (*orig_handler)(int);      // The original SIGXFSZ disposition
+
+    ck_assert_int_eq(0, getrlimit(RLIMIT_FSIZE, &orig_limit));
+    short_limit = orig_limit;
+    short_limit.rlim_cur = 4;
+    orig_handler = signal(SIGXFSZ, SIG_IGN);  // Fail with EFBIG instead
+    ck_assert_int_eq(0, open_appender(&appender, test_file_path, 64, 0, 0, true));
+    ck_assert_int_eq(0, write_appender(&appender, "0123456789", 10));
+    // Four bytes make it, then the write fails
+    ck_assert_int_eq(0, setrlimit(RLIMIT_FSIZE, &short_limit));
+    ck_assert_int_eq(EFBIG, flush_appender(&appender, false));
+    ck_assert_int_eq(0, setrlimit(RLIMIT_FSIZE, &orig_limit));
+    ck_assert_int_eq(6, appender.buffer.length);
+    check_test_file("0123", 4);
+    // Only the rest is written
+    ck_assert_int_eq(0, close_appender(&appender));
+    check_test_file("0123456789", 10);
+    signal(SIGXFSZ, orig_handler);
+}
+END_TEST
+
+
+Suite *open_appender_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFO_Open_Appender");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_flush_size_threshold);
+    tcase_add_test(tc_core, test_n02_flush_appender);
+    tcase_add_test(tc_core, test_n03_close_flushes);
+    tcase_add_test(tc_core, test_n04_write_appender_v);
+    tcase_add_test(tc_core, test_n05_flush_ms_threshold);
+    tcase_add_test(tc_core, test_n06_sync_ms_threshold);
+    tcase_add_test(tc_core, test_e01_bad_open_args);
+    tcase_add_test(tc_core, test_e02_not_opened);
+    tcase_add_test(tc_core, test_b01_empty_entry);
+    tcase_add_test(tc_core, test_b02_entry_larger_than_buffer);
+    tcase_add_test(tc_core, test_b03_entry_does_not_fit);
+    tcase_add_test(tc_core, test_s01_appends_to_existing);
+    tcase_add_test(tc_core, test_s02_failed_open_leaves_caller_fd);
+    tcase_add_test(tc_core, test_s03_short_write_not_repeated);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfo_open_appender.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = open_appender_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
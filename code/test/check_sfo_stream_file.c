@@ -0,0 +1,344 @@
+/*
+ *  Check unit test suit for skid_file_operations.h's stream_file() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sfo_stream_file.bin
+code/dist/check_sfo_stream_file.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sfo_stream_file.bin
+
+ *
+ */
+
+#define _XOPEN_SOURCE 500             // sysconf()
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // ECANCELED, EINVAL, EISDIR, ENOENT, EOVERFLOW
+#include <stdint.h>                   // SIZE_MAX
+#include <stdio.h>                    // fopen(), fwrite(), remove(), snprintf()
+#include <stdlib.h>                   // EXIT_FAILURE, EXIT_SUCCESS
+#include <string.h>                   // memcmp(), memcpy(), strerror()
+#include <sys/stat.h>                 // mkdir()
+#include <unistd.h>                   // rmdir(), sysconf()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_file_operations.h"     // stream_file()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define MAX_STREAM_LEN (size_t)(64 * 1024)  // Largest file a streamTally can reassemble
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+// Everything a stream handed to tally_chunk()
+typedef struct _streamTally
+{
+    char data[MAX_STREAM_LEN];  // The chunks, reassembled
+    size_t data_len;            // Number of bytes in data
+    int num_chunks;             // Number of times the handler was called
+    size_t first_chunk_len;     // Length of the first chunk
+    int stop_after;             // [Optional] Return ECANCELED after this many chunks
+} streamTally;
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+char test_dir[4096];   // test_file_path + ".dir"
+size_t page_size;      // The system's page size
+
+/*
+ *  Heap-allocate len bytes of binary data: every byte value, nul included, over and over.
+ */
+char *make_payload(size_t len);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  ChunkHandler that appends each chunk to the streamTally context, verifying the chunks
+ *  arrive in file order.  Stops the stream after stop_after chunks.
+ */
+int tally_chunk(const char *chunk, size_t chunk_len, off_t offset, void *context);
+
+/*
+ *  Delete the test file and directory.
+ */
+void teardown(void);
+
+/*
+ *  Write data to the test file, replacing it.
+ */
+void write_test_file(const char *data, size_t data_len);
+
+
+char *make_payload(size_t len)
+{
+    // LOCAL VARIABLES
+    char *payload = malloc(len + 1);  // The binary data
+
+    // MAKE IT
+    ck_assert_ptr_nonnull(payload);
+    for (size_t i = 0; i < len; i++)
+    {
+        payload[i] = (char)(i % 251);
+    }
+
+    // DONE
+    return payload;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sfo_stream.bin",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_dir, sizeof(test_dir), "%s.dir", test_file_path);
+    remove(test_file_path);  // Leftovers from a previous run
+    rmdir(test_dir);
+    page_size = sysconf(_SC_PAGESIZE);
+    ck_assert_int_gt(page_size, 0);
+    ck_assert_int_le(page_size * 4, MAX_STREAM_LEN);
+}
+
+
+int tally_chunk(const char *chunk, size_t chunk_len, off_t offset, void *context)
+{
+    // LOCAL VARIABLES
+    streamTally *tally = (streamTally *)context;  // The tally to update
+
+    // TALLY IT
+    ck_assert_int_eq(tally->data_len, offset);  // In order, without gaps
+    ck_assert_int_gt(chunk_len, 0);
+    ck_assert_int_le(tally->data_len + chunk_len, MAX_STREAM_LEN);
+    memcpy(tally->data + tally->data_len, chunk, chunk_len);
+    tally->data_len += chunk_len;
+    if (0 == tally->num_chunks)
+    {
+        tally->first_chunk_len = chunk_len;
+    }
+    tally->num_chunks++;
+
+    // DONE
+    return (tally->stop_after > 0 && tally->num_chunks >= tally->stop_after) ? ECANCELED : 0;
+}
+
+
+void teardown(void)
+{
+    remove(test_file_path);
+    rmdir(test_dir);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+void write_test_file(const char *data, size_t data_len)
+{
+    // LOCAL VARIABLES
+    FILE *file = fopen(test_file_path, "wb");  // The test file
+
+    // WRITE IT
+    ck_assert_ptr_nonnull(file);
+    ck_assert_int_eq(data_len, fwrite(data, 1, data_len, file));
+    fclose(file);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_one_chunk)
+{
+    streamTally tally = { 0 };  // Everything streamed
+
+    write_test_file("Just a\0little binary", 20);
+    ck_assert_int_eq(0, stream_file(test_file_path, 0, tally_chunk, &tally, false));
+    ck_assert_int_eq(1, tally.num_chunks);
+    ck_assert_int_eq(20, tally.data_len);
+    ck_assert_int_eq(0, memcmp("Just a\0little binary", tally.data, 20));
+}
+END_TEST
+
+
+START_TEST(test_n02_many_chunks)
+{
+    streamTally tally = { 0 };               // Everything streamed
+    size_t file_len = page_size * 3 + 100;   // Three full chunks and a short one
+    char *payload = make_payload(file_len);  // The file's contents
+
+    write_test_file(payload, file_len);
+    ck_assert_int_eq(0, stream_file(test_file_path, page_size, tally_chunk, &tally, true));
+    ck_assert_int_eq(4, tally.num_chunks);
+    ck_assert_int_eq(page_size, tally.first_chunk_len);
+    ck_assert_int_eq(file_len, tally.data_len);
+    ck_assert_int_eq(0, memcmp(payload, tally.data, file_len));
+    free(payload);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_handler_stops)
+{
+    streamTally tally = { .stop_after = 2 };  // Everything streamed
+    size_t file_len = page_size * 4;          // Four chunks
+    char *payload = make_payload(file_len);   // The file's contents
+
+    write_test_file(payload, file_len);
+    ck_assert_int_eq(ECANCELED, stream_file(test_file_path, page_size, tally_chunk, &tally,
+                                            false));
+    ck_assert_int_eq(2, tally.num_chunks);
+    ck_assert_int_eq(page_size * 2, tally.data_len);
+    free(payload);
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    streamTally tally = { 0 };  // Everything streamed
+
+    write_test_file("abc", 3);
+    ck_assert_int_eq(EINVAL, stream_file(NULL, 0, tally_chunk, &tally, false));
+    ck_assert_int_eq(EINVAL, stream_file("", 0, tally_chunk, &tally, false));
+    ck_assert_int_eq(EINVAL, stream_file(test_file_path, 0, NULL, &tally, false));
+    ck_assert_int_eq(0, tally.num_chunks);
+}
+END_TEST
+
+
+START_TEST(test_e03_not_a_file)
+{
+    streamTally tally = { 0 };  // Everything streamed
+
+    ck_assert_int_eq(ENOENT, stream_file(test_file_path, 0, tally_chunk, &tally, false));
+    ck_assert_int_eq(0, mkdir(test_dir, 0755));
+    ck_assert_int_eq(EISDIR, stream_file(test_dir, 0, tally_chunk, &tally, false));
+    ck_assert_int_eq(0, tally.num_chunks);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_empty_file)
+{
+    streamTally tally = { 0 };  // Everything streamed
+
+    // Nothing to hand the handler
+    write_test_file("", 0);
+    ck_assert_int_eq(0, stream_file(test_file_path, 0, tally_chunk, &tally, true));
+    ck_assert_int_eq(0, tally.num_chunks);
+    ck_assert_int_eq(0, tally.data_len);
+}
+END_TEST
+
+
+START_TEST(test_b02_exactly_one_chunk)
+{
+    streamTally tally = { 0 };                // Everything streamed
+    char *payload = make_payload(page_size);  // The file's contents
+
+    // No trailing empty chunk
+    write_test_file(payload, page_size);
+    ck_assert_int_eq(0, stream_file(test_file_path, page_size, tally_chunk, &tally, false));
+    ck_assert_int_eq(1, tally.num_chunks);
+    ck_assert_int_eq(0, memcmp(payload, tally.data, page_size));
+    free(payload);
+}
+END_TEST
+
+
+START_TEST(test_b03_chunk_size_rounded_up)
+{
+    streamTally tally = { 0 };               // Everything streamed
+    size_t file_len = page_size * 2;         // Two pages
+    char *payload = make_payload(file_len);  // The file's contents
+
+    // A one byte chunk is rounded up to a page
+    write_test_file(payload, file_len);
+    ck_assert_int_eq(0, stream_file(test_file_path, 1, tally_chunk, &tally, false));
+    ck_assert_int_eq(2, tally.num_chunks);
+    ck_assert_int_eq(page_size, tally.first_chunk_len);
+    ck_assert_int_eq(0, memcmp(payload, tally.data, file_len));
+    free(payload);
+}
+END_TEST
+
+
+START_TEST(test_b04_chunk_size_too_big)
+{
+    streamTally tally = { 0 };  // Everything streamed
+
+    write_test_file("abc", 3);
+    ck_assert_int_eq(EOVERFLOW, stream_file(test_file_path, SIZE_MAX, tally_chunk, &tally,
+                                            false));
+    ck_assert_int_eq(0, tally.num_chunks);
+}
+END_TEST
+
+
+Suite *stream_file_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SFO_Stream_File");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_one_chunk);
+    tcase_add_test(tc_core, test_n02_many_chunks);
+    tcase_add_test(tc_core, test_e01_handler_stops);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_e03_not_a_file);
+    tcase_add_test(tc_core, test_b01_empty_file);
+    tcase_add_test(tc_core, test_b02_exactly_one_chunk);
+    tcase_add_test(tc_core, test_b03_chunk_size_rounded_up);
+    tcase_add_test(tc_core, test_b04_chunk_size_too_big);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sfo_stream_file.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = stream_file_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,346 @@
+/*
+ *  Check unit test suit for skid_io_batch.h's submit_io_batch() function (and the queue/reap
+ *  functions that share a batch with it).  Every case runs twice: once against the synchronous
+ *  fallback and once against io_uring (which silently falls back if the probe fails).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sib_submit_io_batch.bin
+code/dist/check_sib_submit_io_batch.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sib_submit_io_batch.bin
+
+ *
+ */
+
+#define _GNU_SOURCE                   // struct statx
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EAGAIN, EBADF, EINVAL, ENOENT
+#include <fcntl.h>                    // AT_FDCWD, O_RDONLY
+#include <stdio.h>                    // printf()
+#include <stdlib.h>
+#include <string.h>                   // memcmp(), strerror(), strlen()
+#include <sys/stat.h>                 // struct statx, STATX_SIZE
+#include <unistd.h>                   // close(), unlink()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_io_batch.h"            // create_io_batch(), queue_io_*(), reap_io_batch()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define TEST_CONTENTS "Batched I/O test contents"  // Contents written by the write tests
+#define TEST_DEPTH 8  // Depth of every batch under test
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+char *test_file_path;  // Heap array with the test file resolved to the repo
+
+/*
+ *  Create a batch for the _i loop index: 0 forces the fallback and 1 prefers io_uring.
+ */
+skidIoBatch_ptr create_test_batch(int index);
+
+/*
+ *  Reap exactly num_exp completions from batch and find the one with user_data.
+ */
+skidIoResult find_result(skidIoBatch_ptr batch, unsigned int num_exp, uint64_t user_data);
+
+/*
+ *  Resolve the test file's path.
+ */
+void setup(void);
+
+/*
+ *  Delete the test file.
+ */
+void teardown(void);
+
+
+skidIoBatch_ptr create_test_batch(int index)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+    // The batch under test
+    skidIoBatch_ptr batch = create_io_batch(TEST_DEPTH, 0 == index, &errnum);
+
+    // CHECK IT
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(batch);
+    if (0 == index)
+    {
+        ck_assert_msg(false == is_io_uring_batch(batch), "The fallback was not forced");
+    }
+    else if (false == is_io_uring_batch(batch))
+    {
+        printf("io_uring is unavailable so this case exercised the fallback\n");
+    }
+    return batch;
+}
+
+
+skidIoResult find_result(skidIoBatch_ptr batch, unsigned int num_exp, uint64_t user_data)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;                   // Errno from the function call
+    skidIoResult results[TEST_DEPTH] = { 0 };  // Completions
+    skidIoResult found = { 0 };                // The completion for user_data
+    unsigned int num_found = 0;                // Completions with user_data
+
+    // REAP IT
+    ck_assert_int_eq(num_exp, reap_io_batch(batch, results, TEST_DEPTH, num_exp, &errnum));
+    ck_assert_int_eq(0, errnum);
+    for (unsigned int i = 0; i < num_exp; i++)
+    {
+        if (user_data == results[i].user_data)
+        {
+            found = results[i];
+            num_found++;
+        }
+    }
+    ck_assert_int_eq(1, num_found);  // Every user_data round-trips exactly once
+
+    // DONE
+    return found;
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function call
+
+    // SETUP
+    test_file_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/sib_test_file.txt",
+                                     false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    unlink(test_file_path);  // Leftovers from a previous run
+}
+
+
+void teardown(void)
+{
+    unlink(test_file_path);
+    free_devops_mem((void **)&test_file_path);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_open_write_read_close)
+{
+    int errnum = CANARY_INT;             // Errno from the function calls
+    skidIoBatch_ptr batch = NULL;        // The batch under test
+    skidIoResult result = { 0 };         // One completion
+    int fd = -1;                         // File descriptor opened by the batch
+    char buff[64] = { 0 };               // Read buffer
+    size_t len = strlen(TEST_CONTENTS);  // Length of TEST_CONTENTS
+
+    batch = create_test_batch(_i);
+    // Open
+    ck_assert_int_eq(0, queue_io_open(batch, AT_FDCWD, test_file_path, O_CREAT | O_RDWR, 0644,
+                                      0x1111));
+    ck_assert_int_eq(1, submit_io_batch(batch, &errnum));
+    ck_assert_int_eq(0, errnum);
+    result = find_result(batch, 1, 0x1111);
+    ck_assert_int_eq(0, result.errnum);
+    ck_assert_int_ge(result.result, 0);
+    fd = result.result;
+    // Write
+    ck_assert_int_eq(0, queue_io_write(batch, fd, TEST_CONTENTS, len, 0, 0x2222));
+    ck_assert_int_eq(1, submit_io_batch(batch, &errnum));
+    result = find_result(batch, 1, 0x2222);
+    ck_assert_int_eq(0, result.errnum);
+    ck_assert_int_eq(len, result.result);
+    // Read it back
+    ck_assert_int_eq(0, queue_io_read(batch, fd, buff, sizeof(buff), 0, 0x3333));
+    ck_assert_int_eq(1, submit_io_batch(batch, &errnum));
+    result = find_result(batch, 1, 0x3333);
+    ck_assert_int_eq(0, result.errnum);
+    ck_assert_int_eq(len, result.result);  // Short read: the file is smaller than buff
+    ck_assert_int_eq(0, memcmp(TEST_CONTENTS, buff, len));
+    // Close
+    ck_assert_int_eq(0, queue_io_close(batch, fd, 0x4444));
+    ck_assert_int_eq(1, submit_io_batch(batch, &errnum));
+    result = find_result(batch, 1, 0x4444);
+    ck_assert_int_eq(0, result.errnum);
+    ck_assert_int_eq(0, result.result);
+    ck_assert_int_eq(0, destroy_io_batch(&batch));
+    ck_assert_ptr_null(batch);
+}
+END_TEST
+
+
+START_TEST(test_n02_many_ops_one_submit)
+{
+    int errnum = CANARY_INT;             // Errno from the function calls
+    skidIoBatch_ptr batch = NULL;        // The batch under test
+    skidIoResult result = { 0 };         // One completion
+    int fd = -1;                         // File descriptor for the test file
+    char buffs[4][8] = { { 0 } };        // Read buffers
+    struct statx statxbuf = { 0 };       // Statx output
+    size_t len = strlen(TEST_CONTENTS);  // Length of TEST_CONTENTS
+
+    // SETUP
+    fd = open(test_file_path, O_CREAT | O_RDWR, 0644);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(len, write(fd, TEST_CONTENTS, len));
+    batch = create_test_batch(_i);
+
+    // TEST
+    for (int i = 0; i < 4; i++)
+    {
+        ck_assert_int_eq(0, queue_io_read(batch, fd, buffs[i], sizeof(buffs[i]), i * 8, i));
+    }
+    ck_assert_int_eq(0, queue_io_statx(batch, AT_FDCWD, test_file_path, 0, STATX_SIZE, &statxbuf,
+                                       UINT64_MAX));
+    ck_assert_int_eq(5, submit_io_batch(batch, &errnum));
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(0, find_result(batch, 5, UINT64_MAX).errnum);
+    ck_assert_int_eq(len, statxbuf.stx_size);
+    for (int i = 0; i < 4; i++)
+    {
+        ck_assert_int_eq(0, memcmp(TEST_CONTENTS + (i * 8), buffs[i], i < 3 ? 8 : len - 24));
+    }
+    // Nothing left to reap
+    ck_assert_int_eq(0, reap_io_batch(batch, &result, 1, 0, &errnum));
+    ck_assert_int_eq(0, errnum);
+
+    // CLEANUP
+    close(fd);
+    ck_assert_int_eq(0, destroy_io_batch(&batch));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_failing_open)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidIoBatch_ptr batch = NULL;  // The batch under test
+    skidIoResult result = { 0 };   // One completion
+
+    batch = create_test_batch(_i);
+    ck_assert_int_eq(0, queue_io_open(batch, AT_FDCWD, "/this/path/does/not/exist", O_RDONLY, 0,
+                                      42));
+    ck_assert_int_eq(1, submit_io_batch(batch, &errnum));
+    ck_assert_int_eq(0, errnum);  // Submitting worked...
+    result = find_result(batch, 1, 42);
+    ck_assert_int_eq(-1, result.result);  // ...the operation did not
+    ck_assert_int_eq(ENOENT, result.errnum);
+    ck_assert_int_eq(0, destroy_io_batch(&batch));
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidIoBatch_ptr batch = NULL;  // The batch under test
+    skidIoResult result = { 0 };   // One completion
+    char buff[8] = { 0 };          // Read buffer
+
+    ck_assert_ptr_null(create_io_batch(0, true, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(EINVAL, queue_io_close(NULL, 0, 0));
+    ck_assert_int_eq(0, submit_io_batch(NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    batch = create_test_batch(_i);
+    ck_assert_int_eq(EBADF, queue_io_read(batch, -1, buff, sizeof(buff), 0, 0));
+    ck_assert_int_eq(EINVAL, queue_io_read(batch, 0, NULL, sizeof(buff), 0, 0));
+    ck_assert_int_eq(0, reap_io_batch(batch, NULL, 1, 0, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(0, reap_io_batch(batch, &result, 0, 0, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(0, destroy_io_batch(&batch));
+    ck_assert_int_eq(EINVAL, destroy_io_batch(&batch));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_full_batch)
+{
+    int errnum = CANARY_INT;               // Errno from the function calls
+    skidIoBatch_ptr batch = NULL;          // The batch under test
+    skidIoResult results[TEST_DEPTH];      // Completions
+    int fd = open("/dev/zero", O_RDONLY);  // Always-readable file descriptor
+    char buff[TEST_DEPTH] = { 0 };         // Read buffer
+
+    ck_assert_int_ne(-1, fd);
+    batch = create_test_batch(_i);
+    for (int i = 0; i < TEST_DEPTH; i++)
+    {
+        ck_assert_int_eq(0, queue_io_read(batch, fd, buff + i, 1, SKID_IO_CUR_POS, i));
+    }
+    ck_assert_int_eq(EAGAIN, queue_io_read(batch, fd, buff, 1, SKID_IO_CUR_POS, TEST_DEPTH));
+    ck_assert_int_eq(TEST_DEPTH, submit_io_batch(batch, &errnum));
+    // Submitted but unreaped operations still count against the depth
+    ck_assert_int_eq(EAGAIN, queue_io_read(batch, fd, buff, 1, SKID_IO_CUR_POS, TEST_DEPTH));
+    ck_assert_int_eq(TEST_DEPTH, reap_io_batch(batch, results, TEST_DEPTH, TEST_DEPTH, &errnum));
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(0, queue_io_read(batch, fd, buff, 1, SKID_IO_CUR_POS, TEST_DEPTH));
+    close(fd);  // Destroying the batch discards the queued read
+    ck_assert_int_eq(0, destroy_io_batch(&batch));
+}
+END_TEST
+
+
+Suite *submit_io_batch_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SIB_Submit_IO_Batch");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    // Index 0 forces the synchronous fallback and index 1 prefers io_uring
+    tcase_add_loop_test(tc_core, test_n01_open_write_read_close, 0, 2);
+    tcase_add_loop_test(tc_core, test_n02_many_ops_one_submit, 0, 2);
+    tcase_add_loop_test(tc_core, test_e01_failing_open, 0, 2);
+    tcase_add_loop_test(tc_core, test_e02_bad_args, 0, 2);
+    tcase_add_loop_test(tc_core, test_b01_full_batch, 0, 2);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sib_submit_io_batch.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = submit_io_batch_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,331 @@
+/*
+ *  Check unit test suit for skid_meta_cache.h's get_cached_meta() function.
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_smc_get_cached_meta.bin
+code/dist/check_smc_get_cached_meta.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_smc_get_cached_meta.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <fcntl.h>                    // open()
+#include <stdio.h>                    // snprintf(), rename()
+#include <stdlib.h>
+#include <sys/stat.h>                 // chmod(), mkdir()
+#include <unistd.h>                   // chdir(), close(), getcwd(), rmdir(), unlink(), write()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_meta_cache.h"          // create_meta_cache(), get_cached_meta()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+// Use this with usleep(MICRO_SEC_SLEEP) to give the watcher thread time to read inotify events
+#define MICRO_SEC_SLEEP (useconds_t)10000  // 0.01 seconds
+#define MAX_SLEEPS 100                     // Give up waiting on the watcher after one second
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+skidMetaCache_ptr test_cache;  // The metadata cache under test
+char *test_dir_path;           // Heap array with the test directory resolved to the repo
+char test_file_path[4096];     // test_dir_path + "/file.txt"
+char test_link_path[4096];     // test_dir_path + "/link.txt"
+
+/*
+ *  Verify test_cache's counters.
+ */
+void check_stats(uint64_t exp_hits, uint64_t exp_misses, size_t exp_entries);
+
+/*
+ *  Create the test directory, with one file and one symbolic link, and a cache watching it.
+ */
+void setup(void);
+
+/*
+ *  Destroy the cache and delete the test directory.
+ */
+void teardown(void);
+
+/*
+ *  Wait for the watcher thread to invalidate at least exp_invalidations entries.
+ */
+void wait_for_invalidations(uint64_t exp_invalidations);
+
+
+void check_stats(uint64_t exp_hits, uint64_t exp_misses, size_t exp_entries)
+{
+    skidMetaCacheStats stats;  // test_cache's counters
+    ck_assert_int_eq(0, get_meta_cache_stats(test_cache, &stats));
+    ck_assert_int_eq(exp_hits, stats.hits);
+    ck_assert_int_eq(exp_misses, stats.misses);
+    ck_assert_int_eq(exp_entries, stats.entries);
+}
+
+
+void setup(void)
+{
+    // LOCAL VARIABLES
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor for the test file
+
+    // SETUP
+    test_dir_path = resolve_to_repo(SKID_REPO_NAME, "./code/test/test_output/smc_test_dir",
+                                    false, &errnum);
+    ck_assert_msg(0 == errnum, "resolve_to_repo() failed with [%d] %s", errnum, strerror(errnum));
+    snprintf(test_file_path, sizeof(test_file_path), "%s/file.txt", test_dir_path);
+    snprintf(test_link_path, sizeof(test_link_path), "%s/link.txt", test_dir_path);
+    ck_assert_int_eq(0, mkdir(test_dir_path, 0755));
+    fd = open(test_file_path, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(5, write(fd, "Test\n", 5));
+    close(fd);
+    ck_assert_int_eq(0, symlink("file.txt", test_link_path));
+    test_cache = create_meta_cache(0, &errnum);
+    ck_assert_msg(0 == errnum, "create_meta_cache() failed with [%d] %s", errnum,
+                  strerror(errnum));
+    ck_assert_int_eq(0, watch_meta_cache_dir(test_cache, test_dir_path));
+}
+
+
+void teardown(void)
+{
+    ck_assert_int_eq(0, destroy_meta_cache(&test_cache));
+    ck_assert_ptr_null(test_cache);
+    unlink(test_link_path);
+    unlink(test_file_path);
+    rmdir(test_dir_path);
+    free_devops_mem((void **)&test_dir_path);
+}
+
+
+void wait_for_invalidations(uint64_t exp_invalidations)
+{
+    skidMetaCacheStats stats = { 0 };  // test_cache's counters
+    for (int i = 0; i < MAX_SLEEPS && stats.invalidations < exp_invalidations; i++)
+    {
+        usleep(MICRO_SEC_SLEEP);
+        ck_assert_int_eq(0, get_meta_cache_stats(test_cache, &stats));
+    }
+    ck_assert_int_eq(exp_invalidations, stats.invalidations);
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_miss_then_hit)
+{
+    skidFileMeta meta;        // Metadata
+    int errnum = CANARY_INT;  // Errno from the function calls
+
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    check_stats(0, 1, 1);
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    check_stats(1, 1, 1);
+    ck_assert_int_eq(5, get_meta_size(&meta, &errnum));
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+}
+END_TEST
+
+
+START_TEST(test_n02_write_invalidates)
+{
+    skidFileMeta meta;        // Metadata
+    int errnum = CANARY_INT;  // Errno from the function calls
+    int fd = -1;              // File descriptor for the test file
+
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    fd = open(test_file_path, O_WRONLY | O_APPEND);
+    ck_assert_int_ne(-1, fd);
+    ck_assert_int_eq(5, write(fd, "More\n", 5));
+    close(fd);
+    wait_for_invalidations(1);
+    check_stats(0, 1, 0);
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    ck_assert_int_eq(10, get_meta_size(&meta, &errnum));
+    check_stats(0, 2, 1);
+}
+END_TEST
+
+
+START_TEST(test_n03_chmod_invalidates)
+{
+    skidFileMeta meta;        // Metadata
+    int errnum = CANARY_INT;  // Errno from the function calls
+
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    ck_assert_int_eq(0, chmod(test_file_path, 0600));
+    wait_for_invalidations(1);
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    ck_assert_int_eq(0600, get_meta_file_perms(&meta, &errnum));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_cache)
+{
+    skidFileMeta meta;  // Metadata
+    ck_assert_int_eq(EINVAL, get_cached_meta(NULL, test_file_path, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e02_null_pathname)
+{
+    skidFileMeta meta;  // Metadata
+    ck_assert_int_eq(EINVAL, get_cached_meta(test_cache, NULL, &meta));
+}
+END_TEST
+
+
+START_TEST(test_e03_null_meta)
+{
+    ck_assert_int_eq(EINVAL, get_cached_meta(test_cache, test_file_path, NULL));
+}
+END_TEST
+
+
+START_TEST(test_e04_relative_dirname)
+{
+    skidMetaCacheStats stats;  // test_cache's counters
+
+    // Relative keys would silently go stale after a chdir()
+    ck_assert_int_eq(EINVAL, watch_meta_cache_dir(test_cache, "code/test/test_output"));
+    ck_assert_int_eq(EINVAL, watch_meta_cache_dir(test_cache, "."));
+    ck_assert_int_eq(EINVAL, watch_meta_cache_dir(test_cache, "./"));
+    ck_assert_int_eq(0, get_meta_cache_stats(test_cache, &stats));
+    ck_assert_int_eq(0, stats.entries);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_missing_file_not_cached)
+{
+    skidFileMeta meta;   // Metadata
+    char missing[4096];  // A pathname in the test directory that doesn't exist
+
+    snprintf(missing, sizeof(missing), "%s/missing.txt", test_dir_path);
+    ck_assert_int_eq(ENOENT, get_cached_meta(test_cache, missing, &meta));
+    ck_assert_int_eq(ENOENT, get_cached_meta(test_cache, missing, &meta));
+    check_stats(0, 2, 0);
+}
+END_TEST
+
+
+START_TEST(test_s02_symbolic_link_followed_not_cached)
+{
+    skidFileMeta meta;        // Metadata
+    int errnum = CANARY_INT;  // Errno from the function calls
+
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_link_path, &meta));
+    ck_assert_int_eq(S_IFREG, get_meta_file_type(&meta, &errnum));
+    check_stats(0, 1, 0);
+}
+END_TEST
+
+
+START_TEST(test_s03_unwatched_dir_not_cached)
+{
+    skidFileMeta meta;  // Metadata
+    ck_assert_int_eq(0, get_cached_meta(test_cache, "/dev/null", &meta));
+    ck_assert_int_eq(0, get_cached_meta(test_cache, "/dev/null", &meta));
+    check_stats(0, 2, 0);
+}
+END_TEST
+
+
+START_TEST(test_s04_flush)
+{
+    skidFileMeta meta;  // Metadata
+    ck_assert_int_eq(0, get_cached_meta(test_cache, test_file_path, &meta));
+    ck_assert_int_eq(0, flush_meta_cache(test_cache));
+    check_stats(0, 1, 0);
+}
+END_TEST
+
+
+START_TEST(test_s05_relative_pathname_not_cached)
+{
+    skidFileMeta meta;    // Metadata
+    char orig_cwd[4096];  // Restored before returning
+
+    // "file.txt" names a different file after every chdir()
+    ck_assert_ptr_nonnull(getcwd(orig_cwd, sizeof(orig_cwd)));
+    ck_assert_int_eq(0, chdir(test_dir_path));
+    ck_assert_int_eq(0, get_cached_meta(test_cache, "file.txt", &meta));
+    ck_assert_int_eq(0, get_cached_meta(test_cache, "./file.txt", &meta));
+    ck_assert_int_eq(0, chdir(orig_cwd));
+    check_stats(0, 2, 0);
+}
+END_TEST
+
+
+Suite *get_cached_meta_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SMC_Get_Cached_Meta");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+    tcase_add_checked_fixture(tc_core, setup, teardown);
+
+    tcase_add_test(tc_core, test_n01_miss_then_hit);
+    tcase_add_test(tc_core, test_n02_write_invalidates);
+    tcase_add_test(tc_core, test_n03_chmod_invalidates);
+    tcase_add_test(tc_core, test_e01_null_cache);
+    tcase_add_test(tc_core, test_e02_null_pathname);
+    tcase_add_test(tc_core, test_e03_null_meta);
+    tcase_add_test(tc_core, test_e04_relative_dirname);
+    tcase_add_test(tc_core, test_s01_missing_file_not_cached);
+    tcase_add_test(tc_core, test_s02_symbolic_link_followed_not_cached);
+    tcase_add_test(tc_core, test_s03_unwatched_dir_not_cached);
+    tcase_add_test(tc_core, test_s04_flush);
+    tcase_add_test(tc_core, test_s05_relative_pathname_not_cached);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_smc_get_cached_meta.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = get_cached_meta_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
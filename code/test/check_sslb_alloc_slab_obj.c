@@ -0,0 +1,403 @@
+/*
+ *  Check unit test suit for skid_slab.h's alloc_slab_obj() function (and the functions that
+ *  share a slab pool with it).
+ *
+ *  Copy/paste the following from the repo's top-level directory...
+
+make -C code dist/check_sslb_alloc_slab_obj.bin
+code/dist/check_sslb_alloc_slab_obj.bin && CK_FORK=no valgrind --leak-check=full --show-leak-kinds=all code/dist/check_sslb_alloc_slab_obj.bin
+
+ *
+ */
+
+#include <check.h>                    // START_TEST(), END_TEST
+#include <errno.h>                    // EINVAL, EOVERFLOW
+#include <poll.h>                     // struct pollfd
+#include <pthread.h>                  // pthread_create(), pthread_join()
+#include <stddef.h>                   // max_align_t
+#include <stdint.h>                   // SIZE_MAX, uintptr_t
+#include <stdlib.h>
+#include <string.h>                   // memset()
+// Local includes
+#include "devops_code.h"              // resolve_to_repo(), SKID_REPO_NAME
+#include "skid_slab.h"                // alloc_slab_obj(), create_slab_pool(), free_slab_obj()
+
+
+// Use this to help highlight an errnum that wasn't updated
+#define CANARY_INT (int)0xBADC0DE  // Actually, a reverse canary value
+#define NUM_THREADS 4              // Number of threads sharing a pool with thread caches
+#define OBJS_PER_THREAD 200        // Number of objects each thread holds at once
+#define OBJ_ALIGN __alignof__(max_align_t)  // Object sizes are rounded up to a multiple of this
+
+
+/**************************************************************************************************/
+/***************************************** TEST FIXTURES ******************************************/
+/**************************************************************************************************/
+
+/*
+ *  Verify pool's counters.
+ */
+void check_stats(skidSlabPool_ptr pool, uint64_t exp_live, uint64_t exp_high_water);
+
+/*
+ *  Thread start routine: allocate OBJS_PER_THREAD objects from the pool, scribble on them, and
+ *  free them all.  Returns the first errno value encountered.
+ */
+void *churn_slab_pool(void *pool);
+
+
+void check_stats(skidSlabPool_ptr pool, uint64_t exp_live, uint64_t exp_high_water)
+{
+    skidSlabStats stats;  // pool's counters
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, false));
+    ck_assert_int_eq(exp_live, stats.live);
+    ck_assert_int_eq(exp_high_water, stats.high_water);
+}
+
+
+void *churn_slab_pool(void *pool)
+{
+    // LOCAL VARIABLES
+    int errnum = ENOERR;                     // Errno from the function calls
+    void *objs[OBJS_PER_THREAD] = { NULL };  // Objects held at once
+
+    // CHURN
+    for (int round = 0; ENOERR == errnum && round < 10; round++)
+    {
+        for (int i = 0; ENOERR == errnum && i < OBJS_PER_THREAD; i++)
+        {
+            objs[i] = alloc_slab_obj(pool, &errnum);
+            if (ENOERR == errnum && 0 != *(long *)objs[i])
+            {
+                errnum = -1;  // Not zeroized
+            }
+            else if (ENOERR == errnum)
+            {
+                memset(objs[i], 0xFF, sizeof(long));
+            }
+        }
+        for (int i = 0; i < OBJS_PER_THREAD; i++)
+        {
+            if (objs[i] && ENOERR == errnum)
+            {
+                errnum = free_slab_obj(pool, &objs[i]);
+            }
+        }
+    }
+
+    // DONE
+    return (void *)(intptr_t)errnum;
+}
+
+
+/**************************************************************************************************/
+/*************************************** NORMAL TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_n01_alloc_free_reuse)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    long *obj = NULL;              // An object
+    long *old_obj = NULL;          // The first object's address
+
+    pool = create_slab_pool(sizeof(long) * 4, 0, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    obj = alloc_slab_obj(pool, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_nonnull(obj);
+    ck_assert_int_eq(0, obj[0] | obj[1] | obj[2] | obj[3]);
+    obj[0] = obj[3] = -1;
+    old_obj = obj;
+    ck_assert_int_eq(0, free_slab_obj(pool, (void **)&obj));
+    ck_assert_ptr_null(obj);
+    // The free list hands it right back, zeroized again
+    obj = alloc_slab_obj(pool, &errnum);
+    ck_assert_ptr_eq(old_obj, obj);
+    ck_assert_int_eq(0, obj[0] | obj[1] | obj[2] | obj[3]);
+    ck_assert_int_eq(0, free_slab_obj(pool, (void **)&obj));
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+    ck_assert_ptr_null(pool);
+}
+END_TEST
+
+
+START_TEST(test_n02_stats_high_water)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    void *objs[10] = { NULL };     // Objects
+    skidSlabStats stats;           // pool's counters
+
+    pool = create_slab_pool(24, 0, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    check_stats(pool, 0, 0);
+    for (int i = 0; i < 10; i++)
+    {
+        objs[i] = alloc_slab_obj(pool, &errnum);
+        ck_assert_int_eq(0, errnum);
+    }
+    check_stats(pool, 10, 10);
+    for (int i = 0; i < 7; i++)
+    {
+        ck_assert_int_eq(0, free_slab_obj(pool, &objs[i]));
+    }
+    check_stats(pool, 3, 10);
+    // Reset the high-water mark
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, true));
+    ck_assert_int_eq(10, stats.high_water);
+    ck_assert_int_eq((24 + OBJ_ALIGN - 1) / OBJ_ALIGN * OBJ_ALIGN, stats.obj_size);
+    ck_assert_int_eq(1, stats.slabs);
+    check_stats(pool, 3, 3);
+    for (int i = 7; i < 10; i++)
+    {
+        ck_assert_int_eq(0, free_slab_obj(pool, &objs[i]));
+    }
+    check_stats(pool, 0, 3);
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+START_TEST(test_n03_spans_slabs)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    char *objs[10] = { NULL };     // Objects
+    skidSlabStats stats;           // pool's counters
+
+    pool = create_slab_pool(64, 4, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < 10; i++)
+    {
+        objs[i] = alloc_slab_obj(pool, &errnum);
+        ck_assert_int_eq(0, errnum);
+        memset(objs[i], i, 64);
+        for (int j = 0; j < i; j++)
+        {
+            ck_assert_ptr_ne(objs[i], objs[j]);
+        }
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        ck_assert_int_eq(i, objs[i][0]);  // Nobody stepped on anybody
+        ck_assert_int_eq(i, objs[i][63]);
+    }
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, false));
+    ck_assert_int_eq(3, stats.slabs);
+    ck_assert_int_eq(12, stats.capacity);
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));  // Live objects and all
+}
+END_TEST
+
+
+START_TEST(test_n04_thread_caches)
+{
+    int errnum = CANARY_INT;         // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;    // The pool under test
+    pthread_t threads[NUM_THREADS];  // Threads sharing the pool
+    void *thread_ret = NULL;         // A thread's return value
+    skidSlabStats stats;             // pool's counters
+
+    pool = create_slab_pool(sizeof(long), 0, true, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        ck_assert_int_eq(0, pthread_create(&threads[i], NULL, churn_slab_pool, pool));
+    }
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        ck_assert_int_eq(0, pthread_join(threads[i], &thread_ret));
+        ck_assert_int_eq(0, (intptr_t)thread_ret);
+    }
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, false));
+    ck_assert_int_eq(0, stats.live);
+    ck_assert_int_ge(stats.high_water, OBJS_PER_THREAD);
+    ck_assert_int_le(stats.high_water, NUM_THREADS * OBJS_PER_THREAD);
+    // This thread gets a cache too
+    ck_assert_ptr_eq(NULL, churn_slab_pool(pool));
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+START_TEST(test_n05_pollfd_arrays)
+{
+    int errnum = CANARY_INT;         // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;    // The pool under test
+    struct pollfd *poll_fds = NULL;  // An array of pollfd structs
+
+    pool = create_slab_pool(16 * sizeof(struct pollfd), 0, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    poll_fds = alloc_slab_obj(pool, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < 16; i++)
+    {
+        ck_assert_int_eq(0, poll_fds[i].fd);
+        poll_fds[i].fd = i;
+        poll_fds[i].events = POLLIN;
+    }
+    ck_assert_int_eq(15, poll_fds[15].fd);
+    ck_assert_int_eq(0, free_slab_obj(pool, (void **)&poll_fds));
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/**************************************** ERROR TEST CASES ****************************************/
+/**************************************************************************************************/
+START_TEST(test_e01_null_pool)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    void *obj = &errnum;           // A non-NULL pointer
+    skidSlabStats stats;           // Counters
+    skidSlabPool_ptr pool = NULL;  // A NULL pool
+
+    ck_assert_ptr_null(alloc_slab_obj(NULL, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_int_eq(EINVAL, free_slab_obj(NULL, &obj));
+    ck_assert_ptr_eq(&errnum, obj);  // Untouched
+    ck_assert_int_eq(EINVAL, get_slab_stats(NULL, &stats, false));
+    ck_assert_int_eq(EINVAL, destroy_slab_pool(&pool));
+    ck_assert_int_eq(EINVAL, destroy_slab_pool(NULL));
+}
+END_TEST
+
+
+START_TEST(test_e02_bad_args)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    void *obj = NULL;              // A NULL object
+
+    ck_assert_ptr_null(create_slab_pool(0, 0, false, &errnum));
+    ck_assert_int_eq(EINVAL, errnum);
+    ck_assert_ptr_null(create_slab_pool(8, 0, false, NULL));
+    pool = create_slab_pool(8, 0, true, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_ptr_null(alloc_slab_obj(pool, NULL));
+    ck_assert_int_eq(EINVAL, free_slab_obj(pool, NULL));
+    ck_assert_int_eq(EINVAL, free_slab_obj(pool, &obj));
+    ck_assert_int_eq(EINVAL, get_slab_stats(pool, NULL, false));
+    check_stats(pool, 0, 0);
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/************************************** BOUNDARY TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_b01_object_bigger_than_slab)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    char *objs[2] = { NULL };      // Objects
+    skidSlabStats stats;           // pool's counters
+
+    pool = create_slab_pool(SKID_SLAB_SIZE * 2, 0, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    for (int i = 0; i < 2; i++)
+    {
+        objs[i] = alloc_slab_obj(pool, &errnum);
+        ck_assert_int_eq(0, errnum);
+        objs[i][SKID_SLAB_SIZE * 2 - 1] = 'X';  // Touch the last byte
+    }
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, false));
+    ck_assert_int_eq(2, stats.slabs);
+    ck_assert_int_eq(2, stats.capacity);
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+START_TEST(test_b02_overflow)
+{
+    int errnum = CANARY_INT;  // Errno from the function calls
+    ck_assert_ptr_null(create_slab_pool(SIZE_MAX, 0, false, &errnum));
+    ck_assert_int_eq(EOVERFLOW, errnum);
+    ck_assert_ptr_null(create_slab_pool(SIZE_MAX / 4, 8, false, &errnum));
+    ck_assert_int_eq(EOVERFLOW, errnum);
+}
+END_TEST
+
+
+/**************************************************************************************************/
+/*************************************** SPECIAL TEST CASES ***************************************/
+/**************************************************************************************************/
+START_TEST(test_s01_tiny_objects_rounded_up)
+{
+    int errnum = CANARY_INT;       // Errno from the function calls
+    skidSlabPool_ptr pool = NULL;  // The pool under test
+    char *first = NULL;            // An object
+    char *second = NULL;           // The next object
+    skidSlabStats stats;           // pool's counters
+
+    pool = create_slab_pool(1, 0, false, &errnum);
+    ck_assert_int_eq(0, errnum);
+    first = alloc_slab_obj(pool, &errnum);
+    second = alloc_slab_obj(pool, &errnum);
+    ck_assert_int_eq(0, errnum);
+    ck_assert_int_eq(OBJ_ALIGN, second - first);
+    ck_assert_int_eq(0, (uintptr_t)first % OBJ_ALIGN);
+    ck_assert_int_eq(0, get_slab_stats(pool, &stats, false));
+    ck_assert_int_eq(OBJ_ALIGN, stats.obj_size);
+    ck_assert_int_eq(0, destroy_slab_pool(&pool));
+}
+END_TEST
+
+
+Suite *alloc_slab_obj_suite(void)
+{
+    Suite *suite = NULL;
+    TCase *tc_core = NULL;
+
+    suite = suite_create("SSLB_Alloc_Slab_Obj");
+
+    /* Core test case */
+    tc_core = tcase_create("Core");
+
+    tcase_add_test(tc_core, test_n01_alloc_free_reuse);
+    tcase_add_test(tc_core, test_n02_stats_high_water);
+    tcase_add_test(tc_core, test_n03_spans_slabs);
+    tcase_add_test(tc_core, test_n04_thread_caches);
+    tcase_add_test(tc_core, test_n05_pollfd_arrays);
+    tcase_add_test(tc_core, test_e01_null_pool);
+    tcase_add_test(tc_core, test_e02_bad_args);
+    tcase_add_test(tc_core, test_b01_object_bigger_than_slab);
+    tcase_add_test(tc_core, test_b02_overflow);
+    tcase_add_test(tc_core, test_s01_tiny_objects_rounded_up);
+    suite_add_tcase(suite, tc_core);
+
+    return suite;
+}
+
+
+int main(void)
+{
+    // LOCAL VARIABLES
+    int errnum = 0;  // Errno from the function call
+    // Relative path for this test case's input
+    char log_rel_path[] = { "./code/test/test_output/check_sslb_alloc_slab_obj.log" };
+    // Absolute path for log_rel_path as resolved against the repo name
+    char *log_abs_path = resolve_to_repo(SKID_REPO_NAME, log_rel_path, false, &errnum);
+    int number_failed = 0;
+    Suite *suite = NULL;
+    SRunner *suite_runner = NULL;
+
+    // SETUP
+    suite = alloc_slab_obj_suite();
+    suite_runner = srunner_create(suite);
+    srunner_set_log(suite_runner, log_abs_path);
+
+    // RUN IT
+    srunner_run_all(suite_runner, CK_NORMAL);
+    number_failed = srunner_ntests_failed(suite_runner);
+
+    // CLEANUP
+    srunner_free(suite_runner);
+    free_devops_mem((void **)&log_abs_path);
+
+    // DONE
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
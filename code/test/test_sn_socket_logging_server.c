@@ -19,18 +19,20 @@
 #include <stdbool.h>                        // true
 #include <stdint.h>                         // intmax_t
 #include <stdlib.h>                         // exit()
+#include <string.h>                         // strlen()
 #include <sys/socket.h>                     // AF_UNIX
+#include <sys/uio.h>                        // struct iovec
 #include <sys/un.h>                         // struct sockaddr_un
 #include "skid_debug.h"                     // MODULE_LOAD(), MODULE_UNLOAD()
 #include "skid_file_metadata_read.h"        // is_path()
-#include "skid_file_operations.h"           // delete_file()
+#include "skid_file_operations.h"           // delete_file(), open_appender(), write_appender_v()
 #include "skid_macros.h"                    // ENOERR
 #include "skid_memory.h"                    // free_skid_mem()
 #include "skid_network.h"                   // close_socket()
 #include "skid_signal_handlers.h"           // handle_signal_number()
 #include "skid_signals.h"                   // set_signal_handler()
-#include "skid_time.h"                      // timestamp_a_msg()
-#include "skid_validation.h"                // validate_skid_pathname()
+#include "skid_time.h"                      // build_timestamp()
+#include "skid_validation.h"                // validate_skid_string()
 
 MODULE_LOAD();  // Print the module name being loaded using the gcc constructor attribute
 MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destructor attribute
@@ -40,17 +42,14 @@ MODULE_UNLOAD();  // Print the module name being unloaded using the gcc destruct
 #define SOCKET_DOMAIN AF_UNIX          // Socket domain
 #define SOCKET_TYPE SOCK_STREAM        // Socket type
 #define QUEUE_BACKLOG (int)1024        // Maximum length of the pending socket queue
+#define LOG_FLUSH_MS 250               // Write buffered log entries once they're this old
+#define LOG_SYNC_MS 1000               // fdatasync() the log at most this often
 
 /*
- *  Add a newline to msg.  Free the return value with free_skid_mem().  Returns msg if no changes
- *  were made.  Returns NULL on error and errnum is set with an errno value.
+ *  Log a message as one "[timestamp] msg\n" frame, appended with a single write_appender_v()
+ *  call.  A newline is only added if msg doesn't already end with one.
  */
-char *add_newline(char *msg, int *errnum);
-
-/*
- *  Log a message.
- */
-int log_message(const char *log_filename, char *msg);
+int log_message(skidAppender_ptr appender, char *msg);
 
 /*
  *  Single point of truth for this program's "escape".
@@ -63,9 +62,9 @@ void print_shutdown(const char *prog_name, const char *sock_path);
 void print_usage(const char *prog_name);
 
 /*
- *  Read a message from a socket file descriptor, log it to log_filename, and close sockfd.
+ *  Read a message from a socket file descriptor, log it to appender, and close sockfd.
  */
-int receive_and_log(int *sockfd, int flags, const char *log_filename);
+int receive_and_log(int *sockfd, int flags, skidAppender_ptr appender);
 
 /*
  *  Open a socket, binds it to sock_path and sets it to listen.  Returns the socket file descriptor.
@@ -83,6 +82,7 @@ int main(int argc, char *argv[])
     int client_fd = SKID_BAD_FD;      // Incoming client file descriptor
     int tmp_errnum = ENOERR;          // Temp errnum values
     int recv_flags = 0;               // See recv(2)
+    skidAppender appender = { .fd = SKID_BAD_FD };  // Log file, held open for the server's life
 
     // INPUT VALIDATION
     // Arguments
@@ -133,6 +133,17 @@ int main(int argc, char *argv[])
         exit_code = set_signal_handler(SHUTDOWN_SIG, handle_signal_number, flags, NULL);
     }
 
+    // Log file
+    if (ENOERR == exit_code)
+    {
+        exit_code = open_appender(&appender, log_filename, 0, LOG_FLUSH_MS, LOG_SYNC_MS, true);
+        if (ENOERR != exit_code)
+        {
+            PRINT_ERROR(The call to open_appender() failed);
+            PRINT_ERRNO(exit_code);
+        }
+    }
+
     // LOG IT
     // Setup the socket
     if (ENOERR == exit_code)
@@ -182,11 +193,12 @@ int main(int argc, char *argv[])
             else if (ENOERR != exit_code)
             {
                 exit_code = ENOERR;  // Still waiting on an incoming connection
+                flush_appender(&appender, true);  // Idle, so get pending entries on disk
                 sleep(1);  // Tasteful sleep
             }
             else
             {
-                exit_code = receive_and_log(&client_fd, recv_flags, log_filename);
+                exit_code = receive_and_log(&client_fd, recv_flags, &appender);
             }
         }
     }
@@ -194,6 +206,16 @@ int main(int argc, char *argv[])
     // CLEANUP
     // Socket file descriptor
     close_socket(&sock_fd, true);  // Best effort
+    // Log file
+    if (SKID_BAD_FD != appender.fd)
+    {
+        tmp_errnum = close_appender(&appender);  // Writes and syncs pending entries
+        if (ENOERR != tmp_errnum)
+        {
+            PRINT_ERROR(The call to close_appender() failed);
+            PRINT_ERRNO(tmp_errnum);
+        }
+    }
     // Delete SOCK_PATH
     if (true == is_path(SOCK_PATH, &tmp_errnum))
     {
@@ -210,60 +232,20 @@ int main(int argc, char *argv[])
 }
 
 
-char *add_newline(char *msg, int *errnum)
-{
-    // LOCAL VARIABLES
-    int results = validate_skid_string(msg, true);  // Errno values
-    size_t msg_len = 0;                             // Length of msg
-    char *new_msg = msg;                      // Copy of msg w/ newline added
-
-    // INPUT VALIDATION
-    if (ENOERR == results)
-    {
-        results = validate_skid_err(errnum);
-    }
-
-    // ADD IT
-    if (ENOERR == results)
-    {
-        msg_len = strlen(msg);
-        if ('\n' != msg[msg_len - 1])
-        {
-            new_msg = alloc_skid_mem(msg_len + 2, sizeof(msg[0]), &results);
-            if (ENOERR == results)
-            {
-                strncpy(new_msg, msg, msg_len);
-                strcat(new_msg, "\n");
-            }
-        }
-    }
-
-    // DONE
-    if (NULL != errnum)
-    {
-        *errnum = results;
-    }
-    if (ENOERR != results)
-    {
-        new_msg = NULL;
-    }
-    return new_msg;
-}
-
-
-int log_message(const char *log_filename, char *msg)
+int log_message(skidAppender_ptr appender, char *msg)
 {
     // LOCAL VARIABLES
-    int results = ENOERR;           // Errno values
-    char *stamp_msg = NULL;         // Time-stamped message
-    char delims[2] = { '[', ']' };  // Timestamp delimiters
-    char *new_msg = NULL;           // Add a newline if one doesn't exist
+    int results = ENOERR;                         // Errno values
+    char *timestamp = NULL;                       // Heap-allocated timestamp
+    size_t msg_len = 0;                           // Length of msg
+    struct iovec frame[5] = { { 0 } };            // "[", timestamp, "] ", msg, "\n"
+    int frame_cnt = 4;                            // Number of frame entries in use
 
     // INPUT VALIDATION
-    // Log filename
-    if (ENOERR == results)
+    // Appender
+    if (NULL == appender)
     {
-        results = validate_skid_pathname(log_filename, false);
+        results = EINVAL;
     }
     // msg
     if (ENOERR == results)
@@ -272,32 +254,42 @@ int log_message(const char *log_filename, char *msg)
     }
 
     // SETUP
+    // Get the timestamp
     if (ENOERR == results)
     {
-        new_msg = add_newline(msg, &results);
+        timestamp = build_timestamp(&results);
     }
-
-    // LOG IT
-    // Form the time-stamped message
+    // Frame the message without copying it
     if (ENOERR == results)
     {
-        stamp_msg = timestamp_a_msg(new_msg, delims, &results);
+        msg_len = strlen(msg);
+        frame[0].iov_base = "[";
+        frame[0].iov_len = 1;
+        frame[1].iov_base = timestamp;
+        frame[1].iov_len = strlen(timestamp);
+        frame[2].iov_base = "] ";
+        frame[2].iov_len = 2;
+        frame[3].iov_base = msg;
+        frame[3].iov_len = msg_len;
+        if (0 == msg_len || '\n' != msg[msg_len - 1])
+        {
+            frame[4].iov_base = "\n";
+            frame[4].iov_len = 1;
+            frame_cnt++;
+        }
     }
-    // Write the time-stamped message to log_filename
+
+    // LOG IT
+    // Append the time-stamped message to the log
     if (ENOERR == results)
     {
-        results = append_to_file(log_filename, stamp_msg, true);
+        results = write_appender_v(appender, frame, frame_cnt);
     }
 
     // CLEAN UP
-    if (NULL != new_msg && new_msg != msg)
-    {
-        // add_newline() allocated memory
-        free_skid_mem((void **)&new_msg);  // Best effort
-    }
-    if (NULL != stamp_msg)
+    if (NULL != timestamp)
     {
-        free_skid_mem((void**)&stamp_msg);  // Best effort
+        free_skid_mem((void**)&timestamp);  // Best effort
     }
 
     // DONE
@@ -320,7 +312,7 @@ void print_usage(const char *prog_name)
 }
 
 
-int receive_and_log(int *sockfd_ptr, int flags, const char *log_filename)
+int receive_and_log(int *sockfd_ptr, int flags, skidAppender_ptr appender)
 {
     // LOCAL VARIABLES
     int results = ENOERR;      // Errno values
@@ -338,10 +330,10 @@ int receive_and_log(int *sockfd_ptr, int flags, const char *log_filename)
         sockfd = *sockfd_ptr;
         results = validate_skid_sockfd(sockfd);
     }
-    // Log filename
-    if (ENOERR == results)
+    // Appender
+    if (ENOERR == results && NULL == appender)
     {
-        results = validate_skid_pathname(log_filename, false);
+        results = EINVAL;
     }
 
     // DO IT
@@ -359,7 +351,7 @@ int receive_and_log(int *sockfd_ptr, int flags, const char *log_filename)
     // Log
     if (ENOERR == results)
     {
-        results = log_message(log_filename, msg);
+        results = log_message(appender, msg);
     }
 
     // CLEAN UP
@@ -27,9 +27,9 @@
 #include "skid_debug.h"                     // MODULE_*LOAD(), *PRINT*_ERR*()
 #include "skid_file_descriptors.h"          // read_fd(), write_fd()
 #include "skid_macros.h"                    // ENOERR, SKID_BAD_FD, SKID_BAD_PID
-#include "skid_memory.h"                    // free_skid_mem()
+#include "skid_memory.h"                    // free_skid_buffer(), free_skid_mem()
 #include "skid_pipes.h"                     // close_pipe(), create_pipes()
-#include "skid_poll.h"                      // struct pollfd
+#include "skid_poll.h"                      // read_pollfd_buf(), struct pollfd
 #include "skid_random.h"                    // randomize_number()
 #include "skid_signal_handlers.h"           // handle_signal_number()
 #include "skid_signals.h"                   // set_signal_handler()
@@ -100,7 +100,7 @@ int main(int argc, char *argv[])
     int pipe_write_fd = SKID_BAD_FD;  // Temp write end of the pipe
     pid_t *child_pids = NULL;         // Heap-allocated array for the parent to store child PIDs
     struct pollfd *poll_fds = NULL;   // Heap-allocated array for the pollfd structs
-    char *tmp_msg = NULL;             // Temp var w/ heap-allocated string read for poll()ing fds
+    skidBuffer msg_buf = { 0 };       // Reusable buffer for the messages read from poll()ed fds
     int num_rdy = 0;                  // Number of fds ready
     int tmp_revents = 0;              // Temp var to store the revents
 
@@ -229,15 +229,14 @@ int main(int argc, char *argv[])
                 {
                     if (SKID_BAD_FD != poll_fds[i].fd)
                     {
-                        tmp_msg = read_pollfd(&(poll_fds[i]), &tmp_revents, &exit_code);
-                        if (NULL != tmp_msg)
+                        exit_code = read_pollfd_buf(&(poll_fds[i]), &tmp_revents, &msg_buf);
+                        if (ENOERR == exit_code && msg_buf.length > 0)
                         {
-                            fprintf(stdout, "%s: %s\n", PARENT_STR, tmp_msg);
-                            exit_code = free_skid_mem((void **)&tmp_msg);
+                            fprintf(stdout, "%s: %s\n", PARENT_STR, msg_buf.data);
                         }
                         else if (ENOERR != exit_code)
                         {
-                            PRINT_ERROR(The call to read_pollfd() failed);
+                            PRINT_ERROR(The call to read_pollfd_buf() failed);
                             PRINT_ERRNO(exit_code);
                             break;  // Error encountered so stop looping
                         }
@@ -257,6 +256,7 @@ int main(int argc, char *argv[])
     }
     // Free *everything*
     clean_up(&child_pids, &poll_fds, num_children, SKID_BAD_FD);  // Close them *all*
+    free_skid_buffer(&msg_buf);  // Best effort
 
     // DONE
     exit(exit_code);